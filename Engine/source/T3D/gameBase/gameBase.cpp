@@ -677,6 +677,14 @@ void GameBase::consoleInit()
       "@brief Toggles on the rendering of the bounding boxes for certain types of objects in scene.\n\n"
       "@ingroup GameBase" );
 #endif
+
+   Con::addVariable( "$pref::ProcessList::parallelTick", TypeBool, &ProcessList::smParallelTick,
+      "@brief If true, objects that are safe to tick on other threads run processTick on the thread pool "
+      "before the remaining objects tick on the main thread.\n\n"
+      "@ingroup GameBase" );
+   Con::addVariable( "$pref::ProcessList::parallelTickMinObjects", TypeS32, &ProcessList::smParallelTickMinObjects,
+      "@brief Objects are only ticked in parallel if at least this many of them are thread-safe.\n\n"
+      "@ingroup GameBase" );
 }
 
 DefineEngineMethod( GameBase, applyImpulse, bool, ( Point3F pos, VectorF vel ),,
@@ -33,6 +33,7 @@
 #include "sfx/sfxDescription.h"
 #include "app/game.h"
 #include "app/auth.h"
+#include "app/timeDemo.h"
 #include "T3D/camera.h"
 #include "T3D/gameBase/gameProcess.h"
 #include "T3D/gameBase/gameConnectionEvents.h"
@@ -1027,6 +1028,10 @@ void GameConnection::demoPlaybackComplete()
    static const char* demoPlaybackArgv[1] = { "demoPlaybackComplete" };
    static StringStackConsoleWrapper demoPlaybackCmd(1, demoPlaybackArgv);
 
+   // The recording is done, so is any time demo playing it back.
+   if (TimeDemo::isRunning())
+      TimeDemo::stop();
+
    Sim::postCurrentEvent(Sim::getRootGroup(), new SimConsoleEvent(demoPlaybackCmd.argc, demoPlaybackCmd.argv, false));
    Parent::demoPlaybackComplete();
 }
@@ -0,0 +1,534 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "T3D/gameBase/loadTestConnection.h"
+
+#include "core/stream/bitStream.h"
+#include "console/engineAPI.h"
+#include "console/simEvents.h"
+#include "T3D/gameBase/gameProcess.h"
+#include "T3D/gameBase/moveList.h"
+
+IMPLEMENT_CONOBJECT( LoadTestConnection );
+
+ConsoleDocClass( LoadTestConnection,
+   "@brief Simulated client connection used to load test a server from within the same process.\n\n"
+
+   "Each bot is a pair of local connections.  The server side behaves like the connection of a "
+   "real client: it is added to the ClientGroup, ghosts the scene and runs the Moves it receives "
+   "on its control object.  The bot side stands in for the remote client and sends idle, random "
+   "or scripted Moves every tick.\n\n"
+
+   "Unlike a normal client the server side does not call onConnect().  It calls onBotConnect() "
+   "instead, which should create the control object for the bot.  Ghosting is activated right after.\n\n"
+
+   "@tsexample\n"
+   "function LoadTestConnection::onBotConnect(%client)\n"
+   "{\n"
+   "   Game.preparePlayer(%client);\n"
+   "}\n\n"
+   "// 32 bots running around at random for a minute behind a 100 ms ping.\n"
+   "startLoadTest(32, 60, \"random\", 100);\n"
+   "@endtsexample\n\n"
+
+   "@see startLoadTest()\n\n"
+
+   "@ingroup Networking\n");
+
+IMPLEMENT_CALLBACK( LoadTestConnection, onBotConnect, void, (), (),
+   "@brief Called on the server side of a bot once it is connected.\n\n"
+   "This is where the control object for the bot should be created.\n\n");
+
+IMPLEMENT_CALLBACK( LoadTestConnection, onBotMove, void, ( U32 tick ), ( tick ),
+   "@brief Called on the bot side every tick when the test runs with scripted moves.\n\n"
+   "Use setBotMove() and setBotTrigger() to change the move the bot sends.\n\n"
+   "@param tick Number of ticks since the test started.\n\n");
+
+Vector< SimObjectPtr<LoadTestConnection> > LoadTestConnection::smBots;
+bool LoadTestConnection::smRunning = false;
+LoadTestConnection::Stats LoadTestConnection::smStats;
+U32 LoadTestConnection::smEndEvent = 0;
+U32 LoadTestConnection::smPreTickTime = 0;
+
+namespace
+{
+   class LoadTestEndEvent : public SimEvent
+   {
+   public:
+      virtual void process(SimObject*)
+      {
+         LoadTestConnection::stopTest();
+      }
+   };
+
+   S32 QSORT_CALLBACK compareU32(const U32 *a, const U32 *b)
+   {
+      return (*a > *b) - (*a < *b);
+   }
+
+   /// Returns the value at @a fraction of a sorted list.
+   U32 percentile(const Vector<U32> &sorted, F32 fraction)
+   {
+      if(sorted.empty())
+         return 0;
+      return sorted[getMin(U32(fraction * sorted.size()), U32(sorted.size() - 1))];
+   }
+}
+
+void LoadTestConnection::Stats::reset()
+{
+   numBots = 0;
+   durationMs = 0;
+   startTime = 0;
+   numTicks = 0;
+   tickMs = 0;
+   writeMs = 0;
+   parallelTicks = 0;
+   tickTimes.clear();
+   downLatencies.clear();
+   upLatencies.clear();
+}
+
+LoadTestConnection::LoadTestConnection()
+{
+   mMoveMode = MoveIdle;
+   mMove = NullMove;
+   mNextMoveChange = 0;
+   mPacketsSent = 0;
+   mBytesSent = 0;
+}
+
+bool LoadTestConnection::connectBot(const char *name, U32 ping, F32 packetLoss)
+{
+   // This follows NetConnection::connectLocal() except that the server side
+   // does not become the LocalClientConnection and this side does not become
+   // the connection to the server.
+   LoadTestConnection *server = new LoadTestConnection;
+   server->registerObject();
+
+   setSimulatedNetwork(true);
+   server->setSimulatedNetwork(true);
+
+   server->setSequence(0);
+   setSequence(0);
+   setRemoteConnectionObject(server);
+   server->setRemoteConnectionObject(this);
+
+   server->checkMaxRate();
+   checkMaxRate();
+
+   setConnectArgs(1, &name);
+   setJoinPassword(Con::getVariable("$Pref::Server::Password"));
+
+   BitStream *stream = BitStream::getPacketStream();
+   stream->setPosition(0);
+   writeConnectRequest(stream);
+   stream->setPosition(0);
+
+   const char *error;
+   if(!server->readConnectRequest(stream, &error))
+   {
+      Con::errorf("LoadTestConnection::connectBot - %s was rejected: %s", name, error);
+      setRemoteConnectionObject(NULL);
+      server->deleteObject();
+      return false;
+   }
+
+   stream->setPosition(0);
+   server->writeConnectAccept(stream);
+   stream->setPosition(0);
+
+   if(!readConnectAccept(stream, &error))
+   {
+      Con::errorf("LoadTestConnection::connectBot - %s failed to connect: %s", name, error);
+      setRemoteConnectionObject(NULL);
+      server->deleteObject();
+      return false;
+   }
+
+   onConnectionEstablished(true);
+   server->onConnectionEstablished(false);
+   setEstablished();
+   server->setEstablished();
+   setConnectSequence(0);
+   server->setConnectSequence(0);
+
+   setSimulatedNetParams(packetLoss, ping);
+   server->setSimulatedNetParams(packetLoss, ping);
+
+   server->activateGhosting();
+   return true;
+}
+
+void LoadTestConnection::onRemove()
+{
+   // GameConnection only tears down the pair from the bot side, but the
+   // server side goes away on its own when the server shuts down.
+   if(!isConnectionToServer() && getRemoteConnection())
+   {
+      getRemoteConnection()->safeDeleteObject();
+      setRemoteConnectionObject(NULL);
+   }
+
+   Parent::onRemove();
+}
+
+void LoadTestConnection::onConnectionEstablished(bool isInitiator)
+{
+   // Same setup as GameConnection, minus the script callbacks that expect a
+   // single client per process.
+   if(isInitiator)
+   {
+      setGhostFrom(false);
+      setGhostTo(true);
+      setSendingEvents(true);
+      setTranslatesStrings(true);
+      setIsConnectionToServer();
+   }
+   else
+   {
+      setGhostFrom(true);
+      setGhostTo(false);
+      setSendingEvents(true);
+      setTranslatesStrings(true);
+      Sim::getClientGroup()->addObject(this);
+      mMoveList->init();
+
+      onBotConnect_callback();
+   }
+}
+
+void LoadTestConnection::writePacket(BitStream *bstream, PacketNotify *note)
+{
+   const U32 start = Platform::getRealMilliseconds();
+   bstream->write(start);
+
+   Parent::writePacket(bstream, note);
+
+   // Packet writes on the server are mostly ghost updates, so they count
+   // toward the server time.  The ms timer is coarse but the error averages
+   // out over many packets.
+   if(!isConnectionToServer())
+      smStats.writeMs += Platform::getRealMilliseconds() - start;
+
+   mPacketsSent++;
+   mBytesSent += bstream->getPosition();
+}
+
+void LoadTestConnection::readPacket(BitStream *bstream)
+{
+   U32 sendTime;
+   bstream->read(&sendTime);
+
+   const U32 latency = Platform::getRealMilliseconds() - sendTime;
+   if(isConnectionToServer())
+      smStats.downLatencies.push_back(latency);
+   else
+      smStats.upLatencies.push_back(latency);
+
+   Parent::readPacket(bstream);
+}
+
+void LoadTestConnection::randomMove()
+{
+   const U32 time = Sim::getCurrentTime();
+   if(time < mNextMoveChange)
+      return;
+
+   mNextMoveChange = time + mRandom.randI(500, 3000);
+
+   mMove.x = mRandom.randF(-1.0f, 1.0f);
+   mMove.y = mRandom.randF(-0.25f, 1.0f);
+   mMove.yaw = mRandom.randF(-0.05f, 0.05f);
+   mMove.pitch = mRandom.randF(-0.01f, 0.01f);
+   mMove.trigger[0] = mRandom.randF() < 0.2f;
+   mMove.trigger[2] = mRandom.randF() < 0.1f;
+}
+
+//-----------------------------------------------------------------------------
+
+void LoadTestConnection::_onServerPreTick()
+{
+   smPreTickTime = Platform::getRealMilliseconds();
+}
+
+void LoadTestConnection::_onServerPostTick(SimTime delta)
+{
+   const U32 numTicks = delta / TickMs;
+   if(!numTicks)
+      return;
+
+   const U32 elapsed = Platform::getRealMilliseconds() - smPreTickTime;
+   smStats.numTicks += numTicks;
+   smStats.tickMs += elapsed;
+   smStats.tickTimes.push_back(elapsed / numTicks);
+   smStats.parallelTicks += ServerProcessList::get()->getLastParallelTickCount() * numTicks;
+}
+
+void LoadTestConnection::_onClientPostTick(SimTime delta)
+{
+   const U32 tick = (Sim::getCurrentTime() - smStats.startTime) / TickMs;
+
+   for(U32 i = 0; i < smBots.size(); i++)
+   {
+      LoadTestConnection *bot = smBots[i];
+      if(!bot)
+         continue;
+
+      // Hand out one move per tick unless the server has fallen too far
+      // behind acking them.  Bots have no client side control object to
+      // tick the move, so it is marked as ticked right away as the client
+      // process list would.  It stays queued until the server acks it.
+      if(bot->mMoveList->isBacklogged())
+         continue;
+
+      if(bot->mMoveMode == MoveRandom)
+         bot->randomMove();
+      else if(bot->mMoveMode == MoveScript)
+         bot->onBotMove_callback(tick);
+
+      Move move = bot->mMove;
+      move.checksum = Move::ChecksumMismatch;
+      move.clamp();
+      bot->mMoveList->pushMove(move);
+      bot->mMoveList->clearMoves(1);
+   }
+}
+
+bool LoadTestConnection::startTest(U32 numBots, U32 durationMs, MoveMode mode, U32 ping, F32 packetLoss)
+{
+   if(smRunning)
+   {
+      Con::errorf("LoadTestConnection::startTest - a load test is already running.");
+      return false;
+   }
+
+   smStats.reset();
+   smStats.durationMs = durationMs;
+   smStats.startTime = Sim::getCurrentTime();
+
+   for(U32 i = 0; i < numBots; i++)
+   {
+      LoadTestConnection *bot = new LoadTestConnection;
+      bot->registerObject();
+      bot->mMoveMode = mode;
+      bot->mRandom.setSeed(i + 1);
+
+      char name[32];
+      dSprintf(name, sizeof(name), "Bot%d", i);
+      if(!bot->connectBot(name, ping, packetLoss))
+      {
+         bot->deleteObject();
+         continue;
+      }
+
+      smBots.push_back(bot);
+   }
+
+   smStats.numBots = smBots.size();
+   if(smBots.empty())
+      return false;
+
+   smRunning = true;
+   ServerProcessList::get()->preTickSignal().notify(&LoadTestConnection::_onServerPreTick);
+   ServerProcessList::get()->postTickSignal().notify(&LoadTestConnection::_onServerPostTick);
+   ClientProcessList::get()->postTickSignal().notify(&LoadTestConnection::_onClientPostTick);
+
+   smEndEvent = Sim::postEvent(Sim::getRootGroup(), new LoadTestEndEvent, smStats.startTime + durationMs);
+
+   Con::printf("Load test started with %d bots for %.1f seconds.", smStats.numBots, durationMs / 1000.0f);
+   return true;
+}
+
+void LoadTestConnection::stopTest()
+{
+   if(!smRunning)
+      return;
+
+   if(Sim::isEventPending(smEndEvent))
+      Sim::cancelEvent(smEndEvent);
+   smEndEvent = 0;
+
+   ServerProcessList::get()->preTickSignal().remove(&LoadTestConnection::_onServerPreTick);
+   ServerProcessList::get()->postTickSignal().remove(&LoadTestConnection::_onServerPostTick);
+   ClientProcessList::get()->postTickSignal().remove(&LoadTestConnection::_onClientPostTick);
+
+   _printReport();
+
+   // Deleting the bot side deletes the server side along with it.
+   for(U32 i = 0; i < smBots.size(); i++)
+      if(smBots[i])
+         smBots[i]->deleteObject();
+   smBots.clear();
+   smRunning = false;
+
+   if(Con::isFunction("onLoadTestComplete"))
+      Con::executef("onLoadTestComplete");
+}
+
+void LoadTestConnection::_printReport()
+{
+   const F32 seconds = getMax(Sim::getCurrentTime() - smStats.startTime, (U32)1) / 1000.0f;
+
+   U32 numBots = 0;
+   U32 downPackets = 0, downBytes = 0;
+   U32 upPackets = 0, upBytes = 0;
+   U32 totalGhosts = 0, minGhosts = U32_MAX, maxGhosts = 0;
+   F32 totalBudget = 0.0f, minBudget = F32_MAX;
+   for(U32 i = 0; i < smBots.size(); i++)
+   {
+      LoadTestConnection *bot = smBots[i];
+      if(!bot)
+         continue;
+
+      numBots++;
+      upPackets += bot->mPacketsSent;
+      upBytes += bot->mBytesSent;
+
+      LoadTestConnection *server = static_cast<LoadTestConnection*>((NetConnection*)bot->getRemoteConnection());
+      if(server)
+      {
+         downPackets += server->mPacketsSent;
+         downBytes += server->mBytesSent;
+         totalBudget += server->getSendBudget();
+         minBudget = getMin(minBudget, server->getSendBudget());
+      }
+
+      const U32 ghosts = bot->getGhostsActive();
+      totalGhosts += ghosts;
+      minGhosts = getMin(minGhosts, ghosts);
+      maxGhosts = getMax(maxGhosts, ghosts);
+   }
+   if(!numBots)
+      return;
+
+   smStats.tickTimes.sort(compareU32);
+   smStats.downLatencies.sort(compareU32);
+   smStats.upLatencies.sort(compareU32);
+
+   const U32 numTicks = getMax(smStats.numTicks, (U32)1);
+   const F32 perBot = 1.0f / (numBots * seconds);
+
+   Con::printf("Load test results, %d bots over %.1f seconds:", numBots, seconds);
+   Con::printf("   server ticks:        %d", smStats.numTicks);
+   Con::printf("   tick time:           %.2f ms avg, %d ms p50, %d ms p99, %d ms max",
+      F32(smStats.tickMs) / numTicks,
+      percentile(smStats.tickTimes, 0.5f), percentile(smStats.tickTimes, 0.99f), percentile(smStats.tickTimes, 1.0f));
+   Con::printf("   packet writes:       %.2f ms per tick", F32(smStats.writeMs) / numTicks);
+   Con::printf("   parallel ticks:      %.1f objects per tick", F32(smStats.parallelTicks) / numTicks);
+   Con::printf("   server to client:    %.0f bytes/s, %.1f packets/s per client",
+      downBytes * perBot, downPackets * perBot);
+   Con::printf("   client to server:    %.0f bytes/s, %.1f packets/s per client",
+      upBytes * perBot, upPackets * perBot);
+   Con::printf("   send rate at end:    %.0f bytes/s avg, %.0f bytes/s min per client",
+      totalBudget / numBots, minBudget == F32_MAX ? 0.0f : minBudget);
+   Con::printf("   ghosts per client:   %.1f avg, %d min, %d max",
+      F32(totalGhosts) / numBots, minGhosts, maxGhosts);
+   Con::printf("   latency down:        %d ms p50, %d ms p90, %d ms p99, %d ms max",
+      percentile(smStats.downLatencies, 0.5f), percentile(smStats.downLatencies, 0.9f),
+      percentile(smStats.downLatencies, 0.99f), percentile(smStats.downLatencies, 1.0f));
+   Con::printf("   latency up:          %d ms p50, %d ms p90, %d ms p99, %d ms max",
+      percentile(smStats.upLatencies, 0.5f), percentile(smStats.upLatencies, 0.9f),
+      percentile(smStats.upLatencies, 0.99f), percentile(smStats.upLatencies, 1.0f));
+}
+
+//-----------------------------------------------------------------------------
+
+DefineEngineMethod( LoadTestConnection, setBotMove, void, ( F32 x, F32 y, F32 z, F32 yaw, F32 pitch, F32 roll ), ( 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f ),
+   "@brief Sets the move the bot sends every tick from now on.\n\n"
+   "@param x Strafe amount from -1 to 1.\n"
+   "@param y Forward amount from -1 to 1.\n"
+   "@param z Up amount from -1 to 1.\n"
+   "@param yaw Yaw change per tick in radians.\n"
+   "@param pitch Pitch change per tick in radians.\n"
+   "@param roll Roll change per tick in radians.\n")
+{
+   Move move = object->getMove();
+   move.x = mClampF(x, -1.0f, 1.0f);
+   move.y = mClampF(y, -1.0f, 1.0f);
+   move.z = mClampF(z, -1.0f, 1.0f);
+   move.yaw = yaw;
+   move.pitch = pitch;
+   move.roll = roll;
+   object->setMove(move);
+}
+
+DefineEngineMethod( LoadTestConnection, setBotTrigger, void, ( S32 trigger, bool state ),,
+   "@brief Sets the state of a trigger in the move the bot sends.\n\n"
+   "@param trigger Index of the trigger.\n"
+   "@param state True to hold the trigger down.\n")
+{
+   if(trigger < 0 || trigger >= MaxTriggerKeys)
+   {
+      Con::errorf("LoadTestConnection::setBotTrigger - invalid trigger %d.", trigger);
+      return;
+   }
+
+   Move move = object->getMove();
+   move.trigger[trigger] = state;
+   object->setMove(move);
+}
+
+DefineEngineFunction( startLoadTest, bool, ( S32 numBots, F32 seconds, const char *moveMode, S32 ping, F32 packetLoss ), ( 16, 60.0f, "random", 0, 0.0f ),
+   "@brief Connects simulated clients to the server running in this process and reports how it copes.\n\n"
+
+   "The server must already be running a mission.  Each bot is a LoadTestConnection whose server side "
+   "calls LoadTestConnection::onBotConnect() to get a control object.  When the time is up the bots "
+   "disconnect, a report with the server tick time, bandwidth per client, ghost counts and packet "
+   "latency percentiles is printed to the console and onLoadTestComplete() is called if it exists.\n\n"
+
+   "@param numBots Number of bots to connect.\n"
+   "@param seconds How long to run the test.\n"
+   "@param moveMode \"idle\", \"random\" or \"script\".  Scripted bots call LoadTestConnection::onBotMove() every tick.\n"
+   "@param ping Simulated ping in ms added to every packet.\n"
+   "@param packetLoss Simulated packet loss from 0 to 1.\n"
+   "@return True if the test started.\n\n"
+
+   "@see stopLoadTest()\n"
+   "@ingroup Networking")
+{
+   LoadTestConnection::MoveMode mode;
+   if(!dStricmp(moveMode, "idle"))
+      mode = LoadTestConnection::MoveIdle;
+   else if(!dStricmp(moveMode, "random"))
+      mode = LoadTestConnection::MoveRandom;
+   else if(!dStricmp(moveMode, "script"))
+      mode = LoadTestConnection::MoveScript;
+   else
+   {
+      Con::errorf("startLoadTest - unknown move mode '%s'.", moveMode);
+      return false;
+   }
+
+   return LoadTestConnection::startTest(getMax(numBots, 1), U32(getMax(seconds, 0.0f) * 1000.0f), mode,
+      getMax(ping, 0), mClampF(packetLoss, 0.0f, 1.0f));
+}
+
+DefineEngineFunction( stopLoadTest, void, (),,
+   "@brief Ends the running load test early and prints its report.\n\n"
+   "@see startLoadTest()\n"
+   "@ingroup Networking")
+{
+   LoadTestConnection::stopTest();
+}
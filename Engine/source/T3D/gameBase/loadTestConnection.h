@@ -0,0 +1,146 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _LOADTESTCONNECTION_H_
+#define _LOADTESTCONNECTION_H_
+
+#ifndef _GAMECONNECTION_H_
+#include "T3D/gameBase/gameConnection.h"
+#endif
+#ifndef _MOVEMANAGER_H_
+#include "T3D/gameBase/moveManager.h"
+#endif
+#ifndef _MRANDOM_H_
+#include "math/mRandom.h"
+#endif
+
+/// A simulated client used to load test a server from within the same process.
+///
+/// Each bot is a pair of local connections, like the one made by
+/// NetConnection::connectLocal(), except that both sides use the network
+/// rate settings of a remote client and the bot side never becomes the
+/// connection to the server.  The server side goes through the usual ghosting
+/// and move processing, so the server does the same work it would for a real
+/// client.  The bot side pushes its own Moves each client tick instead of
+/// reading them from the MoveManager.
+///
+/// Every packet carries the time it was written so the receiving side can
+/// record its latency.  Ping and packet loss are simulated on both sides with
+/// NetConnection::setSimulatedNetParams().
+///
+/// @see startLoadTest()
+class LoadTestConnection : public GameConnection
+{
+   typedef GameConnection Parent;
+
+public:
+
+   enum MoveMode
+   {
+      MoveIdle,      ///< Only ever sends NullMove.
+      MoveRandom,    ///< Walks, turns, jumps and fires at random.
+      MoveScript,    ///< Calls onBotMove() every tick to let script set the move.
+   };
+
+   /// Totals gathered over a load test.
+   struct Stats
+   {
+      U32 numBots;
+      U32 durationMs;
+      U32 startTime;
+
+      U32 numTicks;
+      U32 tickMs;
+      U32 writeMs;
+
+      /// Objects ticked on worker threads.
+      U32 parallelTicks;
+
+      /// Server tick time in ms for each server process pass.
+      Vector<U32> tickTimes;
+
+      /// Packet latencies in ms, server to bot and bot to server.
+      Vector<U32> downLatencies;
+      Vector<U32> upLatencies;
+
+      void reset();
+   };
+
+protected:
+
+   MoveMode mMoveMode;
+   Move mMove;
+   MRandomLCG mRandom;
+   U32 mNextMoveChange;
+
+   U32 mPacketsSent;
+   U32 mBytesSent;
+
+   /// The bot side of every connection in the running test.
+   static Vector< SimObjectPtr<LoadTestConnection> > smBots;
+   static bool smRunning;
+   static Stats smStats;
+   static U32 smEndEvent;
+   static U32 smPreTickTime;
+
+   /// Pairs this bot with a new server side connection.
+   bool connectBot(const char *name, U32 ping, F32 packetLoss);
+
+   void randomMove();
+
+   static void _onServerPreTick();
+   static void _onServerPostTick(SimTime delta);
+   static void _onClientPostTick(SimTime delta);
+
+   static void _printReport();
+
+public:
+
+   LoadTestConnection();
+   DECLARE_CONOBJECT( LoadTestConnection );
+
+   DECLARE_CALLBACK( void, onBotConnect, () );
+   DECLARE_CALLBACK( void, onBotMove, ( U32 tick ) );
+
+   void setMove(const Move &move) { mMove = move; }
+   const Move& getMove() const { return mMove; }
+
+   /// Starts @a numBots bots that run for @a durationMs and print a report
+   /// when they are done.
+   static bool startTest(U32 numBots, U32 durationMs, MoveMode mode, U32 ping, F32 packetLoss);
+
+   /// Prints the report and disconnects all bots.
+   static void stopTest();
+
+   static bool isTestRunning() { return smRunning; }
+
+   // SimObject
+   virtual void onRemove();
+
+   // NetConnection
+   virtual void onConnectionEstablished(bool isInitiator);
+   virtual void writePacket(BitStream *bstream, PacketNotify *note);
+   virtual void readPacket(BitStream *bstream);
+};
+
+#endif // _LOADTESTCONNECTION_H_
@@ -25,6 +25,7 @@
 
 #include "T3D/gameBase/gameBase.h"
 #include "platform/profiler.h"
+#include "platform/threads/jobGraph.h"
 #include "console/consoleTypes.h"
 
 //----------------------------------------------------------------------------
@@ -33,7 +34,9 @@ ProcessObject::ProcessObject()
  : mProcessTag( 0 ),   
    mOrderGUID( 0 ),
    mProcessTick( false ),
-   mIsGameBase( false )
+   mIsGameBase( false ),
+   mTickPass( 0 ),
+   mTickBatch( -1 )
 { 
    mProcessLink.next = mProcessLink.prev = this;
 }
@@ -105,6 +108,30 @@ void ProcessObject::plJoin(ProcessObject * head)
 
 //--------------------------------------------------------------------------
 
+bool ProcessList::smParallelTick = false;
+S32 ProcessList::smParallelTickMinObjects = 64;
+
+/// Ticks a run of objects of the same parallel batch.
+class ProcessList::TickJob : public JobGraph::Job
+{
+public:
+
+   TickJob( ProcessList *list, ProcessObject **objects, U32 count )
+      : mList( list ), mObjects( objects ), mCount( count ) {}
+
+protected:
+
+   ProcessList *mList;
+   ProcessObject **mObjects;
+   U32 mCount;
+
+   virtual void run()
+   {
+      for ( U32 i = 0; i < mCount; i++ )
+         mList->onTickObject( mObjects[i] );
+   }
+};
+
 ProcessList::ProcessList()
 {
    mCurrentTag = 0;
@@ -114,6 +141,10 @@ ProcessList::ProcessList()
    mLastTick = 0;
    mLastTime = 0;
    mLastDelta = 0.0f;
+
+   mTickPass = 0;
+   mLastParallelTickCount = 0;
+   mDeferUpdates = false;
 }
 
 void ProcessList::addObject( ProcessObject *obj )
@@ -251,10 +282,124 @@ bool ProcessList::advanceTime(SimTime timeDelta)
 
 //----------------------------------------------------------------------------
 
+U32 ProcessList::advanceParallelObjects()
+{
+   PROFILE_SCOPE(ProcessList_AdvanceParallelObjects);
+
+   if (++mTickPass == 0)
+      mTickPass++;
+
+   // Sort the thread-safe objects into batches.  The list is in
+   // processing order so an object's after object is always seen
+   // before the object itself.
+   mParallelObjects.clear();
+   S32 numBatches = 0;
+   for (ProcessObject * pobj = mHead.mProcessLink.next; pobj != &mHead; pobj = pobj->mProcessLink.next)
+   {
+      pobj->mTickPass = mTickPass;
+      pobj->mTickBatch = -1;
+
+      if (!pobj->isTicking() || !pobj->isTickThreadSafe() || pobj->getControllingClient())
+         continue;
+
+      S32 batch = 0;
+      ProcessObject * afterObject = pobj->getAfterObject();
+      if (afterObject && afterObject->mTickPass == mTickPass)
+      {
+         // Has to wait for an object that ticks on the main thread.
+         if (afterObject->mTickBatch < 0)
+            continue;
+
+         batch = afterObject->mTickBatch + 1;
+      }
+
+      pobj->mTickBatch = batch;
+      numBatches = getMax(numBatches, batch + 1);
+      mParallelObjects.push_back(pobj);
+   }
+
+   if ((S32)mParallelObjects.size() < smParallelTickMinObjects)
+      return 0;
+
+   // Order the objects by batch while keeping the list order within
+   // each batch.
+   Vector<U32> batchStart(numBatches + 1);
+   batchStart.setSize(numBatches + 1);
+   dMemset(batchStart.address(), 0, batchStart.memSize());
+   for (U32 i = 0; i < mParallelObjects.size(); i++)
+      batchStart[mParallelObjects[i]->mTickBatch + 1]++;
+   for (S32 i = 1; i <= numBatches; i++)
+      batchStart[i] += batchStart[i - 1];
+
+   Vector<ProcessObject*> sorted(mParallelObjects.size());
+   sorted.setSize(mParallelObjects.size());
+   Vector<U32> batchFill(batchStart);
+   for (U32 i = 0; i < mParallelObjects.size(); i++)
+      sorted[batchFill[mParallelObjects[i]->mTickBatch]++] = mParallelObjects[i];
+   mParallelObjects = sorted;
+
+   // Split each batch into a few jobs per worker.  A job with no objects
+   // separates the batches so that the jobs of a batch only start once
+   // the previous batch is done.
+   ThreadPool *pool = &ThreadPool::GLOBAL();
+   const U32 maxJobs = getMax(pool->getNumThreads(), 1U) * 4;
+   const U32 minObjectsPerJob = 16;
+
+   JobGraph graph(pool);
+   Vector<JobGraph::Job*> prevJobs;
+   Vector<JobGraph::Job*> jobs;
+   for (S32 batch = 0; batch < numBatches; batch++)
+   {
+      const U32 start = batchStart[batch];
+      const U32 count = batchStart[batch + 1] - start;
+      const U32 numJobs = mClamp(count / minObjectsPerJob, 1, maxJobs);
+
+      JobGraph::Job * barrier = NULL;
+      if (prevJobs.size() > 1)
+      {
+         barrier = graph.addJob(new TickJob(this, NULL, 0));
+         for (U32 i = 0; i < prevJobs.size(); i++)
+            graph.addDependency(barrier, prevJobs[i]);
+      }
+      else if (prevJobs.size() == 1)
+         barrier = prevJobs[0];
+
+      jobs.clear();
+      for (U32 i = 0; i < numJobs; i++)
+      {
+         const U32 first = start + count * i / numJobs;
+         const U32 last = start + count * (i + 1) / numJobs;
+         JobGraph::Job * job = graph.addJob(new TickJob(this, mParallelObjects.address() + first, last - first));
+         if (barrier)
+            graph.addDependency(job, barrier);
+         jobs.push_back(job);
+      }
+
+      prevJobs = jobs;
+   }
+
+   // Keep the scene container and the net dirty list untouched while
+   // the workers run and catch up afterwards.
+   mDeferUpdates = true;
+
+   graph.start();
+   graph.wait();
+
+   mDeferUpdates = false;
+
+   for (U32 i = 0; i < mParallelObjects.size(); i++)
+      mParallelObjects[i]->applyDeferredTickUpdates();
+
+   return mParallelObjects.size();
+}
+
 void ProcessList::advanceObjects()
 {
    PROFILE_START(ProcessList_AdvanceObjects);
 
+   mLastParallelTickCount = smParallelTick ? advanceParallelObjects() : 0;
+   const bool skipParallel = mLastParallelTickCount > 0;
+
    // A little link list shuffling is done here to avoid problems
    // with objects being deleted from within the process method.
    ProcessObject list;
@@ -264,6 +409,9 @@ void ProcessList::advanceObjects()
    {
       pobj->plUnlink();
       pobj->plLinkBefore(&mHead);
+
+      if (skipParallel && pobj->mTickPass == mTickPass && pobj->mTickBatch >= 0)
+         continue;
       
       onTickObject(pobj);
    }
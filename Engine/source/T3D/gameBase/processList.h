@@ -29,6 +29,9 @@
 #ifndef _TSIGNAL_H_
 #include "core/util/tSignal.h"
 #endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
 
 //----------------------------------------------------------------------------
 
@@ -88,6 +91,22 @@ public:
    /// @see processAfter
    virtual ProcessObject* getAfterObject() const { return NULL; }
 
+   /// Returns true if processTick() may run on a worker thread alongside
+   /// the ticks of other thread-safe objects.
+   ///
+   /// The tick of such an object must only change the object itself, must
+   /// not add or delete objects or call into script, and may only read
+   /// objects it processes after.  Moving in the scene and setting net mask
+   /// bits is fine as both are deferred until all parallel ticks are done.
+   /// Objects controlled by a client always tick on the main thread.
+   ///
+   /// @see ProcessList::smParallelTick
+   virtual bool isTickThreadSafe() const { return false; }
+
+   /// Called on the main thread after a parallel tick to apply the changes
+   /// the object recorded while ProcessList::isDeferringUpdates() was true.
+   virtual void applyDeferredTickUpdates() {}
+
    /// Processes a move event and updates object state once every 32 milliseconds.
    ///
    /// This takes place both on the client and server, every 32 milliseconds (1 tick).
@@ -131,6 +150,9 @@ public:
    bool mProcessTick;
 
    bool mIsGameBase;
+
+   U32 mTickPass;                         // ProcessList::mTickPass when mTickBatch was set
+   S32 mTickBatch;                        // Parallel tick batch or -1 to tick on the main thread
 };
 
 //----------------------------------------------------------------------------
@@ -164,11 +186,38 @@ public:
    /// Returns true if a tick was processed.
    virtual bool advanceTime( SimTime timeDelta );
 
+   /// Returns the number of objects that ticked on worker threads
+   /// during the last tick.
+   U32 getLastParallelTickCount() const { return mLastParallelTickCount; }
+
+   /// Returns true while objects of this list tick on worker threads.
+   /// Objects then only record scene and net changes and leave the shared
+   /// state alone until ProcessObject::applyDeferredTickUpdates().
+   bool isDeferringUpdates() const { return mDeferUpdates; }
+
+   /// If true, objects that are thread-safe tick on the ThreadPool
+   /// before the remaining objects tick on the main thread.
+   ///
+   /// @see ProcessObject::isTickThreadSafe
+   static bool smParallelTick;
+
+   /// The least number of thread-safe objects for which ticking them in
+   /// parallel is worth it.
+   static S32 smParallelTickMinObjects;
+
 protected:
+
+   class TickJob;
  
    void orderList();
    GameBase* getGameBase( ProcessObject *obj );
 
+   /// Ticks the thread-safe objects on the ThreadPool.  Objects that
+   /// process after another thread-safe object go into a later batch.
+   /// onTickObject() is called on the worker threads for these objects.
+   /// Returns the number of objects ticked.
+   U32 advanceParallelObjects();
+
    virtual void advanceObjects();
    virtual void onAdvanceObjects() { advanceObjects(); }
    virtual void onPreTickObject( ProcessObject* ) {}
@@ -188,6 +237,11 @@ protected:
 
    PreTickSignal mPreTick;
    PostTickSignal mPostTick;
+
+   U32 mTickPass;
+   U32 mLastParallelTickCount;
+   Vector<ProcessObject*> mParallelObjects;
+   bool mDeferUpdates;
 };
 
 #endif // _PROCESSLIST_H_
\ No newline at end of file
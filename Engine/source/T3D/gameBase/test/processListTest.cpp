@@ -0,0 +1,290 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "T3D/gameBase/processList.h"
+#include "T3D/tsStatic.h"
+#include "ts/tsShape.h"
+#include "ts/tsShapeInstance.h"
+#include "core/util/tVector.h"
+#include "math/mMathFn.h"
+#include "console/console.h"
+
+namespace
+{
+   /// Does a bit of busy work each tick and checks that the object it
+   /// processes after already ticked.
+   class TestObject : public ProcessObject
+   {
+   public:
+      TestObject(bool threadSafe, U32 work)
+         : mThreadSafe(threadSafe), mWork(work), mAfter(NULL), mTicks(0), mOrderErrors(0), mValue(1.0f)
+      {
+         mProcessTick = true;
+      }
+
+      bool mThreadSafe;
+      U32 mWork;
+      TestObject *mAfter;
+      U32 mTicks;
+      U32 mOrderErrors;
+      F32 mValue;
+
+      virtual bool isTickThreadSafe() const { return mThreadSafe; }
+      virtual void processAfter(ProcessObject *obj) { mAfter = static_cast<TestObject*>(obj); }
+      virtual ProcessObject* getAfterObject() const { return mAfter; }
+
+      virtual void processTick(const Move*)
+      {
+         if(mAfter && mAfter->mTicks != mTicks + 1)
+            mOrderErrors++;
+
+         for(U32 i = 0; i < mWork; i++)
+            mValue = mSin(mValue) * 0.5f + mCos(mValue + F32(i));
+         if(mAfter)
+            mValue += mAfter->mValue;
+
+         mTicks++;
+      }
+   };
+
+   class TestProcessList : public ProcessList
+   {
+   protected:
+      virtual void onTickObject(ProcessObject *obj)
+      {
+         if(obj->isTicking())
+            obj->processTick(NULL);
+      }
+   };
+
+   /// Fills the list with objects where every fifth is not thread-safe and
+   /// every fourth processes after the one before it.
+   void populate(TestProcessList &list, Vector<TestObject*> &objects, U32 count, U32 work)
+   {
+      for(U32 i = 0; i < count; i++)
+      {
+         TestObject *obj = new TestObject(i % 5 != 0, work);
+         if(i % 4 == 3)
+            obj->processAfter(objects[i - 1]);
+         list.addObject(obj);
+         objects.push_back(obj);
+      }
+      list.markDirty();
+   }
+
+   void destroy(Vector<TestObject*> &objects)
+   {
+      for(U32 i = 0; i < objects.size(); i++)
+         delete objects[i];
+      objects.clear();
+   }
+
+   /// Builds a shape with a single node and a cyclic "ambient" sequence
+   /// that doesn't animate anything, which is all a ticking TSStatic needs.
+   TSShape* createAmbientShape()
+   {
+      TSShape *shape = new TSShape;
+      shape->createEmptyShape();
+      shape->defaultRotations[0].identity();
+      shape->meshes.push_back(NULL);
+
+      shape->sequences.increment();
+      TSShape::Sequence &seq = shape->sequences.last();
+      seq.nameIndex = shape->addName("ambient");
+      seq.numKeyframes = 2;
+      seq.duration = 1.5f;
+      seq.baseRotation = seq.baseTranslation = seq.baseScale = 0;
+      seq.baseObjectState = seq.baseDecalState = 0;
+      seq.firstGroundFrame = seq.numGroundFrames = 0;
+      seq.firstTrigger = seq.numTriggers = 0;
+      seq.toolBegin = 0.0f;
+      seq.priority = 0;
+      seq.flags = TSShape::Cyclic;
+      seq.dirtyFlags = 0;
+
+      shape->init();
+      return shape;
+   }
+
+   /// A server side TSStatic playing its ambient sequence, without the
+   /// shape resource and scene that TSStatic::onAdd() sets up.
+   class TestStatic : public TSStatic
+   {
+   public:
+      TestStatic(TSShape *shape, F32 timeScale)
+      {
+         mShapeInstance = new TSShapeInstance(shape, false);
+         mAmbientThread = mShapeInstance->addThread();
+         mShapeInstance->setTimeScale(mAmbientThread, timeScale);
+         mProcessTick = true;
+      }
+
+      ~TestStatic()
+      {
+         delete mShapeInstance;
+      }
+
+      F32 getAmbientPos() { return mShapeInstance->getPos(mAmbientThread); }
+   };
+
+   U32 tick(TestProcessList &list, U32 numTicks)
+   {
+      const U32 start = Platform::getRealMilliseconds();
+      for(U32 i = 0; i < numTicks; i++)
+         list.advanceTime(TickMs);
+      return Platform::getRealMilliseconds() - start;
+   }
+}
+
+TEST(ProcessList, ParallelTickMatchesSerial)
+{
+   const U32 numObjects = 2000;
+   const U32 numTicks = 10;
+
+   const bool oldParallelTick = ProcessList::smParallelTick;
+
+   Vector<TestObject*> serialObjects;
+   TestProcessList serialList;
+   populate(serialList, serialObjects, numObjects, 20);
+   ProcessList::smParallelTick = false;
+   tick(serialList, numTicks);
+
+   Vector<TestObject*> parallelObjects;
+   TestProcessList parallelList;
+   populate(parallelList, parallelObjects, numObjects, 20);
+   ProcessList::smParallelTick = true;
+   tick(parallelList, numTicks);
+
+   EXPECT_GT(parallelList.getLastParallelTickCount(), 0)
+      << "No objects were ticked in parallel!";
+
+   U32 numMissedTicks = 0;
+   U32 numOrderErrors = 0;
+   U32 numMismatches = 0;
+   for(U32 i = 0; i < numObjects; i++)
+   {
+      numMissedTicks += parallelObjects[i]->mTicks != numTicks;
+      numOrderErrors += parallelObjects[i]->mOrderErrors + serialObjects[i]->mOrderErrors;
+      numMismatches += parallelObjects[i]->mValue != serialObjects[i]->mValue;
+   }
+
+   EXPECT_EQ(numMissedTicks, 0) << "Objects were not ticked exactly once per tick!";
+   EXPECT_EQ(numOrderErrors, 0) << "Objects ticked before the object they process after!";
+   EXPECT_EQ(numMismatches, 0) << "Ticking in parallel changed the results!";
+
+   ProcessList::smParallelTick = oldParallelTick;
+   destroy(serialObjects);
+   destroy(parallelObjects);
+}
+
+TEST(ProcessList, ParallelTickTSStatic)
+{
+   const U32 numObjects = 500;
+   const U32 numTicks = 20;
+
+   const bool oldParallelTick = ProcessList::smParallelTick;
+   TSShape *shape = createAmbientShape();
+
+   Vector<TestStatic*> serialObjects;
+   Vector<TestStatic*> parallelObjects;
+   TestProcessList serialList;
+   TestProcessList parallelList;
+   for(U32 i = 0; i < numObjects; i++)
+   {
+      const F32 timeScale = 0.5f + F32(i % 7) * 0.25f;
+      serialObjects.push_back(new TestStatic(shape, timeScale));
+      serialList.addObject(serialObjects.last());
+      parallelObjects.push_back(new TestStatic(shape, timeScale));
+      parallelList.addObject(parallelObjects.last());
+   }
+   serialList.markDirty();
+   parallelList.markDirty();
+
+   EXPECT_TRUE(static_cast<ProcessObject*>(parallelObjects[0])->isTickThreadSafe())
+      << "TSStatic should tick on worker threads!";
+
+   ProcessList::smParallelTick = false;
+   tick(serialList, numTicks);
+   ProcessList::smParallelTick = true;
+   tick(parallelList, numTicks);
+
+   EXPECT_EQ(parallelList.getLastParallelTickCount(), numObjects)
+      << "Not all TSStatics were ticked in parallel!";
+
+   U32 numMismatches = 0;
+   U32 numStopped = 0;
+   for(U32 i = 0; i < numObjects; i++)
+   {
+      numMismatches += parallelObjects[i]->getAmbientPos() != serialObjects[i]->getAmbientPos();
+      numStopped += parallelObjects[i]->getAmbientPos() == 0.0f;
+   }
+
+   EXPECT_EQ(numMismatches, 0) << "Ticking in parallel changed the ambient animation!";
+   EXPECT_EQ(numStopped, 0) << "Ambient animations didn't advance!";
+
+   ProcessList::smParallelTick = oldParallelTick;
+   for(U32 i = 0; i < numObjects; i++)
+   {
+      delete serialObjects[i];
+      delete parallelObjects[i];
+   }
+   delete shape;
+}
+
+TEST(ProcessList, StressParallelTick)
+{
+   // Ticks ten thousand objects serially and in parallel.  Timings go
+   // to the console.
+
+   const U32 numObjects = 10000;
+   const U32 numTicks = 100;
+
+   const bool oldParallelTick = ProcessList::smParallelTick;
+
+   Vector<TestObject*> objects;
+   TestProcessList list;
+   populate(list, objects, numObjects, 50);
+
+   ProcessList::smParallelTick = false;
+   const U32 serialTime = tick(list, numTicks);
+
+   ProcessList::smParallelTick = true;
+   const U32 parallelTime = tick(list, numTicks);
+   const U32 parallelCount = list.getLastParallelTickCount();
+
+   U32 numOrderErrors = 0;
+   for(U32 i = 0; i < numObjects; i++)
+      numOrderErrors += objects[i]->mOrderErrors;
+   EXPECT_EQ(numOrderErrors, 0) << "Objects ticked before the object they process after!";
+
+   Con::printf("Process list, %u objects (%u thread-safe) over %u ticks:", numObjects, parallelCount, numTicks);
+   Con::printf("   serial:    %u ms (%.2f ms/tick)", serialTime, F32(serialTime) / numTicks);
+   Con::printf("   parallel:  %u ms (%.2f ms/tick)", parallelTime, F32(parallelTime) / numTicks);
+
+   ProcessList::smParallelTick = oldParallelTick;
+   destroy(objects);
+}
+
+#endif
@@ -22,6 +22,7 @@
 
 #include "platform/platform.h"
 #include "T3D/gameFunctions.h"
+#include "app/renderBenchmark.h"
 #include "T3D/gameBase/gameConnection.h"
 #include "T3D/camera.h"
 #include "T3D/sfx/sfx3DWorld.h"
@@ -339,6 +340,9 @@ bool GameProcessCameraQuery(CameraQuery *query)
 
    if (connection && connection->getControlCameraTransform(0.032f, &query->cameraMatrix))
    {
+      // Render benchmarks fly their own camera.
+      RenderBenchmark::getCameraTransform(&query->cameraMatrix);
+
       query->object = dynamic_cast<ShapeBase*>(connection->getControlObject());
       query->nearPlane = gClientSceneGraph->getNearClip();
 
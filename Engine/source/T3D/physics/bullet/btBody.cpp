@@ -52,6 +52,7 @@ void BtBody::_releaseActor()
 {
    if ( mActor )
    {
+      mWorld->releaseWriteLock();
       mWorld->getDynamicsWorld()->removeRigidBody( mActor );
       mActor->setUserPointer( NULL );
       SAFE_DELETE( mActor );
@@ -146,6 +147,7 @@ bool BtBody::init(   PhysicsCollision *shape,
 
    mActor->setCollisionFlags( btFlags );
 
+   mWorld->releaseWriteLock();
    mWorld->getDynamicsWorld()->addRigidBody( mActor );
    mIsEnabled = true;
 
@@ -161,6 +163,7 @@ void BtBody::setMaterial(  F32 restitution,
                            F32 staticFriction )
 {
    AssertFatal( mActor, "BtBody::setMaterial - The actor is null!" );
+   mWorld->releaseWriteLock();
 
    mActor->setRestitution( restitution );
 
@@ -180,18 +183,21 @@ void BtBody::setMaterial(  F32 restitution,
 void BtBody::setSleepThreshold( F32 linear, F32 angular )
 {
    AssertFatal( mActor, "BtBody::setSleepThreshold - The actor is null!" );
+   mWorld->releaseWriteLock();
    mActor->setSleepingThresholds( linear, angular );
 }
 
 void BtBody::setDamping( F32 linear, F32 angular )
 {
    AssertFatal( mActor, "BtBody::setDamping - The actor is null!" );
+   mWorld->releaseWriteLock();
    mActor->setDamping( linear, angular );
 }
 
 void BtBody::getState( PhysicsState *outState )
 {
    AssertFatal( isDynamic(), "BtBody::getState - This call is only for dynamics!" );
+   mWorld->releaseWriteLock();
 
    // TODO: Fix this to do what we intended... to return
    // false so that the caller can early out of the state
@@ -216,12 +222,14 @@ void BtBody::getState( PhysicsState *outState )
 Point3F BtBody::getCMassPosition() const
 {
    AssertFatal( mActor, "BtBody::getCMassPosition - The actor is null!" );
+   mWorld->releaseWriteLock();
    return btCast<Point3F>( mActor->getCenterOfMassTransform().getOrigin() );
 }
 
 void BtBody::setLinVelocity( const Point3F &vel )
 {
    AssertFatal( mActor, "BtBody::setLinVelocity - The actor is null!" );
+   mWorld->releaseWriteLock();
    AssertFatal( isDynamic(), "BtBody::setLinVelocity - This call is only for dynamics!" );
 
    mActor->setLinearVelocity( btCast<btVector3>( vel ) );
@@ -230,6 +238,7 @@ void BtBody::setLinVelocity( const Point3F &vel )
 void BtBody::setAngVelocity( const Point3F &vel )
 {
    AssertFatal( mActor, "BtBody::setAngVelocity - The actor is null!" );
+   mWorld->releaseWriteLock();
    AssertFatal( isDynamic(), "BtBody::setAngVelocity - This call is only for dynamics!" );
 
    mActor->setAngularVelocity( btCast<btVector3>( vel ) );
@@ -238,6 +247,7 @@ void BtBody::setAngVelocity( const Point3F &vel )
 Point3F BtBody::getLinVelocity() const
 {
    AssertFatal( mActor, "BtBody::getLinVelocity - The actor is null!" );
+   mWorld->releaseWriteLock();
    AssertFatal( isDynamic(), "BtBody::getLinVelocity - This call is only for dynamics!" );
 
    return btCast<Point3F>( mActor->getLinearVelocity() );
@@ -246,6 +256,7 @@ Point3F BtBody::getLinVelocity() const
 Point3F BtBody::getAngVelocity() const
 {
    AssertFatal( mActor, "BtBody::getAngVelocity - The actor is null!" );
+   mWorld->releaseWriteLock();
    AssertFatal( isDynamic(), "BtBody::getAngVelocity - This call is only for dynamics!" );
 
    return btCast<Point3F>( mActor->getAngularVelocity() );
@@ -254,6 +265,7 @@ Point3F BtBody::getAngVelocity() const
 void BtBody::setSleeping( bool sleeping )
 {
    AssertFatal( mActor, "BtBody::setSleeping - The actor is null!" );
+   mWorld->releaseWriteLock();
    AssertFatal( isDynamic(), "BtBody::setSleeping - This call is only for dynamics!" );
 
    if ( sleeping )
@@ -282,6 +294,7 @@ PhysicsCollision* BtBody::getColShape()
 MatrixF& BtBody::getTransform( MatrixF *outMatrix )
 {
    AssertFatal( mActor, "BtBody::getTransform - The actor is null!" );
+   mWorld->releaseWriteLock();
 
    if ( mInvCenterOfMass )
       outMatrix->mul( *mInvCenterOfMass, btCast<MatrixF>( mActor->getCenterOfMassTransform() ) );
@@ -294,6 +307,7 @@ MatrixF& BtBody::getTransform( MatrixF *outMatrix )
 void BtBody::setTransform( const MatrixF &transform )
 {
    AssertFatal( mActor, "BtBody::setTransform - The actor is null!" );
+   mWorld->releaseWriteLock();
 
    if ( mCenterOfMass )
    {
@@ -318,6 +332,7 @@ void BtBody::setTransform( const MatrixF &transform )
 void BtBody::applyCorrection( const MatrixF &transform )
 {
    AssertFatal( mActor, "BtBody::applyCorrection - The actor is null!" );
+   mWorld->releaseWriteLock();
    AssertFatal( isDynamic(), "BtBody::applyCorrection - This call is only for dynamics!" );
 
    if ( mCenterOfMass )
@@ -333,6 +348,7 @@ void BtBody::applyCorrection( const MatrixF &transform )
 void BtBody::applyImpulse( const Point3F &origin, const Point3F &force )
 {
    AssertFatal( mActor, "BtBody::applyImpulse - The actor is null!" );
+   mWorld->releaseWriteLock();
    AssertFatal( isDynamic(), "BtBody::applyImpulse - This call is only for dynamics!" );
 
    // Convert the world position to local
@@ -358,6 +374,8 @@ void BtBody::applyImpulse( const Point3F &origin, const Point3F &force )
 
 Box3F BtBody::getWorldBounds()
 {   
+   mWorld->releaseWriteLock();
+
    btVector3 min, max;
    mActor->getAabb( min, max );
 
@@ -371,6 +389,8 @@ void BtBody::setSimulationEnabled( bool enabled )
    if ( mIsEnabled == enabled )
       return;
 
+   mWorld->releaseWriteLock();
+
    if ( !enabled )
       mWorld->getDynamicsWorld()->removeRigidBody( mActor );
    else
@@ -44,6 +44,9 @@ BtCollision::~BtCollision()
 
    for ( U32 i=0; i < mMeshInterfaces.size(); i++ )
       delete mMeshInterfaces[i];
+
+   for ( U32 i=0; i < mHeightfields.size(); i++ )
+      delete [] mHeightfields[i];
 }
 
 btCollisionShape* BtCollision::getShape() 
@@ -170,8 +173,13 @@ bool BtCollision::addHeightfield(   const U16 *heights,
    const F32 minHeight = 0;
    const F32 maxHeight = 65535 * heightScale;
 
+   // The shape references the samples, so it gets its own copy.
+   U16 *samples = new U16[ blockSize * blockSize ];
+   dMemcpy( samples, heights, sizeof( U16 ) * blockSize * blockSize );
+   mHeightfields.push_back( samples );
+
    btHeightfieldTerrainShape *shape = new btHeightfieldTerrainShape( blockSize, blockSize,
-                                                                     (void*)heights,
+                                                                     samples,
                                                                      heightScale,
                                                                      minHeight, maxHeight,
                                                                      2, // Z up! 
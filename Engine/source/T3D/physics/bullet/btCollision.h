@@ -56,6 +56,10 @@ protected:
    /// we need to store the mesh data.
    Vector<btTriangleMesh*> mMeshInterfaces;
 
+   /// Bullet heightfields reference their samples
+   /// so we keep a copy of them here.
+   Vector<U16*> mHeightfields;
+
    /// Helper for adding shapes.
    void _addShape( btCollisionShape *shape, const MatrixF &localXfm );
 
@@ -48,6 +48,7 @@ void BtPlayer::_releaseController()
    if ( !mGhostObject )
       return;
 
+   mWorld->releaseWriteLock();
    mWorld->getDynamicsWorld()->removeCollisionObject( mGhostObject );
 
    SAFE_DELETE( mGhostObject );
@@ -90,6 +91,7 @@ void BtPlayer::init( const char *type,
    mGhostObject = new btPairCachingGhostObject();
    mGhostObject->setCollisionShape( mColShape );
    mGhostObject->setCollisionFlags( btCollisionObject::CF_CHARACTER_OBJECT );
+   mWorld->releaseWriteLock();
    mWorld->getDynamicsWorld()->addCollisionObject( mGhostObject,
                                                    btBroadphaseProxy::CharacterFilter, 
                                                    btBroadphaseProxy::StaticFilter | btBroadphaseProxy::DefaultFilter );
@@ -101,6 +103,7 @@ void BtPlayer::init( const char *type,
 Point3F BtPlayer::move( const VectorF &disp, CollisionList &outCol )
 {
    AssertFatal( mGhostObject, "BtPlayer::move - The controller is null!" );
+   mWorld->releaseWriteLock();
 
    // First recover from any penetrations from the previous tick.
    U32 numPenetrationLoops = 0;
@@ -412,6 +415,7 @@ void BtPlayer::findContact(   SceneObject **contactObject,
                               Vector<SceneObject*> *outOverlapObjects ) const
 {
    AssertFatal( mGhostObject, "BtPlayer::findContact - The controller is null!" );
+   mWorld->releaseWriteLock();
 
    VectorF normal;
    F32 maxDot = -1.0f;
@@ -491,6 +495,7 @@ PhysicsWorld* BtPlayer::getWorld()
 void BtPlayer::setTransform( const MatrixF &transform )
 {
    AssertFatal( mGhostObject, "BtPlayer::setTransform - The ghost object is null!" );
+   mWorld->releaseWriteLock();
 
    btTransform xfm = btCast<btTransform>( transform );
    xfm.getOrigin()[2] += mOriginOffset;
@@ -501,6 +506,7 @@ void BtPlayer::setTransform( const MatrixF &transform )
 MatrixF& BtPlayer::getTransform( MatrixF *outMatrix )
 {
    AssertFatal( mGhostObject, "BtPlayer::getTransform - The ghost object is null!" );
+   mWorld->releaseWriteLock();
 
    *outMatrix = btCast<MatrixF>( mGhostObject->getWorldTransform() );
    *outMatrix[11] -= mOriginOffset;
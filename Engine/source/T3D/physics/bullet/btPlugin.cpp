@@ -30,6 +30,8 @@
 #include "T3D/physics/bullet/btCollision.h"
 #include "T3D/gameBase/gameProcess.h"
 #include "core/util/tNamedFactory.h"
+#include "console/engineAPI.h"
+#include "console/consoleTypes.h"
 
 
 AFTER_MODULE_INIT( Sim )
@@ -39,6 +41,27 @@ AFTER_MODULE_INIT( Sim )
    #if defined(TORQUE_OS_MAC)
       NamedFactory<PhysicsPlugin>::add( "default", &BtPlugin::create );
    #endif   
+
+   Con::addVariable( "$pref::Physics::Bullet::asyncStep", TypeBool, &BtWorld::smAsyncStep, 
+      "@brief If true the Bullet simulation is stepped on the thread pool.\n\n"
+      "The step is started at the end of a tick and joined at the start of the next "
+      "one, so it runs while the main thread renders the frame.\n\n"
+	   "@ingroup Physics\n");
+}
+
+DefineConsoleFunction( btGetStepStats, const char*, (const char * worldName), ("server"), "btGetStepStats( [String worldName] )"
+   "@brief Returns timings of the last Bullet step of a world.\n\n"
+   "@return \"stepTime waitTime earlyJoins\" where the times are in microseconds "
+   "and waitTime is how long the main thread was blocked on the step.\n\n"
+   "@ingroup Physics" )
+{
+   BtWorld *world = PHYSICSMGR ? dynamic_cast<BtWorld*>( PHYSICSMGR->getWorld( worldName ) ) : NULL;
+   if ( !world )
+      return "";
+
+   char *returnBuffer = Con::getReturnBuffer( 64 );
+   dSprintf( returnBuffer, 64, "%u %u %u", world->getStepTime(), world->getStepWaitTime(), world->getEarlyJoins() );
+   return returnBuffer;
 }
 
 
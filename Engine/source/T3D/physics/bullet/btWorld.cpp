@@ -33,12 +33,39 @@
 #include "console/consoleTypes.h"
 #include "scene/sceneRenderState.h"
 #include "T3D/gameBase/gameProcess.h"
+#include "platform/threads/threadPool.h"
+#include "platform/threads/thread.h"
 #ifdef _WIN32
 #include "BulletMultiThreaded/Win32ThreadSupport.h"
 #elif defined (USE_PTHREADS)
 #include "BulletMultiThreaded/PosixThreadSupport.h"
 #endif
 
+bool BtWorld::smAsyncStep = true;
+
+/// Runs the simulation step of a world on the thread pool.
+struct BtWorld::StepItem : public ThreadPool::WorkItem
+{
+   BtWorld *mWorld;
+   F32 mElapsedSec;
+
+   StepItem( BtWorld *world, F32 elapsedSec )
+      : mWorld( world ),
+        mElapsedSec( elapsedSec )
+   {
+   }
+
+   // The main thread will block on this step at the start of
+   // the next tick, so get it out ahead of background work.
+   virtual F32 getPriority() { return 10.0f; }
+
+   virtual void execute()
+   {
+      mWorld->_step( mElapsedSec );
+      mWorld->mStepFence.signal();
+   }
+};
+
 BtWorld::BtWorld() :
    mProcessList( NULL ),
    mIsSimulating( false ),
@@ -47,7 +74,12 @@ BtWorld::BtWorld() :
    mIsEnabled( false ),
    mEditorTimeScale( 1.0f ),
    mDynamicsWorld( NULL ),
-   mThreadSupportCollision( NULL )
+   mThreadSupportCollision( NULL ),
+   mStepPending( false ),
+   mStepTime( 0 ),
+   mStepWaitTime( 0 ),
+   mSteppedTime( 0 ),
+   mEarlyJoins( 0 )
 {
 } 
 
@@ -119,6 +151,9 @@ bool BtWorld::initWorld( bool isServer, ProcessList *processList )
 
 void BtWorld::_destroy()
 {
+   // Never pull the world out from under a running step.
+   releaseWriteLock();
+
    // Release the tick processing signals.
    if ( mProcessList )
    {
@@ -157,13 +192,35 @@ void BtWorld::tickPhysics( U32 elapsedMs )
    const F32 elapsedSec = (F32)elapsedMs * 0.001f;
 
    // Simulate... it is recommended to always use Bullet's default fixed timestep/
-   mDynamicsWorld->stepSimulation( elapsedSec * mEditorTimeScale );
+   if ( smAsyncStep )
+   {
+      // Step on the thread pool while the main thread goes on with
+      // the frame.  The results are joined in getPhysicsResults() at
+      // the start of the next tick.
+      mStepPending = true;
+      mStepFence.add();
+      ThreadPool::GLOBAL().queueWorkItem( new StepItem( this, elapsedSec * mEditorTimeScale ) );
+   }
+   else
+   {
+      _step( elapsedSec * mEditorTimeScale );
+      mStepTime = mStepWaitTime = mSteppedTime;
+   }
 
    mIsSimulating = true;
 
    //Con::printf( "%s BtWorld::tickPhysics!", this == smClientWorld ? "Client" : "Server" );
 }
 
+void BtWorld::_step( F32 elapsedSec )
+{
+   PROFILE_SCOPE(BtWorld_Step);
+
+   const U64 start = Platform::getRealMicroseconds();
+   mDynamicsWorld->stepSimulation( elapsedSec );
+   mSteppedTime = (U32)( Platform::getRealMicroseconds() - start );
+}
+
 void BtWorld::getPhysicsResults()
 {
    if ( !mDynamicsWorld || !mIsSimulating ) 
@@ -171,12 +228,38 @@ void BtWorld::getPhysicsResults()
 
    PROFILE_SCOPE(BtWorld_GetPhysicsResults);
 
-   // Get results from scene.
-  // mScene->fetchResults( NX_RIGID_BODY_FINISHED, true );
+   // Join the step if it is still running.
+   if ( mStepPending )
+   {
+      const U64 start = Platform::getRealMicroseconds();
+      mStepFence.wait();
+      mStepWaitTime = (U32)( Platform::getRealMicroseconds() - start );
+      mStepTime = mSteppedTime;
+      mStepPending = false;
+   }
+
    mIsSimulating = false;
    mTickCount++;
 }
 
+void BtWorld::releaseWriteLock()
+{
+   if ( !mStepPending )
+      return;
+
+   PROFILE_SCOPE(BtWorld_ReleaseWriteLock);
+
+   AssertFatal( ThreadManager::isMainThread(), "BtWorld::releaseWriteLock() - Only the main thread can join the step!" );
+
+   // Something needs the world before the next tick, so wait
+   // for the step here.  We leave mIsSimulating alone so that
+   // getPhysicsResults() still does the tick bookkeeping.
+   mStepFence.wait();
+   mStepTime = mSteppedTime;
+   mStepPending = false;
+   mEarlyJoins++;
+}
+
 void BtWorld::setEnabled( bool enabled )
 {
    mIsEnabled = enabled;
@@ -192,6 +275,8 @@ void BtWorld::destroyWorld()
 
 bool BtWorld::castRay( const Point3F &startPnt, const Point3F &endPnt, RayInfo *ri, const Point3F &impulse )
 {
+   releaseWriteLock();
+
    btCollisionWorld::ClosestRayResultCallback result( btCast<btVector3>( startPnt ), btCast<btVector3>( endPnt ) );
    mDynamicsWorld->rayTest( btCast<btVector3>( startPnt ), btCast<btVector3>( endPnt ), result );
 
@@ -233,6 +318,8 @@ bool BtWorld::castRay( const Point3F &startPnt, const Point3F &endPnt, RayInfo *
 
 PhysicsBody* BtWorld::castRay( const Point3F &start, const Point3F &end, U32 bodyTypes )
 {
+   releaseWriteLock();
+
    btVector3 startPt = btCast<btVector3>( start );
    btVector3 endPt = btCast<btVector3>( end );
 
@@ -286,6 +373,8 @@ void BtWorld::explosion( const Point3F &pos, F32 radius, F32 forceMagnitude )
 
 void BtWorld::onDebugDraw( const SceneRenderState *state )
 {
+   releaseWriteLock();
+
    mDebugDraw.setCuller( &state->getCullingFrustum() );
 
    mDynamicsWorld->setDebugDrawer( &mDebugDraw );
@@ -300,6 +389,8 @@ void BtWorld::reset()
    if ( !mDynamicsWorld )
       return;
 
+   releaseWriteLock();
+
     ///create a copy of the array, not a reference!
     btCollisionObjectArray copyArray = mDynamicsWorld->getCollisionObjectArray();
 
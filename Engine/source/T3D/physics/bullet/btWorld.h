@@ -35,6 +35,9 @@
 #ifndef _TVECTOR_H_
 #include "core/util/tVector.h"
 #endif
+#ifndef _THREADFENCE_H_
+#include "platform/threads/threadFence.h"
+#endif
 
 class ProcessList;
 class btThreadSupportInterface;
@@ -66,8 +69,30 @@ protected:
 
    ProcessList *mProcessList;
 
+   struct StepItem;
+
+   /// Signaled by the thread pool when the step is done.
+   ThreadFence mStepFence;
+
+   /// Set from tickPhysics() until the step has been joined.
+   bool mStepPending;
+
+   /// Timings of the last joined step in microseconds.
+   U32 mStepTime;
+   U32 mStepWaitTime;
+
+   /// Microseconds taken by the step, written by _step() on the thread
+   /// pool.  Only copied to mStepTime once the step has been joined.
+   U32 mSteppedTime;
+
+   /// Times the step had to be joined before getPhysicsResults().
+   U32 mEarlyJoins;
+
    void _destroy();
 
+   /// Run the simulation step for the elapsed seconds.
+   void _step( F32 elapsedSec );
+
 public:
 
    BtWorld();
@@ -83,12 +108,37 @@ public:
    virtual void reset();
    virtual bool isEnabled() const { return mIsEnabled; }
 
-   btDynamicsWorld* getDynamicsWorld() const { return mDynamicsWorld; }
+   /// Returns the Bullet world.  Callers must have called
+   /// releaseWriteLock() first if the world may be stepping.
+   btDynamicsWorld* getDynamicsWorld() const
+   {
+      AssertFatal( !mStepPending, "BtWorld::getDynamicsWorld() - The world is still stepping; call releaseWriteLock() first!" );
+      return mDynamicsWorld;
+   }
 
    void tickPhysics( U32 elapsedMs );
    void getPhysicsResults();
    bool isWritable() const { return !mIsSimulating; }
 
+   /// Waits for a step running on the thread pool to finish so the
+   /// world and its bodies can be read and changed.  This has to be
+   /// called before touching anything in the world outside of the
+   /// game tick.
+   void releaseWriteLock();
+
+   /// Returns the microseconds the last joined step took on the thread pool.
+   U32 getStepTime() const { return mStepTime; }
+
+   /// Returns the microseconds the main thread waited for the last step.
+   U32 getStepWaitTime() const { return mStepWaitTime; }
+
+   /// Returns the number of steps joined early by releaseWriteLock().
+   U32 getEarlyJoins() const { return mEarlyJoins; }
+
+   /// If true, tickPhysics() runs the step on the thread pool and
+   /// getPhysicsResults() joins it at the start of the next tick.
+   static bool smAsyncStep;
+
    void setEnabled( bool enabled );
    bool getEnabled() const { return mIsEnabled; }
 
@@ -0,0 +1,210 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "T3D/physics/bullet/btWorld.h"
+#include "T3D/physics/bullet/btBody.h"
+#include "T3D/physics/bullet/btCollision.h"
+#include "T3D/gameBase/processList.h"
+#include "scene/sceneObject.h"
+#include "math/mRandom.h"
+#include "console/console.h"
+
+namespace
+{
+   /// A world with a ground plane and a pile of falling boxes, the way
+   /// PhysicsShape debris ends up in a BtWorld.
+   struct DebrisWorld
+   {
+      ProcessList mProcessList;
+      BtWorld mWorld;
+      SceneObject mObject;
+      Vector<BtBody*> mBodies;
+
+      DebrisWorld(U32 numBoxes)
+      {
+         mWorld.initWorld(true, &mProcessList);
+         mWorld.setEnabled(true);
+
+         BtCollision *ground = new BtCollision;
+         ground->addPlane(PlaneF(Point3F::Zero, Point3F(0, 0, 1)));
+         addBody(ground, 0.0f, MatrixF::Identity);
+
+         MRandomLCG random(1);
+         for(U32 i = 0; i < numBoxes; i++)
+         {
+            BtCollision *box = new BtCollision;
+            box->addBox(Point3F(0.25f, 0.25f, 0.25f), MatrixF::Identity);
+
+            MatrixF xfm(true);
+            xfm.setPosition(Point3F(random.randF(-20.0f, 20.0f),
+                                    random.randF(-20.0f, 20.0f),
+                                    random.randF(1.0f, 40.0f)));
+            addBody(box, 1.0f, xfm);
+         }
+      }
+
+      ~DebrisWorld()
+      {
+         for(U32 i = 0; i < mBodies.size(); i++)
+            delete mBodies[i];
+         mWorld.destroyWorld();
+      }
+
+      void addBody(BtCollision *shape, F32 mass, const MatrixF &xfm)
+      {
+         BtBody *body = new BtBody;
+         body->init(shape, mass, 0, &mObject, &mWorld);
+         body->setTransform(xfm);
+         mBodies.push_back(body);
+      }
+
+      /// Runs one tick the way the process list does; the physics
+      /// results are joined at the start of the tick and the step is
+      /// started at the end.  Returns the microseconds the main thread
+      /// spent in physics.
+      U32 tick(U32 workMicroseconds)
+      {
+         U64 start = Platform::getRealMicroseconds();
+         mWorld.getPhysicsResults();
+         mWorld.tickPhysics(TickMs);
+         U32 physicsTime = (U32)(Platform::getRealMicroseconds() - start);
+
+         // Pretend to render a frame.
+         start = Platform::getRealMicroseconds();
+         while(Platform::getRealMicroseconds() - start < workMicroseconds)
+            Platform::sleep(0);
+
+         return physicsTime;
+      }
+   };
+
+   struct AsyncStepScope
+   {
+      bool mSaved;
+      AsyncStepScope(bool async) : mSaved(BtWorld::smAsyncStep) { BtWorld::smAsyncStep = async; }
+      ~AsyncStepScope() { BtWorld::smAsyncStep = mSaved; }
+   };
+}
+
+TEST(BtWorld, AsyncStepMatchesSync)
+{
+   const U32 numBoxes = 200;
+   const U32 numTicks = 60;
+
+   DebrisWorld syncWorld(numBoxes);
+   DebrisWorld asyncWorld(numBoxes);
+
+   {
+      AsyncStepScope scope(false);
+      for(U32 i = 0; i < numTicks; i++)
+         syncWorld.tick(0);
+      syncWorld.mWorld.getPhysicsResults();
+   }
+   {
+      AsyncStepScope scope(true);
+      for(U32 i = 0; i < numTicks; i++)
+         asyncWorld.tick(0);
+      asyncWorld.mWorld.getPhysicsResults();
+   }
+
+   EXPECT_EQ(syncWorld.mWorld.getEarlyJoins(), 0);
+   EXPECT_EQ(asyncWorld.mWorld.getEarlyJoins(), 0);
+
+   U32 numMismatches = 0;
+   for(U32 i = 0; i < syncWorld.mBodies.size(); i++)
+   {
+      MatrixF syncXfm, asyncXfm;
+      syncWorld.mBodies[i]->getTransform(&syncXfm);
+      asyncWorld.mBodies[i]->getTransform(&asyncXfm);
+      if(syncXfm.getPosition() != asyncXfm.getPosition())
+         numMismatches++;
+   }
+
+   EXPECT_EQ(numMismatches, 0)
+      << "Stepping on the thread pool changed the simulation!";
+}
+
+TEST(BtWorld, ReleaseWriteLock)
+{
+   AsyncStepScope scope(true);
+   DebrisWorld world(50);
+
+   world.tick(0);
+   EXPECT_FALSE(world.mWorld.isWritable());
+
+   // Touching a body mid-step has to join the step first.
+   MatrixF xfm;
+   world.mBodies[1]->getTransform(&xfm);
+   EXPECT_EQ(world.mWorld.getEarlyJoins(), 1);
+
+   // The tick still finishes normally.
+   world.mWorld.getPhysicsResults();
+   EXPECT_TRUE(world.mWorld.isWritable());
+   EXPECT_EQ(world.mWorld.getEarlyJoins(), 1);
+}
+
+TEST(BtWorld, StressAsyncStep)
+{
+   // Steps 2000 debris boxes with the physics stepped on the main thread
+   // and on the thread pool while the main thread is busy with a frame.
+   // Timings go to the console.
+
+   const U32 numBoxes = 2000;
+   const U32 numTicks = 120;
+   const U32 frameWork = 8000;
+
+   U32 syncTime = 0;
+   U32 syncStepTime = 0;
+   {
+      AsyncStepScope scope(false);
+      DebrisWorld world(numBoxes);
+      for(U32 i = 0; i < numTicks; i++)
+      {
+         syncTime += world.tick(frameWork);
+         syncStepTime += world.mWorld.getStepTime();
+      }
+   }
+
+   U32 asyncTime = 0;
+   U32 asyncStepTime = 0;
+   {
+      AsyncStepScope scope(true);
+      DebrisWorld world(numBoxes);
+      for(U32 i = 0; i < numTicks; i++)
+      {
+         asyncTime += world.tick(frameWork);
+         asyncStepTime += world.mWorld.getStepTime();
+      }
+      EXPECT_EQ(world.mWorld.getEarlyJoins(), 0);
+   }
+
+   Con::printf("Bullet step, %u boxes, %u ticks, %u us of frame work per tick:", numBoxes, numTicks, frameWork);
+   Con::printf("   sync:    %.2f ms main thread per tick (%.2f ms step)", F32(syncTime) / numTicks / 1000.0f, F32(syncStepTime) / numTicks / 1000.0f);
+   Con::printf("   async:   %.2f ms main thread per tick (%.2f ms step)", F32(asyncTime) / numTicks / 1000.0f, F32(asyncStepTime) / numTicks / 1000.0f);
+}
+
+#endif
@@ -76,7 +76,8 @@ public:
                                  U32 triCount,
                                  const MatrixF &localXfm ) = 0;
 
-   /// Add a heightfield to the collision shape.
+   /// Add a heightfield to the collision shape.  The heights are only
+   /// read during the call, so implementations copy what they keep.
    virtual bool addHeightfield(  const U16 *heights,
                                  const bool *holes,
                                  U32 blockSize,
@@ -6146,6 +6146,26 @@ void Player::readPacketData(GameConnection *connection, BitStream *stream)
       setControlObject(0);
 }
 
+void Player::packMoveSnapshot(const Point3F &pos, const VectorF &vel, NetSnapshot *snapshot)
+{
+   // Millimeters for the position and 1/32 m/s for the velocity.
+   snapshot->numValues = 6;
+   for(U32 i = 0; i < 3; i++)
+   {
+      snapshot->values[i] = (S32)mFloor(pos[i] * 1000.0f + 0.5f);
+      snapshot->values[i + 3] = (S32)mFloor(vel[i] * 32.0f + 0.5f);
+   }
+}
+
+void Player::unpackMoveSnapshot(const NetSnapshot &snapshot, Point3F *pos, VectorF *vel)
+{
+   for(U32 i = 0; i < 3; i++)
+   {
+      (*pos)[i] = snapshot.values[i] / 1000.0f;
+      (*vel)[i] = snapshot.values[i + 3] / 32.0f;
+   }
+}
+
 U32 Player::packUpdate(NetConnection *con, U32 mask, BitStream *stream)
 {
    U32 retMask = Parent::packUpdate(con, mask, stream);
@@ -6192,18 +6212,14 @@ U32 Player::packUpdate(NetConnection *con, U32 mask, BitStream *stream)
 
       Point3F pos;
       getTransform().getColumn(3,&pos);
-      stream->writeCompressedPoint(pos);
-      F32 len = mVelocity.len();
-      if(stream->writeFlag(len > 0.02f))
-      {
-         Point3F outVel = mVelocity;
-         outVel *= 1.0f/len;
-         stream->writeNormalVector(outVel, 10);
-         len *= 32.0f;  // 5 bits of fraction
-         if(len > 8191)
-            len = 8191;
-         stream->writeInt((S32)len, 13);
-      }
+
+      // Position and velocity go out as a snapshot so steady motion
+      // costs next to nothing once the client has acked an update.
+      NetSnapshot snapshot, reference;
+      packMoveSnapshot(pos, mVelocity, &snapshot);
+      packMoveSnapshot(stream->getCompressionPoint(), VectorF::Zero, &reference);
+      con->packSnapshot(stream, snapshot, &reference);
+
       stream->writeFloat(mRot.z / M_2PI_F, 7);
       stream->writeSignedFloat(mHead.x / (mDataBlock->maxLookAngle - mDataBlock->minLookAngle), 6);
       stream->writeSignedFloat(mHead.z / mDataBlock->maxFreelookAngle, 6);
@@ -6292,18 +6308,14 @@ void Player::unpackUpdate(NetConnection *con, BitStream *stream)
          setState(actionState);
 
       Point3F pos,rot;
-      stream->readCompressedPoint(&pos);
       F32 speed = mVelocity.len();
-      if(stream->readFlag())
-      {
-         stream->readNormalVector(&mVelocity, 10);
-         mVelocity *= stream->readInt(13) / 32.0f;
-      }
-      else
-      {
-         mVelocity.set(0.0f, 0.0f, 0.0f);
-      }
-      
+
+      NetSnapshot snapshot, reference;
+      packMoveSnapshot(stream->getCompressionPoint(), VectorF::Zero, &reference);
+      snapshot.numValues = reference.numValues;
+      con->unpackSnapshot(stream, &snapshot, &reference);
+      unpackMoveSnapshot(snapshot, &pos, &mVelocity);
+
       rot.y = rot.x = 0.0f;
       rot.z = stream->readFloat(7) * M_2PI_F;
       mHead.x = stream->readSignedFloat(6) * (mDataBlock->maxLookAngle - mDataBlock->minLookAngle);
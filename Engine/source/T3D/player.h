@@ -38,6 +38,7 @@ class ParticleEmitterData;
 class DecalData;
 class SplashData;
 class PhysicsPlayer;
+struct NetSnapshot;
 class Player;
 
 //----------------------------------------------------------------------------
@@ -763,6 +764,10 @@ public:
    U32  packUpdate  (NetConnection *conn, U32 mask, BitStream *stream);
    void unpackUpdate(NetConnection *conn,           BitStream *stream);
 
+   /// Quantizes the position and velocity sent in MoveMask updates.
+   static void packMoveSnapshot(const Point3F &pos, const VectorF &vel, NetSnapshot *snapshot);
+   static void unpackMoveSnapshot(const NetSnapshot &snapshot, Point3F *pos, VectorF *vel);
+
    virtual void prepRenderImage( SceneRenderState* state );
    virtual void renderConvex( ObjectRenderInst *ri, SceneRenderState *state, BaseMatInstance *overrideMat );   
    virtual void renderMountedImage( U32 imageSlot, TSRenderState &rstate, SceneRenderState *state );
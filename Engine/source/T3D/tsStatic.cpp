@@ -569,7 +569,9 @@ void TSStatic::prepRenderImage( SceneRenderState* state )
    if ( mShapeInstance->getCurrentDetail() < 0 )
       return;
 
-   GFXTransformSaver saver;
+   // Only the world matrix changes here, which unlike the
+   // rest of the GFX transforms works on worker threads.
+   GFX->pushWorldMatrix();
    
    // Set up our TS render state.
    TSRenderState rdata;
@@ -620,6 +622,8 @@ void TSStatic::prepRenderImage( SceneRenderState* state )
    }
    mShapeInstance->render( rdata );
 
+   GFX->popWorldMatrix();
+
    if ( mRenderNormalScalar > 0 )
    {
       ObjectRenderInst *ri = state->getRenderPass()->allocInst<ObjectRenderInst>();
@@ -629,6 +633,12 @@ void TSStatic::prepRenderImage( SceneRenderState* state )
    }
 }
 
+bool TSStatic::isPrepRenderImageThreadSafe() const
+{
+   // Skinned meshes fill their vertex buffers while being prepared.
+   return mShapeInstance && !mShapeInstance->getShape()->mHasSkinMesh;
+}
+
 void TSStatic::_renderNormals( ObjectRenderInst *ri, SceneRenderState *state, BaseMatInstance *overrideMat )
 {
    PROFILE_SCOPE( TSStatic_RenderNormals );
@@ -144,6 +144,9 @@ protected:
    virtual void interpolateTick( F32 delta );   
    virtual void advanceTime( F32 dt );
 
+   /// The tick only advances the ambient thread of our own shape instance.
+   virtual bool isTickThreadSafe() const { return true; }
+
    /// Start or stop processing ticks depending on our state.
    void _updateShouldTick();
 
@@ -208,6 +211,7 @@ public:
    void setTransform( const MatrixF &mat );
    void onScaleChanged();
    void prepRenderImage( SceneRenderState *state );
+   bool isPrepRenderImageThreadSafe() const;
    void inspectPostApply();
 
    /// The type of mesh data use for collision queries.
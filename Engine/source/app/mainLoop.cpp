@@ -22,6 +22,8 @@
 
 #include "app/mainLoop.h"
 #include "app/game.h"
+#include "app/timeDemo.h"
+#include "app/renderBenchmark.h"
 
 #include "platform/platformTimer.h"
 #include "platform/platformRedBook.h"
@@ -136,6 +138,10 @@ void processTimeEvent(S32 elapsedTime)
    // If recording a video and not playinb back a journal, override the elapsedTime
    if (VIDCAP->isRecording() && !Journal::IsPlaying())
       elapsedTime = VIDCAP->getMsPerFrame();   
+
+   // Time demos and render benchmarks advance exactly one tick per frame.
+   if (TimeDemo::isRunning() || RenderBenchmark::isRunning())
+      elapsedTime = TickMs;
    
    // cap the elapsed time to one second
    // if it's more than that we're probably in a bad catch-up situation
@@ -159,31 +165,46 @@ void processTimeEvent(S32 elapsedTime)
    bool tickPass;
    
    PROFILE_START(ServerProcess);
-   tickPass = serverProcess(timeDelta);
+   {
+      TimeDemo::Scope timeDemoScope(TimeDemo::ServerProcess);
+      tickPass = serverProcess(timeDelta);
+   }
    PROFILE_END();
    
    PROFILE_START(ServerNetProcess);
    // only send packets if a tick happened
    if(tickPass)
+   {
+      TimeDemo::Scope timeDemoScope(TimeDemo::ServerNet);
       GNet->processServer();
+   }
    // Used to indicate if server was just ticked.
    Con::setBoolVariable( "$pref::hasServerTicked", tickPass );
    PROFILE_END();
 
    
    PROFILE_START(SimAdvanceTime);
-   Sim::advanceTime(timeDelta);
+   {
+      TimeDemo::Scope timeDemoScope(TimeDemo::SimEvents);
+      Sim::advanceTime(timeDelta);
+   }
    PROFILE_END();
    
    PROFILE_START(ClientProcess);
-   tickPass = clientProcess(timeDelta);
+   {
+      TimeDemo::Scope timeDemoScope(TimeDemo::ClientProcess);
+      tickPass = clientProcess(timeDelta);
+   }
    // Used to indicate if client was just ticked.
    Con::setBoolVariable( "$pref::hasClientTicked", tickPass );
    PROFILE_END_NAMED(ClientProcess);
    
    PROFILE_START(ClientNetProcess);
    if(tickPass)
+   {
+      TimeDemo::Scope timeDemoScope(TimeDemo::ClientNet);
       GNet->processClient();
+   }
    PROFILE_END();
    
    GNet->checkTimeouts();
@@ -217,7 +238,7 @@ void StandardMainLoop::init()
    PlatformAssert::create();
    
    ManagedSingleton< ThreadManager >::createSingleton();
-   FrameAllocator::init(TORQUE_FRAME_SIZE);      // See comments in torqueConfig.h
+   FrameAllocator::init(TORQUE_FRAME_SIZE, TORQUE_WORKER_FRAME_SIZE);      // See comments in torqueConfig.h
 
    // Yell if we can't initialize the network.
    if(!Net::init())
@@ -596,13 +617,18 @@ bool StandardMainLoop::doMainLoop()
          tm->setBackground(false);
       }
       
+      // Time demos and render benchmarks run as fast as the frames can be made.
+      tm->setFramePacing(!TimeDemo::isRunning() && !RenderBenchmark::isRunning());
+
       PROFILE_START(MainLoop);
       Sampler::beginFrame();
+      TimeDemo::beginFrame();
 
       if(!Process::processEvents())
          keepRunning = false;
 
       ThreadPool::processMainThreadWorkItems();
+      TimeDemo::endFrame();
       Sampler::endFrame();
       PROFILE_END_NAMED(MainLoop);
    }
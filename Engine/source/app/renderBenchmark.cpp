@@ -0,0 +1,485 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "app/renderBenchmark.h"
+
+#include "core/stream/fileStream.h"
+#include "core/strings/stringUnit.h"
+#include "core/util/journal/process.h"
+#include "console/console.h"
+#include "console/engineAPI.h"
+#include "console/simSet.h"
+#include "math/mQuat.h"
+#include "scene/simPath.h"
+#include "scene/renderStageStats.h"
+#include "gfx/gfxDevice.h"
+
+
+bool RenderBenchmark::smRunning = false;
+String RenderBenchmark::smResultsFile;
+String RenderBenchmark::smBaselineFile;
+F32 RenderBenchmark::smThreshold = 0.0f;
+Vector<MatrixF> RenderBenchmark::smCameras;
+U32 RenderBenchmark::smCurrentFrame = 0;
+U64 RenderBenchmark::smRenderStart = 0;
+Vector<U32> RenderBenchmark::smSeries[NumSeries];
+
+IMPLEMENT_GLOBAL_CALLBACK( onRenderBenchmarkComplete, void, ( bool passed ), ( passed ),
+   "Called by the engine when a render benchmark has written its results.\n"
+   "@param passed False if a series regressed against the baseline or the results "
+   "could not be written.\n"
+   "@see startRenderBenchmark()\n"
+   "@ingroup Rendering\n" );
+
+namespace
+{
+   /// Time regressions smaller than this, in milliseconds, are noise.
+   const F64 TimeNoiseFloor = 0.05;
+
+   S32 QSORT_CALLBACK compareU32(const U32 *a, const U32 *b)
+   {
+      return (*a > *b) - (*a < *b);
+   }
+
+   /// Returns the value at @a fraction of a sorted list.
+   U32 percentile(const Vector<U32> &sorted, F32 fraction)
+   {
+      if(sorted.empty())
+         return 0;
+      return sorted[getMin(U32(fraction * sorted.size()), U32(sorted.size() - 1))];
+   }
+
+   /// Writes the mean and percentiles of a series, divided by @a scale,
+   /// as a JSON object.  The values are @a numPasses passes of equal length.
+   void writeSeries(Stream &stream, const char *name, Vector<U32> &values, U32 numPasses, F64 scale, bool last)
+   {
+      // The spread of the median between the passes tells how
+      // noisy the series is.
+      U32 minMedian = U32_MAX;
+      U32 maxMedian = 0;
+      const U32 passLength = values.size() / getMax(numPasses, U32(1));
+      for(U32 i = 0; i < numPasses && passLength > 0; i++)
+      {
+         Vector<U32> pass;
+         pass.set(values.address() + i * passLength, passLength);
+         pass.sort(compareU32);
+
+         const U32 median = percentile(pass, 0.5f);
+         minMedian = getMin(minMedian, median);
+         maxMedian = getMax(maxMedian, median);
+      }
+      const F64 spread = maxMedian >= minMedian ? F64(maxMedian - minMedian) : 0.0;
+
+      values.sort(compareU32);
+
+      F64 total = 0.0;
+      for(U32 i = 0; i < values.size(); i++)
+         total += values[i];
+      const F64 mean = values.empty() ? 0.0 : total / values.size();
+
+      char buffer[512];
+      dSprintf(buffer, sizeof(buffer),
+         "    \"%s\": { \"mean\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f, \"spread\": %.3f }%s",
+         name, mean / scale,
+         percentile(values, 0.5f) / scale, percentile(values, 0.9f) / scale,
+         percentile(values, 0.95f) / scale, percentile(values, 0.99f) / scale,
+         percentile(values, 1.0f) / scale, spread / scale, last ? "" : ",");
+      stream.writeLine((const U8*)buffer);
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+const char* RenderBenchmark::getSeriesName( Series series )
+{
+   static const char *names[NumSeries] =
+   {
+      "render",
+      "cull",
+      "prepRenderImage",
+      "sort",
+      "renderBins",
+      "drawCalls",
+      "polyCount",
+      "stateBlockChanges",
+      "renderTargetChanges",
+      "shaderConstBytes",
+      "unbatchedDrawCalls"
+   };
+
+   return names[series];
+}
+
+void RenderBenchmark::_addPath( SimPath::Path *path )
+{
+   Vector<Marker*> markers;
+   for ( SimGroup::iterator itr = path->begin(); itr != path->end(); itr++ )
+   {
+      Marker *marker = dynamic_cast<Marker*>( *itr );
+      if ( marker )
+         markers.push_back( marker );
+   }
+
+   if ( markers.empty() )
+      return;
+
+   const U32 numSegments = path->isLooping() ? markers.size() : markers.size() - 1;
+   for ( U32 i = 0; i < numSegments; i++ )
+   {
+      const Marker *from = markers[i];
+      const Marker *to = markers[( i + 1 ) % markers.size()];
+
+      const Point3F fromPos = from->getPosition();
+      const Point3F toPos = to->getPosition();
+      const QuatF fromRot( from->getTransform() );
+      const QuatF toRot( to->getTransform() );
+
+      const U32 steps = getMax( from->mMSToNext / CameraStepMs, U32( 1 ) );
+      for ( U32 step = 0; step < steps; step++ )
+      {
+         const F32 t = F32( step ) / F32( steps );
+
+         QuatF rot;
+         rot.interpolate( fromRot, toRot, t );
+
+         MatrixF mat;
+         rot.setMatrix( &mat );
+         mat.setPosition( fromPos + ( toPos - fromPos ) * t );
+         smCameras.push_back( mat );
+      }
+   }
+
+   if ( !path->isLooping() )
+      smCameras.push_back( markers.last()->getTransform() );
+}
+
+void RenderBenchmark::_addMissionPaths( SimGroup *group )
+{
+   for ( SimGroup::iterator itr = group->begin(); itr != group->end(); itr++ )
+   {
+      SimPath::Path *path = dynamic_cast<SimPath::Path*>( *itr );
+      if ( path )
+      {
+         _addPath( path );
+         continue;
+      }
+
+      SimGroup *subGroup = dynamic_cast<SimGroup*>( *itr );
+      if ( subGroup )
+         _addMissionPaths( subGroup );
+   }
+}
+
+bool RenderBenchmark::start( const char *paths, const char *resultsFile, const char *baselineFile, F32 threshold )
+{
+   if ( smRunning )
+   {
+      Con::errorf( "RenderBenchmark::start - A render benchmark is already running!" );
+      return false;
+   }
+
+   smCameras.clear();
+
+   if ( paths && paths[0] )
+   {
+      const U32 numPaths = StringUnit::getUnitCount( paths, " \t\n" );
+      for ( U32 i = 0; i < numPaths; i++ )
+      {
+         const char *name = StringUnit::getUnit( paths, i, " \t\n" );
+         SimPath::Path *path;
+         if ( !Sim::findObject( name, path ) )
+         {
+            Con::errorf( "RenderBenchmark::start - Could not find the path '%s'.", name );
+            return false;
+         }
+         _addPath( path );
+      }
+   }
+   else
+   {
+      SimGroup *missionGroup;
+      if ( Sim::findObject( "MissionGroup", missionGroup ) )
+         _addMissionPaths( missionGroup );
+   }
+
+   if ( smCameras.empty() )
+   {
+      Con::errorf( "RenderBenchmark::start - There are no camera paths to fly along." );
+      return false;
+   }
+
+   // Frames are measured by bracketing the canvas in the process list.
+   static bool sRenderHooked = false;
+   if ( !sRenderHooked )
+   {
+      Process::notify( &RenderBenchmark::_beginRender, PROCESS_RENDER_ORDER - 0.01f );
+      Process::notify( &RenderBenchmark::_endRender, PROCESS_RENDER_ORDER + 0.01f );
+      sRenderHooked = true;
+   }
+
+   smResultsFile = resultsFile;
+   smBaselineFile = baselineFile ? baselineFile : "";
+   smThreshold = threshold;
+   smCurrentFrame = 0;
+   smRenderStart = 0;
+   for ( U32 i = 0; i < NumSeries; i++ )
+   {
+      smSeries[i].clear();
+      smSeries[i].reserve( smCameras.size() * MeasuredPasses );
+   }
+
+   RenderStageStats::setEnabled( true );
+   smRunning = true;
+
+   Con::printf( "RenderBenchmark::start - Rendering %d cameras %d times, results will be written to '%s'.",
+      smCameras.size(), 1 + MeasuredPasses, resultsFile );
+   return true;
+}
+
+bool RenderBenchmark::getCameraTransform( MatrixF *outMat )
+{
+   if ( !smRunning )
+      return false;
+
+   *outMat = smCameras[smCurrentFrame % smCameras.size()];
+   return true;
+}
+
+void RenderBenchmark::_beginRender()
+{
+   if ( !smRunning )
+      return;
+
+   RenderStageStats::reset();
+   smRenderStart = Platform::getRealMicroseconds();
+}
+
+void RenderBenchmark::_endRender()
+{
+   // The benchmark may have been started in the middle of a frame.
+   if ( !smRunning || !smRenderStart )
+      return;
+
+   // The first pass over the cameras only warms up.
+   if ( smCurrentFrame >= smCameras.size() )
+   {
+      const GFXDeviceStatistics *stats = GFX->getDeviceStatistics();
+
+      smSeries[Render].push_back( U32( Platform::getRealMicroseconds() - smRenderStart ) );
+      smSeries[Cull].push_back( U32( RenderStageStats::getTime( RenderStageStats::Cull ) ) );
+      smSeries[PrepRenderImage].push_back( U32( RenderStageStats::getTime( RenderStageStats::PrepRenderImage ) ) );
+      smSeries[Sort].push_back( U32( RenderStageStats::getTime( RenderStageStats::Sort ) ) );
+      smSeries[RenderBins].push_back( U32( RenderStageStats::getTime( RenderStageStats::RenderBins ) ) );
+      smSeries[DrawCalls].push_back( stats->mDrawCalls );
+      smSeries[PolyCount].push_back( stats->mPolyCount );
+      smSeries[StateBlockChanges].push_back( stats->mStateBlockChanges );
+      smSeries[RenderTargetChanges].push_back( stats->mRenderTargetChanges );
+      smSeries[ShaderConstBytes].push_back( stats->mShaderConstBytes );
+      smSeries[UnbatchedDrawCalls].push_back( stats->mDrawCalls - stats->mInstancedDrawCalls + stats->mInstancedMeshes );
+   }
+
+   smCurrentFrame++;
+   if ( smCurrentFrame >= ( 1 + MeasuredPasses ) * smCameras.size() )
+      _finish();
+}
+
+void RenderBenchmark::_finish()
+{
+   smRunning = false;
+   RenderStageStats::setEnabled( false );
+
+   bool passed = _writeResults();
+
+   if ( passed && smBaselineFile.isNotEmpty() )
+   {
+      ResultMap baseline;
+      ResultMap results;
+
+      FileStream baselineStream;
+      FileStream resultsStream;
+      if ( !baselineStream.open( smBaselineFile, Torque::FS::File::Read ) ||
+           !readResults( baselineStream, baseline ) )
+      {
+         Con::errorf( "RenderBenchmark::_finish - Could not read the baseline '%s'.", smBaselineFile.c_str() );
+         passed = false;
+      }
+      else if ( !resultsStream.open( smResultsFile, Torque::FS::File::Read ) ||
+                !readResults( resultsStream, results ) )
+      {
+         Con::errorf( "RenderBenchmark::_finish - Could not read back the results '%s'.", smResultsFile.c_str() );
+         passed = false;
+      }
+      else
+      {
+         Vector<String> regressions;
+         const U32 numRegressions = compareResults( baseline, results, smThreshold, &regressions );
+         for ( U32 i = 0; i < regressions.size(); i++ )
+            Con::errorf( "RenderBenchmark - %s", regressions[i].c_str() );
+
+         Con::printf( "RenderBenchmark::_finish - %d regressions against '%s' with a threshold of %.0f%%.",
+            numRegressions, smBaselineFile.c_str(), smThreshold * 100.0f );
+         passed = numRegressions == 0;
+      }
+   }
+
+   onRenderBenchmarkComplete_callback( passed );
+}
+
+bool RenderBenchmark::_writeResults()
+{
+   FileStream stream;
+   if ( !stream.open( smResultsFile, Torque::FS::File::Write ) )
+   {
+      Con::errorf( "RenderBenchmark::_writeResults - Could not open '%s' for writing.", smResultsFile.c_str() );
+      return false;
+   }
+
+   char buffer[256];
+   stream.writeLine( (const U8*)"{" );
+   dSprintf( buffer, sizeof( buffer ), "  \"frames\": %d,", smSeries[Render].size() );
+   stream.writeLine( (const U8*)buffer );
+   dSprintf( buffer, sizeof( buffer ), "  \"device\": \"%s\",", GFX->getAdapterType() == NullDevice ? "null" : "hardware" );
+   stream.writeLine( (const U8*)buffer );
+
+   // Times are in milliseconds, counts are per frame.
+   stream.writeLine( (const U8*)"  \"series\": {" );
+   for ( U32 i = 0; i < NumSeries; i++ )
+   {
+      const Series series = (Series)i;
+      writeSeries( stream, getSeriesName( series ), smSeries[i], MeasuredPasses,
+         isTimeSeries( series ) ? 1000.0 : 1.0, i == NumSeries - 1 );
+   }
+   stream.writeLine( (const U8*)"  }" );
+
+   stream.writeLine( (const U8*)"}" );
+   return true;
+}
+
+bool RenderBenchmark::readResults( Stream &stream, ResultMap &outResults )
+{
+   outResults.clear();
+
+   char line[512];
+   while ( stream.getStatus() == Stream::Ok )
+   {
+      stream.readLine( (U8*)line, sizeof( line ) );
+
+      // Results written before the spread was measured have none.
+      char name[64];
+      Summary summary;
+      summary.spread = 0.0;
+      if ( dSscanf( line, " \"%63[^\"]\": { \"mean\": %lf, \"p50\": %lf, \"p90\": %lf, \"p95\": %lf, \"p99\": %lf, \"max\": %lf, \"spread\": %lf",
+               name, &summary.mean, &summary.p50, &summary.p90, &summary.p95, &summary.p99, &summary.max, &summary.spread ) >= 7 )
+         outResults[name] = summary;
+   }
+
+   return !outResults.isEmpty();
+}
+
+U32 RenderBenchmark::compareResults( const ResultMap &baseline,
+                                     const ResultMap &results,
+                                     F32 threshold,
+                                     Vector<String> *outRegressions )
+{
+   U32 numRegressions = 0;
+
+   for ( U32 i = 0; i < NumSeries; i++ )
+   {
+      const Series series = (Series)i;
+      const char *name = getSeriesName( series );
+
+      ResultMap::ConstIterator base = baseline.find( name );
+      ResultMap::ConstIterator current = results.find( name );
+      if ( base == baseline.end() || current == results.end() )
+         continue;
+
+      const F64 was = base->value.p50;
+      const F64 now = current->value.p50;
+
+      // Counts don't depend on the machine, but times have to grow by
+      // more than they varied between the passes of either run.
+      F64 margin = 0.0;
+      F64 floor = 0.0;
+      if ( isTimeSeries( series ) )
+      {
+         margin = getMax( base->value.spread, current->value.spread );
+         floor = TimeNoiseFloor;
+      }
+
+      if ( now > was * ( 1.0 + threshold ) + margin && now - was > floor )
+      {
+         numRegressions++;
+         if ( outRegressions )
+            outRegressions->push_back( String::ToString( "%s regressed from %.3f to %.3f (%+.1f%%, noise margin %.3f)",
+               name, was, now, was > 0.0 ? ( now / was - 1.0 ) * 100.0 : 100.0, margin ) );
+      }
+   }
+
+   return numRegressions;
+}
+
+//-----------------------------------------------------------------------------
+
+DefineEngineFunction( startRenderBenchmark, bool, ( const char *paths, const char *fileName, const char *baselineFileName, F32 threshold ), ( "", 0.2f ),
+   "@brief Flies the camera along camera paths and benchmarks the render path.\n\n"
+
+   "The paths are sampled once per tick and the resulting cameras are rendered "
+   "once to warm up and then measured over several passes.  Each measured frame records "
+   "the CPU time of culling, prepRenderImage, render bin sorting and render bin "
+   "submission, the draw call, polygon, state block, render target and shader "
+   "constant byte counts of the GFX device, and the draw calls there would have been "
+   "without instancing.  On the null device this runs without a GPU.\n\n"
+
+   "onRenderBenchmarkComplete( %passed ) is called when the results are written.\n\n"
+
+   "@param paths Space separated names of the Path objects to fly along, or an empty "
+   "string for all the paths in the MissionGroup.\n"
+   "@param fileName The JSON file the percentiles of every series are written to.\n"
+   "@param baselineFileName The results of an earlier run.  If given, the median of "
+   "every series is compared against it and the benchmark fails if one regressed.  "
+   "Times must also grow by more than their median varied between the passes.\n"
+   "@param threshold How much a series can grow, as a fraction, before it counts as "
+   "a regression.\n"
+   "@return False if a benchmark is already running or there are no camera paths.\n"
+
+   "@ingroup Rendering\n" )
+{
+   char expanded[1024];
+   Con::expandScriptFilename( expanded, sizeof( expanded ), fileName );
+
+   char expandedBaseline[1024];
+   expandedBaseline[0] = 0;
+   if ( baselineFileName && baselineFileName[0] )
+      Con::expandScriptFilename( expandedBaseline, sizeof( expandedBaseline ), baselineFileName );
+
+   return RenderBenchmark::start( paths, expanded, expandedBaseline, threshold );
+}
+
+DefineEngineFunction( isRenderBenchmarkRunning, bool, (),,
+   "@brief Returns true if a render benchmark is running.\n\n"
+   "@see startRenderBenchmark()\n"
+   "@ingroup Rendering\n" )
+{
+   return RenderBenchmark::isRunning();
+}
@@ -0,0 +1,179 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _APP_RENDERBENCHMARK_H_
+#define _APP_RENDERBENCHMARK_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+#ifndef _TORQUE_STRING_H_
+#include "core/util/str.h"
+#endif
+#ifndef _TDICTIONARY_H_
+#include "core/util/tDictionary.h"
+#endif
+#ifndef _MMATRIX_H_
+#include "math/mMatrix.h"
+#endif
+
+class Stream;
+class SimGroup;
+namespace SimPath { class Path; }
+
+
+/// Benchmarks the CPU side of the render path by flying the camera along
+/// the camera paths of the loaded mission.
+///
+/// The camera paths are sampled once per tick, which gives a fixed list
+/// of camera transforms.  The list is rendered once to warm up materials
+/// and other resources created on first use, then measured over several
+/// passes.  Every measured frame records the time spent
+/// in culling, prepRenderImage, render bin sorting and render bin
+/// submission, see RenderStageStats, along with the draw call, polygon,
+/// state block, render target and shader constant byte counts of the GFX
+/// device and the draw calls there would have been without instancing.
+/// That makes the results comparable between runs and, on the null
+/// device, between machines without a GPU.
+///
+/// When the benchmark is done the percentiles of every series are written
+/// to a JSON file and, if a baseline from an earlier run is given, the
+/// median of each series is compared against it.  Counts are compared
+/// directly, while times are given the spread of their median between the
+/// passes as a noise margin.
+///
+/// @see startRenderBenchmark()
+class RenderBenchmark
+{
+public:
+
+   enum Series
+   {
+      Render,
+      Cull,
+      PrepRenderImage,
+      Sort,
+      RenderBins,
+      DrawCalls,
+      PolyCount,
+      StateBlockChanges,
+      RenderTargetChanges,
+      ShaderConstBytes,
+      UnbatchedDrawCalls,
+      NumSeries
+   };
+
+   /// Percentiles of a series as written to the results file.  Times are
+   /// in milliseconds.
+   struct Summary
+   {
+      F64 mean;
+      F64 p50;
+      F64 p90;
+      F64 p95;
+      F64 p99;
+      F64 max;
+
+      /// How much the median varied between the measured passes.
+      F64 spread;
+   };
+
+   typedef Map<String, Summary> ResultMap;
+
+   /// Starts the benchmark.
+   ///
+   /// @param paths         Space separated names or ids of the Path objects to
+   ///                      fly along.  If empty all the paths in the MissionGroup
+   ///                      are used.
+   /// @param resultsFile   The JSON file the results are written to.
+   /// @param baselineFile  A results file of an earlier run to compare against,
+   ///                      or an empty string.
+   /// @param threshold     How much slower, as a fraction, a series can get before
+   ///                      it is considered a regression.
+   static bool start( const char *paths, const char *resultsFile, const char *baselineFile, F32 threshold );
+
+   static bool isRunning() { return smRunning; }
+
+   /// Replaces @a outMat with the benchmark camera while the benchmark runs.
+   /// @return False if no benchmark is running.
+   static bool getCameraTransform( MatrixF *outMat );
+
+   static const char* getSeriesName( Series series );
+
+   /// Returns true if a series is a time rather than a count.
+   static bool isTimeSeries( Series series ) { return series <= RenderBins; }
+
+   /// Reads the percentiles back from a results file.
+   static bool readResults( Stream &stream, ResultMap &outResults );
+
+   /// Compares the median of every series in @a baseline with @a results.
+   /// A time only regressed if it grew by more than the threshold plus the
+   /// larger spread of the two runs, and by more than a small noise floor.
+   /// @return The number of regressions found, which are described in
+   ///         @a outRegressions if given.
+   static U32 compareResults( const ResultMap &baseline,
+                              const ResultMap &results,
+                              F32 threshold,
+                              Vector<String> *outRegressions = NULL );
+
+protected:
+
+   enum
+   {
+      /// The time between two camera samples.
+      CameraStepMs = 32,
+
+      /// How many times the cameras are rendered after the warmup.
+      MeasuredPasses = 3,
+   };
+
+   static bool smRunning;
+
+   static String smResultsFile;
+   static String smBaselineFile;
+   static F32 smThreshold;
+
+   /// The camera of every frame of a pass.
+   static Vector<MatrixF> smCameras;
+
+   /// The index of the frame being rendered, counting the warmup.
+   static U32 smCurrentFrame;
+
+   static U64 smRenderStart;
+
+   static Vector<U32> smSeries[NumSeries];
+
+   static void _addPath( SimPath::Path *path );
+   static void _addMissionPaths( SimGroup *group );
+
+   static void _beginRender();
+   static void _endRender();
+
+   static void _finish();
+   static bool _writeResults();
+};
+
+#endif // _APP_RENDERBENCHMARK_H_
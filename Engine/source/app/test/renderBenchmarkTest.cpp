@@ -0,0 +1,122 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "app/renderBenchmark.h"
+#include "core/stream/memStream.h"
+
+namespace
+{
+   /// Parses results text as written by RenderBenchmark.
+   bool parseResults(const char *text, RenderBenchmark::ResultMap &results)
+   {
+      MemStream stream(dStrlen(text), (void*)text, true, false);
+      return RenderBenchmark::readResults(stream, results);
+   }
+
+   const char *sBaseline =
+      "{\n"
+      "  \"frames\": 120,\n"
+      "  \"device\": \"null\",\n"
+      "  \"series\": {\n"
+      "    \"cull\": { \"mean\": 1.000, \"p50\": 1.000, \"p90\": 1.200, \"p95\": 1.300, \"p99\": 1.400, \"max\": 2.000, \"spread\": 0.100 },\n"
+      "    \"sort\": { \"mean\": 0.010, \"p50\": 0.010, \"p90\": 0.010, \"p95\": 0.010, \"p99\": 0.010, \"max\": 0.020, \"spread\": 0.000 },\n"
+      "    \"drawCalls\": { \"mean\": 200.000, \"p50\": 200.000, \"p90\": 210.000, \"p95\": 220.000, \"p99\": 230.000, \"max\": 240.000, \"spread\": 0.000 }\n"
+      "  }\n"
+      "}\n";
+}
+
+TEST(RenderBenchmark, ReadResults)
+{
+   RenderBenchmark::ResultMap results;
+   ASSERT_TRUE(parseResults(sBaseline, results));
+   EXPECT_EQ(results.size(), 3);
+
+   RenderBenchmark::ResultMap::Iterator cull = results.find("cull");
+   ASSERT_TRUE(cull != results.end());
+   EXPECT_DOUBLE_EQ(cull->value.p50, 1.0);
+   EXPECT_DOUBLE_EQ(cull->value.p95, 1.3);
+   EXPECT_DOUBLE_EQ(cull->value.max, 2.0);
+   EXPECT_DOUBLE_EQ(cull->value.spread, 0.1);
+
+   // Results without a spread still read.
+   RenderBenchmark::ResultMap old;
+   ASSERT_TRUE(parseResults(
+      "    \"cull\": { \"mean\": 1.000, \"p50\": 1.000, \"p90\": 1.200, \"p95\": 1.300, \"p99\": 1.400, \"max\": 2.000 }\n",
+      old));
+   EXPECT_DOUBLE_EQ(old["cull"].p50, 1.0);
+   EXPECT_DOUBLE_EQ(old["cull"].spread, 0.0);
+
+   RenderBenchmark::ResultMap empty;
+   EXPECT_FALSE(parseResults("{\n}\n", empty));
+}
+
+TEST(RenderBenchmark, CompareResults)
+{
+   RenderBenchmark::ResultMap baseline;
+   ASSERT_TRUE(parseResults(sBaseline, baseline));
+
+   // Identical results pass.
+   EXPECT_EQ(RenderBenchmark::compareResults(baseline, baseline, 0.1f), 0);
+
+   RenderBenchmark::ResultMap results = baseline;
+
+   // Growing within the threshold passes.
+   results["cull"].p50 = 1.05;
+   results["drawCalls"].p50 = 210.0;
+   EXPECT_EQ(RenderBenchmark::compareResults(baseline, results, 0.1f), 0);
+
+   // Growing beyond it, but within the spread between the passes, is noise
+   // for times.  Counts have no noise margin.
+   results["cull"].p50 = 1.15;
+   results["drawCalls"].p50 = 230.0;
+   results["drawCalls"].spread = 20.0;
+   EXPECT_EQ(RenderBenchmark::compareResults(baseline, results, 0.1f), 1);
+
+   // The spread of either run counts.
+   results["cull"].spread = 0.3;
+   results["cull"].p50 = 1.35;
+   EXPECT_EQ(RenderBenchmark::compareResults(baseline, results, 0.1f), 1);
+
+   // Growing beyond both fails, once per series.
+   results["cull"].p50 = 1.5;
+   results["drawCalls"].p50 = 250.0;
+   Vector<String> regressions;
+   EXPECT_EQ(RenderBenchmark::compareResults(baseline, results, 0.1f, &regressions), 2);
+   EXPECT_EQ(regressions.size(), 2);
+
+   // Tiny times doubling is still noise.
+   results = baseline;
+   results["sort"].p50 = 0.02;
+   EXPECT_EQ(RenderBenchmark::compareResults(baseline, results, 0.1f), 0);
+
+   // Getting faster never fails.
+   results["cull"].p50 = 0.5;
+   results["drawCalls"].p50 = 100.0;
+   EXPECT_EQ(RenderBenchmark::compareResults(baseline, results, 0.1f), 0);
+}
+
+#endif
@@ -0,0 +1,257 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "app/timeDemo.h"
+
+#include "core/stream/fileStream.h"
+#include "core/util/journal/process.h"
+#include "console/console.h"
+#include "console/engineAPI.h"
+
+
+bool TimeDemo::smRunning = false;
+String TimeDemo::smFileName;
+Vector<U32> TimeDemo::smFrameTimes;
+Vector<U32> TimeDemo::smSubsystemTimes[NumSubsystems];
+U32 TimeDemo::smCurrentTimes[NumSubsystems];
+U64 TimeDemo::smFrameStart = 0;
+U64 TimeDemo::smRenderStart = 0;
+U64 TimeDemo::smStartTime = 0;
+
+namespace
+{
+   S32 QSORT_CALLBACK compareU32(const U32 *a, const U32 *b)
+   {
+      return (*a > *b) - (*a < *b);
+   }
+
+   /// Returns the value at @a fraction of a sorted list.
+   U32 percentile(const Vector<U32> &sorted, F32 fraction)
+   {
+      if(sorted.empty())
+         return 0;
+      return sorted[getMin(U32(fraction * sorted.size()), U32(sorted.size() - 1))];
+   }
+
+   /// Writes the mean and percentiles of a list of microsecond times,
+   /// in milliseconds, as a JSON object.
+   void writeTimes(Stream &stream, const char *name, Vector<U32> &times, bool last)
+   {
+      times.sort(compareU32);
+
+      F64 total = 0.0;
+      for(U32 i = 0; i < times.size(); i++)
+         total += times[i];
+      const F64 mean = times.empty() ? 0.0 : total / times.size();
+
+      char buffer[512];
+      dSprintf(buffer, sizeof(buffer),
+         "    \"%s\": { \"mean\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f, \"total\": %.3f }%s",
+         name, mean / 1000.0,
+         percentile(times, 0.5f) / 1000.0, percentile(times, 0.9f) / 1000.0,
+         percentile(times, 0.95f) / 1000.0, percentile(times, 0.99f) / 1000.0,
+         percentile(times, 1.0f) / 1000.0, total / 1000.0, last ? "" : ",");
+      stream.writeLine((const U8*)buffer);
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+const char* TimeDemo::getSubsystemName( Subsystem subsystem )
+{
+   static const char *names[NumSubsystems] =
+   {
+      "serverProcess",
+      "serverNet",
+      "simEvents",
+      "clientProcess",
+      "clientNet",
+      "render"
+   };
+
+   return names[subsystem];
+}
+
+bool TimeDemo::start( const char *fileName )
+{
+   if ( smRunning )
+   {
+      Con::errorf( "TimeDemo::start - A time demo is already running!" );
+      return false;
+   }
+
+   // Rendering is timed by bracketing the canvas in the process list.
+   static bool sRenderHooked = false;
+   if ( !sRenderHooked )
+   {
+      Process::notify( &TimeDemo::_beginRender, PROCESS_RENDER_ORDER - 0.01f );
+      Process::notify( &TimeDemo::_endRender, PROCESS_RENDER_ORDER + 0.01f );
+      sRenderHooked = true;
+   }
+
+   smFileName = fileName;
+   smFrameTimes.clear();
+   for ( U32 i = 0; i < NumSubsystems; i++ )
+      smSubsystemTimes[i].clear();
+
+   smFrameStart = 0;
+   smStartTime = Platform::getRealMicroseconds();
+   smRunning = true;
+
+   Con::printf( "TimeDemo::start - Results will be written to '%s'.", fileName );
+   return true;
+}
+
+bool TimeDemo::stop()
+{
+   if ( !smRunning )
+      return false;
+
+   smRunning = false;
+   const U64 totalTime = Platform::getRealMicroseconds() - smStartTime;
+
+   const U32 numFrames = smFrameTimes.size();
+   Con::printf( "TimeDemo::stop - %d frames in %.2f seconds, %.1f fps.",
+      numFrames, F64( totalTime ) / 1000000.0,
+      totalTime ? F64( numFrames ) * 1000000.0 / F64( totalTime ) : 0.0 );
+
+   return _writeResults( totalTime );
+}
+
+void TimeDemo::beginFrame()
+{
+   if ( !smRunning )
+      return;
+
+   dMemset( smCurrentTimes, 0, sizeof( smCurrentTimes ) );
+   smFrameStart = Platform::getRealMicroseconds();
+}
+
+void TimeDemo::endFrame()
+{
+   // The demo may have been started in the middle of a frame.
+   if ( !smRunning || !smFrameStart )
+      return;
+
+   smFrameTimes.push_back( U32( Platform::getRealMicroseconds() - smFrameStart ) );
+   for ( U32 i = 0; i < NumSubsystems; i++ )
+      smSubsystemTimes[i].push_back( smCurrentTimes[i] );
+}
+
+void TimeDemo::addTime( Subsystem subsystem, U64 microseconds )
+{
+   smCurrentTimes[subsystem] += U32( microseconds );
+}
+
+void TimeDemo::_beginRender()
+{
+   if ( smRunning )
+      smRenderStart = Platform::getRealMicroseconds();
+}
+
+void TimeDemo::_endRender()
+{
+   if ( smRunning )
+      addTime( Render, Platform::getRealMicroseconds() - smRenderStart );
+}
+
+bool TimeDemo::_writeResults( U64 totalMicroseconds )
+{
+   FileStream stream;
+   if ( !stream.open( smFileName, Torque::FS::File::Write ) )
+   {
+      Con::errorf( "TimeDemo::_writeResults - Could not open '%s' for writing.", smFileName.c_str() );
+      return false;
+   }
+
+   const U32 numFrames = smFrameTimes.size();
+   const U64 peakMemory = Platform::getPeakMemoryUsage();
+
+   char buffer[256];
+   stream.writeLine( (const U8*)"{" );
+   dSprintf( buffer, sizeof( buffer ), "  \"frames\": %d,", numFrames );
+   stream.writeLine( (const U8*)buffer );
+   dSprintf( buffer, sizeof( buffer ), "  \"seconds\": %.3f,", F64( totalMicroseconds ) / 1000000.0 );
+   stream.writeLine( (const U8*)buffer );
+   dSprintf( buffer, sizeof( buffer ), "  \"fps\": %.2f,",
+      totalMicroseconds ? F64( numFrames ) * 1000000.0 / F64( totalMicroseconds ) : 0.0 );
+   stream.writeLine( (const U8*)buffer );
+   dSprintf( buffer, sizeof( buffer ), "  \"peakMemoryMB\": %.1f,", F64( peakMemory ) / ( 1024.0 * 1024.0 ) );
+   stream.writeLine( (const U8*)buffer );
+
+   // All the times are in milliseconds.
+   stream.writeLine( (const U8*)"  \"frameTimes\": {" );
+   writeTimes( stream, "frame", smFrameTimes, true );
+   stream.writeLine( (const U8*)"  }," );
+
+   stream.writeLine( (const U8*)"  \"subsystemTimes\": {" );
+   for ( U32 i = 0; i < NumSubsystems; i++ )
+      writeTimes( stream, getSubsystemName( (Subsystem)i ), smSubsystemTimes[i], i == NumSubsystems - 1 );
+   stream.writeLine( (const U8*)"  }" );
+
+   stream.writeLine( (const U8*)"}" );
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+DefineEngineFunction( startTimeDemo, bool, ( const char *fileName ),,
+   "@brief Starts benchmarking frames for a demo playback.\n\n"
+
+   "While the time demo runs the main loop does not sleep between frames and "
+   "every frame advances the game by exactly one tick, so a demo recording "
+   "plays back as fast as the frames can be made.  Start it right after "
+   "GameConnection::playDemo().  It stops on its own when the playback "
+   "is complete.\n\n"
+
+   "@param fileName The JSON file the frame and subsystem time percentiles and "
+   "the peak memory use are written to.\n"
+   "@return False if a time demo is already running.\n"
+
+   "@see stopTimeDemo()\n"
+   "@ingroup Platform\n" )
+{
+   char expanded[1024];
+   Con::expandScriptFilename( expanded, sizeof( expanded ), fileName );
+   return TimeDemo::start( expanded );
+}
+
+DefineEngineFunction( stopTimeDemo, bool, (),,
+   "@brief Stops the running time demo and writes its results.\n\n"
+
+   "@return False if no time demo was running or the results could not be written.\n"
+
+   "@see startTimeDemo()\n"
+   "@ingroup Platform\n" )
+{
+   return TimeDemo::stop();
+}
+
+DefineEngineFunction( isTimeDemoRunning, bool, (),,
+   "@brief Returns true if a time demo is running.\n\n"
+   "@see startTimeDemo()\n"
+   "@ingroup Platform\n" )
+{
+   return TimeDemo::isRunning();
+}
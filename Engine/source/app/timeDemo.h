@@ -0,0 +1,125 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _APP_TIMEDEMO_H_
+#define _APP_TIMEDEMO_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+#ifndef _TORQUE_STRING_H_
+#include "core/util/str.h"
+#endif
+
+
+/// Benchmarks the engine by playing back a recorded demo as fast as the
+/// frames can be produced.
+///
+/// While a time demo runs every frame advances the simulation by exactly
+/// one tick and the main loop stops sleeping between frames, so the same
+/// recording always produces the same frames no matter how fast the
+/// machine is.  The time each frame took, split up by subsystem, is kept
+/// and when the demo is done the percentiles and the peak memory use of
+/// the process are written to a JSON file.
+///
+/// @see startTimeDemo()
+class TimeDemo
+{
+public:
+
+   enum Subsystem
+   {
+      ServerProcess,
+      ServerNet,
+      SimEvents,
+      ClientProcess,
+      ClientNet,
+      Render,
+      NumSubsystems
+   };
+
+   /// Adds the time of a subsystem to the current frame.
+   class Scope
+   {
+      Subsystem mSubsystem;
+      U64 mStart;
+
+   public:
+
+      Scope( Subsystem subsystem )
+         : mSubsystem( subsystem ),
+           mStart( TimeDemo::isRunning() ? Platform::getRealMicroseconds() : 0 )
+      {
+      }
+
+      ~Scope()
+      {
+         if ( TimeDemo::isRunning() )
+            TimeDemo::addTime( mSubsystem, Platform::getRealMicroseconds() - mStart );
+      }
+   };
+
+   /// Starts collecting frame times.  The results go to @a fileName
+   /// once stop() is called.
+   static bool start( const char *fileName );
+
+   /// Stops the time demo and writes the results.
+   /// @return False if the results could not be written.
+   static bool stop();
+
+   static bool isRunning() { return smRunning; }
+
+   /// Called by the main loop around each frame.
+   static void beginFrame();
+   static void endFrame();
+
+   /// Adds @a microseconds to a subsystem of the current frame.
+   static void addTime( Subsystem subsystem, U64 microseconds );
+
+   static const char* getSubsystemName( Subsystem subsystem );
+
+protected:
+
+   static bool smRunning;
+
+   static String smFileName;
+
+   /// Microseconds of each frame and of each subsystem in each frame.
+   static Vector<U32> smFrameTimes;
+   static Vector<U32> smSubsystemTimes[NumSubsystems];
+
+   static U32 smCurrentTimes[NumSubsystems];
+   static U64 smFrameStart;
+   static U64 smRenderStart;
+   static U64 smStartTime;
+
+   static void _beginRender();
+   static void _endRender();
+
+   static bool _writeResults( U64 totalMicroseconds );
+};
+
+#endif // _APP_TIMEDEMO_H_
@@ -34,10 +34,9 @@
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 
-static DataChunker sChunker;
+static ClassChunker<CollisionStateList> sStateListChunker;
+static ClassChunker<CollisionWorkingList> sWorkingListChunker;
 
-CollisionStateList CollisionStateList::sFreeList;
-CollisionWorkingList CollisionWorkingList::sFreeList;
 F32 sqrDistanceEdges(const Point3F& start0,
                      const Point3F& end0,
                      const Point3F& start1,
@@ -260,19 +259,13 @@ void CollisionStateList::unlink()
 
 CollisionStateList* CollisionStateList::alloc()
 {
-   if (!sFreeList.isEmpty()) {
-      CollisionStateList* nxt = sFreeList.mNext;
-      nxt->unlink();
-      nxt->mState = NULL;
-      return nxt;
-   }
-   return constructInPlace((CollisionStateList*)sChunker.alloc(sizeof(CollisionStateList)));
+   return sStateListChunker.alloc();
 }
 
 void CollisionStateList::free()
 {
    unlink();
-   linkAfter(&sFreeList);
+   sStateListChunker.free(this);
 }
 
 
@@ -313,18 +306,13 @@ void CollisionWorkingList::unlink()
 
 CollisionWorkingList* CollisionWorkingList::alloc()
 {
-   if (sFreeList.wLink.mNext != &sFreeList) {
-      CollisionWorkingList* nxt = sFreeList.wLink.mNext;
-      nxt->unlink();
-      return nxt;
-   }
-   return constructInPlace((CollisionWorkingList*)sChunker.alloc(sizeof(CollisionWorkingList)));
+   return sWorkingListChunker.alloc();
 }
 
 void CollisionWorkingList::free()
 {
    unlink();
-   wLinkAfter(&sFreeList);
+   sWorkingListChunker.free(this);
 }
 
 
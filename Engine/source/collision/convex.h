@@ -120,7 +120,6 @@ struct CollisionState
 
 struct CollisionStateList
 {
-   static CollisionStateList sFreeList;
    CollisionStateList* mNext;
    CollisionStateList* mPrev;
    CollisionState* mState;
@@ -140,7 +139,6 @@ struct CollisionStateList
 
 struct CollisionWorkingList
 {
-   static CollisionWorkingList sFreeList;
    struct WLink {
       CollisionWorkingList* mNext;
       CollisionWorkingList* mPrev;
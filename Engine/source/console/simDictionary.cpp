@@ -25,21 +25,13 @@
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
-extern U32 HashPointer(StringTableEntry e);
-
 SimNameDictionary::SimNameDictionary()
 {
-#ifndef USE_NEW_SIMDICTIONARY
-   hashTable = NULL;
-#endif
    mutex = Mutex::createMutex();
 }
 
 SimNameDictionary::~SimNameDictionary()
 {
-#ifndef USE_NEW_SIMDICTIONARY
-   delete[] hashTable;
-#endif
    Mutex::destroyMutex(mutex);
 }
 
@@ -55,50 +47,10 @@ void SimNameDictionary::insert(SimObject* obj)
 
    Mutex::lockMutex(mutex);
 #ifndef USE_NEW_SIMDICTIONARY
-   if(!hashTable)
-   {
-      hashTable = new SimObject *[DefaultTableSize];
-      hashTableSize = DefaultTableSize;
-      hashEntryCount = 0;
-      
-      dMemset( hashTable, 0, sizeof( *hashTable ) * DefaultTableSize );
-   }
-   
-   S32 idx = HashPointer(obj->objectName) % hashTableSize;
-   obj->nextNameObject = hashTable[idx];
-   hashTable[idx] = obj;
-   hashEntryCount++;
-   
-   // Rehash if necessary.
-
-   if( hashEntryCount > hashTableSize )
-   {
-      // Allocate new table.
-      
-      U32 newHashTableSize = hashTableSize * 2 + 1;
-      SimObject** newHashTable = new SimObject *[ newHashTableSize ];
-      dMemset( newHashTable, 0, sizeof( newHashTable[ 0 ] ) * newHashTableSize );
-      
-      // Move entries over.
-
-      for( U32 i = 0; i < hashTableSize; ++ i )
-         for( SimObject* object = hashTable[ i ]; object != NULL; )
-         {
-            SimObject* next = object->nextNameObject;
-
-            idx = HashPointer( object->objectName ) % newHashTableSize;
-            object->nextNameObject = newHashTable[ idx ];
-            newHashTable[ idx ] = object;
-            
-            object = next;
-         }
-         
-      // Switch tables.
-      
-      delete [] hashTable;
-      hashTable = newHashTable;
-      hashTableSize = newHashTableSize;
-   }
+   // The newest object registered under a name shadows the older ones,
+   // which stay chained behind it and get the name back when it goes.
+   obj->nextNameObject = root.find(obj->objectName);
+   root.insert(obj->objectName, obj);
 #else
    root[obj->objectName] = obj;
 #endif
@@ -108,26 +60,9 @@ void SimNameDictionary::insert(SimObject* obj)
 SimObject* SimNameDictionary::find(StringTableEntry name)
 {
 #ifndef USE_NEW_SIMDICTIONARY
-   // NULL is a valid lookup - it will always return NULL
-   if(!hashTable)
-      return NULL;
-      
-   Mutex::lockMutex(mutex);
-
-   S32 idx = HashPointer(name) % hashTableSize;
-   SimObject *walk = hashTable[idx];
-   while(walk)
-   {
-      if(walk->objectName == name)
-      {
-         Mutex::unlockMutex(mutex);
-         return walk;
-      }
-      walk = walk->nextNameObject;
-   }
-
-   Mutex::unlockMutex(mutex);
-   return NULL;
+   // NULL is a valid lookup - it will always return NULL.  Lookups
+   // don't need the mutex.
+   return root.find(name);
 #else
   Mutex::lockMutex(mutex);
   StringDictDef::iterator it = root.find(name);
@@ -144,20 +79,26 @@ void SimNameDictionary::remove(SimObject* obj)
 
    Mutex::lockMutex(mutex);
 #ifndef USE_NEW_SIMDICTIONARY
-   SimObject **walk = &hashTable[HashPointer(obj->objectName) % hashTableSize];
-   while(*walk)
+   SimObject* head = root.find(obj->objectName);
+   if (head == obj)
+   {
+      if (obj->nextNameObject)
+         root.insert(obj->objectName, obj->nextNameObject);
+      else
+         root.remove(obj->objectName, obj);
+   }
+   else
    {
-      if(*walk == obj)
+      for (SimObject* walk = head; walk; walk = walk->nextNameObject)
       {
-         *walk = obj->nextNameObject;
-			obj->nextNameObject = (SimObject*)-1;
-         hashEntryCount--;
-
-         Mutex::unlockMutex(mutex);
-         return;
+         if (walk->nextNameObject == obj)
+         {
+            walk->nextNameObject = obj->nextNameObject;
+            break;
+         }
       }
-      walk = &((*walk)->nextNameObject);
    }
+   obj->nextNameObject = (SimObject*)-1;
 #else
    const char* name = obj->objectName;
    if (root.find(name) != root.end())
@@ -170,21 +111,11 @@ void SimNameDictionary::remove(SimObject* obj)
 
 SimManagerNameDictionary::SimManagerNameDictionary()
 {
-#ifndef USE_NEW_SIMDICTIONARY
-   hashTable = new SimObject *[DefaultTableSize];
-   hashTableSize = DefaultTableSize;
-   hashEntryCount = 0;
-   
-   dMemset( hashTable, 0, sizeof( hashTable[ 0 ] ) * hashTableSize );
-#endif
    mutex = Mutex::createMutex();
 }
 
 SimManagerNameDictionary::~SimManagerNameDictionary()
 {
-#ifndef USE_NEW_SIMDICTIONARY
-   delete[] hashTable;
-#endif
    Mutex::destroyMutex(mutex);
 }
 
@@ -195,41 +126,10 @@ void SimManagerNameDictionary::insert(SimObject* obj)
 
    Mutex::lockMutex(mutex);
 #ifndef USE_NEW_SIMDICTIONARY
-   S32 idx = HashPointer(obj->objectName) % hashTableSize;
-   obj->nextManagerNameObject = hashTable[idx];
-   hashTable[idx] = obj;
-   hashEntryCount++;
-   
-   // Rehash if necessary.
-
-   if( hashEntryCount > hashTableSize )
-   {
-      // Allocate new table.
-      
-      U32 newHashTableSize = hashTableSize * 2 + 1;
-      SimObject** newHashTable = new SimObject *[ newHashTableSize ];
-      dMemset( newHashTable, 0, sizeof( newHashTable[ 0 ] ) * newHashTableSize );
-      
-      // Move entries over.
-
-      for( U32 i = 0; i < hashTableSize; ++ i )
-         for( SimObject* object = hashTable[ i ]; object != NULL; )
-         {
-            SimObject* next = object->nextManagerNameObject;
-
-            idx = HashPointer( object->objectName ) % newHashTableSize;
-            object->nextManagerNameObject = newHashTable[ idx ];
-            newHashTable[ idx ] = object;
-            
-            object = next;
-         }
-         
-      // Switch tables.
-      
-      delete [] hashTable;
-      hashTable = newHashTable;
-      hashTableSize = newHashTableSize;
-   }
+   // The newest object registered under a name shadows the older ones,
+   // which stay chained behind it and get the name back when it goes.
+   obj->nextManagerNameObject = root.find(obj->objectName);
+   root.insert(obj->objectName, obj);
 #else
    root[obj->objectName] = obj;
 #endif
@@ -240,24 +140,10 @@ SimObject* SimManagerNameDictionary::find(StringTableEntry name)
 {
    // NULL is a valid lookup - it will always return NULL
 
-   Mutex::lockMutex(mutex);
-
 #ifndef USE_NEW_SIMDICTIONARY
-   S32 idx = HashPointer(name) % hashTableSize;
-   SimObject *walk = hashTable[idx];
-   while(walk)
-   {
-      if(walk->objectName == name)
-      {
-         Mutex::unlockMutex(mutex);
-         return walk;
-      }
-      walk = walk->nextManagerNameObject;
-   }
-   Mutex::unlockMutex(mutex);
-
-   return NULL;
+   return root.find(name);
 #else
+   Mutex::lockMutex(mutex);
    StringDictDef::iterator it = root.find(name);
    SimObject* f = (it == root.end() ? NULL : it->second);
    Mutex::unlockMutex(mutex);
@@ -270,23 +156,28 @@ void SimManagerNameDictionary::remove(SimObject* obj)
    if(!obj || !obj->objectName)
       return;
 
-#ifndef USE_NEW_SIMDICTIONARY
    Mutex::lockMutex(mutex);
-
-   SimObject **walk = &hashTable[HashPointer(obj->objectName) % hashTableSize];
-   while(*walk)
+#ifndef USE_NEW_SIMDICTIONARY
+   SimObject* head = root.find(obj->objectName);
+   if (head == obj)
+   {
+      if (obj->nextManagerNameObject)
+         root.insert(obj->objectName, obj->nextManagerNameObject);
+      else
+         root.remove(obj->objectName, obj);
+   }
+   else
    {
-      if(*walk == obj)
+      for (SimObject* walk = head; walk; walk = walk->nextManagerNameObject)
       {
-         *walk = obj->nextManagerNameObject;
-			obj->nextManagerNameObject = (SimObject*)-1;
-         hashEntryCount--;
-
-         Mutex::unlockMutex(mutex);
-         return;
+         if (walk->nextManagerNameObject == obj)
+         {
+            walk->nextManagerNameObject = obj->nextManagerNameObject;
+            break;
+         }
       }
-      walk = &((*walk)->nextManagerNameObject);
    }
+   obj->nextManagerNameObject = (SimObject*)-1;
 #else
    StringTableEntry name = obj->objectName;
    if (root.find(name) != root.end())
@@ -300,9 +191,6 @@ void SimManagerNameDictionary::remove(SimObject* obj)
 
 SimIdDictionary::SimIdDictionary()
 {
-#ifndef USE_NEW_SIMDICTIONARY
-   dMemset( table, 0, sizeof( table[ 0 ] ) * DefaultTableSize );
-#endif
    mutex = Mutex::createMutex();
 }
 
@@ -320,10 +208,8 @@ void SimIdDictionary::insert(SimObject* obj)
 
    Mutex::lockMutex(mutex);
 #ifndef USE_NEW_SIMDICTIONARY
-   S32 idx = obj->getId() & TableBitMask;
-   obj->nextIdObject = table[idx];
-   AssertFatal( obj->nextIdObject != obj, "SimIdDictionary::insert - Creating Infinite Loop linking to self!" );
-   table[idx] = obj;
+   AssertFatal( obj->getId() != 0, "SimIdDictionary::insert - Object has no id!" );
+   root.insert(obj->getId(), obj);
 #else
    root[obj->getId()] = obj;
 #endif
@@ -332,23 +218,11 @@ void SimIdDictionary::insert(SimObject* obj)
 
 SimObject* SimIdDictionary::find(S32 id)
 {
-   Mutex::lockMutex(mutex);
 #ifndef USE_NEW_SIMDICTIONARY
-   S32 idx = id & TableBitMask;
-   SimObject *walk = table[idx];
-   while(walk)
-   {
-      if(walk->getId() == U32(id))
-      {
-         Mutex::unlockMutex(mutex);
-         return walk;
-      }
-      walk = walk->nextIdObject;
-   }
-   Mutex::unlockMutex(mutex);
-
-   return NULL;
+   // Lookups don't need the mutex.
+   return root.find(U32(id));
 #else
+   Mutex::lockMutex(mutex);
    SimObjectIdDictDef::iterator it = root.find(id);
    SimObject* f = (it == root.end() ? NULL : it->second);
    Mutex::unlockMutex(mutex);
@@ -363,11 +237,7 @@ void SimIdDictionary::remove(SimObject* obj)
 
    Mutex::lockMutex(mutex);
 #ifndef USE_NEW_SIMDICTIONARY
-   SimObject **walk = &table[obj->getId() & TableBitMask];
-   while(*walk && *walk != obj)
-      walk = &((*walk)->nextIdObject);
-   if(*walk)
-      *walk = obj->nextIdObject;
+   root.remove(obj->getId(), obj);
 #else
    root.erase(obj->getId());
 #endif
@@ -63,6 +63,33 @@ struct StringTableEntryEq
 
 typedef std::unordered_map<StringTableEntry, SimObject*, StringTableEntryHash, StringTableEntryEq> StringDictDef;	
 typedef std::unordered_map<SimObjectId, SimObject*> SimObjectIdDictDef;
+#else
+#ifndef _TCONCURRENTHASHTABLE_H_
+#include "core/util/tConcurrentHashTable.h"
+#endif
+
+struct SimNameDictionaryHash
+{
+   static inline U32 hash(StringTableEntry name)
+   {
+      // String table entries are at least 4 byte aligned; mix the
+      // remaining bits since the table masks off the low ones.
+      U32 h = U32(uintptr_t(name) >> 2);
+      h ^= h >> 16;
+      h *= 0x45d9f3b;
+      h ^= h >> 16;
+      return h;
+   }
+};
+
+struct SimIdDictionaryHash
+{
+   /// Ids are handed out sequentially, so they spread perfectly as is.
+   static inline U32 hash(U32 id) { return id; }
+};
+
+typedef ConcurrentHashTable<StringTableEntry, SimObject*, SimNameDictionaryHash> StringDictDef;
+typedef ConcurrentHashTable<U32, SimObject*, SimIdDictionaryHash> SimObjectIdDictDef;
 #endif
 
 //----------------------------------------------------------------------------
@@ -70,20 +97,12 @@ typedef std::unordered_map<SimObjectId, SimObject*> SimObjectIdDictDef;
 ///
 /// Provides fast lookup for name->object and
 /// for fast removal of an object given object*
+///
+/// Unless USE_NEW_SIMDICTIONARY is defined, lookups are lock-free and only
+/// insertion and removal take the mutex.
 class SimNameDictionary
 {
-#ifndef USE_NEW_SIMDICTIONARY
-   enum
-   {
-      DefaultTableSize = 29
-   };
-
-   SimObject **hashTable;  // hash the pointers of the names...
-   S32 hashTableSize;
-   S32 hashEntryCount;
-#else
    StringDictDef root;
-#endif
 
    void *mutex;
 
@@ -98,18 +117,7 @@ public:
 
 class SimManagerNameDictionary
 {
-#ifndef USE_NEW_SIMDICTIONARY
-   enum
-   {
-      DefaultTableSize = 29
-   };
-
-   SimObject **hashTable;  // hash the pointers of the names...
-   S32 hashTableSize;
-   S32 hashEntryCount;
-#else
    StringDictDef root;
-#endif
 
    void *mutex;
 
@@ -127,18 +135,12 @@ public:
 ///
 /// Provides fast lookup for ID->object and
 /// for fast removal of an object given object*
+///
+/// Unless USE_NEW_SIMDICTIONARY is defined, lookups are lock-free and only
+/// insertion and removal take the mutex.
 class SimIdDictionary
 {
-#ifndef USE_NEW_SIMDICTIONARY
-   enum
-   {
-      DefaultTableSize = 4096,
-      TableBitMask = 4095
-   };
-   SimObject *table[DefaultTableSize];
-#else
    SimObjectIdDictDef root;
-#endif
 
    void *mutex;
 
@@ -259,6 +259,11 @@ void advanceToTime(SimTime targetTime)
 	gCurrentTime = targetTime;
 
    Mutex::unlockMutex(gEventQueueMutex);
+
+#ifndef USE_NEW_SIMDICTIONARY
+   // Free dictionary tables that no lock-free lookup can still be reading.
+   ConcurrentHashTableBase::collectRetired();
+#endif
 }
 
 void advanceTime(SimTime delta)
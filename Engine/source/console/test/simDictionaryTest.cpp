@@ -0,0 +1,67 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "console/simBase.h"
+
+TEST(SimDictionary, DuplicateNames)
+{
+   // Objects sharing a name: the newest one is found, and when it goes
+   // the name falls back to the next newest that is still around.
+
+   SimGroup *group = new SimGroup();
+   group->registerObject();
+
+   SimObject *objects[3];
+   for (U32 i = 0; i < 3; i++)
+   {
+      objects[i] = new SimObject();
+      objects[i]->registerObject("SimDictionaryDuplicateTest");
+      group->addObject(objects[i]);
+   }
+
+   EXPECT_EQ(Sim::findObject("SimDictionaryDuplicateTest"), objects[2]);
+   EXPECT_EQ(group->findObject("SimDictionaryDuplicateTest"), objects[2]);
+
+   // Removing an older object leaves the newest in place.
+   objects[1]->deleteObject();
+   EXPECT_EQ(Sim::findObject("SimDictionaryDuplicateTest"), objects[2]);
+   EXPECT_EQ(group->findObject("SimDictionaryDuplicateTest"), objects[2]);
+
+   // Removing the newest hands the name back to the oldest.
+   objects[2]->deleteObject();
+   EXPECT_EQ(Sim::findObject("SimDictionaryDuplicateTest"), objects[0])
+      << "The name should fall back to the older object";
+   EXPECT_EQ(group->findObject("SimDictionaryDuplicateTest"), objects[0])
+      << "The name should fall back to the older object";
+
+   objects[0]->deleteObject();
+   EXPECT_TRUE(Sim::findObject("SimDictionaryDuplicateTest") == NULL);
+   EXPECT_TRUE(group->findObject("SimDictionaryDuplicateTest") == NULL);
+
+   group->deleteObject();
+}
+
+#endif
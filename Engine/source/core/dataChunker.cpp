@@ -30,6 +30,7 @@ DataChunker::DataChunker(S32 size)
 {
    mChunkSize          = size;
    mCurBlock           = NULL;
+   mSpareBlock         = NULL;
 }
 
 DataChunker::~DataChunker()
@@ -57,7 +58,11 @@ void *DataChunker::alloc(S32 size)
 
    if(!mCurBlock || size + mCurBlock->curIndex > mChunkSize)
    {
-      DataBlock *temp = new DataBlock(mChunkSize);
+      DataBlock *temp = mSpareBlock;
+      if(temp)
+         mSpareBlock = temp->next;
+      else
+         temp = new DataBlock(mChunkSize);
       temp->next = mCurBlock;
       temp->curIndex = 0;
       mCurBlock = temp;
@@ -69,6 +74,10 @@ void *DataChunker::alloc(S32 size)
 }
 
 DataChunker::DataBlock::DataBlock(S32 size)
+   : prev(NULL),
+     next(NULL),
+     size(size),
+     curIndex(0)
 {
    data = new U8[size];
 }
@@ -93,5 +102,28 @@ void DataChunker::freeBlocks(bool keepOne)
    }
    else if (mCurBlock)
       mCurBlock->curIndex = 0;
+
+   while(mSpareBlock)
+   {
+      DataBlock *temp = mSpareBlock->next;
+      delete mSpareBlock;
+      mSpareBlock = temp;
+   }
+}
+
+void DataChunker::reset()
+{
+   while(mCurBlock)
+   {
+      DataBlock *temp = mCurBlock->next;
+      if(mCurBlock->size == mChunkSize)
+      {
+         mCurBlock->next = mSpareBlock;
+         mSpareBlock = mCurBlock;
+      }
+      else
+         delete mCurBlock;
+      mCurBlock = temp;
+   }
 }
 
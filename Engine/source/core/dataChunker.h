@@ -26,6 +26,12 @@
 #ifndef _PLATFORM_H_
 #  include "platform/platform.h"
 #endif
+#ifndef _PLATFORMTLS_H_
+#  include "platform/platformTLS.h"
+#endif
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#  include "platform/threads/mutex.h"
+#endif
 
 //----------------------------------------------------------------------------
 /// Implements a chunked data allocator.
@@ -42,7 +48,7 @@
 ///
 /// Note that new/free/realloc WILL NOT WORK on memory gotten from the
 /// DataChunker. This also only grows (you can call freeBlocks to deallocate
-/// and reset things).
+/// and reset things, or reset to start over while keeping the blocks).
 class DataChunker
 {
 public:
@@ -64,6 +70,13 @@ public:
    /// This invalidates all pointers returned from alloc().
    void freeBlocks(bool keepOne = false);
 
+   /// Rewind the chunker while keeping its memory blocks for reuse.
+   ///
+   /// Like freeBlocks(), this invalidates all pointers returned from alloc(),
+   /// but subsequent allocations are served from the retained blocks rather
+   /// than the heap.  Oversized blocks are released.
+   void reset();
+
    /// Initialize using blocks of a given size.
    ///
    /// One new block is allocated at constructor-time.
@@ -79,6 +92,10 @@ public:
       DataBlock *temp = d.mCurBlock;
       d.mCurBlock = mCurBlock;
       mCurBlock = temp;
+
+      temp = d.mSpareBlock;
+      d.mSpareBlock = mSpareBlock;
+      mSpareBlock = temp;
    }
    
 private:
@@ -90,6 +107,7 @@ private:
       DataBlock* prev;
       DataBlock* next;        ///< linked list pointer to the next DataBlock for this chunker
       U8 *data;               ///< allocated pointer for the base of this page
+      S32 size;               ///< size of this page in bytes
       S32 curIndex;           ///< current allocation point within this DataBlock
       DataBlock(S32 size);
       ~DataBlock();
@@ -99,6 +117,7 @@ private:
    DataBlock   *mCurBlock;    ///< current page we're allocating data from.  If the
                               ///< data size request is greater than the memory space currently
                               ///< available in the current page, a new page will be allocated.
+   DataBlock   *mSpareBlock;  ///< pages retained by reset() waiting to be reused.
    S32         mChunkSize;    ///< The size allocated for each page in the DataChunker
 };
 
@@ -131,6 +150,87 @@ public:
 
 //----------------------------------------------------------------------------
 
+/// A MultiTypedChunker for memory that is thrown away all at once, like
+/// per-frame render instances.
+///
+/// reset() hands all memory back in one go but keeps the underlying blocks,
+/// so an arena that is reset every frame settles at its high water mark and
+/// stops touching the heap.  Objects allocated with construct() also have
+/// their destructors run, in reverse order of construction, on reset().
+class ArenaChunker : private DataChunker
+{
+public:
+   ArenaChunker(S32 size = DataChunker::ChunkSize)
+      : DataChunker(size),
+        mDestructors(NULL)
+   {
+   }
+
+   ~ArenaChunker()
+   {
+      _destructAll();
+   }
+
+   /// Allocate uninitialized memory.  Use like so:  MyType* t = arena.alloc<MyType>();
+   template<typename T>
+   T* alloc()  { return reinterpret_cast<T*>(DataChunker::alloc(S32(sizeof(T)))); }
+
+   /// Allocate uninitialized memory for count elements.
+   template<typename T>
+   T* allocArray(U32 count)  { return reinterpret_cast<T*>(DataChunker::alloc(S32(sizeof(T) * count))); }
+
+   /// Allocate and default construct an object.  Its destructor is run by reset().
+   template<typename T>
+   T* construct()
+   {
+      DestructorRecord* record = alloc<DestructorRecord>();
+      T* object = constructInPlace(alloc<T>());
+
+      record->mNext = mDestructors;
+      record->mDestruct = &_destruct<T>;
+      record->mObject = object;
+      mDestructors = record;
+
+      return object;
+   }
+
+   /// Release everything allocated from the arena while keeping its memory.
+   void reset()
+   {
+      _destructAll();
+      DataChunker::reset();
+   }
+
+   /// Release everything allocated from the arena along with its memory.
+   void freeBlocks(bool keepOne = false)
+   {
+      _destructAll();
+      DataChunker::freeBlocks(keepOne);
+   }
+
+private:
+   struct DestructorRecord
+   {
+      DestructorRecord* mNext;
+      void (*mDestruct)(void*);
+      void* mObject;
+   };
+
+   template<typename T>
+   static void _destruct(void* object)  { destructInPlace(reinterpret_cast<T*>(object)); }
+
+   void _destructAll()
+   {
+      for(DestructorRecord* record = mDestructors; record != NULL; record = record->mNext)
+         record->mDestruct(record->mObject);
+      mDestructors = NULL;
+   }
+
+   DestructorRecord* mDestructors;  ///< Most recently constructed object first.
+};
+
+//----------------------------------------------------------------------------
+
 /// Templatized data chunker class with proper construction and destruction of its elements.
 ///
 /// DataChunker just allocates space. This subclass actually constructs/destructs the
@@ -294,4 +394,87 @@ private:
    const U32   mElementSize;
    void        *mFreeListHead;
 };
+
+//----------------------------------------------------------------------------
+
+/// Gives every thread its own instance of a chunker so that any of the
+/// chunker classes above can be used from worker threads without locking.
+///
+/// Instances are created on first use by a thread and live until the
+/// ThreadLocalChunker is destroyed.  Memory must be freed through the
+/// instance, and therefore on the thread, that allocated it.
+///
+/// @code
+/// static ThreadLocalChunker< ClassChunker< MyType > > smPool;
+///
+/// MyType* t = smPool.get().alloc();
+/// ...
+/// smPool.get().free( t );
+/// @endcode
+template<class C>
+class ThreadLocalChunker
+{
+public:
+   ThreadLocalChunker()
+      : mInstances( NULL )
+   {
+   }
+
+   ~ThreadLocalChunker()
+   {
+      while( mInstances )
+      {
+         Instance* next = mInstances->mNext;
+         delete mInstances;
+         mInstances = next;
+      }
+   }
+
+   /// Return the calling thread's chunker.
+   C& get()
+   {
+      Instance* instance = reinterpret_cast< Instance* >( mStorage.get() );
+      if( !instance )
+         instance = _create();
+      return instance->mChunker;
+   }
+
+   /// Return the number of threads that have used this chunker.
+   U32 getNumInstances()
+   {
+      MutexHandle lock;
+      lock.lock( &mMutex, true );
+
+      U32 count = 0;
+      for( Instance* instance = mInstances; instance != NULL; instance = instance->mNext )
+         count ++;
+      return count;
+   }
+
+private:
+   struct Instance
+   {
+      C mChunker;
+      Instance* mNext;
+   };
+
+   Instance* _create()
+   {
+      Instance* instance = new Instance;
+
+      MutexHandle lock;
+      lock.lock( &mMutex, true );
+      instance->mNext = mInstances;
+      mInstances = instance;
+      lock.unlock();
+
+      mStorage.set( instance );
+      return instance;
+   }
+
+   ThreadStorage mStorage;
+   Mutex mMutex;
+   Instance* mInstances;
+};
+
 #endif
@@ -22,16 +22,188 @@
 
 #include "core/frameAllocator.h"
 #include "console/console.h"
+#include "console/engineAPI.h"
+#include "platform/threads/mutex.h"
+#include "platform/threads/thread.h"
 
-U8*   FrameAllocator::smBuffer = NULL;
-U32   FrameAllocator::smWaterMark = 0;
-U32   FrameAllocator::smHighWaterMark = 0;
+FrameAllocatorArena* FrameAllocator::smMainArena = NULL;
+U32 FrameAllocator::smWorkerFrameSize = 0;
+FRAMEALLOCATOR_THREAD_LOCAL FrameAllocatorArena* FrameAllocator::smThreadArena = NULL;
 
-#ifdef TORQUE_DEBUG
-U32   FrameAllocator::smMaxFrameAllocation = 0;
+/// Guards the arena lists below.
+static Mutex sgArenaMutex;
 
-ConsoleFunction(getMaxFrameAllocation, S32, 1,1, "getMaxFrameAllocation();")
+/// Arenas currently owned by a thread.
+static FrameAllocatorArena* sgActiveArenas = NULL;
+
+/// Worker arenas returned through releaseThreadArena().
+static FrameAllocatorArena* sgFreeArenas = NULL;
+
+//-----------------------------------------------------------------------------
+
+FrameAllocatorArena::FrameAllocatorArena( const U32 size )
+   : mBuffer( new U8[ size ] ),
+     mHighWaterMark( size ),
+     mWaterMark( 0 ),
+     mMaxAllocation( 0 ),
+     mThreadId( 0 ),
+     mNext( NULL )
 {
-   return FrameAllocator::getMaxFrameAllocation();
 }
+
+FrameAllocatorArena::~FrameAllocatorArena()
+{
+   delete [] mBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::init( const U32 frameSize, const U32 workerFrameSize )
+{
+#ifdef FRAMEALLOCATOR_DEBUG_GUARD
+   AssertISV( false, "FRAMEALLOCATOR_DEBUG_GUARD has been removed because it allows non-contiguous memory allocation by the FrameAllocator, and this is *not* ok." );
 #endif
+
+   AssertFatal( smMainArena == NULL, "Error, already initialized" );
+
+   smWorkerFrameSize = workerFrameSize;
+   smMainArena = new FrameAllocatorArena( frameSize );
+   smMainArena->mThreadId = ThreadManager::getCurrentThreadId();
+
+   sgArenaMutex.lock();
+   smMainArena->mNext = sgActiveArenas;
+   sgActiveArenas = smMainArena;
+   sgArenaMutex.unlock();
+
+   smThreadArena = smMainArena;
+}
+
+void FrameAllocator::destroy()
+{
+   AssertFatal( smMainArena != NULL, "Error, not initialized" );
+   AssertFatal( smThreadArena == smMainArena, "FrameAllocator::destroy - must be called on the thread that called init()" );
+
+   sgArenaMutex.lock();
+
+   FrameAllocatorArena* lists[] = { sgActiveArenas, sgFreeArenas };
+   for( U32 i = 0; i < 2; ++ i )
+   {
+      FrameAllocatorArena* arena = lists[ i ];
+      while( arena )
+      {
+         FrameAllocatorArena* next = arena->mNext;
+         delete arena;
+         arena = next;
+      }
+   }
+
+   sgActiveArenas = NULL;
+   sgFreeArenas = NULL;
+   smMainArena = NULL;
+
+   sgArenaMutex.unlock();
+
+   // Arenas still referenced by other threads' storage are dangling now;
+   // those threads must be gone by the time we get here.
+   smThreadArena = NULL;
+}
+
+FrameAllocatorArena* FrameAllocator::_acquireThreadArena()
+{
+   AssertFatal( smMainArena != NULL, "FrameAllocator::_acquireThreadArena - not initialized" );
+
+   sgArenaMutex.lock();
+
+   // Reuse an arena from a thread that has exited, if possible.
+
+   FrameAllocatorArena* arena = sgFreeArenas;
+   if( arena )
+      sgFreeArenas = arena->mNext;
+   else
+      arena = new FrameAllocatorArena( smWorkerFrameSize );
+
+   arena->mWaterMark = 0;
+   arena->mThreadId = ThreadManager::getCurrentThreadId();
+   arena->mNext = sgActiveArenas;
+   sgActiveArenas = arena;
+
+   sgArenaMutex.unlock();
+
+   smThreadArena = arena;
+   return arena;
+}
+
+void FrameAllocator::releaseThreadArena()
+{
+   FrameAllocatorArena* arena = smThreadArena;
+   if( !arena || arena == smMainArena )
+      return;
+
+   AssertFatal( arena->mWaterMark == 0, "FrameAllocator::releaseThreadArena - thread still has live frame allocations" );
+
+   sgArenaMutex.lock();
+
+   FrameAllocatorArena** link = &sgActiveArenas;
+   while( *link && *link != arena )
+      link = &( *link )->mNext;
+
+   if( *link )
+      *link = arena->mNext;
+
+   arena->mThreadId = 0;
+   arena->mNext = sgFreeArenas;
+   sgFreeArenas = arena;
+
+   sgArenaMutex.unlock();
+
+   smThreadArena = NULL;
+}
+
+void FrameAllocator::dumpArenas()
+{
+   sgArenaMutex.lock();
+
+   U32 numArenas = 0;
+   U32 totalSize = 0;
+
+   Con::printf( "FrameAllocator arenas:" );
+   for( FrameAllocatorArena* arena = sgActiveArenas; arena != NULL; arena = arena->mNext )
+   {
+      Con::printf( "   thread %-10u %s  in use: %9u  peak: %9u  size: %9u",
+         arena->getThreadId(),
+         arena == smMainArena ? "(main)" : "      ",
+         arena->getWaterMark(),
+         arena->getMaxAllocation(),
+         arena->getHighWaterMark() );
+
+      numArenas ++;
+      totalSize += arena->getHighWaterMark();
+   }
+
+   U32 numFree = 0;
+   for( FrameAllocatorArena* arena = sgFreeArenas; arena != NULL; arena = arena->mNext )
+   {
+      numFree ++;
+      totalSize += arena->getHighWaterMark();
+   }
+
+   Con::printf( "   %u active, %u free, %u bytes reserved", numArenas, numFree, totalSize );
+
+   sgArenaMutex.unlock();
+}
+
+//-----------------------------------------------------------------------------
+
+DefineConsoleFunction( getMaxFrameAllocation, S32, (), ,
+   "Return the largest number of bytes ever in use in the main thread's frame allocator.\n"
+   "@ingroup Debugging" )
+{
+   return FrameAllocator::getMaxFrameAllocation();
+}
+
+DefineConsoleFunction( dumpFrameAllocators, void, (), ,
+   "Print the usage and peak allocation of every thread's frame allocator arena.\n"
+   "@ingroup Debugging" )
+{
+   FrameAllocator::dumpArenas();
+}
@@ -36,6 +36,82 @@
 /// memory which is allocated and expected to be contiguous.
 #define FRAMEALLOCATOR_BYTE_ALIGNMENT 4
 
+/// Default size of the frame arena given to threads other than the main
+/// thread.  Worker arenas are created lazily the first time a thread touches
+/// the FrameAllocator.
+#ifndef TORQUE_WORKER_FRAME_SIZE
+   #define TORQUE_WORKER_FRAME_SIZE ( 4 << 20 )
+#endif
+
+/// The calling thread's arena is found through a compiler thread-local
+/// rather than ThreadStorage, which would cost a call on every allocation.
+#if defined( TORQUE_COMPILER_VISUALC )
+#  define FRAMEALLOCATOR_THREAD_LOCAL __declspec( thread )
+#else
+#  define FRAMEALLOCATOR_THREAD_LOCAL __thread
+#endif
+
+/// A single bump-pointer arena used by the FrameAllocator.
+///
+/// Every thread that uses the FrameAllocator owns exactly one arena, so
+/// water marks on one thread never disturb allocations made on another.
+class FrameAllocatorArena
+{
+   friend class FrameAllocator;
+
+   U8*   mBuffer;
+   U32   mHighWaterMark;
+   U32   mWaterMark;
+
+   /// Largest water mark ever reached in this arena.
+   U32   mMaxAllocation;
+
+   /// Id of the thread currently owning this arena.
+   U32   mThreadId;
+
+   /// Next arena in the FrameAllocator's active or free list.
+   FrameAllocatorArena* mNext;
+
+   FrameAllocatorArena( const U32 size );
+   ~FrameAllocatorArena();
+
+  public:
+
+   inline void* alloc( const U32 allocSize );
+
+   inline void setWaterMark( const U32 waterMark );
+   U32 getWaterMark() const { return mWaterMark; }
+   U32 getHighWaterMark() const { return mHighWaterMark; }
+   U32 getMaxAllocation() const { return mMaxAllocation; }
+   U32 getThreadId() const { return mThreadId; }
+};
+
+void* FrameAllocatorArena::alloc( const U32 allocSize )
+{
+   U32 _allocSize = allocSize;
+
+   AssertFatal(mBuffer != NULL, "Error, no buffer!");
+   mWaterMark = ( mWaterMark + ( FRAMEALLOCATOR_BYTE_ALIGNMENT - 1 ) ) & (~( FRAMEALLOCATOR_BYTE_ALIGNMENT - 1 ));
+   AssertFatal(mWaterMark + _allocSize <= mHighWaterMark, "Error alloc too large, increase frame size!");
+
+   // Sanity check.
+   AssertFatal( !( mWaterMark & ( FRAMEALLOCATOR_BYTE_ALIGNMENT - 1 ) ), "Frame allocation is not on a specified byte boundry." );
+
+   U8* p = &mBuffer[mWaterMark];
+   mWaterMark += _allocSize;
+
+   if (mWaterMark > mMaxAllocation)
+      mMaxAllocation = mWaterMark;
+
+   return p;
+}
+
+void FrameAllocatorArena::setWaterMark( const U32 waterMark )
+{
+   AssertFatal(waterMark < mHighWaterMark, "Error, invalid waterMark");
+   mWaterMark = waterMark;
+}
+
 /// Temporary memory pool for per-frame allocations.
 ///
 /// In the course of rendering a frame, it is often necessary to allocate
@@ -52,92 +128,55 @@
 ///   // Free frameAllocator memory
 ///   FrameAllocator::setWaterMark(waterMark);
 /// @endcode
+///
+/// All calls operate on the calling thread's FrameAllocatorArena.  The main
+/// thread's arena is created by init(); any other thread gets its own arena
+/// on first use and should hand it back with releaseThreadArena() before it
+/// exits.  Water marks are only meaningful on the thread they came from.
 class FrameAllocator
 {
-   static U8*   smBuffer;
-   static U32   smHighWaterMark;
-   static U32   smWaterMark;
-
-#ifdef TORQUE_DEBUG
-   static U32 smMaxFrameAllocation;
-#endif
-
-  public:
-   inline static void init(const U32 frameSize);
-   inline static void destroy();
-
-   inline static void* alloc(const U32 allocSize);
-
-   inline static void setWaterMark(const U32);
-   inline static U32  getWaterMark();
-   inline static U32  getHighWaterMark();
-
-#ifdef TORQUE_DEBUG
-   static U32 getMaxFrameAllocation() { return smMaxFrameAllocation; }
-#endif
-};
-
-void FrameAllocator::init(const U32 frameSize)
-{
-#ifdef FRAMEALLOCATOR_DEBUG_GUARD
-   AssertISV( false, "FRAMEALLOCATOR_DEBUG_GUARD has been removed because it allows non-contiguous memory allocation by the FrameAllocator, and this is *not* ok." );
-#endif
-
-   AssertFatal(smBuffer == NULL, "Error, already initialized");
-   smBuffer = new U8[frameSize];
-   smWaterMark = 0;
-   smHighWaterMark = frameSize;
-}
+   /// The arena belonging to the thread that called init().
+   static FrameAllocatorArena* smMainArena;
 
-void FrameAllocator::destroy()
-{
-   AssertFatal(smBuffer != NULL, "Error, not initialized");
+   /// Size of arenas handed out to other threads.
+   static U32 smWorkerFrameSize;
 
-   delete [] smBuffer;
-   smBuffer = NULL;
-   smWaterMark = 0;
-   smHighWaterMark = 0;
-}
+   /// The calling thread's arena or NULL if it doesn't have one yet.
+   static FRAMEALLOCATOR_THREAD_LOCAL FrameAllocatorArena* smThreadArena;
 
+   static FrameAllocatorArena* _acquireThreadArena();
 
-void* FrameAllocator::alloc(const U32 allocSize)
-{
-   U32 _allocSize = allocSize;
-
-   AssertFatal(smBuffer != NULL, "Error, no buffer!");
-   AssertFatal(smWaterMark + _allocSize <= smHighWaterMark, "Error alloc too large, increase frame size!");
-   smWaterMark = ( smWaterMark + ( FRAMEALLOCATOR_BYTE_ALIGNMENT - 1 ) ) & (~( FRAMEALLOCATOR_BYTE_ALIGNMENT - 1 ));
-
-   // Sanity check.
-   AssertFatal( !( smWaterMark & ( FRAMEALLOCATOR_BYTE_ALIGNMENT - 1 ) ), "Frame allocation is not on a specified byte boundry." );
+  public:
+   static void init(const U32 frameSize, const U32 workerFrameSize = TORQUE_WORKER_FRAME_SIZE);
+   static void destroy();
 
-   U8* p = &smBuffer[smWaterMark];
-   smWaterMark += _allocSize;
+   /// Return the calling thread's arena, creating it if necessary.
+   static FrameAllocatorArena* getThreadArena()
+   {
+      FrameAllocatorArena* arena = smThreadArena;
+      if( !arena )
+         arena = _acquireThreadArena();
+      return arena;
+   }
 
-#ifdef TORQUE_DEBUG
-   if (smWaterMark > smMaxFrameAllocation)
-      smMaxFrameAllocation = smWaterMark;
-#endif
+   /// Return the calling thread's arena to the allocator for reuse by
+   /// other threads.  All of its allocations must have been released.
+   /// Does nothing on the main thread or on threads without an arena.
+   static void releaseThreadArena();
 
-   return p;
-}
+   inline static void* alloc(const U32 allocSize) { return getThreadArena()->alloc( allocSize ); }
 
+   inline static void setWaterMark(const U32 waterMark) { getThreadArena()->setWaterMark( waterMark ); }
+   inline static U32  getWaterMark() { return getThreadArena()->getWaterMark(); }
+   inline static U32  getHighWaterMark() { return getThreadArena()->getHighWaterMark(); }
 
-void FrameAllocator::setWaterMark(const U32 waterMark)
-{
-   AssertFatal(waterMark < smHighWaterMark, "Error, invalid waterMark");
-   smWaterMark = waterMark;
-}
+   /// Largest amount of memory ever in use in the calling thread's arena.
+   static U32 getMaxFrameAllocation() { return getThreadArena()->getMaxAllocation(); }
 
-U32 FrameAllocator::getWaterMark()
-{
-   return smWaterMark;
-}
+   /// Print the usage of every live arena to the console.
+   static void dumpArenas();
+};
 
-U32 FrameAllocator::getHighWaterMark()
-{
-   return smHighWaterMark;
-}
 
 /// Helper class to deal with FrameAllocator usage.
 ///
@@ -156,28 +195,32 @@ U32 FrameAllocator::getHighWaterMark()
 /// don't have to remember to reset the FrameAllocator on every posssible branch.
 class FrameAllocatorMarker
 {
+   FrameAllocatorArena* mArena;
    U32 mMarker;
 
 public:
    FrameAllocatorMarker()
    {
-      mMarker = FrameAllocator::getWaterMark();
+      mArena = FrameAllocator::getThreadArena();
+      mMarker = mArena->getWaterMark();
    }
 
    ~FrameAllocatorMarker()
    {
-      FrameAllocator::setWaterMark(mMarker);
+      AssertFatal( mArena == FrameAllocator::getThreadArena(), "FrameAllocatorMarker released on a different thread than it was created on!" );
+      mArena->setWaterMark(mMarker);
    }
 
    void* alloc(const U32 allocSize) const
    {
-      return FrameAllocator::alloc(allocSize);
+      AssertFatal( mArena == FrameAllocator::getThreadArena(), "FrameAllocatorMarker used on a different thread than it was created on!" );
+      return mArena->alloc(allocSize);
    }
 
    template<typename T>
    T* alloc(const U32 numElements) const
    {
-      return reinterpret_cast<T *>(FrameAllocator::alloc(numElements * sizeof(T)));
+      return reinterpret_cast<T *>(alloc(numElements * sizeof(T)));
    }
 };
 
@@ -208,6 +251,7 @@ template<class T>
 class FrameTemp
 {
 protected:
+   FrameAllocatorArena* mArena;
    U32 mWaterMark;
    T *mMemory;
    U32 mNumObjectsInMemory;
@@ -231,8 +275,9 @@ public:
    FrameTemp( const U32 count = 1 ) : mNumObjectsInMemory( count )
    {
       AssertFatal( count > 0, "Allocating a FrameTemp with less than one instance" );
-      mWaterMark = FrameAllocator::getWaterMark();
-      mMemory = reinterpret_cast<T *>( FrameAllocator::alloc( sizeof( T ) * count ) );
+      mArena = FrameAllocator::getThreadArena();
+      mWaterMark = mArena->getWaterMark();
+      mMemory = reinterpret_cast<T *>( mArena->alloc( sizeof( T ) * count ) );
 
       for( S32 i = 0; i < mNumObjectsInMemory; i++ )
          constructInPlace<T>( &mMemory[i] );
@@ -245,7 +290,8 @@ public:
       for( S32 i = 0; i < mNumObjectsInMemory; i++ )
          destructInPlace<T>( &mMemory[i] );
 
-      FrameAllocator::setWaterMark( mWaterMark );
+      AssertFatal( mArena == FrameAllocator::getThreadArena(), "FrameTemp released on a different thread than it was created on!" );
+      mArena->setWaterMark( mWaterMark );
    }
 
    /// NOTE: This will return the memory, NOT perform a ones-complement
@@ -293,13 +339,15 @@ public:
    inline FrameTemp<type>::FrameTemp( const U32 count ) \
    { \
       AssertFatal( count > 0, "Allocating a FrameTemp with less than one instance" ); \
-      mWaterMark = FrameAllocator::getWaterMark(); \
-      mMemory = reinterpret_cast<type *>( FrameAllocator::alloc( sizeof( type ) * count ) ); \
+      mArena = FrameAllocator::getThreadArena(); \
+      mWaterMark = mArena->getWaterMark(); \
+      mMemory = reinterpret_cast<type *>( mArena->alloc( sizeof( type ) * count ) ); \
    } \
    template<>\
    inline FrameTemp<type>::~FrameTemp() \
    { \
-      FrameAllocator::setWaterMark( mWaterMark ); \
+      AssertFatal( mArena == FrameAllocator::getThreadArena(), "FrameTemp released on a different thread than it was created on!" ); \
+      mArena->setWaterMark( mWaterMark ); \
    } \
 
 FRAME_TEMP_NC_SPEC(char);
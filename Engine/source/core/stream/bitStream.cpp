@@ -378,6 +378,42 @@ S32 BitStream::readSignedInt(S32 bitCount)
       return readInt(bitCount - 1);
 }
 
+void BitStream::writeDeltaInt(S32 value, S32 base)
+{
+   // Wrap around rather than overflow for far apart values.
+   S32 delta = S32(U32(value) - U32(base));
+
+   if(writeFlag(delta == 0))
+      return;
+
+   if(writeFlag(delta >= -0x7F && delta <= 0x7F))
+      writeSignedInt(delta, 8);
+   else if(writeFlag(delta >= -0xFFF && delta <= 0xFFF))
+      writeSignedInt(delta, 13);
+   else if(writeFlag(delta >= -0x1FFFF && delta <= 0x1FFFF))
+      writeSignedInt(delta, 18);
+   else
+      writeInt(delta, 32);
+}
+
+S32 BitStream::readDeltaInt(S32 base)
+{
+   if(readFlag())
+      return base;
+
+   S32 delta;
+   if(readFlag())
+      delta = readSignedInt(8);
+   else if(readFlag())
+      delta = readSignedInt(13);
+   else if(readFlag())
+      delta = readSignedInt(18);
+   else
+      delta = readInt(32);
+
+   return S32(U32(base) + U32(delta));
+}
+
 void BitStream::writeNormalVector(const Point3F& vec, S32 bitCount)
 {
    F32 phi   = mAtan2(vec.x, vec.y) / M_PI;
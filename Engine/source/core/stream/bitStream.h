@@ -135,6 +135,14 @@ public:
    void writeSignedInt(S32 value, S32 bitCount);
    S32  readSignedInt(S32 bitCount);
 
+   /// Writes the difference between value and base.  Costs one bit if they
+   /// are equal and 10, 16 or 22 bits for differences that fit in 8, 13 or
+   /// 18 signed bits.  Anything larger is written whole in 36 bits.
+   void writeDeltaInt(S32 value, S32 base);
+
+   /// Reads a value written with writeDeltaInt against the same base.
+   S32  readDeltaInt(S32 base);
+
    void writeRangedU32(U32 value, U32 rangeStart, U32 rangeEnd);
    U32  readRangedU32(U32 rangeStart, U32 rangeEnd);
    
@@ -169,6 +177,7 @@ public:
 
    void clearCompressionPoint();
    void setCompressionPoint(const Point3F& p);
+   const Point3F& getCompressionPoint() const { return mCompressPoint; }
 
    // Matching calls to these compression methods must, of course,
    // have matching scale values.
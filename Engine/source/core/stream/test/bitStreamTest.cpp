@@ -0,0 +1,89 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "core/stream/bitStream.h"
+#include "math/mRandom.h"
+#include "core/util/tVector.h"
+
+TEST(BitStream, DeltaInt)
+{
+   // Pairs of values and bases that hit every size of difference,
+   // including ones that wrap around.
+   const S32 values[][2] =
+   {
+      { 0, 0 },
+      { 1000, 1000 },
+      { 1127, 1000 },
+      { 873, 1000 },
+      { 5095, 1000 },
+      { -3095, 1000 },
+      { 132071, 1000 },
+      { -130071, 1000 },
+      { 132072, 1000 },
+      { S32_MAX, S32_MIN },
+      { S32_MIN, S32_MAX },
+   };
+   const U32 numValues = sizeof(values) / sizeof(values[0]);
+
+   U8 buffer[1024];
+   BitStream stream(buffer, sizeof(buffer));
+   for(U32 i = 0; i < numValues; i++)
+      stream.writeDeltaInt(values[i][0], values[i][1]);
+
+   stream.setPosition(0);
+   for(U32 i = 0; i < numValues; i++)
+      EXPECT_EQ(stream.readDeltaInt(values[i][1]), values[i][0]);
+
+   // No difference costs one bit.
+   stream.setPosition(0);
+   stream.writeDeltaInt(42, 42);
+   EXPECT_EQ(stream.getCurPos(), 1);
+}
+
+TEST(BitStream, DeltaIntRandom)
+{
+   MRandomLCG random(1);
+   Vector<S32> values, bases;
+   values.setSize(2000);
+   bases.setSize(2000);
+
+   U8 buffer[16384];
+   BitStream stream(buffer, sizeof(buffer));
+   for(U32 i = 0; i < values.size(); i++)
+   {
+      const S32 delta = S32(random.randI() << 1) >> random.randI(0, 31);
+      bases[i] = S32(random.randI() << 1);
+      values[i] = S32(U32(bases[i]) + U32(delta));
+      stream.writeDeltaInt(values[i], bases[i]);
+   }
+
+   stream.setPosition(0);
+   U32 numMismatches = 0;
+   for(U32 i = 0; i < values.size(); i++)
+      numMismatches += stream.readDeltaInt(bases[i]) != values[i];
+   EXPECT_EQ(numMismatches, 0);
+}
+
+#endif
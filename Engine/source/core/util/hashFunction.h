@@ -34,6 +34,57 @@ extern U32 hash(register const U8 *k, register U32 length, register U32 initval)
 
 extern U64 hash64(register const U8 *k, register U32 length, register U64 initval);
 
+/// Builds a 64 bit hash a piece at a time, so that a key made up of
+/// several values doesn't have to be printed into a string first.
+///
+/// This is FNV-1a over the bytes of each value in little endian order,
+/// so the result is the same on every run and every platform and can be
+/// used to name files.
+class IncrementalHash64
+{
+   U64 mHash;
+
+   void _addByte(U8 byte)
+   {
+      mHash ^= byte;
+      mHash *= 0x100000001b3ULL;
+   }
+
+public:
+
+   IncrementalHash64() : mHash(0xcbf29ce484222325ULL) {}
+
+   void add(const void *data, U32 size)
+   {
+      const U8 *bytes = (const U8*)data;
+      for(U32 i = 0; i < size; i++)
+         _addByte(bytes[i]);
+   }
+
+   void addU32(U32 value)
+   {
+      for(U32 i = 0; i < 32; i += 8)
+         _addByte(U8(value >> i));
+   }
+
+   void addU64(U64 value)
+   {
+      for(U32 i = 0; i < 64; i += 8)
+         _addByte(U8(value >> i));
+   }
+
+   /// Adds a null terminated string including the terminator, so that
+   /// "ab","c" and "a","bc" hash differently.
+   void addString(const char *str)
+   {
+      while(*str)
+         _addByte(U8(*str++));
+      _addByte(0);
+   }
+
+   U64 getHash() const { return mHash; }
+};
+
 }
 
 #endif // _HASHFUNCTION_H_
@@ -0,0 +1,151 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "core/util/tConcurrentHashTable.h"
+#include "platform/threads/mutex.h"
+
+
+ConcurrentHashTableBase* ConcurrentHashTableBase::smTables;
+
+/// Guards the table list and the retired lists.  Tables may be
+/// constructed during static initialization, so create it on first use.
+static Mutex& _getRetiredMutex()
+{
+   static Mutex sRetiredMutex;
+   return sRetiredMutex;
+}
+
+//-----------------------------------------------------------------------------
+
+ConcurrentHashTableBase::ConcurrentHashTableBase()
+   : mRetired( NULL ),
+     mEpoch( 0 ),
+     mNextTable( NULL )
+{
+   mReaders[ 0 ] = 0;
+   mReaders[ 1 ] = 0;
+
+   MutexHandle lock;
+   lock.lock( &_getRetiredMutex(), true );
+
+   mNextTable = smTables;
+   smTables = this;
+}
+
+//-----------------------------------------------------------------------------
+
+ConcurrentHashTableBase::~ConcurrentHashTableBase()
+{
+   {
+      MutexHandle lock;
+      lock.lock( &_getRetiredMutex(), true );
+
+      for( ConcurrentHashTableBase** walk = &smTables; *walk; walk = &( *walk )->mNextTable )
+         if( *walk == this )
+         {
+            *walk = mNextTable;
+            break;
+         }
+   }
+
+   // Nothing can be reading a table that is being destroyed.
+   while( mRetired )
+   {
+      RetiredBlock* next = mRetired->mNextRetired;
+      dFree( mRetired );
+      mRetired = next;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void ConcurrentHashTableBase::_retire( RetiredBlock* block )
+{
+   MutexHandle lock;
+   lock.lock( &_getRetiredMutex(), true );
+
+   // The block has already been replaced, so only readers that started
+   // in this epoch or before can still be looking at it.
+   block->mRetireEpoch = mEpoch;
+   block->mNextRetired = mRetired;
+   mRetired = block;
+}
+
+//-----------------------------------------------------------------------------
+
+void ConcurrentHashTableBase::_collectRetired( RetiredBlock*& expired )
+{
+   for( ;; )
+   {
+      // Readers of the previous epoch share a counter with the next
+      // one.  While any of them are left, we can neither free what was
+      // retired before the current epoch nor start a new epoch.
+      const U32 epoch = mEpoch;
+      if( dAtomicRead( mReaders[ ( epoch - 1 ) & 1 ] ) != 0 )
+         break;
+
+      // Everything retired in an earlier epoch is unreachable now.  The
+      // list is sorted newest first, so cut it at the first such block.
+      for( RetiredBlock** walk = &mRetired; *walk; walk = &( *walk )->mNextRetired )
+         if( ( *walk )->mRetireEpoch != epoch )
+         {
+            RetiredBlock* tail = *walk;
+            while( tail->mNextRetired )
+               tail = tail->mNextRetired;
+
+            tail->mNextRetired = expired;
+            expired = *walk;
+            *walk = NULL;
+            break;
+         }
+
+      if( !mRetired )
+         break;
+
+      // Start a new epoch so the blocks retired in this one can go once
+      // the readers still counted in it have finished.
+      dFetchAndAdd( mEpoch, 1 );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void ConcurrentHashTableBase::collectRetired()
+{
+   RetiredBlock* expired = NULL;
+   {
+      MutexHandle lock;
+      lock.lock( &_getRetiredMutex(), true );
+
+      for( ConcurrentHashTableBase* table = smTables; table; table = table->mNextTable )
+         if( table->mRetired )
+            table->_collectRetired( expired );
+   }
+
+   while( expired )
+   {
+      RetiredBlock* next = expired->mNextRetired;
+      dFree( expired );
+      expired = next;
+   }
+}
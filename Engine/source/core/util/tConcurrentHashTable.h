@@ -0,0 +1,323 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _TCONCURRENTHASHTABLE_H_
+#define _TCONCURRENTHASHTABLE_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _PLATFORMINTRINSICS_H_
+#include "platform/platformIntrinsics.h"
+#endif
+
+
+/// Slot array reclamation for ConcurrentHashTable.
+///
+/// When a table grows, readers on other threads may still be probing the
+/// old slot array, so it cannot be freed right away.  Reclamation is epoch
+/// based: every find() counts itself as a reader of the table's current
+/// epoch for the duration of the lookup, and retired arrays are tagged with
+/// the epoch they were retired in.  Once no reader of that epoch or an
+/// earlier one is left, nothing can still see the array and it is freed.
+/// Each table keeps its own epoch and reader counts, so lookups in
+/// different tables don't contend.  The Sim calls collectRetired() once
+/// per tick.
+class ConcurrentHashTableBase
+{
+public:
+
+   /// Free the slot arrays of all tables that no find() can still be
+   /// reading and move on to a new epoch where any are left.  Safe to
+   /// call at any time.
+   static void collectRetired();
+
+protected:
+
+   ConcurrentHashTableBase();
+   ~ConcurrentHashTableBase();
+
+   /// Header of every slot array, used to chain it on the retired list.
+   /// Readers never look at it.
+   struct RetiredBlock
+   {
+      RetiredBlock* mNextRetired;
+      U32 mRetireEpoch;
+   };
+
+   /// Retired blocks, newest first.
+   RetiredBlock* mRetired;
+
+   /// The current epoch.  Only collectRetired() advances it.
+   volatile U32 mEpoch;
+
+   /// Number of lookups in progress, indexed by the parity of the epoch
+   /// they started in.  An epoch's counter is only reused two epochs
+   /// later, after it has dropped to zero.
+   mutable volatile U32 mReaders[ 2 ];
+
+   /// Next table in the list collectRetired() walks.
+   ConcurrentHashTableBase* mNextTable;
+
+   /// All live tables.
+   static ConcurrentHashTableBase* smTables;
+
+   void _retire( RetiredBlock* block );
+
+   /// Move the blocks of this table that no reader can still see to
+   /// @a expired.  Must be called with the retired list locked.
+   void _collectRetired( RetiredBlock*& expired );
+
+   /// Count the calling thread as a reader of the current epoch and return
+   /// the epoch.  The atomic add is a full barrier, so the table pointer
+   /// read afterwards is at least as new as the epoch.
+   inline U32 _beginRead() const
+   {
+      for( ;; )
+      {
+         const U32 epoch = mEpoch;
+         dFetchAndAdd( mReaders[ epoch & 1 ], 1 );
+
+         // If the epoch moved on in between, the counter may already have
+         // been checked, so count ourselves again in the new one.
+         if( mEpoch == epoch )
+            return epoch;
+
+         dFetchAndAdd( mReaders[ epoch & 1 ], U32( -1 ) );
+      }
+   }
+
+   inline void _endRead( U32 epoch ) const
+   {
+      dFetchAndAdd( mReaders[ epoch & 1 ], U32( -1 ) );
+   }
+};
+
+
+/// Open-addressing hash table with lock-free lookups.
+///
+/// Maps keys to pointers.  find() never takes a lock and can run on any
+/// number of threads concurrently with a single writer.  insert() and
+/// remove() must be serialized by the caller.
+///
+/// Keys must be integers or pointers, and Key( 0 ) is reserved as the empty
+/// key.  Values must be pointers; a NULL value marks a removed entry.  Once a
+/// slot has been given a key that slot keeps the key until the table is
+/// rebuilt, so a reader can never pair a key with another key's value.
+/// Removed entries are dropped when the table is rebuilt, which happens when
+/// live entries plus removed entries fill more than 5/8 of the slots.
+///
+/// KeyHash must provide a static U32 hash( Key ) function.
+template< typename Key, typename Value, class KeyHash >
+class ConcurrentHashTable : public ConcurrentHashTableBase
+{
+public:
+
+   ConcurrentHashTable()
+      : mTable( NULL )
+   {
+   }
+
+   ~ConcurrentHashTable()
+   {
+      if( mTable )
+         dFree( mTable );
+   }
+
+   /// Return the value mapped to @a key or NULL.  Lock-free.
+   Value find( Key key ) const
+   {
+      if( key == Key( 0 ) )
+         return NULL;
+
+      const U32 epoch = _beginRead();
+
+      Value value = NULL;
+      const Table* table = mTable;
+      if( table )
+      {
+         const U32 mask = table->mMask;
+         for( U32 i = KeyHash::hash( key ) & mask; ; i = ( i + 1 ) & mask )
+         {
+            const Slot& slot = table->mSlots[ i ];
+            const Key slotKey = slot.mKey;
+            if( slotKey == key )
+            {
+               value = slot.mValue;
+               break;
+            }
+            if( slotKey == Key( 0 ) )
+               break;
+         }
+      }
+
+      _endRead( epoch );
+      return value;
+   }
+
+   /// Map @a key to @a value, replacing any existing mapping.
+   /// Writers must be serialized by the caller.
+   void insert( Key key, Value value )
+   {
+      AssertFatal( key != Key( 0 ), "ConcurrentHashTable::insert - the empty key cannot be inserted" );
+      AssertFatal( value != NULL, "ConcurrentHashTable::insert - NULL values cannot be inserted" );
+
+      Table* table = mTable;
+      if( !table || ( table->mNumUsed + 1 ) * 8 > ( table->mMask + 1 ) * 5 )
+         table = _rebuild();
+
+      const U32 mask = table->mMask;
+      for( U32 i = KeyHash::hash( key ) & mask; ; i = ( i + 1 ) & mask )
+      {
+         Slot& slot = table->mSlots[ i ];
+         const Key slotKey = slot.mKey;
+
+         if( slotKey == key )
+         {
+            if( !slot.mValue )
+               table->mNumLive ++;
+            slot.mValue = value;
+            return;
+         }
+
+         if( slotKey == Key( 0 ) )
+         {
+            // Publish the value before the key so readers that match the
+            // key always see it.
+            slot.mValue = value;
+            dCompareAndSwap( slot.mKey, Key( 0 ), key );
+
+            table->mNumUsed ++;
+            table->mNumLive ++;
+            return;
+         }
+      }
+   }
+
+   /// Remove the mapping for @a key if it maps to @a value.
+   /// Writers must be serialized by the caller.
+   /// @return True if the mapping was removed.
+   bool remove( Key key, Value value )
+   {
+      Table* table = mTable;
+      if( !table || key == Key( 0 ) )
+         return false;
+
+      const U32 mask = table->mMask;
+      for( U32 i = KeyHash::hash( key ) & mask; ; i = ( i + 1 ) & mask )
+      {
+         Slot& slot = table->mSlots[ i ];
+         const Key slotKey = slot.mKey;
+
+         if( slotKey == key )
+         {
+            if( !slot.mValue || slot.mValue != value )
+               return false;
+
+            slot.mValue = NULL;
+            table->mNumLive --;
+            return true;
+         }
+
+         if( slotKey == Key( 0 ) )
+            return false;
+      }
+   }
+
+   /// Return the number of live entries.
+   U32 size() const { return mTable ? mTable->mNumLive : 0; }
+
+   /// Return the number of slots in the current table.
+   U32 getCapacity() const { return mTable ? mTable->mMask + 1 : 0; }
+
+protected:
+
+   enum
+   {
+      MinCapacity = 16
+   };
+
+   struct Slot
+   {
+      Key volatile mKey;
+      Value volatile mValue;
+   };
+
+   struct Table : public RetiredBlock
+   {
+      U32 mMask;
+      U32 mNumUsed;     ///< Slots with a key, live or removed.
+      U32 mNumLive;     ///< Slots with a key and a value.
+      Slot mSlots[ 1 ];
+   };
+
+   Table* volatile mTable;
+
+   /// Copy all live entries into a new slot array sized for twice the
+   /// live entry count, publish it, and retire the old one.
+   Table* _rebuild()
+   {
+      Table* oldTable = mTable;
+      const U32 numLive = oldTable ? oldTable->mNumLive : 0;
+
+      U32 capacity = MinCapacity;
+      while( capacity < ( numLive + 1 ) * 2 )
+         capacity *= 2;
+
+      const dsize_t tableSize = sizeof( Table ) + sizeof( Slot ) * ( capacity - 1 );
+      Table* newTable = reinterpret_cast< Table* >( dMalloc( tableSize ) );
+      dMemset( newTable, 0, tableSize );
+      newTable->mMask = capacity - 1;
+
+      if( oldTable )
+      {
+         const U32 oldCapacity = oldTable->mMask + 1;
+         for( U32 n = 0; n < oldCapacity; ++ n )
+         {
+            const Slot& oldSlot = oldTable->mSlots[ n ];
+            if( oldSlot.mKey == Key( 0 ) || !oldSlot.mValue )
+               continue;
+
+            U32 i = KeyHash::hash( oldSlot.mKey ) & newTable->mMask;
+            while( newTable->mSlots[ i ].mKey != Key( 0 ) )
+               i = ( i + 1 ) & newTable->mMask;
+
+            newTable->mSlots[ i ].mKey = oldSlot.mKey;
+            newTable->mSlots[ i ].mValue = oldSlot.mValue;
+         }
+
+         newTable->mNumUsed = numLive;
+         newTable->mNumLive = numLive;
+      }
+
+      // Full barrier so the new slots are visible before the table is.
+      dCompareAndSwap( mTable, oldTable, newTable );
+
+      if( oldTable )
+         _retire( oldTable );
+
+      return newTable;
+   }
+};
+
+#endif // _TCONCURRENTHASHTABLE_H_
@@ -0,0 +1,185 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "core/dataChunker.h"
+#include "platform/threads/thread.h"
+#include "console/console.h"
+
+namespace
+{
+   struct PoolTestObject
+   {
+      static S32 smNumLive;
+
+      U32 mData[ 12 ];
+
+      PoolTestObject() { smNumLive ++; }
+      ~PoolTestObject() { smNumLive --; }
+   };
+
+   S32 PoolTestObject::smNumLive = 0;
+}
+
+TEST(DataChunker, ResetReusesBlocks)
+{
+   DataChunker chunker(1024);
+
+   void* first = chunker.alloc(64);
+   for(U32 i = 0; i < 100; i++)
+      chunker.alloc(64);
+
+   chunker.reset();
+
+   EXPECT_EQ(chunker.alloc(64), first)
+      << "DataChunker::reset did not hand out the retained blocks!";
+}
+
+TEST(DataChunker, OversizedAllocAndReset)
+{
+   DataChunker chunker(256);
+
+   U8* big = reinterpret_cast<U8*>(chunker.alloc(1024));
+   dMemset(big, 0xAB, 1024);
+   chunker.alloc(16);
+
+   // Oversized blocks are dropped rather than retained.
+   chunker.reset();
+   EXPECT_TRUE(chunker.alloc(16) != NULL);
+}
+
+TEST(ArenaChunker, ConstructAndReset)
+{
+   ArenaChunker arena(512);
+
+   for(U32 i = 0; i < 64; i++)
+      arena.construct<PoolTestObject>();
+   arena.alloc<PoolTestObject>(); // Not constructed, not destructed.
+
+   EXPECT_EQ(PoolTestObject::smNumLive, 64);
+   arena.reset();
+   EXPECT_EQ(PoolTestObject::smNumLive, 0)
+      << "ArenaChunker::reset did not destruct its objects!";
+
+   arena.construct<PoolTestObject>();
+   arena.freeBlocks();
+   EXPECT_EQ(PoolTestObject::smNumLive, 0);
+}
+
+TEST(ThreadLocalChunker, InstancePerThread)
+{
+   typedef ThreadLocalChunker< ClassChunker<PoolTestObject> > PoolType;
+
+   struct thread : public Thread
+   {
+      PoolType* mPool;
+      ClassChunker<PoolTestObject>* mChunker;
+
+      thread(PoolType* pool) : mPool(pool), mChunker(NULL) {}
+
+      virtual void run(void*)
+      {
+         mChunker = &mPool->get();
+         mChunker->free(mChunker->alloc());
+      }
+   };
+
+   PoolType pool;
+   ClassChunker<PoolTestObject>* mainChunker = &pool.get();
+   EXPECT_EQ(mainChunker, &pool.get());
+
+   thread worker(&pool);
+   worker.start();
+   worker.join();
+
+   EXPECT_TRUE(worker.mChunker != NULL);
+   EXPECT_NE(worker.mChunker, mainChunker)
+      << "Threads share a ThreadLocalChunker instance!";
+   EXPECT_EQ(pool.getNumInstances(), 2);
+   EXPECT_EQ(PoolTestObject::smNumLive, 0);
+}
+
+TEST(DataChunker, StressPoolThroughput)
+{
+   // Simulates frames of short-lived objects and compares the heap against
+   // the free-list pool and the reset-all arena.  Timings go to the console.
+
+   const U32 numFrames = 200;
+   const U32 numObjects = 2000;
+
+   PoolTestObject* objects[ numObjects ];
+
+   U32 start = Platform::getRealMilliseconds();
+   for(U32 frame = 0; frame < numFrames; frame++)
+   {
+      for(U32 i = 0; i < numObjects; i++)
+         objects[i] = new PoolTestObject;
+      for(U32 i = 0; i < numObjects; i++)
+         delete objects[i];
+   }
+   const U32 heapTime = Platform::getRealMilliseconds() - start;
+
+   ClassChunker<PoolTestObject> pool;
+   start = Platform::getRealMilliseconds();
+   for(U32 frame = 0; frame < numFrames; frame++)
+   {
+      for(U32 i = 0; i < numObjects; i++)
+         objects[i] = pool.alloc();
+      for(U32 i = 0; i < numObjects; i++)
+         pool.free(objects[i]);
+   }
+   const U32 poolTime = Platform::getRealMilliseconds() - start;
+
+   MultiTypedChunker chunker;
+   start = Platform::getRealMilliseconds();
+   for(U32 frame = 0; frame < numFrames; frame++)
+   {
+      for(U32 i = 0; i < numObjects; i++)
+         objects[i] = constructInPlace(chunker.alloc<PoolTestObject>());
+      for(U32 i = 0; i < numObjects; i++)
+         destructInPlace(objects[i]);
+      chunker.clear();
+   }
+   const U32 chunkerTime = Platform::getRealMilliseconds() - start;
+
+   ArenaChunker arena;
+   start = Platform::getRealMilliseconds();
+   for(U32 frame = 0; frame < numFrames; frame++)
+   {
+      for(U32 i = 0; i < numObjects; i++)
+         objects[i] = arena.construct<PoolTestObject>();
+      arena.reset();
+   }
+   const U32 arenaTime = Platform::getRealMilliseconds() - start;
+
+   EXPECT_EQ(PoolTestObject::smNumLive, 0);
+
+   Con::printf("DataChunker throughput, %u frames of %u objects:", numFrames, numObjects);
+   Con::printf("   new/delete:         %u ms", heapTime);
+   Con::printf("   ClassChunker:       %u ms", poolTime);
+   Con::printf("   MultiTypedChunker:  %u ms", chunkerTime);
+   Con::printf("   ArenaChunker:       %u ms", arenaTime);
+}
+
+#endif
@@ -0,0 +1,84 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "core/frameAllocator.h"
+#include "platform/threads/thread.h"
+
+TEST(FrameAllocator, MarkerRestoresWaterMark)
+{
+   const U32 waterMark = FrameAllocator::getWaterMark();
+   {
+      FrameAllocatorMarker mem;
+      U8* p = mem.alloc<U8>(100);
+      EXPECT_TRUE(p != NULL);
+      EXPECT_GE(FrameAllocator::getWaterMark(), waterMark + 100);
+   }
+   EXPECT_EQ(FrameAllocator::getWaterMark(), waterMark)
+      << "FrameAllocatorMarker did not restore the water mark!";
+}
+
+TEST(FrameAllocator, PerThreadArenas)
+{
+   // Allocates on its own thread while the main thread holds a FrameTemp.
+   struct thread : public Thread
+   {
+      FrameAllocatorArena* mArena;
+      U32 mWaterMarkInside;
+      U32 mWaterMarkAfter;
+
+      thread() : mArena(NULL), mWaterMarkInside(0), mWaterMarkAfter(~0) {}
+
+      virtual void run(void*)
+      {
+         mArena = FrameAllocator::getThreadArena();
+         {
+            FrameTemp<U32> temp(64);
+            for(U32 i = 0; i < 64; i++)
+               temp[i] = i;
+            mWaterMarkInside = FrameAllocator::getWaterMark();
+         }
+         mWaterMarkAfter = FrameAllocator::getWaterMark();
+      }
+   };
+
+   FrameAllocatorArena* mainArena = FrameAllocator::getThreadArena();
+   FrameTemp<U8> mainTemp(256);
+   const U32 mainWaterMark = FrameAllocator::getWaterMark();
+
+   thread worker;
+   worker.start();
+   worker.join();
+
+   EXPECT_TRUE(worker.mArena != NULL);
+   EXPECT_NE(worker.mArena, mainArena)
+      << "Worker thread shared the main thread's arena!";
+   EXPECT_GE(worker.mWaterMarkInside, 64 * sizeof(U32));
+   EXPECT_EQ(worker.mWaterMarkAfter, 0U)
+      << "FrameTemp did not restore the worker's water mark!";
+   EXPECT_EQ(FrameAllocator::getWaterMark(), mainWaterMark)
+      << "Worker allocations disturbed the main thread's arena!";
+}
+
+#endif
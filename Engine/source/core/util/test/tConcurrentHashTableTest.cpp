@@ -0,0 +1,406 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "core/util/tConcurrentHashTable.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/mutex.h"
+#include "platform/platformIntrinsics.h"
+#include "console/console.h"
+#include "torqueConfig.h"
+
+#ifdef USE_NEW_SIMDICTIONARY
+#include <unordered_map>
+#endif
+
+namespace
+{
+   struct TestObject
+   {
+      U32 mId;
+      TestObject* mNext;   ///< Only used by the chained reference table.
+   };
+
+   struct IdentityHash
+   {
+      static inline U32 hash(U32 key) { return key; }
+   };
+
+   typedef ConcurrentHashTable<U32, TestObject*, IdentityHash> TestTable;
+
+   /// The fixed 4096 bucket chained table with a mutex that SimIdDictionary
+   /// used before it switched to ConcurrentHashTable.
+   class ChainedTable
+   {
+      enum
+      {
+         TableSize = 4096,
+         TableMask = TableSize - 1
+      };
+
+      TestObject* mTable[ TableSize ];
+      void* mMutex;
+
+   public:
+
+      ChainedTable()
+      {
+         dMemset(mTable, 0, sizeof(mTable));
+         mMutex = Mutex::createMutex();
+      }
+
+      ~ChainedTable()
+      {
+         Mutex::destroyMutex(mMutex);
+      }
+
+      void insert(TestObject* obj)
+      {
+         Mutex::lockMutex(mMutex);
+         obj->mNext = mTable[obj->mId & TableMask];
+         mTable[obj->mId & TableMask] = obj;
+         Mutex::unlockMutex(mMutex);
+      }
+
+      TestObject* find(U32 id)
+      {
+         Mutex::lockMutex(mMutex);
+         TestObject* walk = mTable[id & TableMask];
+         while(walk && walk->mId != id)
+            walk = walk->mNext;
+         Mutex::unlockMutex(mMutex);
+         return walk;
+      }
+   };
+
+#ifdef USE_NEW_SIMDICTIONARY
+   /// std::unordered_map behind a mutex, as with USE_NEW_SIMDICTIONARY.
+   class StdMapTable
+   {
+      std::unordered_map<U32, TestObject*> mMap;
+      void* mMutex;
+
+   public:
+
+      StdMapTable()
+      {
+         mMutex = Mutex::createMutex();
+      }
+
+      ~StdMapTable()
+      {
+         Mutex::destroyMutex(mMutex);
+      }
+
+      void insert(TestObject* obj)
+      {
+         Mutex::lockMutex(mMutex);
+         mMap[obj->mId] = obj;
+         Mutex::unlockMutex(mMutex);
+      }
+
+      TestObject* find(U32 id)
+      {
+         Mutex::lockMutex(mMutex);
+         std::unordered_map<U32, TestObject*>::iterator it = mMap.find(id);
+         TestObject* obj = (it == mMap.end() ? NULL : it->second);
+         Mutex::unlockMutex(mMutex);
+         return obj;
+      }
+   };
+#endif
+
+   /// Exposes the reclamation state to the tests.
+   struct ReclamationTable : public TestTable
+   {
+      U32 beginRead() const { return _beginRead(); }
+      void endRead(U32 epoch) const { _endRead(epoch); }
+      bool hasRetired() const { return mRetired != NULL; }
+   };
+
+   /// Looks up a pseudo-random sequence of ids, the same one for every
+   /// table type so the timings compare.
+   template<class T>
+   struct LookupThread : public Thread
+   {
+      T* mTable;
+      U32 mNumObjects;
+      U32 mNumLookups;
+      U32 mSeed;
+      U32 mFound;
+
+      LookupThread(T* table, U32 numObjects, U32 numLookups, U32 seed)
+         : mTable(table), mNumObjects(numObjects), mNumLookups(numLookups), mSeed(seed), mFound(0) {}
+
+      virtual void run(void*)
+      {
+         U32 seed = mSeed;
+         for(U32 i = 0; i < mNumLookups; i++)
+         {
+            seed = seed * 1664525 + 1013904223;
+            mFound += mTable->find((seed >> 8) % mNumObjects + 1) != NULL;
+         }
+      }
+   };
+
+   /// Run @a numLookups lookups split over @a numThreads threads and
+   /// return the wall clock time taken in milliseconds.
+   template<class T>
+   U32 timeLookups(T* table, U32 numObjects, U32 numLookups, U32 numThreads, U32& found)
+   {
+      Vector<LookupThread<T>*> threads;
+      for(U32 i = 0; i < numThreads; i++)
+         threads.push_back(new LookupThread<T>(table, numObjects, numLookups / numThreads, i + 1));
+
+      const U32 start = Platform::getRealMilliseconds();
+      for(U32 i = 0; i < numThreads; i++)
+         threads[i]->start();
+
+      found = 0;
+      for(U32 i = 0; i < numThreads; i++)
+      {
+         threads[i]->join();
+         found += threads[i]->mFound;
+         delete threads[i];
+      }
+
+      return Platform::getRealMilliseconds() - start;
+   }
+}
+
+TEST(ConcurrentHashTable, InsertFindRemove)
+{
+   TestObject a = { 1, NULL };
+   TestObject b = { 2, NULL };
+   TestTable table;
+
+   EXPECT_TRUE(table.find(1) == NULL);
+
+   table.insert(1, &a);
+   table.insert(2, &b);
+   EXPECT_EQ(table.find(1), &a);
+   EXPECT_EQ(table.find(2), &b);
+   EXPECT_TRUE(table.find(3) == NULL);
+   EXPECT_TRUE(table.find(0) == NULL);
+   EXPECT_EQ(table.size(), 2);
+
+   // Removing requires the value to match.
+   EXPECT_FALSE(table.remove(1, &b));
+   EXPECT_TRUE(table.remove(1, &a));
+   EXPECT_TRUE(table.find(1) == NULL);
+   EXPECT_EQ(table.find(2), &b);
+   EXPECT_EQ(table.size(), 1);
+
+   // A removed key can be mapped again and inserting replaces.
+   table.insert(1, &b);
+   table.insert(1, &a);
+   EXPECT_EQ(table.find(1), &a);
+   EXPECT_EQ(table.size(), 2);
+}
+
+TEST(ConcurrentHashTable, Grow)
+{
+   const U32 numObjects = 10000;
+   Vector<TestObject> objects;
+   objects.setSize(numObjects);
+
+   TestTable table;
+   for(U32 i = 0; i < numObjects; i++)
+   {
+      objects[i].mId = i + 1;
+      table.insert(i + 1, &objects[i]);
+   }
+
+   EXPECT_EQ(table.size(), numObjects);
+   EXPECT_GE(table.getCapacity(), numObjects * 8 / 5);
+
+   // Churn through removals so the table has to purge removed slots.
+   for(U32 i = 0; i < numObjects; i += 2)
+      EXPECT_TRUE(table.remove(i + 1, &objects[i]));
+   for(U32 i = 0; i < numObjects; i += 2)
+      table.insert(i + 1, &objects[i]);
+   for(U32 i = 0; i < numObjects; i += 2)
+      EXPECT_TRUE(table.remove(i + 1, &objects[i]));
+
+   bool ok = true;
+   for(U32 i = 0; i < numObjects; i++)
+      ok &= table.find(i + 1) == ((i & 1) ? &objects[i] : NULL);
+   EXPECT_TRUE(ok) << "Lookups returned the wrong object after growing!";
+   EXPECT_EQ(table.size(), numObjects / 2);
+
+   ConcurrentHashTableBase::collectRetired();
+}
+
+TEST(ConcurrentHashTable, Reclamation)
+{
+   // A retired slot array must stay around while a lookup that may have
+   // seen it is in progress, and go once that lookup has finished.
+
+   TestObject objects[64];
+   ReclamationTable table;
+   objects[0].mId = 1;
+   table.insert(1, &objects[0]);
+   EXPECT_FALSE(table.hasRetired());
+
+   const U32 epoch = table.beginRead();
+
+   for(U32 i = 1; i < 64; i++)
+   {
+      objects[i].mId = i + 1;
+      table.insert(i + 1, &objects[i]);
+   }
+   EXPECT_TRUE(table.hasRetired());
+
+   // A lookup in another table doesn't hold this one back.
+   ReclamationTable other;
+   const U32 otherEpoch = other.beginRead();
+
+   for(U32 i = 0; i < 4; i++)
+      ConcurrentHashTableBase::collectRetired();
+   EXPECT_TRUE(table.hasRetired()) << "Freed a table while a lookup was still reading it!";
+
+   table.endRead(epoch);
+   ConcurrentHashTableBase::collectRetired();
+   EXPECT_FALSE(table.hasRetired());
+
+   other.endRead(otherEpoch);
+}
+
+TEST(ConcurrentHashTable, ConcurrentReaders)
+{
+   // Readers look up a fixed set of keys while the main thread keeps
+   // inserting and removing others, forcing the table to grow under them.
+
+   const U32 numStable = 256;
+   const U32 numChurn = 20000;
+
+   struct reader : public Thread
+   {
+      TestTable* mTable;
+      TestObject* mStable;
+      volatile U32* mDone;
+      U32 mErrors;
+
+      reader(TestTable* table, TestObject* stable, volatile U32* done)
+         : mTable(table), mStable(stable), mDone(done), mErrors(0) {}
+
+      virtual void run(void*)
+      {
+         while(!*mDone)
+            for(U32 i = 0; i < numStable; i++)
+               if(mTable->find(mStable[i].mId) != &mStable[i])
+                  mErrors++;
+      }
+   };
+
+   Vector<TestObject> stable;
+   stable.setSize(numStable);
+   Vector<TestObject> churn;
+   churn.setSize(numChurn);
+
+   TestTable table;
+   for(U32 i = 0; i < numStable; i++)
+   {
+      stable[i].mId = i + 1;
+      table.insert(stable[i].mId, &stable[i]);
+   }
+
+   volatile U32 done = 0;
+   reader reader1(&table, stable.address(), &done);
+   reader reader2(&table, stable.address(), &done);
+   reader1.start();
+   reader2.start();
+
+   for(U32 i = 0; i < numChurn; i++)
+   {
+      churn[i].mId = numStable + i + 1;
+      table.insert(churn[i].mId, &churn[i]);
+      if(i >= 100)
+         table.remove(churn[i - 100].mId, &churn[i - 100]);
+   }
+
+   dCompareAndSwap(done, 0, 1);
+   reader1.join();
+   reader2.join();
+
+   EXPECT_EQ(reader1.mErrors, 0);
+   EXPECT_EQ(reader2.mErrors, 0);
+
+   // Nothing is reading anymore, so everything retired can go.
+   ConcurrentHashTableBase::collectRetired();
+}
+
+TEST(ConcurrentHashTable, StressLookup)
+{
+   // Compares lookups against the chained table SimIdDictionary used to
+   // have, and against the std::unordered_map of USE_NEW_SIMDICTIONARY
+   // when that is on, with a million registered objects.  The lookups run
+   // on one thread and then on several at once, as with parallel ticking
+   // and scene prep.  Timings go to the console.
+
+   const U32 numObjects = 1000000;
+   const U32 numLookups = 4000000;
+   const U32 numThreads = 4;
+
+   Vector<TestObject> objects;
+   objects.setSize(numObjects);
+   for(U32 i = 0; i < numObjects; i++)
+      objects[i].mId = i + 1;
+
+   ChainedTable chained;
+   TestTable table;
+   for(U32 i = 0; i < numObjects; i++)
+   {
+      chained.insert(&objects[i]);
+      table.insert(objects[i].mId, &objects[i]);
+   }
+
+   Con::printf("Id lookups, %u lookups among %u objects:", numLookups, numObjects);
+
+   for(U32 threads = 1; threads <= numThreads; threads *= numThreads)
+   {
+      U32 found;
+      const U32 chainedTime = timeLookups(&chained, numObjects, numLookups, threads, found);
+      EXPECT_EQ(found, numLookups);
+      Con::printf("   %u thread(s), chained + mutex:       %u ms (%.1f ns/lookup)", threads, chainedTime, F64(chainedTime) * 1000000.0 / numLookups);
+
+#ifdef USE_NEW_SIMDICTIONARY
+      StdMapTable stdMap;
+      for(U32 i = 0; i < numObjects; i++)
+         stdMap.insert(&objects[i]);
+
+      const U32 stdMapTime = timeLookups(&stdMap, numObjects, numLookups, threads, found);
+      EXPECT_EQ(found, numLookups);
+      Con::printf("   %u thread(s), unordered_map + mutex: %u ms (%.1f ns/lookup)", threads, stdMapTime, F64(stdMapTime) * 1000000.0 / numLookups);
+#endif
+
+      const U32 tableTime = timeLookups(&table, numObjects, numLookups, threads, found);
+      EXPECT_EQ(found, numLookups);
+      Con::printf("   %u thread(s), ConcurrentHashTable:   %u ms (%.1f ns/lookup)", threads, tableTime, F64(tableTime) * 1000000.0 / numLookups);
+   }
+
+   ConcurrentHashTableBase::collectRetired();
+}
+
+#endif
@@ -0,0 +1,289 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "core/util/zip/zipArchive.h"
+#include "core/stream/fileStream.h"
+#include "platform/threads/thread.h"
+#include "console/console.h"
+
+using namespace Zip;
+
+namespace
+{
+   /// Fills a buffer with the contents of test file i and returns its size.
+   /// The contents compress well enough for deflate to be worth it.
+   U32 makeContents(U32 i, U32 maxSize, Vector<U8> &contents)
+   {
+      const U32 size = (i * 2654435761U) % (maxSize + 1);
+      contents.setSize(size);
+      for(U32 j = 0; j < size; j++)
+         contents[j] = (U8)((j / 7) + i * (j % 5));
+      return size;
+   }
+
+   String makeFileName(U32 i)
+   {
+      return String::ToString("dir%u/file%u.dat", i % 16, i);
+   }
+
+   /// Writes a zip with alternately stored and deflated files.
+   bool createTestZip(const char *zipName, U32 numFiles, U32 maxSize)
+   {
+      ZipArchive zip;
+      if(!zip.openArchive(zipName, ZipArchive::Write))
+         return false;
+
+      Vector<U8> contents;
+      for(U32 i = 0; i < numFiles; i++)
+      {
+         Stream *stream = zip.openFileForWrite(makeFileName(i), (i & 1) ? Deflated : Stored);
+         if(!stream)
+            return false;
+
+         makeContents(i, maxSize, contents);
+         stream->write(contents.size(), contents.address());
+         zip.closeFile(stream);
+      }
+
+      zip.closeArchive();
+      return true;
+   }
+
+   /// Reads a file from the zip and returns true if it is as expected.
+   bool readAndCheck(ZipArchive *zip, U32 i, U32 maxSize, Vector<U8> &expected, Vector<U8> &buffer)
+   {
+      const String name = makeFileName(i);
+      ZipArchive::ZipEntry *entry = zip->findZipEntry(name);
+      if(!entry)
+         return false;
+
+      Stream *stream = zip->openFile(name, entry, ZipArchive::Read);
+      if(!stream)
+         return false;
+
+      const U32 size = entry->mCD.mUncompressedSize;
+      buffer.setSize(size);
+      const bool ok = size == 0 || stream->read(size, buffer.address());
+      zip->closeFile(stream);
+
+      makeContents(i, maxSize, expected);
+      return ok && size == expected.size() && dMemcmp(buffer.address(), expected.address(), size) == 0;
+   }
+
+   struct readThread : public Thread
+   {
+      ZipArchive *mZip;
+      U32 mFirst, mCount, mMaxSize;
+      U32 mNumBad;
+
+      readThread(ZipArchive *zip, U32 first, U32 count, U32 maxSize)
+         : mZip(zip), mFirst(first), mCount(count), mMaxSize(maxSize), mNumBad(0) {}
+
+      virtual void run(void*)
+      {
+         Vector<U8> expected, buffer;
+         for(U32 i = mFirst; i < mFirst + mCount; i++)
+            if(!readAndCheck(mZip, i, mMaxSize, expected, buffer))
+               mNumBad++;
+      }
+   };
+
+   /// Reads every file on the given number of threads and returns the
+   /// number of files that didn't read back correctly.
+   U32 readOnThreads(ZipArchive *zip, U32 numFiles, U32 maxSize, U32 numThreads)
+   {
+      Vector<readThread*> threads;
+      const U32 filesPerThread = numFiles / numThreads;
+      for(U32 i = 0; i < numThreads; i++)
+      {
+         const U32 first = i * filesPerThread;
+         const U32 count = (i == numThreads - 1) ? numFiles - first : filesPerThread;
+         threads.push_back(new readThread(zip, first, count, maxSize));
+         threads.last()->start();
+      }
+
+      U32 numBad = 0;
+      for(U32 i = 0; i < numThreads; i++)
+      {
+         threads[i]->join();
+         numBad += threads[i]->mNumBad;
+         delete threads[i];
+      }
+
+      return numBad;
+   }
+}
+
+TEST(ZipArchive, MappedMatchesStream)
+{
+   const char *zipName = "testZipMapped.zip";
+   const U32 numFiles = 200;
+   const U32 maxSize = 20000;
+   ASSERT_TRUE(createTestZip(zipName, numFiles, maxSize)) << "Failed to create the test zip!";
+
+   ZipArchive mapped;
+   ASSERT_TRUE(mapped.openArchive(zipName, ZipArchive::Read));
+   EXPECT_TRUE(mapped.isMapped());
+
+   // Opening from a stream doesn't map the archive.
+   FileStream *fileStream = new FileStream;
+   ASSERT_TRUE(fileStream->open(zipName, Torque::FS::File::Read));
+   ZipArchive unmapped;
+   ASSERT_TRUE(unmapped.openArchive(fileStream, ZipArchive::Read));
+   unmapped.setDiskStream(fileStream);
+   EXPECT_FALSE(unmapped.isMapped());
+
+   U32 numBadMapped = 0;
+   U32 numBadUnmapped = 0;
+   Vector<U8> expected, buffer;
+   for(U32 i = 0; i < numFiles; i++)
+   {
+      numBadMapped += !readAndCheck(&mapped, i, maxSize, expected, buffer);
+      numBadUnmapped += !readAndCheck(&unmapped, i, maxSize, expected, buffer);
+   }
+
+   EXPECT_EQ(numBadMapped, 0) << "Files read from the mapped zip are wrong!";
+   EXPECT_EQ(numBadUnmapped, 0) << "Files read from the zip stream are wrong!";
+
+   // Streams from a mapped zip have positions of their own, so
+   // reading two files in turn doesn't mix them up.
+   for(U32 method = 0; method < 2; method++)
+   {
+      const U32 a = 100 + method;
+      const U32 b = 102 + method;
+      Stream *streamA = mapped.openFile(makeFileName(a));
+      Stream *streamB = mapped.openFile(makeFileName(b));
+      ASSERT_TRUE(streamA && streamB);
+
+      Vector<U8> contentsA, contentsB;
+      makeContents(a, maxSize, contentsA);
+      makeContents(b, maxSize, contentsB);
+
+      U32 numBad = 0;
+      const U32 chunk = 64;
+      for(U32 pos = 0; pos + chunk <= getMin(contentsA.size(), contentsB.size()); pos += chunk)
+      {
+         U8 bufA[chunk], bufB[chunk];
+         streamA->read(chunk, bufA);
+         streamB->read(chunk, bufB);
+         numBad += dMemcmp(bufA, contentsA.address() + pos, chunk) != 0;
+         numBad += dMemcmp(bufB, contentsB.address() + pos, chunk) != 0;
+      }
+      EXPECT_EQ(numBad, 0) << "Interleaved reads from the mapped zip are wrong!";
+
+      mapped.closeFile(streamA);
+      mapped.closeFile(streamB);
+   }
+
+   mapped.closeArchive();
+   unmapped.closeArchive();
+   dFileDelete(zipName);
+}
+
+TEST(ZipArchive, ConcurrentReads)
+{
+   const char *zipName = "testZipConcurrent.zip";
+   const U32 numFiles = 1000;
+   const U32 maxSize = 8000;
+   ASSERT_TRUE(createTestZip(zipName, numFiles, maxSize)) << "Failed to create the test zip!";
+
+   ZipArchive zip;
+   ASSERT_TRUE(zip.openArchive(zipName, ZipArchive::Read));
+   ASSERT_TRUE(zip.isMapped()) << "Concurrent reads need a mapped zip!";
+
+   // Every thread reads every file.
+   Vector<readThread*> threads;
+   for(U32 i = 0; i < 4; i++)
+   {
+      threads.push_back(new readThread(&zip, 0, numFiles, maxSize));
+      threads.last()->start();
+   }
+
+   U32 numBad = 0;
+   for(U32 i = 0; i < threads.size(); i++)
+   {
+      threads[i]->join();
+      numBad += threads[i]->mNumBad;
+      delete threads[i];
+   }
+
+   EXPECT_EQ(numBad, 0) << "Files read concurrently from the mapped zip are wrong!";
+
+   zip.closeArchive();
+   dFileDelete(zipName);
+}
+
+TEST(ZipArchive, StressRead)
+{
+   // Reads every file of a 10k file zip thru the archive stream, from the
+   // mapping, and from the mapping on several threads.  Timings go to the
+   // console.
+
+   const char *zipName = "testZipStress.zip";
+   const U32 numFiles = 10000;
+   const U32 maxSize = 16384;
+   const U32 numThreads = 4;
+   ASSERT_TRUE(createTestZip(zipName, numFiles, maxSize)) << "Failed to create the test zip!";
+
+   U64 totalBytes = 0;
+   Vector<U8> contents;
+   for(U32 i = 0; i < numFiles; i++)
+      totalBytes += makeContents(i, maxSize, contents);
+
+   FileStream *fileStream = new FileStream;
+   ASSERT_TRUE(fileStream->open(zipName, Torque::FS::File::Read));
+   ZipArchive unmapped;
+   ASSERT_TRUE(unmapped.openArchive(fileStream, ZipArchive::Read));
+   unmapped.setDiskStream(fileStream);
+
+   ZipArchive mapped;
+   ASSERT_TRUE(mapped.openArchive(zipName, ZipArchive::Read));
+   ASSERT_TRUE(mapped.isMapped());
+
+   U32 start = Platform::getRealMilliseconds();
+   EXPECT_EQ(readOnThreads(&unmapped, numFiles, maxSize, 1), 0);
+   const U32 streamTime = Platform::getRealMilliseconds() - start;
+
+   start = Platform::getRealMilliseconds();
+   EXPECT_EQ(readOnThreads(&mapped, numFiles, maxSize, 1), 0);
+   const U32 mappedTime = Platform::getRealMilliseconds() - start;
+
+   start = Platform::getRealMilliseconds();
+   EXPECT_EQ(readOnThreads(&mapped, numFiles, maxSize, numThreads), 0);
+   const U32 threadedTime = Platform::getRealMilliseconds() - start;
+
+   const F32 totalMB = totalBytes / (1024.0f * 1024.0f);
+   Con::printf("Zip reads, %u files, %.1f MB:", numFiles, totalMB);
+   Con::printf("   archive stream:       %u ms (%.1f MB/s)", streamTime, totalMB * 1000.0f / getMax(streamTime, 1U));
+   Con::printf("   mapped:               %u ms (%.1f MB/s)", mappedTime, totalMB * 1000.0f / getMax(mappedTime, 1U));
+   Con::printf("   mapped, %u threads:    %u ms (%.1f MB/s)", numThreads, threadedTime, totalMB * 1000.0f / getMax(threadedTime, 1U));
+
+   mapped.closeArchive();
+   unmapped.closeArchive();
+   dFileDelete(zipName);
+}
+
+#endif
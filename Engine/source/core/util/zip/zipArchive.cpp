@@ -25,7 +25,9 @@
 
 #include "core/stream/stream.h"
 #include "core/stream/fileStream.h"
+#include "core/stream/memStream.h"
 #include "core/filterStream.h"
+#include "core/volume.h"
 #include "core/util/zip/zipCryptStream.h"
 #include "core/crc.h"
 //#include "core/resManager.h"
@@ -48,6 +50,41 @@
 namespace Zip
 {
 
+//-----------------------------------------------------------------------------
+// ZipMappedRStream (Internal)
+//-----------------------------------------------------------------------------
+
+/// A read only stream over part of a mapped archive.  Every file opened from
+/// a mapped archive gets one of these with its own position.  It is deleted
+/// by ZipArchive::closeFile().
+class ZipMappedRStream : public MemStream, public IStreamByteCount
+{
+   typedef MemStream Parent;
+
+   U32 mLastBytesRead;
+
+public:
+   ZipMappedRStream(const U8 *data, U32 size)
+      // MemStream doesn't allow empty buffers.
+      : Parent(size > 0 ? size : 1, const_cast<U8*>(data), true, false),
+        mLastBytesRead(0)
+   {
+      mStreamSize = size;
+   }
+
+   // IStreamByteCount
+   U32 getLastBytesRead() { return mLastBytesRead; }
+   U32 getLastBytesWritten() { return 0; }
+
+protected:
+   bool _read(const U32 in_numBytes, void *out_pBuffer)
+   {
+      const U32 remaining = mStreamSize - mCurrentPosition;
+      mLastBytesRead = in_numBytes < remaining ? in_numBytes : remaining;
+      return Parent::_read(in_numBytes, out_pBuffer);
+   }
+};
+
 //-----------------------------------------------------------------------------
 // Constructor/Destructor
 //-----------------------------------------------------------------------------
@@ -592,7 +629,12 @@ bool ZipArchive::openArchive(const char *filename, AccessMode mode /* = Read */)
       setFilename(filename);
 
       if(openArchive(mDiskStream, mode))
+      {
+         if(mode == Read)
+            mapArchive(filename);
+
          return true;
+      }
    }
    
    // Cleanup just in case openArchive() failed
@@ -642,6 +684,8 @@ void ZipArchive::closeArchive()
    }
    mTempFiles.clear();
 
+   mMappedFile.close();
+
    // Close the zip file stream and clean up
    if(mDiskStream)
    {
@@ -658,6 +702,30 @@ void ZipArchive::closeArchive()
    mEntries.clear();
 }
 
+bool ZipArchive::mapArchive(const char *filename)
+{
+   mMappedFile.close();
+
+   if(mMode != Read || mStream == NULL)
+      return false;
+
+   Torque::Path fsPath;
+   if(! Torque::FS::GetFSPath(filename, fsPath) || ! mMappedFile.open(fsPath.getFullPath()))
+      return false;
+
+   // Make sure we mapped the same file that we read the central directory from.
+   if(mMappedFile.getSize() != mStream->getStreamSize())
+   {
+      if(isVerbose())
+         Con::errorf("ZipArchive::mapArchive - %s: The mapped file doesn't match the archive stream", filename);
+
+      mMappedFile.close();
+      return false;
+   }
+
+   return true;
+}
+
 //-----------------------------------------------------------------------------
 Stream * ZipArchive::openFile(const char *filename, AccessMode mode /* = Read */)
 {
@@ -700,6 +768,36 @@ Stream * ZipArchive::openFile(const char *filename, ZipEntry* ze, AccessMode mod
    return NULL;
 }
 
+Stream *ZipArchive::openFileForWrite(const char *filename, S32 compressMethod)
+{
+   if(mMode != Write && mMode != ReadWrite)
+      return NULL;
+
+   Compressor *comp = Compressor::findCompressor(compressMethod);
+   if(comp == NULL)
+   {
+      if(isVerbose())
+         Con::errorf("ZipArchive::openFileForWrite - Unsupported compression method (%d) for file %s", compressMethod, filename);
+      return NULL;
+   }
+
+   ZipEntry *ze = findZipEntry(filename);
+   if(ze)
+   {
+      if(ze->mCD.mInternalFlags & CDFileOpen)
+      {
+         if(isVerbose())
+            Con::errorf("ZipArchive::openFileForWrite - File %s is already open", filename);
+         return NULL;
+      }
+
+      // Remove the old entry so we can create a new one
+      removeEntry(ze);
+   }
+
+   return createNewFile(filename, comp);
+}
+
 void ZipArchive::closeFile(Stream *stream)
 {
    FilterStream *currentStream, *nextStream;
@@ -717,6 +815,13 @@ void ZipArchive::closeFile(Stream *stream)
       delete currentStream;
    }
 
+   // Streams over a mapped archive belong to the file.
+   if(dynamic_cast<ZipMappedRStream *>(stream))
+   {
+      delete stream;
+      return;
+   }
+
    ZipTempStream *tempStream = dynamic_cast<ZipTempStream *>(stream);
    if(tempStream && (tempStream->getCentralDir()->mInternalFlags & CDFileOpen))
    {
@@ -765,6 +870,43 @@ Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
          return NULL;
       }
    }
+   else if(mMappedFile.isOpen())
+   {
+      // Read from the mapping with a stream of our own so
+      // that we don't have to share a position with anyone.
+      const U8 *data = mMappedFile.getData();
+      const U64 size = mMappedFile.getSize();
+
+      if(fileCD->mLocalHeadOffset >= size)
+      {
+         if(isVerbose())
+            Con::errorf("ZipArchive::openFile - %s: Could not locate local header for file %s", mFilename ? mFilename : "<no filename>", fileCD->mFilename.c_str());
+         return NULL;
+      }
+
+      ZipMappedRStream headerStream(data + fileCD->mLocalHeadOffset, (U32)(size - fileCD->mLocalHeadOffset));
+      FileHeader fh;
+      if(! fh.read(&headerStream))
+      {
+         if(isVerbose())
+            Con::errorf("ZipArchive::openFile - %s: Could not read local header for file %s", mFilename ? mFilename : "<no filename>", fileCD->mFilename.c_str());
+         return NULL;
+      }
+
+      const U64 dataOffset = fileCD->mLocalHeadOffset + headerStream.getPosition();
+      if(dataOffset + fileCD->mCompressedSize > size)
+      {
+         if(isVerbose())
+            Con::errorf("ZipArchive::openFile - %s: File %s runs past the end of the archive", mFilename ? mFilename : "<no filename>", fileCD->mFilename.c_str());
+         return NULL;
+      }
+
+      stream = new ZipMappedRStream(data + dataOffset, fileCD->mCompressedSize);
+
+      // Stored files need no filtering at all.
+      if(fileCD->mCompressMethod == Stored && !(fileCD->mFlags & Encrypted))
+         return stream;
+   }
    else
    {
       // Read from the zip file directly
@@ -803,6 +945,7 @@ Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
          if(! cryptStream->attachStream(stream))
          {
             delete cryptStream;
+            closeFile(stream);
             return NULL;
          }
 
@@ -815,10 +958,18 @@ Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
    {
       if(isVerbose())
          Con::errorf("ZipArchive::openFile - %s: Unsupported compression method (%d) for file %s", mFilename ? mFilename : "<no filename>", fileCD->mCompressMethod, fileCD->mFilename.c_str());
+
+      closeFile(attachTo);
       return NULL;
    }
 
-   return comp->createReadStream(fileCD, attachTo);
+   Stream *readStream = comp->createReadStream(fileCD, attachTo);
+
+   // Don't leak a stream over the mapping if the compressor failed.
+   if(readStream == NULL)
+      closeFile(attachTo);
+
+   return readStream;
 }
 
 //-----------------------------------------------------------------------------
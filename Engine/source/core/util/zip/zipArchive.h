@@ -25,6 +25,7 @@
 #include "core/util/zip/compressor.h"
 
 #include "core/stream/fileStream.h"
+#include "platform/platformMemoryMappedFile.h"
 
 #include "core/util/tVector.h"
 #include "core/util/tDictionary.h"
@@ -305,6 +306,11 @@ protected:
    FileStream *mDiskStream;
    AccessMode mMode;
 
+   /// The archive file mapped into memory.  While this is open files
+   /// are read from the mapping and mStream is left alone, so any
+   /// number of threads can read from the archive at once.
+   MemoryMappedFile mMappedFile;
+
    EndOfCentralDir mEOCD;
 
    // mRoot forms a tree of entries for fast queries given a file path
@@ -450,6 +456,26 @@ public:
    /// @see ZipArchive::openArchive(Stream *, AccessMode), ZipArchive::openArchive(const char *, AccessMode)
    //-----------------------------------------------------------------------------
    virtual void closeArchive();
+
+   //-----------------------------------------------------------------------------
+   /// @brief Map the archive file into memory for reading
+   ///
+   /// Once mapped, every stream returned by openFile() reads from the mapping
+   /// with a position of its own.  Stored files are read directly from the
+   /// mapping and deflated files are inflated by each stream.  This makes it
+   /// safe to read from the archive on several threads at once.
+   ///
+   /// This is done for you by openArchive(const char *, AccessMode) in Read
+   /// mode.  It fails if the archive isn't open for Read, or the file isn't on
+   /// a native volume, in which case files are read thru the archive stream.
+   ///
+   /// @param filename Filename of the zip file that was opened
+   /// @return true if the archive is now mapped
+   //-----------------------------------------------------------------------------
+   bool mapArchive(const char *filename);
+
+   /// Returns true if the archive is mapped into memory.
+   bool isMapped() const { return mMappedFile.isOpen(); }
    // @}
 
    /// @name Stream Based File Access Methods
@@ -476,6 +502,18 @@ public:
    virtual Stream *openFile(const char *filename, AccessMode mode = Read);
    virtual Stream *openFile(const char *filename, ZipEntry* ze, AccessMode = Read);
 
+   //-----------------------------------------------------------------------------
+   /// @brief Open a new file within the zip file for write
+   ///
+   /// Like openFile() in Write mode, but with a choice of compression method.
+   ///
+   /// @param filename Filename of the file in the zip
+   /// @param compressMethod The compression method, such as Stored or Deflated
+   /// @return Pointer to stream or NULL for failure
+   /// @see ZipArchive::openFile(const char *, AccessMode), ZipArchive::closeFile()
+   //-----------------------------------------------------------------------------
+   Stream *openFileForWrite(const char *filename, S32 compressMethod);
+
    //-----------------------------------------------------------------------------
    /// @brief Close a file opened through openFile()
    ///
@@ -40,10 +40,11 @@ class ZipFileNode : public Torque::FS::File, public Noncopyable
    // ZipFileNode class (Internal)
    //--------------------------------------------------------------------------
 public:
-   ZipFileNode(StrongRefPtr<ZipArchive>& archive, String zipFilename, Stream* zipStream, ZipArchive::ZipEntry* ze) 
+   ZipFileNode(ZipArchiveHolder* holder, String zipFilename, Stream* zipStream, ZipArchive::ZipEntry* ze) 
    {
       mZipStream = zipStream;
-      mArchive = archive;
+      mHolder = holder;
+      mArchive = holder->mArchive;
       mZipFilename = zipFilename;
       mByteCount = dynamic_cast<IStreamByteCount*>(mZipStream);
       AssertFatal(mByteCount, "error, zip stream interface does not implement IStreamByteCount");
@@ -154,7 +155,8 @@ public:
       };
 
       Stream* mZipStream;
-      StrongRefPtr<ZipArchive> mArchive;
+      ThreadSafeRef<ZipArchiveHolder> mHolder;
+      ZipArchive* mArchive;
       ZipArchive::ZipEntry* mZipEntry;
       String mZipFilename;
       IStreamByteCount* mByteCount;
@@ -167,10 +169,11 @@ public:
 class ZipDirectoryNode : public Torque::FS::Directory, public Noncopyable
 {
 public:
-   ZipDirectoryNode(StrongRefPtr<ZipArchive>& archive, const Torque::Path& path, ZipArchive::ZipEntry* ze)
+   ZipDirectoryNode(ZipArchiveHolder* holder, const Torque::Path& path, ZipArchive::ZipEntry* ze)
    {
       mPath = path;
-      mArchive = archive;
+      mHolder = holder;
+      mArchive = holder->mArchive;
       mZipEntry = ze;
       if (mZipEntry)
          mChildIter = mZipEntry->mChildren.end();
@@ -207,7 +210,7 @@ public:
       // reset iterator
       if (mZipEntry)
          mChildIter = mZipEntry->mChildren.begin();
-      return (mZipEntry != NULL && mArchive.getPointer() != NULL);
+      return (mZipEntry != NULL && mArchive != NULL);
    }
    bool close()
    {
@@ -249,7 +252,8 @@ private:
 
    Torque::Path mPath;
    Map<String,ZipArchive::ZipEntry*>::Iterator mChildIter;
-   StrongRefPtr<ZipArchive> mArchive;
+   ThreadSafeRef<ZipArchiveHolder> mHolder;
+   ZipArchive* mArchive;
    ZipArchive::ZipEntry* mZipEntry;
 };
 
@@ -260,10 +264,11 @@ private:
 class ZipFakeRootNode : public Torque::FS::Directory, public Noncopyable
 {
 public:
-   ZipFakeRootNode(StrongRefPtr<ZipArchive>& archive, const Torque::Path& path, const String &fakeRoot)
+   ZipFakeRootNode(ZipArchiveHolder* holder, const Torque::Path& path, const String &fakeRoot)
    {
       mPath = path;
-      mArchive = archive;
+      mHolder = holder;
+      mArchive = holder->mArchive;
       mRead = false;
       mFakeRoot = fakeRoot;
    }
@@ -299,7 +304,7 @@ public:
    bool open()
    {
       mRead = false;
-      return (mArchive.getPointer() != NULL);
+      return (mArchive != NULL);
    }
    bool close()
    {
@@ -340,7 +345,8 @@ private:
 
    Torque::Path mPath;
    Map<String,ZipArchive::ZipEntry*>::Iterator mChildIter;
-   StrongRefPtr<ZipArchive> mArchive;
+   ThreadSafeRef<ZipArchiveHolder> mHolder;
+   ZipArchive* mArchive;
    bool mRead;
    String mFakeRoot;
 };
@@ -384,19 +390,28 @@ ZipFileSystem::~ZipFileSystem()
 
 FileNodeRef ZipFileSystem::resolve(const Path& path)
 {
-   if (!mInitted)
+   if (!dAtomicRead(mInitted))
+   {
+      MutexHandle handle;
+      handle.lock(&mInitMutex, true);
       _init();
+   }
 
-   if (mZipArchive.isNull())
+   // The archive was published before mInitted so it is safe to read
+   // here.  It doesn't change again until the file system is deleted.
+   ZipArchiveHolder* holder = mZipArchive;
+   if (holder == NULL || holder->mArchive.isNull())
       return NULL;
 
+   ZipArchive* archive = holder->mArchive;
+
    // eat leading "/"
    String name = path.getFullPathWithoutRoot();
    if (name.find("/") == 0)
       name = name.substr(1, name.length() - 1);
 
    if(name.isEmpty() && mZipNameIsDir)
-      return new ZipFakeRootNode(mZipArchive, path, mFakeRoot);
+      return new ZipFakeRootNode(holder, path, mFakeRoot);
 
    if(mZipNameIsDir)
    {
@@ -422,26 +437,26 @@ FileNodeRef ZipFileSystem::resolve(const Path& path)
    // check for request of root directory
    if (name.isEmpty())
    {
-      ZipDirectoryNode* zdn = new ZipDirectoryNode(mZipArchive, path, mZipArchive->getRoot());
+      ZipDirectoryNode* zdn = new ZipDirectoryNode(holder, path, archive->getRoot());
       return zdn;
    }
 
-   ZipArchive::ZipEntry* ze = mZipArchive->findZipEntry(name);
+   ZipArchive::ZipEntry* ze = archive->findZipEntry(name);
    if (ze == NULL)
       return NULL;
 
    if (ze->mIsDirectory)
    {
-      ZipDirectoryNode* zdn = new ZipDirectoryNode(mZipArchive, path, ze);
+      ZipDirectoryNode* zdn = new ZipDirectoryNode(holder, path, ze);
       return zdn;
    }
 
    // pass in the zip entry so that openFile() doesn't need to look it up again.
-   Stream* stream = mZipArchive->openFile(name, ze, ZipArchive::Read);
+   Stream* stream = archive->openFile(name, ze, ZipArchive::Read);
    if (stream == NULL)
       return NULL;
 
-   ZipFileNode* zfn = new ZipFileNode(mZipArchive, name, stream, ze);
+   ZipFileNode* zfn = new ZipFileNode(holder, name, stream, ze);
    return zfn;
 }
 
@@ -449,25 +464,36 @@ void ZipFileSystem::_init()
 {
    if (mInitted)
       return;
-   mInitted = true;
 
-   if (!mZipArchive.isNull())
-      return;
-   if (mZipArchiveStream->getStatus() != Stream::Ok)
+   if (mZipArchive != NULL || mZipArchiveStream->getStatus() != Stream::Ok)
+   {
+      dCompareAndSwap(mInitted, 0, 1);
       return;
+   }
 
-   mZipArchive = new ZipArchive();
-   if (!mZipArchive->openArchive(mZipArchiveStream, ZipArchive::Read))
+   StrongRefPtr<ZipArchive> archive = new ZipArchive();
+   if (!archive->openArchive(mZipArchiveStream, ZipArchive::Read))
    {
       Con::errorf("ZipFileSystem: failed to open zip archive %s", mZipFilename.c_str());
+      mZipArchive = new ZipArchiveHolder(archive);
+      dCompareAndSwap(mInitted, 0, 1);
       return;
    }
 
    // tell the archive that it owns the zipStream now
-   mZipArchive->setDiskStream(mZipArchiveStream);
+   archive->setDiskStream(mZipArchiveStream);
    // and null it out because we don't own it anymore
    mZipArchiveStream = NULL;
 
+   // Map the archive so that files can be read from it
+   // on several threads at once.
+   archive->mapArchive(mZipFilename);
+
+   // Only publish the archive once it is ready.  The swap is a full
+   // barrier so resolve() sees the archive once it sees mInitted.
+   mZipArchive = new ZipArchiveHolder(archive);
+   dCompareAndSwap(mInitted, 0, 1);
+
    // for debugging
    //mZipArchive->dumpCentralDirectory();
 }
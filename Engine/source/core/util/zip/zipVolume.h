@@ -26,12 +26,25 @@
 #include "core/util/str.h"
 #include "core/util/zip/zipArchive.h"
 #include "core/util/autoPtr.h"
+#include "platform/threads/mutex.h"
+#include "platform/threads/threadSafeRefCount.h"
 
 namespace Torque
 {
    using namespace FS;
    using namespace Zip;
 
+/// Shares an archive between the nodes resolved from it.  The archive is
+/// counted by StrongRefPtr which isn't thread safe, so the nodes hold this
+/// instead and only the last one to go releases the archive.
+class ZipArchiveHolder : public ThreadSafeRefCount< ZipArchiveHolder >
+{
+public:
+   ZipArchiveHolder(ZipArchive *archive) : mArchive(archive) {}
+
+   StrongRefPtr<ZipArchive> mArchive;
+};
+
 class ZipFileSystem: public FileSystem
 {
 public:
@@ -53,17 +66,22 @@ public:
 
 public:
    /// Private interface for use by unit test only. 
-   StrongRefPtr<ZipArchive> getArchive() { return mZipArchive; }
+   StrongRefPtr<ZipArchive> getArchive() { return mZipArchive ? mZipArchive->mArchive : StrongRefPtr<ZipArchive>(); }
 
 private:
    void _init();
 
-   bool mInitted;
+   /// Guards the lazy opening of the archive.  Once it is open
+   /// files can be resolved and read from any thread.
+   Mutex mInitMutex;
+
+   /// Set with a full barrier once the archive is published.
+   volatile U32 mInitted;
    bool mZipNameIsDir;
    String mZipFilename;
    String mFakeRoot;
    FileStream* mZipArchiveStream;
-   StrongRefPtr<ZipArchive> mZipArchive;
+   ThreadSafeRef<ZipArchiveHolder> mZipArchive;
 };
 
 }
@@ -80,6 +80,7 @@ GFXD3D9Device::GFXD3D9Device( LPDIRECT3D9 d3d, U32 index )
    mCreateFenceType = -1; // Unknown, test on first allocate
 
    mCurrentConstBuffer = NULL;
+   mConstShadow.invalidate();
 
    mOcclusionQuerySupported = false;
 
@@ -203,7 +204,7 @@ void GFXD3D9Device::setShaderConstBufferInternal(GFXShaderConstBuffer* buffer)
       AssertFatal(dynamic_cast<GFXD3D9ShaderConstBuffer*>(buffer), "Incorrect shader const buffer type for this device!");
       GFXD3D9ShaderConstBuffer* d3dBuffer = static_cast<GFXD3D9ShaderConstBuffer*>(buffer);
 
-      d3dBuffer->activate(mCurrentConstBuffer);
+      mDeviceStatistics.mShaderConstBytes += d3dBuffer->activate(mCurrentConstBuffer, &mConstShadow);
       mCurrentConstBuffer = d3dBuffer;
    } else {
       mCurrentConstBuffer = NULL;
@@ -403,6 +404,7 @@ void GFXD3D9Device::releaseDefaultPoolResources()
    // activate may erroneously think the device is still holding
    // this state and fail to set it.   
    mCurrentConstBuffer = NULL;
+   mConstShadow.invalidate();
 
    // Set current VB to NULL and set state dirty
    for ( U32 i=0; i < VERTEX_STREAM_COUNT; i++ )
@@ -43,6 +43,9 @@
 #ifndef _GFXD3D9PRIMITIVEBUFFER_H_
 #include "gfx/D3D9/gfxD3D9PrimitiveBuffer.h"
 #endif
+#ifndef _GFXD3D9SHADER_H_
+#include "gfx/D3D9/gfxD3D9Shader.h"
+#endif
 #ifndef _GFXINIT_H_
 #include "gfx/gfxInit.h"
 #endif
@@ -214,6 +217,8 @@ protected:
    /// Track the last const buffer we've used.  Used to notify new constant buffers that
    /// they should send all of their constants up
    StrongRefPtr<GFXD3D9ShaderConstBuffer> mCurrentConstBuffer;
+   /// The shader constants the device currently holds.
+   GFXD3D9ShaderConstShadow mConstShadow;
    /// Called by base GFXDevice to actually set a const buffer
    virtual void setShaderConstBufferInternal(GFXShaderConstBuffer* buffer);
 
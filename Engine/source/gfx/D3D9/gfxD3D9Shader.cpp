@@ -467,7 +467,7 @@ bool GFXD3D9ShaderConstBuffer::isDirty()
    return ret;
 }
 
-void GFXD3D9ShaderConstBuffer::activate( GFXD3D9ShaderConstBuffer *prevShaderBuffer )
+U32 GFXD3D9ShaderConstBuffer::activate( GFXD3D9ShaderConstBuffer *prevShaderBuffer, GFXD3D9ShaderConstShadow *shadow )
 {
    PROFILE_SCOPE(GFXD3D9ShaderConstBuffer_activate);
 
@@ -477,78 +477,69 @@ void GFXD3D9ShaderConstBuffer::activate( GFXD3D9ShaderConstBuffer *prevShaderBuf
    // Alot of the calls here are inlined... be careful 
    // what you change.
 
-   // If the buffer has changed we need to compare it
-   // with the new buffer to see if we can skip copying
-   // equal buffer content.
+   // If the buffer has changed then all of its content
+   // has to be checked against what the card holds.  The
+   // per-frame and per-view constants are usually equal 
+   // to what the last buffer sent, so they get skipped.
    //
    // If the buffer hasn't changed then we only will
-   // be copying the changes that have occured since
+   // be checking the changes that have occured since
    // the last activate call.
    //
    if ( prevShaderBuffer != this )
    {
-      // If the previous buffer is dirty, than we can't compare 
-      // against it, because it hasn't sent its contents to the
-      // card yet and must be copied.
-      if ( prevShaderBuffer && !prevShaderBuffer->isDirty() )
-      {
-         PROFILE_SCOPE(GFXD3D9ShaderConstBuffer_activate_dirty_check_1);
-
-         // If the buffer content is equal then we set the dirty
-         // flag to false knowing the current state of the card matches
-         // the new buffer.
-         //
-         // If the content is not equal we set the dirty flag to
-         // true which causes the full content of the buffer to be
-         // copied to the card.
-         //
-         mVertexConstBufferF->setDirty( !prevShaderBuffer->mVertexConstBufferF->isEqual( mVertexConstBufferF ) );
-         mPixelConstBufferF->setDirty( !prevShaderBuffer->mPixelConstBufferF->isEqual( mPixelConstBufferF ) );
-         mVertexConstBufferI->setDirty( !prevShaderBuffer->mVertexConstBufferF->isEqual( mVertexConstBufferI ) );
-         mPixelConstBufferI->setDirty( !prevShaderBuffer->mPixelConstBufferF->isEqual( mPixelConstBufferI ) );
-      } 
-      else
-      {
-         // This happens rarely... but it can happen.
-         //
-         // We copy the entire dirty state to the card.
-
-         PROFILE_SCOPE(GFXD3D9ShaderConstBuffer_activate_dirty_check_2);
-
-         mVertexConstBufferF->setDirty( true );
-         mPixelConstBufferF->setDirty( true );
-         mVertexConstBufferI->setDirty( true );
-         mPixelConstBufferI->setDirty( true );
-      }      
+      mVertexConstBufferF->setDirty( true );
+      mPixelConstBufferF->setDirty( true );
+      mVertexConstBufferI->setDirty( true );
+      mPixelConstBufferI->setDirty( true );
    }
 
-   const U32 bytesToFloat4 = 16;
-   const U32 bytesToInt4 = 16;
+   const U32 bytesToFloat4 = GFXD3D9ShaderConstShadow::RegisterSize;
+   const U32 bytesToInt4 = GFXD3D9ShaderConstShadow::RegisterSize;
    U32 start, bufferSize;      
+   U32 bytesUploaded = 0;
    const U8* buf;
 
+   // Only the runs of registers which differ from the
+   // shadow of the card state are uploaded.
    if ( mVertexConstBufferF->isDirty() )
    {
-      buf = mVertexConstBufferF->getDirtyBuffer( &start, &bufferSize );
-      mDevice->SetVertexShaderConstantF( start / bytesToFloat4, (float*)buf, bufferSize / bytesToFloat4 );
+      start = bufferSize = 0;
+      while ( ( buf = mVertexConstBufferF->getNextChangedRange( shadow->vertexF, shadow->vertexFValid, bytesToFloat4, &start, &bufferSize ) ) != NULL )
+      {
+         mDevice->SetVertexShaderConstantF( start / bytesToFloat4, (float*)buf, bufferSize / bytesToFloat4 );
+         bytesUploaded += bufferSize;
+      }
    }
 
    if ( mPixelConstBufferF->isDirty() )    
    {
-      buf = mPixelConstBufferF->getDirtyBuffer( &start, &bufferSize );
-      mDevice->SetPixelShaderConstantF( start / bytesToFloat4, (float*)buf, bufferSize / bytesToFloat4 );      
+      start = bufferSize = 0;
+      while ( ( buf = mPixelConstBufferF->getNextChangedRange( shadow->pixelF, shadow->pixelFValid, bytesToFloat4, &start, &bufferSize ) ) != NULL )
+      {
+         mDevice->SetPixelShaderConstantF( start / bytesToFloat4, (float*)buf, bufferSize / bytesToFloat4 );
+         bytesUploaded += bufferSize;
+      }
    }
 
    if ( mVertexConstBufferI->isDirty() )
    {
-      buf = mVertexConstBufferI->getDirtyBuffer( &start, &bufferSize );
-      mDevice->SetVertexShaderConstantI( start / bytesToInt4, (int*)buf, bufferSize / bytesToInt4 );
+      start = bufferSize = 0;
+      while ( ( buf = mVertexConstBufferI->getNextChangedRange( shadow->vertexI, shadow->vertexIValid, bytesToInt4, &start, &bufferSize ) ) != NULL )
+      {
+         mDevice->SetVertexShaderConstantI( start / bytesToInt4, (int*)buf, bufferSize / bytesToInt4 );
+         bytesUploaded += bufferSize;
+      }
    }
 
    if ( mPixelConstBufferI->isDirty() )    
    {
-      buf = mPixelConstBufferI->getDirtyBuffer( &start, &bufferSize );
-      mDevice->SetPixelShaderConstantI( start / bytesToInt4, (int*)buf, bufferSize / bytesToInt4 );      
+      start = bufferSize = 0;
+      while ( ( buf = mPixelConstBufferI->getNextChangedRange( shadow->pixelI, shadow->pixelIValid, bytesToInt4, &start, &bufferSize ) ) != NULL )
+      {
+         mDevice->SetPixelShaderConstantI( start / bytesToInt4, (int*)buf, bufferSize / bytesToInt4 );
+         bytesUploaded += bufferSize;
+      }
    }
 
    #ifdef TORQUE_DEBUG
@@ -566,6 +557,8 @@ void GFXD3D9ShaderConstBuffer::activate( GFXD3D9ShaderConstBuffer *prevShaderBuf
 
    // Clear the lost state.
    mWasLost = false;
+
+   return bytesUploaded;
 }
 
 void GFXD3D9ShaderConstBuffer::onShaderReload( GFXD3D9Shader *shader )
@@ -106,6 +106,44 @@ public:
 };
 
 
+/// A copy of the shader constant registers last uploaded to the
+/// device, which lets constant buffers skip the registers the device
+/// already holds.  The registers are shared by all shaders, so this
+/// is owned by the device.
+struct GFXD3D9ShaderConstShadow
+{
+   enum
+   {
+      RegisterSize = 16,
+      VertexRegistersF = 256,
+      PixelRegistersF = 224,
+      RegistersI = 16
+   };
+
+   U8 vertexF[ VertexRegistersF * RegisterSize ];
+   U8 pixelF[ PixelRegistersF * RegisterSize ];
+   U8 vertexI[ RegistersI * RegisterSize ];
+   U8 pixelI[ RegistersI * RegisterSize ];
+
+   /// One bit per register which is set once the
+   /// shadow register holds what the device does.
+   U32 vertexFValid[ ( VertexRegistersF + 31 ) / 32 ];
+   U32 pixelFValid[ ( PixelRegistersF + 31 ) / 32 ];
+   U32 vertexIValid[ ( RegistersI + 31 ) / 32 ];
+   U32 pixelIValid[ ( RegistersI + 31 ) / 32 ];
+
+   /// Called when the device registers are lost.  Every register
+   /// is uploaded again the next time a buffer sets it.
+   void invalidate()
+   {
+      dMemset( vertexFValid, 0, sizeof( vertexFValid ) );
+      dMemset( pixelFValid, 0, sizeof( pixelFValid ) );
+      dMemset( vertexIValid, 0, sizeof( vertexIValid ) );
+      dMemset( pixelIValid, 0, sizeof( pixelIValid ) );
+   }
+};
+
+
 /// The D3D9 implementation of a shader constant buffer.
 class GFXD3D9ShaderConstBuffer : public GFXShaderConstBuffer
 {
@@ -122,7 +160,9 @@ public:
 
    /// Called by GFXD3D9Device to activate this buffer.
    /// @param mPrevShaderBuffer The previously active buffer
-   void activate( GFXD3D9ShaderConstBuffer *prevShaderBuffer );
+   /// @param shadow The constants the device currently holds.
+   /// @return The number of constant bytes uploaded.
+   U32 activate( GFXD3D9ShaderConstBuffer *prevShaderBuffer, GFXD3D9ShaderConstShadow *shadow );
    
    /// Used internally by GXD3D9ShaderConstBuffer to determine if it's dirty.
    bool isDirty();
@@ -31,6 +31,9 @@
 #include "gfx/gfxTextureManager.h"
 #include "gfx/bitmap/gBitmap.h"
 #include "core/util/safeDelete.h"
+#include "core/util/tDictionary.h"
+#include "core/volume.h"
+#include "console/console.h"
 
 
 GFXAdapter::CreateDeviceInstanceDelegate GFXNullDevice::mCreateDeviceInstance(GFXNullDevice::createInstance); 
@@ -234,11 +237,13 @@ void GFXNullPrimitiveBuffer::unlock()
 class GFXNullStateBlock : public GFXStateBlock
 {
 public:
+   GFXNullStateBlock(const GFXStateBlockDesc& desc) : mDesc(desc) { }
+
    /// Returns the hash value of the desc that created this block
-   virtual U32 getHashValue() const { return 0; };
+   virtual U32 getHashValue() const { return mDesc.getHashValue(); };
 
    /// Returns a GFXStateBlockDesc that this block represents
-   virtual const GFXStateBlockDesc& getDesc() const { return mDefaultDesc; }
+   virtual const GFXStateBlockDesc& getDesc() const { return mDesc; }
 
    //
    // GFXResource
@@ -247,9 +252,606 @@ public:
    /// When called the resource should restore all device sensitive information destroyed by zombify()
    virtual void resurrect() { }
 private:
-   GFXStateBlockDesc mDefaultDesc;
+   GFXStateBlockDesc mDesc;
+};
+
+//
+// GFXNullTextureTarget
+//
+class GFXNullTextureTarget : public GFXTextureTarget
+{
+public:
+   GFXNullTextureTarget() : mSize( 1, 1 ) { }
+
+   virtual const Point2I getSize() { return mSize; }
+   virtual GFXFormat getFormat() { return GFXFormatR8G8B8A8; }
+
+   virtual void attachTexture( RenderSlot slot, GFXTextureObject *tex, U32 mipLevel = 0, U32 zOffset = 0 )
+   {
+      if ( slot == Color0 && tex && tex->getWidth() && tex->getHeight() )
+         mSize.set( tex->getWidth(), tex->getHeight() );
+   }
+   virtual void attachTexture( RenderSlot slot, GFXCubemap *tex, U32 face, U32 mipLevel = 0 ) { }
+   virtual void resolve() { }
+
+   virtual void zombify() { }
+   virtual void resurrect() { }
+
+private:
+   Point2I mSize;
+};
+
+//
+// GFXNullShader
+//
+class GFXNullShader;
+
+class GFXNullShaderConstHandle : public GFXShaderConstHandle
+{
+public:
+   GFXNullShaderConstHandle( const String &name )
+      :  mInstancingConstant( false ),
+         mOffset( 0 ),
+         mSize( 0 ),
+         mSamplerRegister( -1 )
+   {
+      mDesc.name = name;
+      mDesc.constType = GFXSCT_Float;
+      mDesc.arraySize = 1;
+   }
+
+   void reinit( const GFXShaderConstDesc &desc, S32 samplerRegister );
+   void setValid( bool valid ) { mValid = valid; }
+
+   virtual const String& getName() const { return mDesc.name; }
+   virtual GFXShaderConstType getType() const { return mDesc.constType; }
+   virtual U32 getArraySize() const { return mDesc.arraySize; }
+   virtual S32 getSamplerRegister() const { return mSamplerRegister; }
+
+   GFXShaderConstDesc mDesc;
+
+   /// True if this constant is stepped per instance and lives
+   /// in the instance data rather than the const buffer.
+   bool mInstancingConstant;
+
+   U32 mOffset;
+   U32 mSize;
+   S32 mSamplerRegister;
+};
+
+class GFXNullShaderConstBuffer : public GFXShaderConstBuffer
+{
+public:
+   GFXNullShaderConstBuffer( GFXNullShader *shader );
+   virtual ~GFXNullShaderConstBuffer();
+
+   /// Called by GFXNullDevice to activate this buffer.
+   /// @return The number of constant bytes a device would upload.
+   U32 activate();
+
+   /// Called when the shader this buffer references is reloaded.
+   void onShaderReload();
+
+   // GFXShaderConstBuffer
+   virtual GFXShader* getShader();
+   virtual void set( GFXShaderConstHandle *handle, const F32 fv ) { _set( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const Point2F &fv ) { _set( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const Point3F &fv ) { _set( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const Point4F &fv ) { _set( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const PlaneF &fv ) { _set( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const ColorF &fv ) { _set( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const S32 f ) { _set( handle, f ); }
+   virtual void set( GFXShaderConstHandle *handle, const Point2I &fv ) { _set( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const Point3I &fv ) { _set( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const Point4I &fv ) { _set( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const AlignedArray<F32> &fv ) { _setArray( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const AlignedArray<Point2F> &fv ) { _setArray( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const AlignedArray<Point3F> &fv ) { _setArray( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const AlignedArray<Point4F> &fv ) { _setArray( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const AlignedArray<S32> &fv ) { _setArray( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const AlignedArray<Point2I> &fv ) { _setArray( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const AlignedArray<Point3I> &fv ) { _setArray( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const AlignedArray<Point4I> &fv ) { _setArray( handle, fv ); }
+   virtual void set( GFXShaderConstHandle *handle, const MatrixF &mat, const GFXShaderConstType matrixType = GFXSCT_Float4x4 );
+   virtual void set( GFXShaderConstHandle *handle, const MatrixF *mat, const U32 arraySize, const GFXShaderConstType matrixType = GFXSCT_Float4x4 );
+
+   // GFXResource
+   virtual const String describeSelf() const { return String(); }
+   virtual void zombify() { }
+   virtual void resurrect() { }
+
+private:
+
+   WeakRefPtr<GFXNullShader> mShader;
+   U8 *mBuffer;
+
+   /// Returns where the value of a handle is stored.
+   U8* _getValue( GFXShaderConstHandle *handle, U32 *outSize );
+
+   template<typename ConstType>
+   void _set( GFXShaderConstHandle *handle, const ConstType &value )
+   {
+      U32 size;
+      U8 *buf = _getValue( handle, &size );
+      dMemcpy( buf, &value, getMin( size, (U32)sizeof( ConstType ) ) );
+   }
+
+   template<typename ConstType>
+   void _setArray( GFXShaderConstHandle *handle, const AlignedArray<ConstType> &fv )
+   {
+      U32 size;
+      U8 *buf = _getValue( handle, &size );
+      const U32 count = getMin( fv.size(), handle->getArraySize() );
+      const U32 stride = size / handle->getArraySize();
+      for ( U32 i = 0; i < count; i++ )
+         dMemcpy( buf + i * stride, &fv[i], getMin( stride, (U32)sizeof( ConstType ) ) );
+   }
+};
+
+/// A shader which is never compiled.  The uniforms are found by scanning
+/// the shader sources, so the same constants are valid as on a GPU and the
+/// constants which changed between activations are counted as uploaded.
+class GFXNullShader : public GFXShader
+{
+   typedef Map<String, GFXNullShaderConstHandle*> HandleMap;
+
+public:
+
+   GFXNullShader();
+   virtual ~GFXNullShader();
+
+   // GFXShader
+   virtual GFXShaderConstBufferRef allocConstBuffer();
+   virtual const Vector<GFXShaderConstDesc>& getShaderConstDesc() const { return mConstants; }
+   virtual GFXShaderConstHandle* getShaderConstHandle( const String &name );
+   virtual GFXShaderConstHandle* findShaderConstHandle( const String &name );
+   virtual U32 getAlignmentValue( const GFXShaderConstType constType ) const { return getConstTypeSize( constType ); }
+
+   // GFXResource
+   virtual void zombify();
+   virtual void resurrect() { }
+
+   /// Returns the size in bytes of one element of a constant type.
+   static U32 getConstTypeSize( GFXShaderConstType constType );
+
+protected:
+
+   friend class GFXNullShaderConstBuffer;
+
+   virtual bool _init();
+
+   /// Adds the uniforms declared in a shader source to the constants.
+   /// Nothing is preprocessed, so uniforms in disabled blocks are added too.
+   void _parseConstants( const char *source );
+
+   /// Adds the per instance constants of the instancing format.
+   void _initInstancingHandles();
+
+   /// Copies the constants of a buffer which differ from the last
+   /// activated ones and returns how many bytes that was.
+   U32 _uploadConstants( const U8 *buffer );
+
+   Vector<GFXShaderConstDesc> mConstants;
+   Vector<S32> mSamplerRegisters;
+   HandleMap mHandles;
+   Vector<GFXNullShaderConstHandle*> mValidHandles;
+
+   U32 mConstBufferSize;
+
+   /// The constants as they were last activated.
+   U8 *mConstShadow;
 };
 
+void GFXNullShaderConstHandle::reinit( const GFXShaderConstDesc &desc, S32 samplerRegister )
+{
+   mDesc = desc;
+   mSamplerRegister = samplerRegister;
+   mInstancingConstant = false;
+   mOffset = 0;
+   mSize = GFXNullShader::getConstTypeSize( desc.constType ) * desc.arraySize;
+   mValid = true;
+}
+
+GFXNullShaderConstBuffer::GFXNullShaderConstBuffer( GFXNullShader *shader )
+   :  mShader( shader ),
+      mBuffer( NULL )
+{
+   onShaderReload();
+}
+
+GFXNullShaderConstBuffer::~GFXNullShaderConstBuffer()
+{
+   delete [] mBuffer;
+
+   if ( mShader )
+      mShader->_unlinkBuffer( this );
+}
+
+GFXShader* GFXNullShaderConstBuffer::getShader()
+{
+   return mShader;
+}
+
+U32 GFXNullShaderConstBuffer::activate()
+{
+   mWasLost = false;
+   return mShader->_uploadConstants( mBuffer );
+}
+
+void GFXNullShaderConstBuffer::onShaderReload()
+{
+   delete [] mBuffer;
+   mBuffer = new U8[ mShader->mConstBufferSize ];
+   dMemset( mBuffer, 0, mShader->mConstBufferSize );
+   mWasLost = true;
+}
+
+U8* GFXNullShaderConstBuffer::_getValue( GFXShaderConstHandle *handle, U32 *outSize )
+{
+   AssertFatal( handle && handle->isValid(), "GFXNullShaderConstBuffer::set - Handle is not valid!" );
+   AssertFatal( dynamic_cast<GFXNullShaderConstHandle*>( handle ), "GFXNullShaderConstBuffer::set - Incorrect const buffer type!" );
+
+   GFXNullShaderConstHandle *nullHandle = static_cast<GFXNullShaderConstHandle*>( handle );
+   *outSize = nullHandle->mSize;
+
+   if ( nullHandle->mInstancingConstant )
+   {
+      AssertFatal( mInstPtr, "GFXNullShaderConstBuffer::set - No instance data to set!" );
+      return mInstPtr + nullHandle->mOffset;
+   }
+
+   return mBuffer + nullHandle->mOffset;
+}
+
+void GFXNullShaderConstBuffer::set( GFXShaderConstHandle *handle, const MatrixF &mat, const GFXShaderConstType matrixType )
+{
+   U32 size;
+   U8 *buf = _getValue( handle, &size );
+   dMemcpy( buf, (const F32*)mat, getMin( size, (U32)sizeof( MatrixF ) ) );
+}
+
+void GFXNullShaderConstBuffer::set( GFXShaderConstHandle *handle, const MatrixF *mat, const U32 arraySize, const GFXShaderConstType matrixType )
+{
+   U32 size;
+   U8 *buf = _getValue( handle, &size );
+   const U32 count = getMin( arraySize, handle->getArraySize() );
+   const U32 stride = size / handle->getArraySize();
+   for ( U32 i = 0; i < count; i++ )
+      dMemcpy( buf + i * stride, (const F32*)mat[i], getMin( stride, (U32)sizeof( MatrixF ) ) );
+}
+
+GFXNullShader::GFXNullShader()
+   :  mConstBufferSize( 0 ),
+      mConstShadow( NULL )
+{
+}
+
+GFXNullShader::~GFXNullShader()
+{
+   for ( HandleMap::Iterator iter = mHandles.begin(); iter != mHandles.end(); ++iter )
+      delete iter->value;
+
+   delete [] mConstShadow;
+}
+
+U32 GFXNullShader::getConstTypeSize( GFXShaderConstType constType )
+{
+   switch ( constType )
+   {
+      case GFXSCT_Float2:
+      case GFXSCT_Int2:
+         return 8;
+      case GFXSCT_Float3:
+      case GFXSCT_Int3:
+         return 12;
+      case GFXSCT_Float4:
+      case GFXSCT_Int4:
+      case GFXSCT_Float2x2:
+         return 16;
+      case GFXSCT_Float3x3:
+         return 36;
+      case GFXSCT_Float4x4:
+         return 64;
+      default:
+         return 4;
+   }
+}
+
+bool GFXNullShader::_init()
+{
+   // Don't initialize empty shaders.
+   if ( mVertexFile.isEmpty() && mPixelFile.isEmpty() )
+      return false;
+
+   mConstants.clear();
+   mSamplerRegisters.clear();
+
+   const Torque::Path *files[2] = { &mVertexFile, &mPixelFile };
+   for ( U32 i = 0; i < 2; i++ )
+   {
+      if ( files[i]->isEmpty() )
+         continue;
+
+      void *source;
+      U32 sourceSize;
+      if ( !Torque::FS::ReadFile( *files[i], source, sourceSize, true ) )
+      {
+         if ( smLogErrors )
+            Con::errorf( "GFXNullShader::_init - Failed to open shader file '%s'.", files[i]->getFullPath().c_str() );
+         return false;
+      }
+
+      _parseConstants( (const char*)source );
+      delete [] (U8*)source;
+   }
+
+   // Mark all the existing handles as invalid, then create or
+   // reinitialize the ones which the shader has.
+   for ( HandleMap::Iterator iter = mHandles.begin(); iter != mHandles.end(); ++iter )
+      iter->value->setValid( false );
+
+   for ( U32 i = 0; i < mConstants.size(); i++ )
+   {
+      const GFXShaderConstDesc &desc = mConstants[i];
+
+      HandleMap::Iterator iter = mHandles.find( desc.name );
+      if ( iter == mHandles.end() )
+         iter = mHandles.insert( desc.name, new GFXNullShaderConstHandle( desc.name ) );
+
+      iter->value->reinit( desc, mSamplerRegisters[i] );
+   }
+
+   // Lay out the const buffer.
+   mValidHandles.clear();
+   mConstBufferSize = 0;
+   for ( HandleMap::Iterator iter = mHandles.begin(); iter != mHandles.end(); ++iter )
+   {
+      GFXNullShaderConstHandle *handle = iter->value;
+      if ( !handle->isValid() )
+         continue;
+
+      handle->mOffset = mConstBufferSize;
+      mConstBufferSize += handle->mSize;
+      mValidHandles.push_back( handle );
+   }
+
+   delete [] mConstShadow;
+   mConstShadow = new U8[ mConstBufferSize ];
+   dMemset( mConstShadow, 0, mConstBufferSize );
+
+   _initInstancingHandles();
+
+   // Notify buffers of the new layout.
+   for ( U32 i = 0; i < mActiveBuffers.size(); i++ )
+      static_cast<GFXNullShaderConstBuffer*>( mActiveBuffers[i] )->onShaderReload();
+
+   return true;
+}
+
+namespace
+{
+   bool isIdentChar( char c )
+   {
+      return dIsalnum( c ) || c == '_';
+   }
+
+   const char* skipSpace( const char *pos )
+   {
+      while ( *pos && dIsspace( *pos ) )
+         pos++;
+      return pos;
+   }
+
+   /// Copies the identifier at @a pos into @a out and returns the
+   /// position after it.
+   const char* readIdent( const char *pos, char *out, U32 outSize )
+   {
+      U32 len = 0;
+      while ( isIdentChar( *pos ) )
+      {
+         if ( len + 1 < outSize )
+            out[len++] = *pos;
+         pos++;
+      }
+      out[len] = 0;
+      return pos;
+   }
+
+   /// Maps an HLSL or GLSL type name to a constant type.
+   bool getConstType( const char *typeName, GFXShaderConstType *outType )
+   {
+      static const struct { const char *name; GFXShaderConstType type; } sTypes[] =
+      {
+         { "float", GFXSCT_Float },       { "half", GFXSCT_Float },
+         { "float2", GFXSCT_Float2 },     { "half2", GFXSCT_Float2 },     { "vec2", GFXSCT_Float2 },
+         { "float3", GFXSCT_Float3 },     { "half3", GFXSCT_Float3 },     { "vec3", GFXSCT_Float3 },
+         { "float4", GFXSCT_Float4 },     { "half4", GFXSCT_Float4 },     { "vec4", GFXSCT_Float4 },
+         { "float2x2", GFXSCT_Float2x2 }, { "mat2", GFXSCT_Float2x2 },
+         { "float3x3", GFXSCT_Float3x3 }, { "mat3", GFXSCT_Float3x3 },
+         { "float4x4", GFXSCT_Float4x4 }, { "mat4", GFXSCT_Float4x4 },
+         { "int", GFXSCT_Int },           { "bool", GFXSCT_Int },
+         { "int2", GFXSCT_Int2 },         { "ivec2", GFXSCT_Int2 },
+         { "int3", GFXSCT_Int3 },         { "ivec3", GFXSCT_Int3 },
+         { "int4", GFXSCT_Int4 },         { "ivec4", GFXSCT_Int4 },
+         { "samplerCUBE", GFXSCT_SamplerCube }, { "samplerCube", GFXSCT_SamplerCube },
+      };
+
+      for ( U32 i = 0; i < sizeof( sTypes ) / sizeof( sTypes[0] ); i++ )
+      {
+         if ( dStrcmp( typeName, sTypes[i].name ) == 0 )
+         {
+            *outType = sTypes[i].type;
+            return true;
+         }
+      }
+
+      // All the other samplers are 1D, 2D or 3D textures.
+      if ( dStrncmp( typeName, "sampler", 7 ) == 0 )
+      {
+         *outType = GFXSCT_Sampler;
+         return true;
+      }
+
+      return false;
+   }
+}
+
+void GFXNullShader::_parseConstants( const char *source )
+{
+   U32 numSamplers = 0;
+   for ( U32 i = 0; i < mConstants.size(); i++ )
+   {
+      if ( mSamplerRegisters[i] != -1 )
+         numSamplers++;
+   }
+
+   const char *pos = source;
+   while ( ( pos = dStrstr( pos, "uniform" ) ) != NULL )
+   {
+      const bool isWord = ( pos == source || !isIdentChar( pos[-1] ) ) && dIsspace( pos[7] );
+      pos += 7;
+      if ( !isWord )
+         continue;
+
+      char typeName[32];
+      char name[64];
+      pos = readIdent( skipSpace( pos ), typeName, sizeof( typeName ) );
+      pos = readIdent( skipSpace( pos ), name, sizeof( name ) );
+
+      GFXShaderConstDesc desc;
+      if ( !name[0] || !getConstType( typeName, &desc.constType ) )
+         continue;
+
+      desc.name = String::ToString( "$%s", name );
+      desc.arraySize = 1;
+
+      pos = skipSpace( pos );
+      if ( *pos == '[' )
+         desc.arraySize = getMax( dAtoi( pos + 1 ), 1 );
+
+      // Constants used by both shaders are only added once.
+      bool found = false;
+      for ( U32 i = 0; i < mConstants.size() && !found; i++ )
+         found = mConstants[i].name == desc.name;
+      if ( found )
+         continue;
+
+      S32 samplerRegister = -1;
+      if ( desc.constType == GFXSCT_Sampler || desc.constType == GFXSCT_SamplerCube )
+      {
+         // Use the HLSL register binding if there is one, then the
+         // order of the sampler names like OpenGL does.
+         const U32 declLength = dStrcspn( pos, ",;)" );
+         const char *binding = dStrstr( pos, "register(" );
+         if ( binding && binding < pos + declLength )
+            samplerRegister = dAtoi( skipSpace( binding + 9 ) + 1 );
+         else
+         {
+            samplerRegister = mSamplerNamesOrdered.find_next( desc.name );
+            if ( samplerRegister == -1 )
+               samplerRegister = numSamplers;
+         }
+
+         numSamplers++;
+      }
+
+      mConstants.push_back( desc );
+      mSamplerRegisters.push_back( samplerRegister );
+   }
+}
+
+void GFXNullShader::_initInstancingHandles()
+{
+   // The per instance constants are laid out in the
+   // order of the elements of the instancing format.
+   U32 offset = 0;
+   for ( U32 i = 0; i < mInstancingFormat.getElementCount(); i++ )
+   {
+      const GFXVertexElement &element = mInstancingFormat.getElement( i );
+
+      GFXShaderConstDesc desc;
+      desc.name = String::ToString( "$%s", element.getSemantic().c_str() );
+      desc.constType = element.getType() == GFXDeclType_Float4 ? GFXSCT_Float4 : GFXSCT_Float;
+      desc.arraySize = 1;
+
+      U32 size = element.getSizeInBytes();
+
+      // A matrix is split into several elements with the same semantic.
+      while ( i + 1 < mInstancingFormat.getElementCount() &&
+              mInstancingFormat.getElement( i + 1 ).getSemantic() == element.getSemantic() )
+      {
+         i++;
+         desc.arraySize++;
+         size += mInstancingFormat.getElement( i ).getSizeInBytes();
+      }
+
+      if ( desc.arraySize == 4 && desc.constType == GFXSCT_Float4 )
+      {
+         desc.constType = GFXSCT_Float4x4;
+         desc.arraySize = 1;
+      }
+
+      HandleMap::Iterator iter = mHandles.find( desc.name );
+      if ( iter == mHandles.end() )
+         iter = mHandles.insert( desc.name, new GFXNullShaderConstHandle( desc.name ) );
+
+      GFXNullShaderConstHandle *handle = iter->value;
+      handle->reinit( desc, -1 );
+      handle->mInstancingConstant = true;
+      handle->mOffset = offset;
+      handle->mSize = size;
+
+      offset += size;
+   }
+}
+
+U32 GFXNullShader::_uploadConstants( const U8 *buffer )
+{
+   U32 bytesUploaded = 0;
+   for ( U32 i = 0; i < mValidHandles.size(); i++ )
+   {
+      const GFXNullShaderConstHandle *handle = mValidHandles[i];
+      if ( dMemcmp( mConstShadow + handle->mOffset, buffer + handle->mOffset, handle->mSize ) == 0 )
+         continue;
+
+      dMemcpy( mConstShadow + handle->mOffset, buffer + handle->mOffset, handle->mSize );
+      bytesUploaded += handle->mSize;
+   }
+
+   return bytesUploaded;
+}
+
+GFXShaderConstBufferRef GFXNullShader::allocConstBuffer()
+{
+   GFXNullShaderConstBuffer *buffer = new GFXNullShaderConstBuffer( this );
+   buffer->registerResourceWithDevice( getOwningDevice() );
+   mActiveBuffers.push_back( buffer );
+   return buffer;
+}
+
+GFXShaderConstHandle* GFXNullShader::getShaderConstHandle( const String &name )
+{
+   HandleMap::Iterator iter = mHandles.find( name );
+   if ( iter != mHandles.end() )
+      return iter->value;
+
+   // The constant may appear when the shader is reloaded.
+   GFXNullShaderConstHandle *handle = new GFXNullShaderConstHandle( name );
+   mHandles.insert( name, handle );
+   return handle;
+}
+
+GFXShaderConstHandle* GFXNullShader::findShaderConstHandle( const String &name )
+{
+   HandleMap::Iterator iter = mHandles.find( name );
+   return iter != mHandles.end() ? iter->value : NULL;
+}
+
+void GFXNullShader::zombify()
+{
+   dMemset( mConstShadow, 0, mConstBufferSize );
+}
+
 //
 // GFXNullDevice
 //
@@ -263,6 +865,15 @@ GFXNullDevice::GFXNullDevice()
 {
    clip.set(0, 0, 800, 800);
 
+   // Shaders are generated in HLSL, like on every other device which
+   // isn't OpenGL, so there is a shader model where the HLSL generator
+   // is built.
+#if defined( TORQUE_OS_WIN ) || defined( TORQUE_OS_XENON )
+   mPixVersion = 3.0f;
+#else
+   mPixVersion = 0.0f;
+#endif
+
    mTextureManager = new GFXNullTextureManager();
    gScreenShot = new ScreenShot();
    mCardProfiler = new GFXNullCardProfiler();
@@ -321,11 +932,57 @@ void GFXNullDevice::init( const GFXVideoMode &mode, PlatformWindow *window )
 {
    mCardProfiler = new GFXNullCardProfiler();
    mCardProfiler->init();
+
+   deviceInited();
 }
 
 GFXStateBlockRef GFXNullDevice::createStateBlockInternal(const GFXStateBlockDesc& desc)
 {
-   return new GFXNullStateBlock();
+   return new GFXNullStateBlock(desc);
+}
+
+GFXShader* GFXNullDevice::createShader()
+{
+   GFXNullShader *shader = new GFXNullShader();
+   shader->registerResourceWithDevice( this );
+   return shader;
+}
+
+void GFXNullDevice::setShaderConstBufferInternal( GFXShaderConstBuffer *buffer )
+{
+   if ( !buffer )
+      return;
+
+   AssertFatal( dynamic_cast<GFXNullShaderConstBuffer*>( buffer ), "GFXNullDevice::setShaderConstBufferInternal - Incorrect shader const buffer type for this device!" );
+   mDeviceStatistics.mShaderConstBytes += static_cast<GFXNullShaderConstBuffer*>( buffer )->activate();
+}
+
+GFXTextureTarget* GFXNullDevice::allocRenderToTextureTarget()
+{
+   GFXNullTextureTarget *target = new GFXNullTextureTarget();
+   target->registerResourceWithDevice( this );
+   return target;
+}
+
+void GFXNullDevice::drawPrimitive( GFXPrimitiveType primType, U32 vertexStart, U32 primitiveCount )
+{
+   updateStates();
+
+   mDeviceStatistics.mDrawCalls++;
+   mDeviceStatistics.mPolyCount += primitiveCount;
+}
+
+void GFXNullDevice::drawIndexedPrimitive( GFXPrimitiveType primType, 
+                                          U32 startVertex, 
+                                          U32 minIndex, 
+                                          U32 numVerts, 
+                                          U32 startIndex, 
+                                          U32 primitiveCount )
+{
+   updateStates();
+
+   mDeviceStatistics.mDrawCalls++;
+   mDeviceStatistics.mPolyCount += primitiveCount;
 }
 
 //
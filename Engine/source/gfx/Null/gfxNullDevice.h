@@ -95,7 +95,7 @@ protected:
    /// @}
 
    /// Called by base GFXDevice to actually set a const buffer
-   virtual void setShaderConstBufferInternal(GFXShaderConstBuffer* buffer) { };
+   virtual void setShaderConstBufferInternal(GFXShaderConstBuffer* buffer);
 
    virtual void setTextureInternal(U32 textureUnit, const GFXTextureObject*texture) { };
 
@@ -132,7 +132,7 @@ public:
 
    ///@}
 
-   virtual GFXTextureTarget *allocRenderToTextureTarget(){return NULL;};
+   virtual GFXTextureTarget *allocRenderToTextureTarget();
    virtual GFXWindowTarget *allocWindowTarget(PlatformWindow *window)
    {
       return new GFXNullWindowTarget();
@@ -140,25 +140,30 @@ public:
 
    virtual void _updateRenderTargets(){};
 
-   virtual F32 getPixelShaderVersion() const { return 0.0f; };
-   virtual void setPixelShaderVersion( F32 version ) { };
-   virtual U32 getNumSamplers() const { return 0; };
-   virtual U32 getNumRenderTargets() const { return 0; };
+   virtual F32 getPixelShaderVersion() const { return mPixVersion; };
+   virtual void setPixelShaderVersion( F32 version ) { mPixVersion = version; };
+   virtual U32 getNumSamplers() const { return TEXTURE_STAGE_COUNT; };
+   virtual U32 getNumRenderTargets() const { return 1; };
 
-   virtual GFXShader* createShader() { return NULL; };
+   // Shaders are never compiled, but they know their constants, so
+   // shader materials, constant uploads and instancing run as they
+   // would on a GPU.
+   virtual GFXShader* createShader();
 
 
    virtual void clear( U32 flags, ColorI color, F32 z, U32 stencil ) { };
    virtual bool beginSceneInternal() { return true; };
    virtual void endSceneInternal() { };
 
-   virtual void drawPrimitive( GFXPrimitiveType primType, U32 vertexStart, U32 primitiveCount ) { };
+   // Draws are only counted, so the render path can be benchmarked
+   // without a GPU.
+   virtual void drawPrimitive( GFXPrimitiveType primType, U32 vertexStart, U32 primitiveCount );
    virtual void drawIndexedPrimitive(  GFXPrimitiveType primType, 
                                        U32 startVertex, 
                                        U32 minIndex, 
                                        U32 numVerts, 
                                        U32 startIndex, 
-                                       U32 primitiveCount ) { };
+                                       U32 primitiveCount );
 
    virtual void setClipRect( const RectI &rect ) { };
    virtual const RectI &getClipRect() const { return clip; };
@@ -180,6 +185,8 @@ public:
 private:
    typedef GFXDevice Parent;
    RectI clip;
+
+   F32 mPixVersion;
 };
 
 #endif
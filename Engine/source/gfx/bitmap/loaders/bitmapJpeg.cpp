@@ -30,6 +30,11 @@
 static bool sReadJPG(Stream &stream, GBitmap *bitmap);
 static bool sWriteJPG(GBitmap *bitmap, Stream &stream, U32 compressionLevel);
 
+static S32 jpegReadDataFn(void *client_data, U8 *data, S32 length);
+static S32 jpegWriteDataFn(void *client_data, U8 *data, S32 length);
+static S32 jpegFlushDataFn(void *);
+static S32 jpegErrorFn(void *client_data);
+
 static struct _privateRegisterJPG
 {
    _privateRegisterJPG()
@@ -44,6 +49,13 @@ static struct _privateRegisterJPG
       reg.writeFunc = sWriteJPG;
 
       GBitmap::sRegisterFormat( reg );
+
+      // Bind our stream functions to the jpeg library once here.  These
+      // are globals and images are decoded on several threads at once.
+      JFREAD  = jpegReadDataFn;
+      JFWRITE = jpegWriteDataFn;
+      JFFLUSH = jpegFlushDataFn;
+      JFERROR = jpegErrorFn;
    }
 } sStaticRegisterJPG;
 
@@ -97,9 +109,6 @@ static S32 jpegErrorFn(void *client_data)
 //--------------------------------------
 static bool sReadJPG(Stream &stream, GBitmap *bitmap)
 {
-   JFREAD  = jpegReadDataFn;
-   JFERROR = jpegErrorFn;
-
    jpeg_decompress_struct cinfo;
    jpeg_error_mgr jerr;
 
@@ -188,12 +197,6 @@ static bool sWriteJPG(GBitmap *bitmap, Stream &stream, U32 compressionLevel)
    if (bitmap->getHeight() > MAX_HEIGHT)
       return false;
 
-   // Bind our own stream writing, error, and memory flush functions
-   // to the jpeg library interface
-   JFWRITE = jpegWriteDataFn;
-   JFFLUSH = jpegFlushDataFn;
-   JFERROR = jpegErrorFn;
-
    // Allocate and initialize our jpeg compression structure and error manager
    jpeg_compress_struct cinfo;
    jpeg_error_mgr jerr;
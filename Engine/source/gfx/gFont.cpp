@@ -29,6 +29,7 @@
 #include "core/strings/findMatch.h"
 #include "core/strings/stringFunctions.h"
 #include "core/util/endian.h"
+#include "core/util/hashFunction.h"
 #include "core/util/safeDelete.h"
 #include "console/console.h"
 #include "console/engineAPI.h"
@@ -203,6 +204,8 @@ GFont::GFont()
    for (U32 i = 0; i < (sizeof(mRemapTable) / sizeof(S32)); i++)
       mRemapTable[i] = -1;
 
+   _resetMetricCaches();
+
    mCurX = mCurY = mCurSheet = -1;
 
    mPlatformFont = NULL;
@@ -389,6 +392,31 @@ const PlatformFont::CharInfo &GFont::getCharInfo(const UTF16 in_charIndex)
     return mCharInfoList[mRemapTable[in_charIndex]];
 }
 
+void GFont::_cacheAsciiGlyph(const UTF16 in_charIndex)
+{
+   AsciiGlyph &glyph = mAsciiGlyphs[in_charIndex];
+
+   // Char 0 terminates strings and has no glyph.
+   if(in_charIndex == 0 || !isValidChar(in_charIndex))
+   {
+      glyph.xIncrement = 0;
+      glyph.width = 0;
+      glyph.state = GlyphInvalid;
+      return;
+   }
+
+   const PlatformFont::CharInfo& rChar = getCharInfo(in_charIndex);
+   glyph.xIncrement = rChar.xIncrement;
+   glyph.width = rChar.width;
+   glyph.state = GlyphValid;
+}
+
+void GFont::_resetMetricCaches()
+{
+   dMemset(mAsciiGlyphs, 0, sizeof(mAsciiGlyphs));
+   dMemset(mLineWidthCache, 0, sizeof(mLineWidthCache));
+}
+
 const PlatformFont::CharInfo &GFont::getDefaultCharInfo()
 {
    static PlatformFont::CharInfo c;
@@ -419,12 +447,73 @@ U32 GFont::getStrWidthPrecise(const UTF8* in_pString)
 }
 
 //-----------------------------------------------------------------------------
+bool GFont::_isAsciiString(const UTF8 *str, U32 n, U32 &outLen)
+{
+   bool ascii = true;
+   U32 i;
+   for(i = 0; i < n && str[i]; i++)
+   {
+      if(U8(str[i]) >= AsciiGlyphCount)
+         ascii = false;
+   }
+
+   outLen = i;
+   return ascii;
+}
+
+U64 GFont::_getLineKey(const UTF8 *str, U32 len, bool precise)
+{
+   Torque::IncrementalHash64 hash;
+   hash.addU32(len);
+   hash.addU32(precise);
+   hash.add(str, len);
+
+   // Zero marks an empty cache slot.
+   const U64 key = hash.getHash();
+   return key ? key : 1;
+}
+
+bool GFont::_findLineWidth(U64 key, U32 &outWidth) const
+{
+   const LineWidth &entry = mLineWidthCache[key % LineWidthCacheSize];
+   if(entry.key != key)
+      return false;
+
+   outWidth = entry.width;
+   return true;
+}
+
+void GFont::_storeLineWidth(U64 key, U32 width)
+{
+   LineWidth &entry = mLineWidthCache[key % LineWidthCacheSize];
+   entry.key = key;
+   entry.width = width;
+}
+
 U32 GFont::getStrNWidth(const UTF8 *str, U32 n)
 {
+   U32 len;
+   if(_isAsciiString(str, n, len))
+   {
+      // Plain ASCII maps one to one onto UTF16, so measure it in place.
+      U32 totWidth = 0;
+      for(U32 i = 0; i < len; i++)
+         totWidth += _getCharAdvance(str[i]);
+      return totWidth;
+   }
+
+   U32 width;
+   const U64 key = _getLineKey(str, len, false);
+   if(_findLineWidth(key, width))
+      return width;
+
    // UTF8 conversion is expensive. Avoid converting in a tight loop.
    FrameTemp<UTF16> str16(n + 1);
    convertUTF8toUTF16N(str, str16, n + 1);
-   return getStrNWidth(str16, dStrlen(str16));
+   width = getStrNWidth(str16, dStrlen(str16));
+
+   _storeLineWidth(key, width);
+   return width;
 }
 
 U32 GFont::getStrNWidth(const UTF16 *str, U32 n)
@@ -444,16 +533,7 @@ U32 GFont::getStrNWidth(const UTF16 *str, U32 n)
       if(curChar == '\0')
          break;
 
-      if(isValidChar(curChar))
-      {
-         const PlatformFont::CharInfo& rChar = getCharInfo(curChar);
-         totWidth += rChar.xIncrement;
-      }
-      else if (curChar == dT('\t'))
-      {
-         const PlatformFont::CharInfo& rChar = getCharInfo(dT(' '));
-         totWidth += rChar.xIncrement * TabWidthInSpaces;
-      }
+      totWidth += _getCharAdvance(curChar);
    }
 
    return(totWidth);
@@ -461,9 +541,34 @@ U32 GFont::getStrNWidth(const UTF16 *str, U32 n)
 
 U32 GFont::getStrNWidthPrecise(const UTF8 *str, U32 n)
 {
+   U32 len;
+   if(_isAsciiString(str, n, len))
+   {
+      if(len == 0)
+         return 0;
+
+      U32 totWidth = 0;
+      for(U32 i = 0; i < len; i++)
+         totWidth += _getCharAdvance(str[i]);
+
+      U32 xIncrement, width;
+      if(getGlyphMetrics(str[len - 1], xIncrement, width) && width != xIncrement)
+         totWidth += (width - xIncrement);
+
+      return totWidth;
+   }
+
+   U32 width;
+   const U64 key = _getLineKey(str, len, true);
+   if(_findLineWidth(key, width))
+      return width;
+
    FrameTemp<UTF16> str16(n + 1);
    convertUTF8toUTF16N(str, str16, n + 1);
-   return getStrNWidthPrecise(str16, dStrlen(str16));
+   width = getStrNWidthPrecise(str16, dStrlen(str16));
+
+   _storeLineWidth(key, width);
+   return width;
 }
 
 U32 GFont::getStrNWidthPrecise(const UTF16 *str, U32 n)
@@ -483,25 +588,16 @@ U32 GFont::getStrNWidthPrecise(const UTF16 *str, U32 n)
       if(curChar == '\0')
          break;
          
-      if(isValidChar(curChar))
-      {
-         const PlatformFont::CharInfo& rChar = getCharInfo(curChar);
-         totWidth += rChar.xIncrement;
-      }
-      else if (curChar == dT('\t'))
-      {
-         const PlatformFont::CharInfo& rChar = getCharInfo(dT(' '));
-         totWidth += rChar.xIncrement * TabWidthInSpaces;
-      }
+      totWidth += _getCharAdvance(curChar);
    }
 
    UTF16 endChar = str[getMin(charCount,n-1)];
 
-   if (isValidChar(endChar))
+   U32 xIncrement, width;
+   if (getGlyphMetrics(endChar, xIncrement, width))
    {
-      const PlatformFont::CharInfo& rChar = getCharInfo(endChar);
-      if (rChar.width != rChar.xIncrement)
-         totWidth += (rChar.width - rChar.xIncrement);
+      if (width != xIncrement)
+         totWidth += (width - xIncrement);
    }
 
    return(totWidth);
@@ -527,7 +623,8 @@ U32 GFont::getBreakPos(const UTF16 *str16, U32 slen, U32 width, bool breakOnWhit
       if(c == dT('\t'))
          c = dT(' ');
       
-      if(!isValidChar(c))
+      U32 charXIncrement, charWidth;
+      if(!getGlyphMetrics(c, charXIncrement, charWidth))
       {
          ret++;
          continue;
@@ -536,15 +633,14 @@ U32 GFont::getBreakPos(const UTF16 *str16, U32 slen, U32 width, bool breakOnWhit
       if(c == dT(' '))
          lastws = ret+1;
 
-      const PlatformFont::CharInfo& rChar = getCharInfo(c);
-      if(rChar.width > width || rChar.xIncrement > width)
+      if(charWidth > width || charXIncrement > width)
       {
          if(lastws && breakOnWhitespace)
             return lastws;
          return ret;
       }
 
-      width -= rChar.xIncrement;
+      width -= charXIncrement;
       
       ret++;
    }
@@ -565,6 +661,7 @@ void GFont::wrapString(const UTF8 *txt, U32 lineWidth, Vector<U32> &startLineOff
    U32 len = dStrlen(txt);
 
    U32 startLine; 
+   U32 charXIncrement, charWidth;
 
    for (U32 i = 0; i < len;)
    {
@@ -581,9 +678,9 @@ void GFont::wrapString(const UTF8 *txt, U32 lineWidth, Vector<U32> &startLineOff
             needsNewLine = true;
             break;
          }
-         else if(isValidChar(txt[i]))
+         else if(getGlyphMetrics(txt[i], charXIncrement, charWidth))
          {
-            lineStrWidth += getCharInfo(txt[i]).xIncrement;
+            lineStrWidth += charXIncrement;
             if( lineStrWidth > lineWidth )
             {
                needsNewLine = true;
@@ -733,6 +830,9 @@ bool GFont::read(Stream& io_rStream)
       for(i = minGlyph; i <= maxGlyph; i++)
          mRemapTable[i] = convertBEndianToHost(mRemapTable[i]);
    }
+
+   // The glyphs were all replaced.
+   _resetMetricCaches();
    
    return (io_rStream.getStatus() == Stream::Ok);
 }
@@ -938,6 +1038,9 @@ void GFont::importStrip(const char *fileName, U32 padding, U32 kerning)
       curWidth += ri.extent.x;
    }
 
+   // The widths and advances changed above.
+   _resetMetricCaches();
+
    // Ok, we have a big list of glyphmaps now. So let's sort them, then pack them.
    dQsort(glyphList.address(), glyphList.size(), sizeof(GlyphMap), GlyphMapCompare);
 
@@ -50,6 +50,8 @@ public:
    {
       TabWidthInSpaces = 3,
       TextureSheetSize = 256,
+      AsciiGlyphCount = 128,
+      LineWidthCacheSize = 64,
    };
 
 public:
@@ -69,6 +71,14 @@ public:
    
    bool isValidChar(const UTF16 in_charIndex) const;
 
+   /// Get the horizontal metrics of a character.  ASCII characters are
+   /// served from a flat per-font table, so this is the preferred way to
+   /// measure text in a loop.
+   ///
+   /// @return False if the font has no glyph for the character, in which
+   ///         case xIncrement and width are undefined.
+   bool getGlyphMetrics(const UTF16 in_charIndex, U32 &xIncrement, U32 &width);
+
    const U32 getHeight() const   { return mHeight; }
    const U32 getBaseline() const { return mBaseline; }
    const U32 getAscent() const   { return mAscent; }
@@ -133,6 +143,25 @@ protected:
 
    void *mMutex;
 
+   /// Fill the advance table entry of an ASCII character.
+   void _cacheAsciiGlyph(const UTF16 in_charIndex);
+
+   /// Forget the cached ASCII metrics and line widths.  Call this
+   /// whenever the metrics of glyphs already in the font change.
+   void _resetMetricCaches();
+
+   /// Returns the width a character adds to a line, tabs included.
+   U32 _getCharAdvance(const UTF16 in_charIndex);
+
+   /// Returns true and the length up to n or the first null in outLen
+   /// if str is plain 7 bit ASCII.
+   static bool _isAsciiString(const UTF8 *str, U32 n, U32 &outLen);
+
+   /// Look up or store the width of a line in the line width cache.
+   bool _findLineWidth(U64 key, U32 &outWidth) const;
+   void _storeLineWidth(U64 key, U32 width);
+   static U64 _getLineKey(const UTF8 *str, U32 len, bool precise);
+
 private:
    static const U32 csm_fileVersion;
 
@@ -160,6 +189,35 @@ private:
 
    /// Index remapping
    S32             mRemapTable[65536];
+
+   enum GlyphState
+   {
+      GlyphUncached = 0,
+      GlyphValid,
+      GlyphInvalid,
+   };
+
+   struct AsciiGlyph
+   {
+      U16 xIncrement;
+      U16 width;
+      U8  state;
+   };
+
+   /// Metrics of the ASCII range, filled on first use so that measuring
+   /// skips the remap table and the platform font lookup.
+   AsciiGlyph mAsciiGlyphs[AsciiGlyphCount];
+
+   struct LineWidth
+   {
+      U64 key;
+      U32 width;
+   };
+
+   /// Direct mapped cache of the widths of recently measured non-ASCII
+   /// UTF8 strings, keyed by a hash of their bytes.  These would otherwise
+   /// be converted to UTF16 every time they are measured.
+   LineWidth mLineWidthCache[LineWidthCacheSize];
 };
 
 inline U32 GFont::getCharXIncrement(const UTF16 in_charIndex)
@@ -191,4 +249,38 @@ inline bool GFont::isValidChar(const UTF16 in_charIndex) const
    return false;
 }
 
+inline bool GFont::getGlyphMetrics(const UTF16 in_charIndex, U32 &xIncrement, U32 &width)
+{
+   if(in_charIndex < AsciiGlyphCount)
+   {
+      const AsciiGlyph &glyph = mAsciiGlyphs[in_charIndex];
+      if(glyph.state == GlyphUncached)
+         _cacheAsciiGlyph(in_charIndex);
+
+      xIncrement = glyph.xIncrement;
+      width = glyph.width;
+      return glyph.state == GlyphValid;
+   }
+
+   if(!isValidChar(in_charIndex))
+      return false;
+
+   const PlatformFont::CharInfo& rChar = getCharInfo(in_charIndex);
+   xIncrement = rChar.xIncrement;
+   width = rChar.width;
+   return true;
+}
+
+inline U32 GFont::_getCharAdvance(const UTF16 in_charIndex)
+{
+   U32 xIncrement, width;
+   if(getGlyphMetrics(in_charIndex, xIncrement, width))
+      return xIncrement;
+
+   if(in_charIndex == dT('\t'))
+      return _getCharAdvance(dT(' ')) * TabWidthInSpaces;
+
+   return 0;
+}
+
 #endif //_GFONT_H_
@@ -210,6 +210,21 @@ public:
    /// state at the same time.
    inline const U8* getDirtyBuffer( U32 *start, U32 *size );
 
+   /// Gets the next run of registers within the dirty range which
+   /// differ from the shadow copy of the constants last submitted to
+   /// the device, and copies that run into the shadow.
+   ///
+   /// Start with @a start and @a size at zero and pass back the
+   /// returned range each call.  When it returns NULL the device holds all
+   /// the dirty constants and the dirty state is cleared.
+   ///
+   /// @param shadow The shadow copy, at least as large as this buffer.
+   /// @param shadowValid One bit per register which is set when the
+   ///   shadow register holds what the device does.  Registers without
+   ///   the bit are always uploaded and then marked valid.
+   /// @param registerSize The size of a device register in bytes.
+   inline const U8* getNextChangedRange( U8 *shadow, U32 *shadowValid, U32 registerSize, U32 *start, U32 *size );
+
    /// Sets the entire buffer as dirty or clears the dirty state.
    inline void setDirty( bool dirty );
 
@@ -248,6 +263,10 @@ protected:
                               const U32 size, 
                               const void *data );
 
+   /// Returns true if the shadow register at the byte offset
+   /// is valid and equal to the one in this buffer.
+   inline bool _shadowHolds( const U8 *shadow, const U32 *shadowValid, U32 registerSize, U32 offset ) const;
+
    /// The buffer layout.
    GenericConstBufferLayout *mLayout;
 
@@ -348,6 +367,43 @@ inline const U8* GenericConstBuffer::getDirtyBuffer( U32 *start, U32 *size )
    return buffer;
 }
 
+inline bool GenericConstBuffer::_shadowHolds( const U8 *shadow, const U32 *shadowValid, U32 registerSize, U32 offset ) const
+{
+   const U32 reg = offset / registerSize;
+   return ( shadowValid[ reg >> 5 ] & BIT( reg & 31 ) ) &&
+          dMemcmp( shadow + offset, mBuffer + offset, registerSize ) == 0;
+}
+
+inline const U8* GenericConstBuffer::getNextChangedRange( U8 *shadow, U32 *shadowValid, U32 registerSize, U32 *start, U32 *size )
+{
+   AssertFatal( mBuffer, "GenericConstBuffer::getNextChangedRange() - Buffer is empty!" );
+   AssertFatal( mLayout->getBufferSize() % registerSize == 0, "GenericConstBuffer::getNextChangedRange() - Buffer is not register aligned!" );
+
+   // Skip past the previous run and any registers the device already holds.
+   U32 offset = getMax( *start + *size, mDirtyStart - ( mDirtyStart % registerSize ) );
+   while ( offset < mDirtyEnd && _shadowHolds( shadow, shadowValid, registerSize, offset ) )
+      offset += registerSize;
+
+   if ( offset >= mDirtyEnd )
+   {
+      mDirtyStart = U32_MAX;
+      mDirtyEnd = 0;
+      return NULL;
+   }
+
+   U32 end = offset + registerSize;
+   while ( end < mDirtyEnd && !_shadowHolds( shadow, shadowValid, registerSize, end ) )
+      end += registerSize;
+
+   dMemcpy( shadow + offset, mBuffer + offset, end - offset );
+   for ( U32 reg = offset / registerSize; reg < end / registerSize; reg++ )
+      shadowValid[ reg >> 5 ] |= BIT( reg & 31 );
+
+   *start = offset;
+   *size = end - offset;
+   return mBuffer + offset;
+}
+
 inline bool GenericConstBuffer::isEqual( const GenericConstBuffer *buffer ) const
 {      
    U32 bsize = mLayout->getBufferSize();
@@ -44,14 +44,19 @@
 #include "math/util/frustum.h"
 #include "console/consoleTypes.h"
 #include "console/engineAPI.h"
+#include "platform/platformTLS.h"
 
 GFXDevice * GFXDevice::smGFXDevice = NULL;
 bool GFXDevice::smWireframe = false;
 bool GFXDevice::smDisableVSync = true;
 F32 GFXDevice::smForcedPixVersion = -1.0f;
 bool GFXDevice::smDisableOcclusionQuery = false;
+bool GFXDevice::smThreadWorldMatrices = false;
 bool gDisassembleAllShaders = false;
 
+/// The world matrix stack bound to the calling thread.
+static ThreadStorage sgThreadWorldMatrixStack;
+
 
 void GFXDevice::initConsole()
 {
@@ -310,13 +315,19 @@ GFXStateBlockRef GFXDevice::createStateBlock(const GFXStateBlockDesc& desc)
 {
    PROFILE_SCOPE( GFXDevice_CreateStateBlock );
 
+   // Different descs can share a hash, so compare the
+   // descs of every block created with this hash value.
    U32 hashValue = desc.getHashValue();
-   if (mCurrentStateBlocks[hashValue])
-      return mCurrentStateBlocks[hashValue];
+   StateBlockMap::Iterator iter = mCurrentStateBlocks.find(hashValue);
+   for ( ; iter != mCurrentStateBlocks.end() && iter->key == hashValue; ++iter )
+   {
+      if (iter->value->getDesc() == desc)
+         return iter->value;
+   }
 
    GFXStateBlockRef result = createStateBlockInternal(desc);
    result->registerResourceWithDevice(this);   
-   mCurrentStateBlocks[hashValue] = result;
+   mCurrentStateBlocks.insertEqual(hashValue, result);
    return result;
 }
 
@@ -381,7 +392,10 @@ void GFXDevice::updateStates(bool forceSetAll /*=false*/)
 
       /// Stateblocks
       if ( mNewStateBlock )
+      {
          setStateBlockInternal(mNewStateBlock, true);
+         mDeviceStatistics.mStateBlockChanges++;
+      }
       mCurrentStateBlock = mNewStateBlock;
 
       for(U32 i = 0; i < getNumSamplers(); i++)
@@ -512,6 +526,7 @@ void GFXDevice::updateStates(bool forceSetAll /*=false*/)
       setStateBlockInternal(mNewStateBlock, false);
       mCurrentStateBlock = mNewStateBlock;
       mStateBlockDirty = false;
+      mDeviceStatistics.mStateBlockChanges++;
    }
 
    if( mTexturesDirty )
@@ -840,6 +855,22 @@ inline void GFXDevice::endField()
    getDeviceEventSignal().trigger( GFXDevice::deEndOfField );
 }
 
+void GFXDevice::bindThreadWorldMatrixStack( ThreadWorldMatrixStack *stack )
+{
+   if ( stack )
+   {
+      stack->matrix[0] = mWorldMatrix[mWorldStackSize];
+      stack->size = 0;
+   }
+
+   sgThreadWorldMatrixStack.set( stack );
+}
+
+GFXDevice::ThreadWorldMatrixStack* GFXDevice::_getThreadWorldMatrixStack()
+{
+   return reinterpret_cast< ThreadWorldMatrixStack* >( sgThreadWorldMatrixStack.get() );
+}
+
 void GFXDevice::setViewport( const RectI &inRect ) 
 {
    // Clip the rect against the renderable size.
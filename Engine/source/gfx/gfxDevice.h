@@ -485,8 +485,9 @@ protected:
    bool           mTextureDirty[TEXTURE_STAGE_COUNT];
    bool           mTexturesDirty;
 
-   // This maps a GFXStateBlockDesc hash value to a GFXStateBlockRef
-   typedef Map<U32, GFXStateBlockRef> StateBlockMap;
+   // This maps a GFXStateBlockDesc hash value to the GFXStateBlockRefs
+   // with that hash, so that equal descs always share one state block.
+   typedef HashTable<U32, GFXStateBlockRef> StateBlockMap;
    StateBlockMap mCurrentStateBlocks;
 
    // This tracks whether or not our state block is dirty.
@@ -959,7 +960,7 @@ public:
    void setWorldMatrix( const MatrixF &newWorld );
 
    /// Gets the matrix on the top of the world matrix stack
-   inline const MatrixF &getWorldMatrix() const { return mWorldMatrix[mWorldStackSize]; }
+   const MatrixF &getWorldMatrix() const;
 
    /// Pushes the world matrix stack and copies the current top
    /// matrix to the new top of the stack
@@ -987,6 +988,25 @@ public:
    /// @param   mat   Matrix to multiply
    void multWorld( const MatrixF &mat );
 
+   /// A world matrix stack which a worker thread uses in place of the
+   /// device stack.
+   /// @see bindThreadWorldMatrixStack
+   struct ThreadWorldMatrixStack
+   {
+      MatrixF matrix[WORLD_STACK_MAX];
+      S32 size;
+   };
+
+   /// If true, the world matrix interface looks for a stack bound to the
+   /// calling thread.  This is only on while render instances are being
+   /// prepared on worker threads.
+   static bool smThreadWorldMatrices;
+
+   /// Make the world matrix interface use @a stack on the calling thread
+   /// or go back to the device stack if @a stack is NULL.  The stack is
+   /// reset to hold the current world matrix of the device.
+   void bindThreadWorldMatrixStack( ThreadWorldMatrixStack *stack );
+
    /// Set texture matrix for a sampler
    void setTextureMatrix( const U32 stage, const MatrixF &texMat );
 
@@ -1084,6 +1104,10 @@ public:
 #endif
    protected:
       GFXDrawUtil *mDrawer;
+
+   /// Returns the stack bound to the calling thread if any.
+   /// @see bindThreadWorldMatrixStack
+   static ThreadWorldMatrixStack* _getThreadWorldMatrixStack();
 }; 
 
 //-----------------------------------------------------------------------------
@@ -1091,13 +1115,38 @@ public:
 
 inline void GFXDevice::setWorldMatrix( const MatrixF &newWorld )
 {
+   ThreadWorldMatrixStack *stack = smThreadWorldMatrices ? _getThreadWorldMatrixStack() : NULL;
+   if ( stack )
+   {
+      stack->matrix[stack->size] = newWorld;
+      return;
+   }
+
    mWorldMatrixDirty = true;
    mStateDirty = true;
    mWorldMatrix[mWorldStackSize] = newWorld;
 }
 
+inline const MatrixF& GFXDevice::getWorldMatrix() const
+{
+   ThreadWorldMatrixStack *stack = smThreadWorldMatrices ? _getThreadWorldMatrixStack() : NULL;
+   if ( stack )
+      return stack->matrix[stack->size];
+
+   return mWorldMatrix[mWorldStackSize];
+}
+
 inline void GFXDevice::pushWorldMatrix()
 {
+   ThreadWorldMatrixStack *stack = smThreadWorldMatrices ? _getThreadWorldMatrixStack() : NULL;
+   if ( stack )
+   {
+      stack->size++;
+      AssertFatal( stack->size < WORLD_STACK_MAX, "GFX: Exceeded world matrix stack size" );
+      stack->matrix[stack->size] = stack->matrix[stack->size - 1];
+      return;
+   }
+
    mWorldMatrixDirty = true;
    mStateDirty = true;
    mWorldStackSize++;
@@ -1107,6 +1156,14 @@ inline void GFXDevice::pushWorldMatrix()
 
 inline void GFXDevice::popWorldMatrix()
 {
+   ThreadWorldMatrixStack *stack = smThreadWorldMatrices ? _getThreadWorldMatrixStack() : NULL;
+   if ( stack )
+   {
+      stack->size--;
+      AssertFatal( stack->size >= 0, "GFX: Negative WorldStackSize!" );
+      return;
+   }
+
    mWorldMatrixDirty = true;
    mStateDirty = true;
    mWorldStackSize--;
@@ -1115,6 +1172,13 @@ inline void GFXDevice::popWorldMatrix()
 
 inline void GFXDevice::multWorld( const MatrixF &mat )
 {
+   ThreadWorldMatrixStack *stack = smThreadWorldMatrices ? _getThreadWorldMatrixStack() : NULL;
+   if ( stack )
+   {
+      stack->matrix[stack->size].mul( mat );
+      return;
+   }
+
    mWorldMatrixDirty = true;
    mStateDirty = true;
    mWorldMatrix[mWorldStackSize].mul(mat);
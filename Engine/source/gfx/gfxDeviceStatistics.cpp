@@ -36,6 +36,10 @@ void GFXDeviceStatistics::setPrefix(const String& prefix)
    vnPolyCount = prefix + "polyCount";
    vnDrawCalls = prefix + "drawCalls";
    vnRenderTargetChanges = prefix + "renderTargetChanges";
+   vnStateBlockChanges = prefix + "stateBlockChanges";
+   vnShaderConstBytes = prefix + "shaderConstBytes";
+   vnInstancedDrawCalls = prefix + "instancedDrawCalls";
+   vnInstancedMeshes = prefix + "instancedMeshes";
 }
 
 /// Clear stats
@@ -44,6 +48,10 @@ void GFXDeviceStatistics::clear()
    mPolyCount = 0;
    mDrawCalls = 0;
    mRenderTargetChanges = 0;
+   mStateBlockChanges = 0;
+   mShaderConstBytes = 0;
+   mInstancedDrawCalls = 0;
+   mInstancedMeshes = 0;
 }
 
 /// Copy from source (should just be a memcpy, but that may change later) used in 
@@ -54,6 +62,10 @@ void GFXDeviceStatistics::start(GFXDeviceStatistics * source)
    mPolyCount = source->mPolyCount;
    mDrawCalls = source->mDrawCalls;
    mRenderTargetChanges = source->mRenderTargetChanges;
+   mStateBlockChanges = source->mStateBlockChanges;
+   mShaderConstBytes = source->mShaderConstBytes;
+   mInstancedDrawCalls = source->mInstancedDrawCalls;
+   mInstancedMeshes = source->mInstancedMeshes;
 }
 
 /// Used with start to get a subset of stats on a device.  Basically will do
@@ -63,6 +75,10 @@ void GFXDeviceStatistics::end(GFXDeviceStatistics * source)
    mPolyCount = source->mPolyCount - mPolyCount;
    mDrawCalls = source->mDrawCalls - mDrawCalls;
    mRenderTargetChanges = source->mRenderTargetChanges - mRenderTargetChanges;   
+   mStateBlockChanges = source->mStateBlockChanges - mStateBlockChanges;
+   mShaderConstBytes = source->mShaderConstBytes - mShaderConstBytes;
+   mInstancedDrawCalls = source->mInstancedDrawCalls - mInstancedDrawCalls;
+   mInstancedMeshes = source->mInstancedMeshes - mInstancedMeshes;
 }
 
 /// Exports the stats to the console
@@ -71,4 +87,8 @@ void GFXDeviceStatistics::exportToConsole()
    Con::setIntVariable(vnPolyCount, mPolyCount);
    Con::setIntVariable(vnDrawCalls, mDrawCalls);
    Con::setIntVariable(vnRenderTargetChanges, mRenderTargetChanges);
+   Con::setIntVariable(vnStateBlockChanges, mStateBlockChanges);
+   Con::setIntVariable(vnShaderConstBytes, mShaderConstBytes);
+   Con::setIntVariable(vnInstancedDrawCalls, mInstancedDrawCalls);
+   Con::setIntVariable(vnInstancedMeshes, mInstancedMeshes);
 }
\ No newline at end of file
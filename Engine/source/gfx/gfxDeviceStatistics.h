@@ -34,6 +34,16 @@ public:
    S32 mPolyCount;
    S32 mDrawCalls;
    S32 mRenderTargetChanges;
+   S32 mStateBlockChanges;
+   S32 mShaderConstBytes;
+
+   /// Instanced draw calls issued by the render bins.
+   S32 mInstancedDrawCalls;
+
+   /// Meshes drawn by those instanced draw calls, so without instancing
+   /// there would have been mDrawCalls - mInstancedDrawCalls + mInstancedMeshes
+   /// draw calls.
+   S32 mInstancedMeshes;
 
    GFXDeviceStatistics();
 
@@ -57,6 +67,10 @@ private:
    String vnPolyCount;
    String vnDrawCalls;
    String vnRenderTargetChanges;
+   String vnStateBlockChanges;
+   String vnShaderConstBytes;
+   String vnInstancedDrawCalls;
+   String vnInstancedMeshes;
 };
 
 #endif
\ No newline at end of file
@@ -38,6 +38,12 @@ const String GFXStateBlock::describeSelf() const
 ///
 GFXStateBlockDesc::GFXStateBlockDesc()
 {
+   // The hash and the comparisons run over the raw bytes, so clear
+   // the padding between the members before filling in the defaults.
+   dMemset( this, 0, sizeof( GFXStateBlockDesc ) );
+   for ( U32 i = 0; i < TEXTURE_STAGE_COUNT; i++ )
+      samplers[i] = GFXSamplerStateDesc();
+
    // Alpha blending
    blendDefined = false;
    blendEnable = false;
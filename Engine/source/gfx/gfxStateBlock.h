@@ -168,6 +168,12 @@ struct GFXStateBlockDesc
    /// Returns the hash value of this state description
    U32 getHashValue() const;
 
+   /// Returns true if both descriptions define the exact same state.
+   bool operator==(const GFXStateBlockDesc &b) const
+   {
+      return !dMemcmp(this, &b, sizeof(GFXStateBlockDesc));
+   }
+
    /// Adds data from desc to this description, uses *defined parameters in desc to figure out
    /// what blocks of state to actually copy from desc.
    void addDesc( const GFXStateBlockDesc& desc );
@@ -67,6 +67,7 @@ U32 GFXVertexElement::getSizeInBytes() const
 
 GFXVertexFormat::GFXVertexFormat()
    :  mDirty( true ),
+      mHash( 0 ),
       mHasColor( false ),
       mHasNormal( false ),
       mHasTangent( false ),
@@ -86,6 +87,7 @@ void GFXVertexFormat::copy( const GFXVertexFormat &format )
    mTexCoordCount = format.mTexCoordCount;
    mSizeInBytes = format.mSizeInBytes;
    mDescription = format.mDescription;
+   mHash = format.mHash;
    mElements = format.mElements;
    mDecl = format.mDecl;
 }
@@ -129,6 +131,14 @@ const String& GFXVertexFormat::getDescription() const
    return mDescription;
 }
 
+U64 GFXVertexFormat::getHash() const
+{
+   if ( mDirty )
+      const_cast<GFXVertexFormat*>(this)->_updateDirty();
+
+   return mHash;
+}
+
 GFXVertexDecl* GFXVertexFormat::getDecl() const
 {
    if ( !mDecl || mDirty )
@@ -189,6 +199,7 @@ void GFXVertexFormat::_updateDirty()
    mSizeInBytes = 0;
 
    String desc;
+   Torque::IncrementalHash64 hash;
 
    for ( U32 i=0; i < mElements.size(); i++ )
    {
@@ -199,6 +210,11 @@ void GFXVertexFormat::_updateDirty()
                                                    element.mSemanticIndex, 
                                                    element.mType );
 
+      hash.addU32( element.mStreamIndex );
+      hash.addString( element.mSemantic.c_str() );
+      hash.addU32( element.mSemanticIndex );
+      hash.addU32( element.mType );
+
       if ( element.isSemantic( GFXSemantic::NORMAL ) )
          mHasNormal = true;
       else if ( element.isSemantic( GFXSemantic::TANGENT ) )
@@ -213,6 +229,7 @@ void GFXVertexFormat::_updateDirty()
 
    // Intern the string for fast compares later.
    mDescription = desc.intern();
+   mHash = hash.getHash();
 
    mDirty = false;
 }
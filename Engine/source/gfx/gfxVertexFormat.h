@@ -162,6 +162,10 @@ public:
    /// Returns a unique description string for this vertex format.
    const String& getDescription() const;
 
+   /// Returns a hash of the elements which is the same from run 
+   /// to run and can be used in place of the description for keys.
+   U64 getHash() const;
+
    /// Clears all the vertex elements.
    void clear();
 
@@ -234,6 +238,9 @@ protected:
 
    /// An interned string which uniquely identifies the format.
    String mDescription;
+
+   /// A hash of the elements.
+   U64 mHash;
    
    /// The elements of the vertex format.
    Vector<GFXVertexElement> mElements;
@@ -830,7 +830,7 @@ void GFXGLDevice::setShader(GFXShader *shader, bool force)
 
 void GFXGLDevice::setShaderConstBufferInternal(GFXShaderConstBuffer* buffer)
 {
-   static_cast<GFXGLShaderConstBuffer*>(buffer)->activate();
+   mDeviceStatistics.mShaderConstBytes += static_cast<GFXGLShaderConstBuffer*>(buffer)->activate();
 }
 
 U32 GFXGLDevice::getNumSamplers() const
@@ -342,10 +342,11 @@ void GFXGLShaderConstBuffer::set(GFXShaderConstHandle* handle, const MatrixF* ma
    }
 }
 
-void GFXGLShaderConstBuffer::activate()
+U32 GFXGLShaderConstBuffer::activate()
 {
-   mShader->setConstantsFromBuffer(this);
+   U32 bytesUploaded = mShader->setConstantsFromBuffer(this);
    mWasLost = false;
+   return bytesUploaded;
 }
 
 const String GFXGLShaderConstBuffer::describeSelf() const
@@ -748,8 +749,9 @@ GFXShaderConstHandle* GFXGLShader::findShaderConstHandle(const String& name)
    }
 }
 
-void GFXGLShader::setConstantsFromBuffer(GFXGLShaderConstBuffer* buffer)
+U32 GFXGLShader::setConstantsFromBuffer(GFXGLShaderConstBuffer* buffer)
 {
+   U32 bytesUploaded = 0;
    for(Vector<GFXGLShaderConstHandle*>::iterator i = mValidHandles.begin(); i != mValidHandles.end(); ++i)
    {
       GFXGLShaderConstHandle* handle = *i;
@@ -764,6 +766,7 @@ void GFXGLShader::setConstantsFromBuffer(GFXGLShaderConstBuffer* buffer)
          
       // Copy new value into our const buffer and set in GL.
       dMemcpy(mConstBuffer + handle->mOffset, buffer->mBuffer + handle->mOffset, handle->getSize());
+      bytesUploaded += handle->getSize();
       switch(handle->mDesc.constType)
       {
          case GFXSCT_Float:
@@ -806,6 +809,8 @@ void GFXGLShader::setConstantsFromBuffer(GFXGLShaderConstBuffer* buffer)
             break;
       }
    }
+
+   return bytesUploaded;
 }
 
 GFXShaderConstBufferRef GFXGLShader::allocConstBuffer()
@@ -79,7 +79,9 @@ protected:
    void clearShaders();
    void initConstantDescs();
    void initHandles();
-   void setConstantsFromBuffer(GFXGLShaderConstBuffer* buffer);
+   /// Uploads the constants which differ from what the program holds
+   /// and returns the number of bytes uploaded.
+   U32 setConstantsFromBuffer(GFXGLShaderConstBuffer* buffer);
    
    static char* _handleIncludes( const Torque::Path &path, FileStream *s );
 
@@ -109,7 +111,8 @@ public:
    ~GFXGLShaderConstBuffer();
    
    /// Called by GFXGLDevice to activate this buffer.
-   void activate();
+   /// @return The number of constant bytes uploaded.
+   U32 activate();
 
    /// Called when the shader this buffer references is reloaded.
    void onShaderReload( GFXGLShader *shader );
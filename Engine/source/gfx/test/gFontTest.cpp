@@ -0,0 +1,200 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "gfx/gFont.h"
+#include "core/stream/memStream.h"
+#include "core/strings/unicode.h"
+#include "core/util/endian.h"
+#include "zlib/zlib.h"
+
+namespace
+{
+   const U32 FontFileVersion = 3;
+   const UTF16 LastGlyph = 0xE9;
+
+   /// Writes a font file with glyphs for the printable ASCII range and
+   /// one accented character, but no texture sheets.  Some glyphs are
+   /// wider than their advance so the precise width rule gets tested.
+   void writeTestFont( MemStream &stream, S32 extraAdvance )
+   {
+      stream.write( FontFileVersion );
+      stream.writeString( "Test" );
+      stream.write( U32( 12 ) );
+      stream.write( U32( TGE_ANSI_CHARSET ) );
+
+      stream.write( U32( 14 ) ); // height
+      stream.write( U32( 11 ) ); // baseline
+      stream.write( U32( 11 ) ); // ascent
+      stream.write( U32( 3 ) );  // descent
+
+      Vector<UTF16> chars;
+      for ( UTF16 c = ' '; c < 127; c++ )
+         chars.push_back( c );
+      chars.push_back( LastGlyph );
+
+      stream.write( U32( chars.size() ) );
+      for ( U32 i = 0; i < chars.size(); i++ )
+      {
+         const S32 advance = 4 + ( chars[i] % 5 ) + extraAdvance;
+         const U32 width = ( chars[i] % 3 ) == 0 ? advance + 2 : advance;
+
+         stream.write( S16( chars[i] == ' ' ? -1 : 0 ) );
+         stream.write( U32( 0 ) );
+         stream.write( U32( 0 ) );
+         stream.write( width );
+         stream.write( U32( 14 ) );
+         stream.write( S32( 0 ) );
+         stream.write( S32( 11 ) );
+         stream.write( advance );
+      }
+
+      stream.write( U32( 0 ) ); // texture sheets
+      stream.write( S32( 0 ) );
+      stream.write( S32( 0 ) );
+      stream.write( S32( 0 ) );
+
+      // The remap table is stored big endian and compressed.
+      const S32 minGlyph = ' ';
+      const S32 maxGlyph = LastGlyph;
+      Vector<S32> remap;
+      remap.setSize( maxGlyph - minGlyph + 1 );
+      for ( U32 i = 0; i < remap.size(); i++ )
+         remap[i] = convertHostToBEndian( S32( -1 ) );
+      for ( U32 i = 0; i < chars.size(); i++ )
+         remap[ chars[i] - minGlyph ] = convertHostToBEndian( S32( i ) );
+
+      Vector<U8> packed;
+      uLongf packedLen = compressBound( remap.memSize() );
+      packed.setSize( packedLen );
+      compress2( packed.address(), &packedLen, (const Bytef*)remap.address(), remap.memSize(), 9 );
+
+      stream.write( minGlyph );
+      stream.write( maxGlyph );
+      stream.write( U32( packedLen ) );
+      stream.write( packedLen, packed.address() );
+   }
+
+   bool loadTestFont( GFont &font, S32 extraAdvance )
+   {
+      MemStream stream( 4096 );
+      writeTestFont( stream, extraAdvance );
+      stream.setPosition( 0 );
+      return font.read( stream );
+   }
+
+   /// Measures a string one UTF16 character at a time thru the char
+   /// info, the way the widths were measured before the ASCII table.
+   U32 referenceWidth( GFont &font, const UTF8 *str, bool precise )
+   {
+      UTF16 str16[256];
+      convertUTF8toUTF16N( str, str16, 256 );
+
+      U32 width = 0;
+      U32 len = 0;
+      for ( ; str16[len]; len++ )
+      {
+         UTF16 c = str16[len];
+         U32 count = 1;
+         if ( c == '\t' )
+         {
+            c = ' ';
+            count = GFont::TabWidthInSpaces;
+         }
+
+         if ( font.isValidChar( c ) )
+            width += font.getCharInfo( c ).xIncrement * count;
+      }
+
+      if ( precise && len > 0 && font.isValidChar( str16[ len - 1 ] ) )
+      {
+         const PlatformFont::CharInfo &info = font.getCharInfo( str16[ len - 1 ] );
+         if ( info.width != info.xIncrement )
+            width += info.width - info.xIncrement;
+      }
+
+      return width;
+   }
+
+   const UTF8 *const TestStrings[] =
+   {
+      "",
+      "a",
+      "Hello World",
+      "tab\tstop",
+      "ends in c",
+      "ends in space ",
+      "caf\xC3\xA9",
+      "\xC3\xA9t\xC3\xA9",
+      "unknown \xE2\x82\xAC sign",
+   };
+   const U32 TestStringCount = sizeof( TestStrings ) / sizeof( TestStrings[0] );
+
+   /// Returns the number of strings the font measures differently
+   /// than the reference.
+   U32 countMismatches( GFont &font )
+   {
+      U32 numDifferent = 0;
+      for ( U32 i = 0; i < TestStringCount; i++ )
+      {
+         const UTF8 *str = TestStrings[i];
+         if ( font.getStrWidth( str ) != referenceWidth( font, str, false ) )
+            numDifferent++;
+         if ( font.getStrWidthPrecise( str ) != referenceWidth( font, str, true ) )
+            numDifferent++;
+      }
+      return numDifferent;
+   }
+}
+
+TEST(GFont, WidthMatchesCharInfo)
+{
+   GFont font;
+   ASSERT_TRUE( loadTestFont( font, 0 ) );
+
+   // Twice so the second pass runs from the ASCII table and line cache.
+   EXPECT_EQ( countMismatches( font ), 0 );
+   EXPECT_EQ( countMismatches( font ), 0 );
+
+   // The precise width of a line ending in a wide glyph includes the
+   // overhang of that glyph.
+   const PlatformFont::CharInfo &c = font.getCharInfo( 'c' );
+   ASSERT_NE( c.width, (U32)c.xIncrement );
+   EXPECT_EQ( font.getStrWidthPrecise( "c" ), c.width );
+   EXPECT_EQ( font.getStrWidth( "c" ), (U32)c.xIncrement );
+}
+
+TEST(GFont, WidthAfterMetricsChange)
+{
+   GFont font;
+   ASSERT_TRUE( loadTestFont( font, 0 ) );
+   EXPECT_EQ( countMismatches( font ), 0 );
+
+   // Replacing the glyphs must not leave stale cached widths behind.
+   ASSERT_TRUE( loadTestFont( font, 3 ) );
+   EXPECT_EQ( countMismatches( font ), 0 );
+}
+
+#endif
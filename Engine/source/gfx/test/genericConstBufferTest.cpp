@@ -0,0 +1,155 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "gfx/genericConstBuffer.h"
+#include "gfx/gfxStateBlock.h"
+
+namespace
+{
+   const U32 RegisterSize = 16;
+   const U32 RegisterCount = 4;
+
+   /// A layout with a float4 in each of registers 0, 2 and 3.
+   struct TestLayout : public GenericConstBufferLayout
+   {
+      TestLayout()
+      {
+         addParameter( "$first", GFXSCT_Float4, 0, RegisterSize, 1, 0 );
+         addParameter( "$second", GFXSCT_Float4, RegisterSize * 2, RegisterSize, 1, 0 );
+         addParameter( "$last", GFXSCT_Float4, RegisterSize * 3, RegisterSize, 1, 0 );
+      }
+   };
+
+   /// Returns the number of runs uploaded and the bytes in them.
+   U32 countChangedRanges( GenericConstBuffer &buffer, U8 *shadow, U32 *shadowValid, U32 *bytes )
+   {
+      U32 runs = 0;
+      U32 start = 0, size = 0;
+      *bytes = 0;
+      while ( buffer.getNextChangedRange( shadow, shadowValid, RegisterSize, &start, &size ) )
+      {
+         runs++;
+         *bytes += size;
+      }
+      return runs;
+   }
+}
+
+TEST(GenericConstBuffer, ChangedRanges)
+{
+   TestLayout layout;
+   GenericConstBufferLayout::ParamDesc first, second, last;
+   layout.getDesc( "$first", first );
+   layout.getDesc( "$second", second );
+   layout.getDesc( "$last", last );
+
+   // Start out like a lost device with no valid registers.
+   U8 shadow[ RegisterSize * RegisterCount ];
+   dMemset( shadow, 0, sizeof( shadow ) );
+   U32 shadowValid = 0;
+
+   GenericConstBuffer buffer( &layout );
+   buffer.set( first, Point4F( 1, 2, 3, 4 ) );
+   buffer.set( second, Point4F( 5, 6, 7, 8 ) );
+   buffer.set( last, Point4F( 9, 10, 11, 12 ) );
+
+   // Nothing is valid yet, so the whole dirty range uploads as
+   // one run, the unused register 1 included.
+   U32 bytes;
+   EXPECT_EQ( countChangedRanges( buffer, shadow, &shadowValid, &bytes ), 1 );
+   EXPECT_EQ( bytes, RegisterSize * RegisterCount );
+   EXPECT_FALSE( buffer.isDirty() );
+
+   // A second buffer holding the same values uploads nothing.
+   GenericConstBuffer other( &layout );
+   other.set( first, Point4F( 1, 2, 3, 4 ) );
+   other.set( second, Point4F( 5, 6, 7, 8 ) );
+   other.set( last, Point4F( 9, 10, 11, 12 ) );
+   EXPECT_EQ( countChangedRanges( other, shadow, &shadowValid, &bytes ), 0 );
+   EXPECT_EQ( bytes, 0 );
+   EXPECT_FALSE( other.isDirty() );
+
+   // Only the register that differs is uploaded.
+   other.set( second, Point4F( 0, 0, 0, 0 ) );
+   other.setDirty( true );
+   EXPECT_EQ( countChangedRanges( other, shadow, &shadowValid, &bytes ), 1 );
+   EXPECT_EQ( bytes, RegisterSize );
+}
+
+TEST(GenericConstBuffer, LostShadow)
+{
+   TestLayout layout;
+   GenericConstBufferLayout::ParamDesc first;
+   layout.getDesc( "$first", first );
+
+   // Garbage in the shadow must not match a register which happens to
+   // hold the same bytes, all ones included, once the device was lost.
+   U8 shadow[ RegisterSize * RegisterCount ];
+   dMemset( shadow, 0xFF, sizeof( shadow ) );
+   U32 shadowValid = 0;
+
+   U32 allOnes[4];
+   dMemset( allOnes, 0xFF, sizeof( allOnes ) );
+
+   GenericConstBuffer buffer( &layout );
+   buffer.set( first, *(Point4F*)allOnes );
+
+   U32 bytes;
+   EXPECT_EQ( countChangedRanges( buffer, shadow, &shadowValid, &bytes ), 1 );
+   EXPECT_EQ( bytes, RegisterSize );
+   EXPECT_TRUE( shadowValid & BIT( 0 ) );
+
+   // Once the device holds every register nothing is uploaded.
+   buffer.setDirty( true );
+   countChangedRanges( buffer, shadow, &shadowValid, &bytes );
+   buffer.setDirty( true );
+   EXPECT_EQ( countChangedRanges( buffer, shadow, &shadowValid, &bytes ), 0 );
+
+   // Losing the device uploads everything again.
+   shadowValid = 0;
+   buffer.setDirty( true );
+   EXPECT_EQ( countChangedRanges( buffer, shadow, &shadowValid, &bytes ), 1 );
+   EXPECT_EQ( bytes, RegisterSize * RegisterCount );
+}
+
+TEST(GFXStateBlockDesc, Equality)
+{
+   GFXStateBlockDesc a;
+   a.setBlend( true );
+   a.setZReadWrite( true, false );
+
+   GFXStateBlockDesc b;
+   b.setBlend( true );
+   b.setZReadWrite( true, false );
+
+   EXPECT_TRUE( a == b );
+   EXPECT_EQ( a.getHashValue(), b.getHashValue() );
+
+   b.setCullMode( GFXCullNone );
+   EXPECT_FALSE( a == b );
+}
+
+#endif
@@ -95,6 +95,10 @@ GFX_ImplementTextureProfile(GFXMLTextureProfile,
 
 const U32 GuiMLTextCtrl::csmTextBufferGrowthSize = 1024;
 
+// Every resumed reflow leaves the discarded tail of the previous layout in
+// the view chunker, so do a full reflow now and then to reclaim it.
+const U32 GuiMLTextCtrl::csmMaxReflowResumes = 256;
+
 DefineEngineMethod( GuiMLTextCtrl, setText, void, (const char* text),,
    "@brief Set the text contained in the control.\n\n"
    "@param text The text to display in the control.\n"
@@ -267,6 +271,7 @@ GuiMLTextCtrl::GuiMLTextCtrl()
   mFontList( NULL )
 {   
    mActive = true;
+   dMemset(&mReflowCheckpoint, 0, sizeof(mReflowCheckpoint));
    //mInitialText = StringTable->insert("");
    Sim::findObject("InputDeniedSound", mDeniedSound);
 }
@@ -492,6 +497,7 @@ void GuiMLTextCtrl::freeLineBuffers()
    mTagList = NULL;
    mHitURL = 0;
    mDirty = true;
+   mReflowCheckpoint.valid = false;
 }
 
 //--------------------------------------------------------------------------
@@ -598,6 +604,7 @@ void GuiMLTextCtrl::setText(const char* textBuffer, const U32 numChars)
    setCursorPosition(0);
    clearSelection();
    mDirty = true;
+   mReflowCheckpoint.valid = false;
    scrollToTop();
 }
 
@@ -933,6 +940,7 @@ void GuiMLTextCtrl::insertChars(const char* inputChars,
 
    AssertFatal(mCursorPosition <= mTextBuffer.length(), "GuiMLTextCtrl::insertChars: bad cursor position");
    mDirty = true;
+   mReflowCheckpoint.valid = false;
 }
 
 //--------------------------------------------------------------------------
@@ -966,6 +974,7 @@ void GuiMLTextCtrl::deleteChars(const U32 rangeStart,
 
    AssertFatal(mCursorPosition <= mTextBuffer.length(), "GuiMLTextCtrl::deleteChars: bad cursor position");
    mDirty = true;
+   mReflowCheckpoint.valid = false;
 }
 
 //--------------------------------------------------------------------------
@@ -1617,56 +1626,152 @@ GuiMLTextCtrl::Style *GuiMLTextCtrl::allocStyle(GuiMLTextCtrl::Style *style)
 }
 
 //--------------------------------------------------------------------------
-void GuiMLTextCtrl::reflow()
+void GuiMLTextCtrl::saveReflowCheckpoint()
 {
-   AssertFatal(mAwake, "Can't reflow a sleeping control.");
-   freeLineBuffers();
-   mDirty = false;
-   mScanPos = 0;
+   // Only resume from a clean line start with no bitmaps still blocking
+   // the margins, everything else is reset by emitNewLine.
+   if(mBlockList != &mSentinel || mEmitAtoms || mLineAtoms)
+      return;
 
-   mLineList = NULL;
-   mLineInsert = &mLineList;
+   // Styles that are not marked used get modified in place by style tags,
+   // lock down the current stack so resuming sees it as it is now.
+   for(Style *walk = mCurStyle; walk; walk = walk->next)
+      walk->used = true;
+
+   mReflowCheckpoint.valid = true;
+   mReflowCheckpoint.width = getWidth();
+   mReflowCheckpoint.profile = mProfile;
+   mReflowCheckpoint.fontType = mProfile->mFontType;
+   mReflowCheckpoint.fontSize = mProfile->mFontSize;
+   mReflowCheckpoint.fontColor = mProfile->mFontColor;
+   mReflowCheckpoint.linkColor = mProfile->mFontColors[GuiControlProfile::ColorUser0];
+   mReflowCheckpoint.linkColorHL = mProfile->mFontColors[GuiControlProfile::ColorUser1];
+   mReflowCheckpoint.scanPos = mScanPos;
+   mReflowCheckpoint.lineInsert = mLineInsert;
+   mReflowCheckpoint.style = mCurStyle;
+   mReflowCheckpoint.lMargin = mCurLMargin;
+   mReflowCheckpoint.rMargin = mCurRMargin;
+   mReflowCheckpoint.justify = mCurJustify;
+   mReflowCheckpoint.y = mCurY;
+   mReflowCheckpoint.maxY = mMaxY;
+   mReflowCheckpoint.lineStart = mLineStart;
+   mReflowCheckpoint.tabStops = mTabStops;
+   mReflowCheckpoint.tabStopCount = mTabStopCount;
+   mReflowCheckpoint.url = mCurURL;
+   mReflowCheckpoint.tagList = mTagList;
+   mReflowCheckpoint.bitmapRefList = mBitmapRefList;
+}
 
-   mCurStyle = allocStyle(NULL);
-   mCurStyle->font = allocFont((char *) mProfile->mFontType, dStrlen(mProfile->mFontType), mProfile->mFontSize);
-   if(!mCurStyle->font)
-      return;
-   mCurStyle->color = mProfile->mFontColor;
-   mCurStyle->shadowColor = mProfile->mFontColor;
-   mCurStyle->shadowOffset.set(0,0);
-   mCurStyle->linkColor = mProfile->mFontColors[GuiControlProfile::ColorUser0];
-   mCurStyle->linkColorHL = mProfile->mFontColors[GuiControlProfile::ColorUser1];
+//--------------------------------------------------------------------------
+bool GuiMLTextCtrl::resumeReflow(U32 width)
+{
+   ReflowCheckpoint &cp = mReflowCheckpoint;
+   if(!cp.valid || cp.width != width || cp.profile != mProfile)
+      return false;
 
-   U32 width = getWidth();
+   // The profile may have been changed without being swapped out.
+   if(cp.fontType != mProfile->mFontType || cp.fontSize != mProfile->mFontSize ||
+      cp.fontColor != mProfile->mFontColor ||
+      cp.linkColor != mProfile->mFontColors[GuiControlProfile::ColorUser0] ||
+      cp.linkColorHL != mProfile->mFontColors[GuiControlProfile::ColorUser1])
+      return false;
 
-   mCurLMargin = 0;
-   mCurRMargin = width;
-   mCurJustify = LeftJustify;
+   if(cp.resumeCount >= csmMaxReflowResumes)
+      return false;
+   cp.resumeCount++;
+
+   // Drop the lines laid out after the checkpoint, their memory stays in
+   // the view chunker until the next full reflow.
+   *cp.lineInsert = NULL;
+   mLineInsert = cp.lineInsert;
+
+   mScanPos = cp.scanPos;
+   mCurStyle = cp.style;
+   mCurLMargin = cp.lMargin;
+   mCurRMargin = cp.rMargin;
+   mCurJustify = cp.justify;
    mCurDiv = 0;
-   mCurY = 0;
-   mCurX = 0;
+   mCurY = cp.y;
+   mCurX = cp.lMargin;
    mCurClipX = 0;
+   mMaxY = cp.maxY;
+   mLineStart = cp.lineStart;
+   mTabStops = cp.tabStops;
+   mCurTabStop = 0;
+   mTabStopCount = cp.tabStopCount;
+   mCurURL = cp.url;
+   mTagList = cp.tagList;
+   mBitmapRefList = cp.bitmapRefList;
+
    mLineAtoms = NULL;
    mLineAtomPtr = &mLineAtoms;
-
-   mSentinel.point.x = width;
-   mSentinel.point.y = 0;
-   mSentinel.extent.x = 0;
-   mSentinel.extent.y = 0x7FFFFF;
-   mSentinel.nextBlocker = NULL;
-   mLineStart = 0;
-   mEmitAtoms = 0;
-   mMaxY = 0;
+   mEmitAtoms = NULL;
    mEmitAtomPtr = &mEmitAtoms;
-
    mBlockList = &mSentinel;
+   mHitURL = 0;
+
+   return true;
+}
+
+//--------------------------------------------------------------------------
+void GuiMLTextCtrl::reflow()
+{
+   AssertFatal(mAwake, "Can't reflow a sleeping control.");
+
+   U32 width = getWidth();
+
+   if(resumeReflow(width))
+      mDirty = false;
+   else
+   {
+      freeLineBuffers();
+      mReflowCheckpoint.resumeCount = 0;
+      mDirty = false;
+      mScanPos = 0;
+
+      mLineList = NULL;
+      mLineInsert = &mLineList;
+
+      mCurStyle = allocStyle(NULL);
+      mCurStyle->font = allocFont((char *) mProfile->mFontType, dStrlen(mProfile->mFontType), mProfile->mFontSize);
+      if(!mCurStyle->font)
+         return;
+      mCurStyle->color = mProfile->mFontColor;
+      mCurStyle->shadowColor = mProfile->mFontColor;
+      mCurStyle->shadowOffset.set(0,0);
+      mCurStyle->linkColor = mProfile->mFontColors[GuiControlProfile::ColorUser0];
+      mCurStyle->linkColorHL = mProfile->mFontColors[GuiControlProfile::ColorUser1];
+
+      mCurLMargin = 0;
+      mCurRMargin = width;
+      mCurJustify = LeftJustify;
+      mCurDiv = 0;
+      mCurY = 0;
+      mCurX = 0;
+      mCurClipX = 0;
+      mLineAtoms = NULL;
+      mLineAtomPtr = &mLineAtoms;
+
+      mSentinel.point.x = width;
+      mSentinel.point.y = 0;
+      mSentinel.extent.x = 0;
+      mSentinel.extent.y = 0x7FFFFF;
+      mSentinel.nextBlocker = NULL;
+      mLineStart = 0;
+      mEmitAtoms = 0;
+      mMaxY = 0;
+      mEmitAtomPtr = &mEmitAtoms;
+
+      mBlockList = &mSentinel;
+
+      mTabStops = 0;
+      mCurTabStop = 0;
+      mTabStopCount = 0;
+      mCurURL = 0;
+   }
 
    Font *nextFont;
    LineTag *nextTag;
-   mTabStops = 0;
-   mCurTabStop = 0;
-   mTabStopCount = 0;
-   mCurURL = 0;
    Style *newStyle;
 
    U32 textStart;
@@ -1689,6 +1794,7 @@ void GuiMLTextCtrl::reflow()
          processEmitAtoms();
          emitNewLine(textStart);
          mCurDiv = 0;
+         saveReflowCheckpoint();
          continue;
       }
 
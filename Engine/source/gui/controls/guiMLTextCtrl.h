@@ -124,6 +124,37 @@ class GuiMLTextCtrl : public GuiControl
       LineTag *next;
    };
 
+   /// Layout state at the last hard line break of the previous reflow.
+   /// Text appended after that point is laid out by resuming from here
+   /// instead of reflowing the whole document.
+   struct ReflowCheckpoint {
+      bool valid;
+      U32 resumeCount;
+      U32 width;
+      GuiControlProfile *profile;
+      /// Profile settings the first style was built from, as profiles
+      /// can be changed in place.
+      StringTableEntry fontType;
+      S32 fontSize;
+      ColorI fontColor;
+      ColorI linkColor;
+      ColorI linkColorHL;
+      U32 scanPos;
+      Line **lineInsert;
+      Style *style;
+      U32 lMargin;
+      U32 rMargin;
+      U32 justify;
+      U32 y;
+      U32 maxY;
+      U32 lineStart;
+      U32 *tabStops;
+      U32 tabStopCount;
+      URL *url;
+      LineTag *tagList;
+      BitmapRef *bitmapRefList;
+   };
+
    GuiMLTextCtrl();
    ~GuiMLTextCtrl();
 
@@ -208,6 +239,8 @@ class GuiMLTextCtrl : public GuiControl
 
    URL *mHitURL;
 
+   ReflowCheckpoint mReflowCheckpoint;
+
    void freeLineBuffers();
    void freeResources();
 
@@ -223,8 +256,11 @@ class GuiMLTextCtrl : public GuiControl
    void drawAtomText(bool sel, U32 start, U32 end, Atom *atom, Line *line, Point2I offset);
    Atom *findHitAtom(const Point2I localCoords);
    Style *allocStyle(Style *style);
+   void saveReflowCheckpoint();
+   bool resumeReflow(U32 width);
 
    static const U32 csmTextBufferGrowthSize;
+   static const U32 csmMaxReflowResumes;
 
    //-------------------------------------- Data...
   protected:
@@ -0,0 +1,176 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "gui/controls/guiMLTextCtrl.h"
+#include "core/util/tVector.h"
+
+namespace
+{
+   /// Exposes the layout of a GuiMLTextCtrl.
+   class TestMLTextCtrl : public GuiMLTextCtrl
+   {
+   public:
+      U32 getResumeCount() const { return mReflowCheckpoint.resumeCount; }
+
+      /// Collects where each line starts and where each atom on it is.
+      void getLayout(Vector<U32> &out) const
+      {
+         out.clear();
+         for(Line *line = mLineList; line; line = line->next)
+         {
+            out.push_back(line->textStart);
+            out.push_back(line->y);
+            out.push_back(line->height);
+            for(Atom *atom = line->atomList; atom; atom = atom->next)
+            {
+               out.push_back(atom->textStart);
+               out.push_back(atom->len);
+               out.push_back(atom->xStart);
+               out.push_back(atom->width);
+            }
+         }
+      }
+   };
+
+   TestMLTextCtrl* createCtrl(GuiControlProfile *profile)
+   {
+      TestMLTextCtrl *ctrl = new TestMLTextCtrl;
+      ctrl->setControlProfile(profile);
+      ctrl->registerObject();
+      ctrl->setExtent(160, 20);
+      ctrl->awaken();
+      return ctrl;
+   }
+
+   GuiControlProfile* createProfile()
+   {
+      GuiControlProfile *profile = new GuiControlProfile;
+      profile->mFontType = StringTable->insert("Arial");
+      profile->mFontSize = 14;
+      profile->registerObject();
+      return profile;
+   }
+
+   /// Paragraphs long enough to wrap, with tags that change the state a
+   /// checkpoint has to carry over.
+   const char *sParagraphs[] =
+   {
+      "The quick brown fox jumps over the lazy dog and keeps on running.\n",
+      "<font:Arial:18>Bigger text that wraps around the edge of the control.\n",
+      "<color:ff0000><lmargin:20>Indented red text, also long enough to wrap.\n",
+      "<just:center>Centered words on a line\n",
+      "<tab:40,80>a\tb\tc and some more text after the tabs.\n",
+      "<a:example.com>A link</a> followed by plain text\n",
+   };
+   const U32 sNumParagraphs = sizeof(sParagraphs) / sizeof(sParagraphs[0]);
+
+   /// Lays out all paragraphs at once in a new control.
+   void getFullLayout(GuiControlProfile *profile, Vector<U32> &out)
+   {
+      String text;
+      for(U32 i = 0; i < sNumParagraphs; i++)
+         text += sParagraphs[i];
+
+      TestMLTextCtrl *ctrl = createCtrl(profile);
+      ctrl->setText(text.c_str(), text.length());
+      ctrl->reflow();
+      ctrl->getLayout(out);
+      ctrl->deleteObject();
+   }
+
+   bool isSameLayout(const Vector<U32> &a, const Vector<U32> &b)
+   {
+      if(a.size() != b.size())
+         return false;
+      for(U32 i = 0; i < a.size(); i++)
+         if(a[i] != b[i])
+            return false;
+      return true;
+   }
+}
+
+TEST(GuiMLTextCtrl, AppendMatchesFullReflow)
+{
+   GuiControlProfile *profile = createProfile();
+
+   TestMLTextCtrl *ctrl = createCtrl(profile);
+   ctrl->setText("", 0);
+   ctrl->reflow();
+   for(U32 i = 0; i < sNumParagraphs; i++)
+   {
+      ctrl->addText(sParagraphs[i], dStrlen(sParagraphs[i]), true);
+      ctrl->reflow();
+   }
+
+   EXPECT_GT(ctrl->getResumeCount(), 0)
+      << "Appending text should resume the previous reflow";
+
+   Vector<U32> appended;
+   ctrl->getLayout(appended);
+   ctrl->deleteObject();
+
+   Vector<U32> full;
+   getFullLayout(profile, full);
+
+   ASSERT_FALSE(full.empty()) << "Nothing was laid out";
+   EXPECT_TRUE(isSameLayout(appended, full))
+      << "Appending text should break lines like a full reflow";
+
+   profile->deleteObject();
+}
+
+TEST(GuiMLTextCtrl, ProfileChangeForcesFullReflow)
+{
+   GuiControlProfile *profile = createProfile();
+
+   TestMLTextCtrl *ctrl = createCtrl(profile);
+   ctrl->setText(sParagraphs[0], dStrlen(sParagraphs[0]));
+   ctrl->reflow();
+
+   // Edit the profile in place, as the GUI editor does.
+   profile->mFontSize = 20;
+
+   for(U32 i = 1; i < sNumParagraphs; i++)
+   {
+      ctrl->addText(sParagraphs[i], dStrlen(sParagraphs[i]), true);
+      ctrl->reflow();
+   }
+
+   Vector<U32> appended;
+   ctrl->getLayout(appended);
+   ctrl->deleteObject();
+
+   Vector<U32> full;
+   getFullLayout(profile, full);
+
+   ASSERT_FALSE(full.empty()) << "Nothing was laid out";
+   EXPECT_TRUE(isSameLayout(appended, full))
+      << "Text laid out with the old font size was kept";
+
+   profile->deleteObject();
+}
+
+#endif
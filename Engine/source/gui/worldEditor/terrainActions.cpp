@@ -831,6 +831,7 @@ void TerrainSmoothAction::redo()
    TerrainFile *terrFile = terrain->getFile();
 
    // First copy the heightmap state.
+   terrFile->unmap();
    mUnsmoothedHeights = terrFile->getHeightMap();
 
    // Do the smooth.
@@ -1169,6 +1169,7 @@ void TerrainEditor::setGridMaterial( const GridPoint &gPoint, U8 index )
       mNeedsGridUpdate = true;
    }
 
+   file->unmap();
    file->setLayerIndex( cPos.x, cPos.y, index );
 }
 
@@ -71,14 +71,12 @@ void LightQuery::getLights( LightInfo** outLights, U32 maxLights )
    // Copy them over.
    for ( U32 i = 0; i < lightCount; i++ )
    {
-      LightInfo *light = mLights[i];
-
       // If the score reaches zero then we got to
       // the end of the valid lights for this object.
-      if ( light->getScore() <= 0.0f )
+      if ( mLights[i].score <= 0.0f )
          break;
 
-      outLights[i] = light;
+      outLights[i] = mLights[i].light;
    }
 }
 
@@ -90,13 +88,16 @@ void LightQuery::_scoreLights()
       return;
 
    // Get all the lights.
-   LIGHTMGR->getAllUnsortedLights( &mLights );
+   Vector<LightInfo*> lights;
+   LIGHTMGR->getAllUnsortedLights( &lights );
    LightInfo *sun = LIGHTMGR->getSpecialLight( LightManager::slSunLightType );
 
    const Point3F lumDot( 0.2125f, 0.7154f, 0.0721f );
 
-   Vector<LightInfo*>::iterator iter = mLights.begin();
-   for ( ; iter != mLights.end(); iter++ )
+   mLights.setSize( lights.size() );
+
+   Vector<LightInfo*>::iterator iter = lights.begin();
+   for ( U32 i = 0; iter != lights.end(); iter++, i++ )
    {
       // Get the light.
       LightInfo *light = (*iter);
@@ -157,15 +158,16 @@ void LightQuery::_scoreLights()
       
       // TODO: Manager ambient lights here too!
 
-      light->setScore( luminace * weight * dist );
+      mLights[i].light = light;
+      mLights[i].score = luminace * weight * dist;
    }
 
    // Sort them!
    mLights.sort( _lightScoreCmp );
 }
 
-S32 LightQuery::_lightScoreCmp( LightInfo* const *a, LightInfo* const *b )
+S32 LightQuery::_lightScoreCmp( const ScoredLight *a, const ScoredLight *b )
 {
-   F32 diff = (*a)->getScore() - (*b)->getScore();
+   F32 diff = a->score - b->score;
    return diff < 0 ? 1 : diff > 0 ? -1 : 0;
 }
@@ -64,15 +64,25 @@ public:
 
 protected:
 
+   /// A light and its score for the query volume.
+   ///
+   /// The score is kept here rather than on the LightInfo so
+   /// that queries can run on several threads at once.
+   struct ScoredLight
+   {
+      LightInfo *light;
+      F32 score;
+   };
+
    void _scoreLights();
 
-   static S32 _lightScoreCmp( LightInfo* const *a, LightInfo* const *b );
+   static S32 _lightScoreCmp( const ScoredLight *a, const ScoredLight *b );
 
    /// The maximum lights to return from the query.
    const U32 mMaxLights;
 
    /// The sorted list of best lights.
-	Vector<LightInfo*> mLights;
+	Vector<ScoredLight> mLights;
 
    /// The sphere used to query for lights.
    SphereF mVolume;
@@ -29,6 +29,7 @@
 #include "materials/processedMaterial.h"
 #include "core/volume.h"
 #include "console/simSet.h"
+#include "gfx/bitmap/gBitmap.h"
 
 
 MaterialList::MaterialList()
@@ -384,6 +385,23 @@ void MaterialList::mapMaterial( U32 i )
 void MaterialList::initMatInstances(   const FeatureSet &features, 
                                        const GFXVertexFormat *vertexFormat )
 {
+   // Decode the textures of all the materials at once on the 
+   // thread pool.  The bitmaps are held until every instance 
+   // has created its textures from them.
+   Vector< Resource<GBitmap> > bitmaps;
+   if ( MaterialManager::smPrefetchTextures && mMatInstList.size() > 1 )
+   {
+      Vector<Material*> materials;
+      for( U32 i=0; i < mMatInstList.size(); i++ )
+      {
+         Material *mat = mMatInstList[i] ? dynamic_cast<Material*>( mMatInstList[i]->getMaterial() ) : NULL;
+         if ( mat )
+            materials.push_back( mat );
+      }
+
+      MATMGR->prefetchTextures( materials, &bitmaps );
+   }
+
    for( U32 i=0; i < mMatInstList.size(); i++ )
    {
       BaseMatInstance *matInst = mMatInstList[i];
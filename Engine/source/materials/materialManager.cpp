@@ -31,6 +31,13 @@
 #include "core/module.h"
 #include "console/consoleTypes.h"
 #include "console/engineAPI.h"
+#include "core/resourceManager.h"
+#include "core/stream/memStream.h"
+#include "core/volume.h"
+#include "gfx/bitmap/gBitmap.h"
+#include "gfx/bitmap/ddsFile.h"
+#include "platform/threads/threadPool.h"
+#include "platform/threads/threadFence.h"
 
 
 MODULE_BEGIN( MaterialManager )
@@ -51,6 +58,9 @@ MODULE_BEGIN( MaterialManager )
 MODULE_END;
 
 
+bool MaterialManager::smPrefetchTextures = true;
+
+
 MaterialManager::MaterialManager()
 {
    VECTOR_SET_ASSOCIATION( mMatInstanceList );
@@ -81,6 +91,11 @@ MaterialManager::MaterialManager()
    Con::NotifyDelegate callabck( this, &MaterialManager::_updateDefaultAnisotropy );
    Con::addVariableNotify( "$pref::Video::defaultAnisotropy", callabck );
 
+   Con::addVariable( "$pref::Materials::prefetchTextures", TypeBool, &smPrefetchTextures, 
+      "@brief If true the textures of the materials of a shape are decoded on the thread pool "
+      "before its material instances are initialized.\n\n"
+      "@ingroup Materials");
+
    Con::NotifyDelegate callabck2( this, &MaterialManager::_onDisableMaterialFeature );
    Con::setVariable( "$pref::Video::disableNormalMapping", "false" );
    Con::addVariableNotify( "$pref::Video::disableNormalMapping", callabck2 );
@@ -430,6 +445,155 @@ void MaterialManager::recalcFeaturesFromPrefs()
                                     Con::getBoolVariable( "$pref::Video::disableParallaxMapping", false ) );
 }
 
+/// Decodes a texture file which was read on the main thread.
+struct MaterialTextureDecodeItem : public ThreadPool::WorkItem
+{
+   /// The file data which is freed once decoded.
+   void *mData;
+   U32 mSize;
+
+   String mExtension;
+
+   /// The result or NULL if decoding failed.
+   GBitmap *mBitmap;
+
+   ThreadFence *mFence;
+
+   MaterialTextureDecodeItem( void *data, U32 size, const String &extension, ThreadFence *fence )
+      :  mData( data ),
+         mSize( size ),
+         mExtension( extension ),
+         mBitmap( NULL ),
+         mFence( fence )
+   {
+   }
+
+   ~MaterialTextureDecodeItem()
+   {
+      delete [] (char*)mData;
+      delete mBitmap;
+   }
+
+   virtual void execute()
+   {
+      PROFILE_SCOPE( MaterialTextureDecodeItem_execute );
+
+      MemStream stream( mSize, mData, true, false );
+      mBitmap = new GBitmap;
+      if ( !mBitmap->readBitmap( mExtension, stream ) )
+         SAFE_DELETE( mBitmap );
+
+      delete [] (char*)mData;
+      mData = NULL;
+
+      mFence->signal();
+   }
+};
+
+void MaterialManager::prefetchTextures( const Vector<Material*> &materials, Vector< Resource<GBitmap> > *outBitmaps )
+{
+   PROFILE_SCOPE( MaterialManager_PrefetchTextures );
+
+   const U64 startTime = Platform::getRealMicroseconds();
+
+   // Gather the stage textures the same way ProcessedMaterial 
+   // does and resolve them to files the way GBitmap does.
+   Vector<Torque::Path> paths;
+   for ( U32 i=0; i < materials.size(); i++ )
+   {
+      Material *mat = materials[i];
+
+      for ( U32 j=0; j < Material::MAX_STAGES; j++ )
+      {
+         const FileName *names[] = 
+         {
+            &mat->mDiffuseMapFilename[j],
+            &mat->mOverlayMapFilename[j],
+            &mat->mLightMapFilename[j],
+            &mat->mToneMapFilename[j],
+            &mat->mDetailMapFilename[j],
+            &mat->mNormalMapFilename[j],
+            &mat->mDetailNormalMapFilename[j],
+            &mat->mSpecularMapFilename[j],
+         };
+
+         for ( U32 k=0; k < sizeof( names ) / sizeof( names[0] ); k++ )
+         {
+            const String &name = *names[k];
+
+            // Skip texture targets.
+            if ( name.isEmpty() || name[0] == '#' )
+               continue;
+
+            Torque::Path path( name.find( '/' ) != String::NPos ? name : mat->getPath() + name );
+
+            // The texture manager loads DDS files itself.
+            if ( path.getExtension().equal( "dds", String::NoCase ) )
+               continue;
+
+            if ( !Torque::FS::IsFile( path ) )
+            {
+               Torque::Path ddsPath( path );
+               ddsPath.setExtension( "dds" );
+               if ( Torque::FS::IsFile( ddsPath ) || !GBitmap::sFindFile( path, &path ) )
+                  continue;
+            }
+
+            // Skip textures shared between materials and bitmaps
+            // which are already loaded or loading elsewhere.
+            if ( paths.contains( path ) ||
+                 !ResourceManager::get().find( path ).getPath().isEmpty() )
+               continue;
+
+            paths.push_back( path );
+         }
+      }
+   }
+
+   if ( paths.empty() )
+      return;
+
+   // Read the files here and decode them in parallel.
+   ThreadFence fence;
+   Vector< ThreadSafeRef<MaterialTextureDecodeItem> > items;
+   items.reserve( paths.size() );
+
+   for ( U32 i=0; i < paths.size(); i++ )
+   {
+      void *data;
+      U32 size;
+      if ( !Torque::FS::ReadFile( paths[i], data, size ) )
+      {
+         items.push_back( NULL );
+         continue;
+      }
+
+      MaterialTextureDecodeItem *item = new MaterialTextureDecodeItem( data, size, paths[i].getExtension(), &fence );
+      items.push_back( item );
+
+      fence.add();
+      ThreadPool::GLOBAL().queueWorkItem( item );
+   }
+
+   fence.wait();
+
+   // Hand the bitmaps to the resource manager so 
+   // GBitmap::load finds them already loaded.
+   for ( U32 i=0; i < paths.size(); i++ )
+   {
+      if ( !items[i] || !items[i]->mBitmap )
+         continue;
+
+      outBitmaps->increment();
+      outBitmaps->last().setResource( ResourceManager::get().load( paths[i] ), items[i]->mBitmap );
+      items[i]->mBitmap = NULL;
+
+      mInitStats.prefetchedTextures++;
+   }
+
+   mInitStats.prefetchTime += Platform::getRealMicroseconds() - startTime;
+}
+
 bool MaterialManager::_handleGFXEvent( GFXDevice::GFXDeviceEventType event_ )
 {
    switch ( event_ )
@@ -493,3 +657,27 @@ DefineConsoleFunction( getMapEntry, const char*, (const char * texName), ,
 {
 	return MATMGR->getMapEntry( String(texName) );
 }
+
+DefineEngineFunction( getMaterialInitStats, String, (),,
+   "@brief Returns the time spent initializing shader material instances since the "
+   "last call to resetMaterialInitStats().\n\n"
+   "@return A string of the form \"instances prefetchedTextures prefetchMs textureMs featureMs shaderMs finalizeMs\".\n"
+   "@ingroup Materials")
+{
+   const MaterialManager::InitStats &stats = MATMGR->getInitStats();
+   return String::ToString( "%d %d %.1f %.1f %.1f %.1f %.1f",
+      stats.instances,
+      stats.prefetchedTextures,
+      F64( stats.prefetchTime ) / 1000.0,
+      F64( stats.textureTime ) / 1000.0,
+      F64( stats.featureTime ) / 1000.0,
+      F64( stats.shaderTime ) / 1000.0,
+      F64( stats.finalizeTime ) / 1000.0 );
+}
+
+DefineEngineFunction( resetMaterialInitStats, void, (),,
+   "@brief Resets the material initialization timings returned by getMaterialInitStats().\n\n"
+   "@ingroup Materials")
+{
+   MATMGR->getInitStats().clear();
+}
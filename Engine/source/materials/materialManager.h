@@ -34,9 +34,13 @@
 #ifndef _TSINGLETON_H_
 #include "core/util/tSingleton.h"
 #endif
+#ifndef __RESOURCE_H__
+#include "core/resource.h"
+#endif
 
 class SimSet;
 class MatInstance;
+class GBitmap;
 
 class MaterialManager : public ManagedSingleton<MaterialManager>
 {
@@ -120,6 +124,52 @@ public:
    /// Re-initializes the material instances for a specific target material.   
    void reInitInstance( BaseMaterialDefinition *target );
 
+   /// Time spent initializing shader material instances 
+   /// broken down by stage, in microseconds.
+   struct InitStats
+   {
+      /// The number of material instances initialized.
+      U32 instances;
+
+      /// The number of textures decoded on the thread pool.
+      U32 prefetchedTextures;
+
+      /// Reading the prefetched texture files and 
+      /// waiting for them to be decoded.
+      U64 prefetchTime;
+
+      /// Creating the stage textures.
+      U64 textureTime;
+
+      /// Determining the features of each stage.
+      U64 featureTime;
+
+      /// Generating and compiling the shaders of each pass.
+      U64 shaderTime;
+
+      /// Creating the state blocks and material parameters.
+      U64 finalizeTime;
+
+      InitStats() { clear(); }
+
+      void clear() { dMemset( this, 0, sizeof( InitStats ) ); }
+   };
+
+   /// Returns the material initialization timings.
+   InitStats& getInitStats() { return mInitStats; }
+
+   /// Reads the stage textures of the materials that aren't loaded yet 
+   /// and decodes them on the thread pool.  The decoded bitmaps are held
+   /// as resources in @a outBitmaps, so while they are held initializing
+   /// the materials only has to create the textures.
+   ///
+   /// @see smPrefetchTextures
+   void prefetchTextures( const Vector<Material*> &materials, Vector< Resource<GBitmap> > *outBitmaps );
+
+   /// If true MaterialList decodes the textures of its
+   /// materials in parallel before initializing them.
+   static bool smPrefetchTextures;
+
 protected:
 
    // MatInstance tracks it's instances here
@@ -162,6 +212,8 @@ protected:
 
    BaseMatInstance* mWarningInst;
 
+   InitStats mInitStats;
+
    /// The default max anisotropy used in texture filtering.
    S32 mDefaultAnisotropy;
 
@@ -169,8 +169,13 @@ bool ProcessedShaderMaterial::init( const FeatureSet &features,
                                     const GFXVertexFormat *vertexFormat,
                                     const MatFeaturesDelegate &featuresDelegate )
 {
+   MaterialManager::InitStats &stats = MATMGR->getInitStats();
+   stats.instances++;
+
    // Load our textures
+   U64 startTime = Platform::getRealMicroseconds();
    _setStageData();
+   stats.textureTime += Platform::getRealMicroseconds() - startTime;
 
    // Determine how many stages we use
    mMaxStages = getNumStages(); 
@@ -184,18 +189,27 @@ bool ProcessedShaderMaterial::init( const FeatureSet &features,
       MaterialFeatureData fd;
 
       // Determine the features of this stage
+      startTime = Platform::getRealMicroseconds();
       _determineFeatures( i, fd, features );
    
       // Let the delegate poke at the features.
       if ( featuresDelegate )
          featuresDelegate( this, i, fd, features );
+      stats.featureTime += Platform::getRealMicroseconds() - startTime;
 
       // Create the passes for this stage
       if ( fd.features.isNotEmpty() )
-         if( !_createPasses( fd, i, features ) )
+      {
+         startTime = Platform::getRealMicroseconds();
+         const bool created = _createPasses( fd, i, features );
+         stats.shaderTime += Platform::getRealMicroseconds() - startTime;
+
+         if ( !created )
             return false;
+      }
    }
 
+   startTime = Platform::getRealMicroseconds();
    _initRenderPassDataStateBlocks();
    _initMaterialParameters();
    mDefaultParameters =  allocMaterialParameters();
@@ -230,6 +244,8 @@ bool ProcessedShaderMaterial::init( const FeatureSet &features,
          }
       }
 
+   stats.finalizeTime += Platform::getRealMicroseconds() - startTime;
+
    return true;
 }
 
@@ -0,0 +1,103 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "materials/materialManager.h"
+#include "materials/materialDefinition.h"
+#include "gfx/bitmap/gBitmap.h"
+#include "core/stream/fileStream.h"
+
+namespace
+{
+   /// Writes a small PNG where every pixel encodes its index.
+   bool writeTestBitmap(const char *fileName, U32 size)
+   {
+      GBitmap bitmap(size, size);
+      for(U32 y = 0; y < size; y++)
+         for(U32 x = 0; x < size; x++)
+            bitmap.setColor(x, y, ColorI(x, y, (x + y) & 0xFF));
+
+      FileStream stream;
+      if(!stream.open(fileName, Torque::FS::File::Write))
+         return false;
+
+      return bitmap.writeBitmap("png", stream);
+   }
+}
+
+TEST(MaterialManager, PrefetchTextures)
+{
+   const U32 numTextures = 8;
+   const U32 size = 64;
+
+   Vector<String> fileNames;
+   Vector<Material*> materials;
+   for(U32 i = 0; i < numTextures; i++)
+   {
+      fileNames.push_back(String::ToString("testPrefetch%d.png", i));
+      ASSERT_TRUE(writeTestBitmap(fileNames.last(), size))
+         << "Failed to write the test texture!";
+
+      // Two textures per material and every texture used twice.
+      if((i & 1) == 0)
+         materials.push_back(new Material);
+      materials.last()->mDiffuseMapFilename[0] = fileNames.last();
+      materials.last()->mNormalMapFilename[0] = fileNames.last();
+   }
+
+   const MaterialManager::InitStats before = MATMGR->getInitStats();
+
+   Vector< Resource<GBitmap> > bitmaps;
+   MATMGR->prefetchTextures(materials, &bitmaps);
+   EXPECT_EQ(bitmaps.size(), numTextures);
+   EXPECT_EQ(MATMGR->getInitStats().prefetchedTextures - before.prefetchedTextures, numTextures);
+
+   // Loading the textures now finds the decoded bitmaps.
+   for(U32 i = 0; i < bitmaps.size(); i++)
+   {
+      Resource<GBitmap> loaded = GBitmap::load(bitmaps[i].getPath());
+      EXPECT_TRUE((GBitmap*)loaded == (GBitmap*)bitmaps[i]);
+      ASSERT_TRUE(loaded != NULL);
+      EXPECT_EQ(loaded->getWidth(), size);
+      EXPECT_EQ(loaded->getHeight(), size);
+
+      ColorI color;
+      loaded->getColor(5, 9, color);
+      EXPECT_EQ(color, ColorI(5, 9, 14));
+   }
+
+   // Bitmaps which are loaded already aren't decoded again.
+   Vector< Resource<GBitmap> > again;
+   MATMGR->prefetchTextures(materials, &again);
+   EXPECT_EQ(again.size(), 0);
+
+   bitmaps.clear();
+   for(U32 i = 0; i < materials.size(); i++)
+      delete materials[i];
+   for(U32 i = 0; i < fileNames.size(); i++)
+      dFileDelete(fileNames[i]);
+}
+
+#endif
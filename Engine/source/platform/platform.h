@@ -197,6 +197,14 @@ namespace Platform
    /// @see PlatformTimer
    U32 getRealMilliseconds();
 
+   /// Returns a monotonic time in microseconds, for timing short pieces
+   /// of code.  Only differences between two calls mean anything.
+   U64 getRealMicroseconds();
+
+   /// Returns the most memory the process has had resident at any one
+   /// time, in bytes, or 0 if the platform can't tell.
+   U64 getPeakMemoryUsage();
+
    void advanceTime(U32 delta);
    S32 getBackgroundSleepTime();
 
@@ -29,6 +29,7 @@
 #include "platform/profiler.h"
 #include "platform/threads/mutex.h"
 #include "core/module.h"
+#include "platform/platformSlabAllocator.h"
 
 // If profile paths are enabled, disable profiling of the
 // memory manager as that would cause a cyclic dependency
@@ -47,6 +48,22 @@
 #ifdef TORQUE_MULTITHREAD
 void * gMemMutex = NULL;
 #endif
+
+#ifdef TORQUE_USE_SLAB_ALLOCATOR
+/// Resize a block owned by the slab allocator, moving it if the new size
+/// no longer fits its size class reasonably.
+static void* reallocSlabBlock( void* mem, dsize_t size, const char* fileName, const U32 line )
+{
+   const dsize_t oldSize = SlabAllocator::getBlockSize( mem );
+   if( size <= oldSize && size > oldSize / 2 )
+      return mem;
+
+   void* ret = dMalloc_r( size, fileName, line );
+   dMemcpy( ret, mem, getMin( oldSize, size ) );
+   SlabAllocator::free( mem );
+   return ret;
+}
+#endif
    
 //-------------------------------------- Make sure we don't have the define set
 #ifdef new
@@ -1270,6 +1287,15 @@ static void* alloc(dsize_t size, bool array, const char* fileName, const U32 lin
 {
    AssertFatal(size < MaxAllocationAmount, "Memory::alloc - tried to allocate > MaxAllocationAmount!");
 
+#ifdef TORQUE_USE_SLAB_ALLOCATOR
+   if( size && SlabAllocator::isSmall( size ) )
+   {
+      void* mem = SlabAllocator::alloc( size );
+      if( mem )
+         return mem;
+   }
+#endif
+
 #ifdef TORQUE_MULTITHREAD
    if(!gMemMutex && !gReentrantGuard)
    {
@@ -1384,6 +1410,14 @@ static void free(void* mem, bool array)
    if (!mem)
       return;
 
+#ifdef TORQUE_USE_SLAB_ALLOCATOR
+   if( SlabAllocator::owns( mem ) )
+   {
+      SlabAllocator::free( mem );
+      return;
+   }
+#endif
+
 #ifdef TORQUE_MULTITHREAD
    if(!gMemMutex)
       gMemMutex = Mutex::createMutex();
@@ -1470,6 +1504,11 @@ static void* realloc(void* mem, dsize_t size, const char* fileName, const U32 li
    if(!mem)
       return alloc(size, false, fileName, line);
 
+#ifdef TORQUE_USE_SLAB_ALLOCATOR
+   if( SlabAllocator::owns( mem ) )
+      return reallocSlabBlock( mem, size, fileName, line );
+#endif
+
 #ifdef TORQUE_MULTITHREAD
    if(!gMemMutex)
       gMemMutex = Mutex::createMutex();
@@ -1675,6 +1714,15 @@ dsize_t getMemoryAllocated()
 
 void getMemoryInfo( void* ptr, Info& info )
 {
+   #ifdef TORQUE_USE_SLAB_ALLOCATOR
+   if( SlabAllocator::owns( ptr ) )
+   {
+      dMemset( &info, 0, sizeof( info ) );
+      info.mAllocSize = SlabAllocator::getBlockSize( ptr );
+      return;
+   }
+   #endif
+
    #ifndef TORQUE_DISABLE_MEMORY_MANAGER
    
    AllocatedHeader* header = ( ( AllocatedHeader* ) ptr ) - 1;
@@ -1777,17 +1825,73 @@ AFTER_MODULE_INIT( Sim )
 // Don't manage our own memory
 void* dMalloc_r(dsize_t in_size, const char* fileName, const dsize_t line)
 {
+#ifdef TORQUE_USE_SLAB_ALLOCATOR
+   if( SlabAllocator::isSmall( in_size ) )
+   {
+      void* mem = SlabAllocator::alloc( in_size );
+      if( mem )
+         return mem;
+   }
+#endif
+
    return malloc(in_size);
 }
 
 void dFree(void* in_pFree)
 {
+#ifdef TORQUE_USE_SLAB_ALLOCATOR
+   if( SlabAllocator::owns( in_pFree ) )
+   {
+      SlabAllocator::free( in_pFree );
+      return;
+   }
+#endif
+
    free(in_pFree);
 }
 
 void* dRealloc_r(void* in_pResize, dsize_t in_size, const char* fileName, const dsize_t line)
 {
+#ifdef TORQUE_USE_SLAB_ALLOCATOR
+   if( SlabAllocator::owns( in_pResize ) )
+   {
+      if( !in_size )
+      {
+         SlabAllocator::free( in_pResize );
+         return NULL;
+      }
+
+      return reallocSlabBlock( in_pResize, in_size, fileName, line );
+   }
+#endif
+
    return realloc(in_pResize,in_size);
 }
 
+#ifdef TORQUE_USE_SLAB_ALLOCATOR
+
+// Send all of operator new through the slab allocator as well.
+
+void* FN_CDECL operator new(dsize_t size)
+{
+   return dMalloc_r(size, NULL, 0);
+}
+
+void* FN_CDECL operator new[](dsize_t size)
+{
+   return dMalloc_r(size, NULL, 0);
+}
+
+void FN_CDECL operator delete(void* mem)
+{
+   dFree(mem);
+}
+
+void FN_CDECL operator delete[](void* mem)
+{
+   dFree(mem);
+}
+
+#endif
+
 #endif
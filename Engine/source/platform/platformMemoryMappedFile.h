@@ -0,0 +1,80 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _PLATFORMMEMORYMAPPEDFILE_H_
+#define _PLATFORMMEMORYMAPPEDFILE_H_
+
+#ifndef _TORQUE_TYPES_H_
+#include "platform/types.h"
+#endif
+
+
+/// Platform independent read-only view of a whole file.
+///
+/// The file is mapped into the address space and the OS pages its
+/// contents in on first access, so only the parts that are actually
+/// read cost memory.  Clean pages can be dropped again by the OS at
+/// any time since they are backed by the file.
+///
+/// The path must be a native file system path; files inside zip
+/// volumes cannot be mapped.
+class MemoryMappedFile
+{
+   const U8 *mData;
+   U64 mSize;
+
+public:
+
+   MemoryMappedFile();
+   ~MemoryMappedFile();
+
+   /// Map the file at the native @a path, closing any previous mapping.
+   /// @return False if the file cannot be opened or mapped.
+   bool open( const char *path );
+
+   /// Unmap the file.  Pointers into the data become invalid.
+   void close();
+
+   bool isOpen() const { return mData != NULL; }
+
+   /// Returns the start of the mapped file or NULL if not open.
+   const U8* getData() const { return mData; }
+
+   /// Returns the size of the mapped file in bytes.
+   U64 getSize() const { return mSize; }
+
+   /// Hint that the given byte range will be read soon.
+   void prefetch( U64 offset, U64 size ) const;
+
+   /// Hint that the given byte range won't be read for a while so
+   /// the OS can reclaim its pages.
+   void evict( U64 offset, U64 size ) const;
+
+private:
+
+   // Not copyable.
+   MemoryMappedFile( const MemoryMappedFile& );
+   MemoryMappedFile& operator=( const MemoryMappedFile& );
+};
+
+#endif // _PLATFORMMEMORYMAPPEDFILE_H_
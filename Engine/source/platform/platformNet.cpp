@@ -134,6 +134,8 @@ static const char* strerror_wsa( S32 code )
 
 #include "core/util/tVector.h"
 #include "platform/platformNetAsync.h"
+#include "platform/platformNetIOThread.h"
+#include "platform/threads/thread.h"
 #include "console/console.h"
 #include "core/util/journal/process.h"
 #include "core/util/journal/journal.h"
@@ -143,11 +145,16 @@ static S32 defaultPort = 28000;
 static S32 netPort = 0;
 static NetSocket udpSocket = InvalidSocket;
 
+/// Does the I/O for udpSocket when Net::smUseIOThread is set.
+static NetIOThread *gIOThread = NULL;
+
 ConnectionNotifyEvent   Net::smConnectionNotify;
 ConnectionAcceptedEvent Net::smConnectionAccept;
 ConnectionReceiveEvent  Net::smConnectionReceive;
 PacketReceiveEvent      Net::smPacketReceive;
 
+bool Net::smUseIOThread = NetIOThread::isSupported();
+
 // local enum for socket states for polled sockets
 enum SocketState
 {
@@ -479,7 +486,7 @@ Net::Error Net::sendtoSocket(NetSocket socket, const U8 *buffer, S32  bufferSize
 bool Net::openPort(S32 port, bool doBind)
 {
    if(udpSocket != InvalidSocket)
-      ::closesocket(udpSocket);
+      closePort();
 
    // we turn off VDP in non-release builds because VDP does not support broadcast packets
    // which are required for LAN queries (PC->Xbox connectivity).  The wire protocol still
@@ -521,6 +528,17 @@ bool Net::openPort(S32 port, bool doBind)
       }
    }
    netPort = port;
+
+   // When playing back a journal the packets come from the journal.
+   if(udpSocket != InvalidSocket && smUseIOThread && !Journal::IsPlaying())
+   {
+      gIOThread = new NetIOThread;
+      if(gIOThread->start(udpSocket, port))
+         Con::printf("UDP I/O thread started");
+      else
+         SAFE_DELETE(gIOThread);
+   }
+
    return udpSocket != InvalidSocket;
 }
 
@@ -535,6 +553,9 @@ NetSocket Net::getPort()
 
 void Net::closePort()
 {
+   // Stop the I/O before the socket goes away.
+   SAFE_DELETE(gIOThread);
+
    if(udpSocket != InvalidSocket)
       ::closesocket(udpSocket);
 }
@@ -544,6 +565,12 @@ Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32  bufferS
    if(Journal::IsPlaying())
       return NoError;
 
+   // Hand the packet to the I/O thread.  Anyone but the
+   // main thread sends directly as the ring only has room
+   // for one producer.
+   if(gIOThread && ThreadManager::isMainThread())
+      return gIOThread->queueSend(address, buffer, bufferSize);
+
    if(address->type == NetAddress::IPAddress)
    {
       sockaddr_in ipAddr;
@@ -574,12 +601,30 @@ void Net::process()
    RawData tmpBuffer;
    tmpBuffer.alloc(MaxPacketDataSize);
 
+   // The I/O thread has already filtered the packets so just pass them
+   // on.  Each one is released before the handlers run as they may close
+   // the port, which deletes the I/O thread.
+   while(gIOThread)
+   {
+      const NetIOThread::Packet *packet = gIOThread->peekReceived();
+      if(!packet)
+         break;
+
+      const U32 size = packet->size;
+      srcAddress = packet->address;
+      dMemcpy(tmpBuffer.data, packet->data, size);
+      gIOThread->popReceived();
+
+      if(size > 0)
+         Net::smPacketReceive.trigger(srcAddress, RawData(tmpBuffer.data, size));
+   }
+
    for(;;)
    {
       socklen_t addrLen = sizeof(sa);
       S32 bytesRead = -1;
 
-      if(udpSocket != InvalidSocket)
+      if(udpSocket != InvalidSocket && !gIOThread)
          bytesRead = recvfrom(udpSocket, (char *) tmpBuffer.data, MaxPacketDataSize, 0, &sa, &addrLen);
 
       if(bytesRead == -1)
@@ -100,6 +100,11 @@ struct Net
    static ConnectionReceiveEvent  smConnectionReceive;
    static PacketReceiveEvent      smPacketReceive;
 
+   /// If true and the platform supports it, openPort() starts a thread
+   /// that does the UDP socket I/O in batches.
+   /// @see NetIOThread
+   static bool smUseIOThread;
+
    static bool init();
    static void shutdown();
 
@@ -0,0 +1,360 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platformNetIOThread.h"
+#include "platform/platformIntrinsics.h"
+
+#if defined( TORQUE_OS_LINUX )
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/poll.h>
+#include <sys/eventfd.h>
+#include <netinet/in.h>
+#include <errno.h>
+#endif
+
+
+NetIOThread::NetIOThread()
+   :  mSocket( InvalidSocket ),
+      mIgnorePort( 0 ),
+      mWakeFd( -1 ),
+      mWakePending( 0 ),
+      mReceiveRing( NULL ),
+      mReceiveHead( 0 ),
+      mReceiveTail( 0 ),
+      mSendRing( NULL ),
+      mSendHead( 0 ),
+      mSendTail( 0 )
+{
+   dMemset( &mStats, 0, sizeof( mStats ) );
+}
+
+NetIOThread::~NetIOThread()
+{
+   shutdown();
+}
+
+bool NetIOThread::isSupported()
+{
+#if defined( TORQUE_OS_LINUX )
+   return true;
+#else
+   return false;
+#endif
+}
+
+bool NetIOThread::start( NetSocket socket, U16 ignorePort )
+{
+   AssertFatal( mSocket == InvalidSocket, "NetIOThread::start - Already started!" );
+
+#if defined( TORQUE_OS_LINUX )
+
+   mWakeFd = eventfd( 0, EFD_NONBLOCK );
+   if ( mWakeFd == -1 )
+      return false;
+
+   mSocket = socket;
+   mIgnorePort = ignorePort;
+   mWakePending = 0;
+   mReceiveHead = mReceiveTail = 0;
+   mSendHead = mSendTail = 0;
+   dMemset( &mStats, 0, sizeof( mStats ) );
+
+   mReceiveRing = new Packet[ RingSize ];
+   mSendRing = new Packet[ RingSize ];
+
+   Parent::start();
+   return true;
+
+#else
+
+   return false;
+
+#endif
+}
+
+void NetIOThread::shutdown()
+{
+   if ( mSocket == InvalidSocket )
+      return;
+
+   stop();
+   _wake();
+   join();
+
+#if defined( TORQUE_OS_LINUX )
+   close( mWakeFd );
+#endif
+
+   mWakeFd = -1;
+   mSocket = InvalidSocket;
+
+   delete [] mReceiveRing;
+   mReceiveRing = NULL;
+   delete [] mSendRing;
+   mSendRing = NULL;
+}
+
+const NetIOThread::Packet* NetIOThread::peekReceived()
+{
+   // The I/O thread only moves the tail after it is
+   // done writing to the packets before it.
+   if ( mReceiveHead == dAtomicRead( mReceiveTail ) )
+      return NULL;
+
+   return &mReceiveRing[ mReceiveHead & ( RingSize - 1 ) ];
+}
+
+void NetIOThread::popReceived()
+{
+   AssertFatal( mReceiveHead != mReceiveTail, "NetIOThread::popReceived - The ring is empty!" );
+
+   // Hand the packet back to the I/O thread.
+   dFetchAndAdd( mReceiveHead, 1 );
+}
+
+Net::Error NetIOThread::queueSend( const NetAddress *address, const U8 *data, U32 size )
+{
+   AssertFatal( size <= Net::MaxPacketDataSize, "NetIOThread::queueSend - The packet is too big!" );
+
+   const U32 tail = mSendTail;
+   if ( tail - dAtomicRead( mSendHead ) >= RingSize )
+   {
+      // The I/O thread isn't keeping up.  Sending this one
+      // ourselves would get it out ahead of the queued ones, so
+      // drop it as a full socket buffer would.
+      mStats.sendOverflows++;
+      return Net::WouldBlock;
+   }
+
+   Packet &packet = mSendRing[ tail & ( RingSize - 1 ) ];
+   packet.address = *address;
+   packet.size = size;
+   dMemcpy( packet.data, data, size );
+
+   // Publish the packet.
+   dFetchAndAdd( mSendTail, 1 );
+
+   // Wake the I/O thread unless someone already did.
+   if ( dCompareAndSwap( mWakePending, 0, 1 ) )
+      _wake();
+
+   return Net::NoError;
+}
+
+void NetIOThread::_wake()
+{
+#if defined( TORQUE_OS_LINUX )
+   const U64 one = 1;
+   if ( write( mWakeFd, &one, sizeof( one ) ) != sizeof( one ) )
+   {
+      // The counter can only overflow if nobody
+      // is reading it, so there is nothing to do.
+   }
+#endif
+}
+
+void NetIOThread::run( void *arg )
+{
+   _setName( "NetIOThread" );
+
+#if defined( TORQUE_OS_LINUX )
+
+   bool canSend = true;
+
+   while ( !checkForStop() )
+   {
+      const bool receiveFull = mReceiveTail - dAtomicRead( mReceiveHead ) >= RingSize;
+      const bool sendPending = mSendHead != dAtomicRead( mSendTail );
+
+      pollfd fds[2];
+      fds[0].fd = mSocket;
+      fds[0].events = ( receiveFull ? 0 : POLLIN ) | ( sendPending && !canSend ? POLLOUT : 0 );
+      fds[0].revents = 0;
+      fds[1].fd = mWakeFd;
+      fds[1].events = POLLIN;
+      fds[1].revents = 0;
+
+      // If the main thread isn't draining the receive ring
+      // then check back soon, otherwise wait for I/O.
+      const S32 timeout = receiveFull ? 1 : 100;
+      if ( poll( fds, 2, timeout ) < 0 && errno != EINTR )
+         break;
+
+      if ( fds[1].revents & POLLIN )
+      {
+         U64 count;
+         if ( read( mWakeFd, &count, sizeof( count ) ) != sizeof( count ) )
+         {
+            // Spurious wake up... nothing to do.
+         }
+
+         // Clear the flag before looking at the ring so
+         // that any later send wakes us up again.
+         dCompareAndSwap( mWakePending, 1, 0 );
+      }
+
+      if ( fds[0].revents & POLLOUT )
+         canSend = true;
+
+      if ( canSend )
+         canSend = _send();
+
+      if ( fds[0].revents & POLLIN )
+         _receive();
+   }
+
+#endif
+}
+
+void NetIOThread::_receive()
+{
+#if defined( TORQUE_OS_LINUX )
+
+   mmsghdr msgs[ BatchSize ];
+   iovec iovs[ BatchSize ];
+   sockaddr_in addrs[ BatchSize ];
+
+   // Keep reading till the socket is drained or the ring is full.
+   for ( ;; )
+   {
+      const U32 tail = mReceiveTail;
+      const U32 free = RingSize - ( tail - dAtomicRead( mReceiveHead ) );
+      const U32 count = getMin( free, (U32)BatchSize );
+      if ( count == 0 )
+         return;
+
+      for ( U32 i = 0; i < count; i++ )
+      {
+         Packet &packet = mReceiveRing[ ( tail + i ) & ( RingSize - 1 ) ];
+         iovs[i].iov_base = packet.data;
+         iovs[i].iov_len = Net::MaxPacketDataSize;
+
+         dMemset( &msgs[i], 0, sizeof( mmsghdr ) );
+         msgs[i].msg_hdr.msg_name = &addrs[i];
+         msgs[i].msg_hdr.msg_namelen = sizeof( sockaddr_in );
+         msgs[i].msg_hdr.msg_iov = &iovs[i];
+         msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+
+      const S32 numRead = recvmmsg( mSocket, msgs, count, MSG_DONTWAIT, NULL );
+      mStats.receiveCalls++;
+      if ( numRead <= 0 )
+         return;
+
+      for ( S32 i = 0; i < numRead; i++ )
+      {
+         Packet &packet = mReceiveRing[ ( tail + i ) & ( RingSize - 1 ) ];
+         const sockaddr_in &addr = addrs[i];
+
+         // The sin_addr bytes are already in a.b.c.d order.
+         const U8 *ip = (const U8*)&addr.sin_addr.s_addr;
+         packet.address.type = NetAddress::IPAddress;
+         packet.address.netNum[0] = ip[0];
+         packet.address.netNum[1] = ip[1];
+         packet.address.netNum[2] = ip[2];
+         packet.address.netNum[3] = ip[3];
+         packet.address.port = ntohs( addr.sin_port );
+         packet.size = msgs[i].msg_len;
+
+         // Skip anything that isn't IPv4, truncated packets, and
+         // packets we sent to ourselves as Net::process does.
+         if (  addr.sin_family != AF_INET ||
+               ( msgs[i].msg_hdr.msg_flags & MSG_TRUNC ) ||
+               (  ip[0] == 127 && ip[1] == 0 && ip[2] == 0 && ip[3] == 1 &&
+                  packet.address.port == mIgnorePort ) )
+            packet.size = 0;
+      }
+
+      mStats.packetsReceived += numRead;
+
+      // Publish the packets.
+      dFetchAndAdd( mReceiveTail, numRead );
+
+      if ( numRead < count )
+         return;
+   }
+
+#endif
+}
+
+bool NetIOThread::_send()
+{
+#if defined( TORQUE_OS_LINUX )
+
+   mmsghdr msgs[ BatchSize ];
+   iovec iovs[ BatchSize ];
+   sockaddr_in addrs[ BatchSize ];
+
+   for ( ;; )
+   {
+      const U32 head = mSendHead;
+      const U32 count = getMin( dAtomicRead( mSendTail ) - head, (U32)BatchSize );
+      if ( count == 0 )
+         return true;
+
+      for ( U32 i = 0; i < count; i++ )
+      {
+         Packet &packet = mSendRing[ ( head + i ) & ( RingSize - 1 ) ];
+         iovs[i].iov_base = packet.data;
+         iovs[i].iov_len = packet.size;
+
+         dMemset( &addrs[i], 0, sizeof( sockaddr_in ) );
+         addrs[i].sin_family = AF_INET;
+         addrs[i].sin_port = htons( packet.address.port );
+         dMemcpy( &addrs[i].sin_addr.s_addr, packet.address.netNum, 4 );
+
+         dMemset( &msgs[i], 0, sizeof( mmsghdr ) );
+         msgs[i].msg_hdr.msg_name = &addrs[i];
+         msgs[i].msg_hdr.msg_namelen = sizeof( sockaddr_in );
+         msgs[i].msg_hdr.msg_iov = &iovs[i];
+         msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+
+      S32 numSent = sendmmsg( mSocket, msgs, count, MSG_DONTWAIT );
+      mStats.sendCalls++;
+
+      if ( numSent < 0 )
+      {
+         // Wait for the socket to drain.
+         if ( errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS )
+            return false;
+
+         // Any other error is for the first packet alone... drop
+         // it as sendto would have and carry on with the rest.
+         numSent = 1;
+      }
+      else
+         mStats.packetsSent += numSent;
+
+      // Hand the packets back to the main thread.
+      dFetchAndAdd( mSendHead, numSent );
+   }
+
+#else
+
+   return true;
+
+#endif
+}
@@ -0,0 +1,148 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _PLATFORM_PLATFORMNETIOTHREAD_H_
+#define _PLATFORM_PLATFORMNETIOTHREAD_H_
+
+#ifndef _PLATFORM_PLATFORMNET_H_
+#include "platform/platformNet.h"
+#endif
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+
+/// A thread that does the UDP socket I/O for Net in batches.
+///
+/// Received packets are handed to the main thread thru a single producer,
+/// single consumer ring and packets sent from the main thread are handed
+/// to the I/O thread thru another, so neither thread ever takes a lock.
+/// On Linux the thread moves up to BatchSize packets per system call with
+/// recvmmsg and sendmmsg.  It isn't supported on other platforms.
+///
+/// @see Net::smUseIOThread
+class NetIOThread : public Thread
+{
+   typedef Thread Parent;
+
+public:
+
+   enum Constants
+   {
+      /// The packet count of each ring.  This must be a power of 2.
+      RingSize = 1024,
+
+      /// The most packets moved per system call.
+      BatchSize = 64,
+   };
+
+   struct Packet
+   {
+      NetAddress address;
+
+      /// The packet size or zero if the packet should be skipped.
+      U32 size;
+
+      U8 data[ Net::MaxPacketDataSize ];
+   };
+
+   /// Counters for measuring how well the batching works.
+   struct Stats
+   {
+      U32 packetsReceived;
+      U32 packetsSent;
+      U32 receiveCalls;
+      U32 sendCalls;
+
+      /// Packets dropped as the send ring was full.
+      U32 sendOverflows;
+   };
+
+   NetIOThread();
+   virtual ~NetIOThread();
+
+   /// Returns true if the I/O thread works on this platform.
+   static bool isSupported();
+
+   /// Starts doing the I/O for a non-blocking UDP socket.  Packets
+   /// from the loopback address and ignorePort are dropped.
+   bool start( NetSocket socket, U16 ignorePort );
+
+   /// Stops the thread and waits for it to exit.  Unsent
+   /// packets are discarded.
+   void shutdown();
+
+   /// @name Main Thread Interface
+   /// These must only be called from the thread that started the I/O thread.
+   /// @{
+
+   /// Returns the oldest received packet or NULL if there isn't one.
+   const Packet* peekReceived();
+
+   /// Releases the packet returned by peekReceived().
+   void popReceived();
+
+   /// Queues a packet to be sent.  If the send ring is full the packet
+   /// is dropped, as sending it directly would pass the queued ones.
+   /// @return Net::WouldBlock if the packet was dropped.
+   Net::Error queueSend( const NetAddress *address, const U8 *data, U32 size );
+
+   /// @}
+
+   const Stats& getStats() const { return mStats; }
+
+   // Thread
+   virtual void run( void *arg );
+
+protected:
+
+   NetSocket mSocket;
+
+   U16 mIgnorePort;
+
+   /// Used to wake the I/O thread when there are packets to send.
+   S32 mWakeFd;
+
+   /// Set while a wake up is pending so that a burst of sends
+   /// only writes to mWakeFd once.
+   volatile U32 mWakePending;
+
+   Packet *mReceiveRing;
+   volatile U32 mReceiveHead;
+   volatile U32 mReceiveTail;
+
+   Packet *mSendRing;
+   volatile U32 mSendHead;
+   volatile U32 mSendTail;
+
+   Stats mStats;
+
+   void _wake();
+
+   void _receive();
+
+   /// Returns false if the socket can't take any more right now.
+   bool _send();
+};
+
+#endif // _PLATFORM_PLATFORMNETIOTHREAD_H_
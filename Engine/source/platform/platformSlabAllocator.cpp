@@ -0,0 +1,612 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "platform/platformSlabAllocator.h"
+
+#ifdef TORQUE_USE_SLAB_ALLOCATOR
+
+#include "platform/platformIntrinsics.h"
+#include "platform/threads/thread.h"
+#include "console/console.h"
+#include "console/engineAPI.h"
+
+#if defined( TORQUE_COMPILER_VISUALC )
+#  define SLAB_THREAD_LOCAL __declspec( thread )
+#else
+#  define SLAB_THREAD_LOCAL __thread
+#endif
+
+// Everything in here runs underneath operator new, so none of it may use
+// the engine's own containers, mutexes or anything else that allocates.
+// All state is zero-initialized POD so that allocations made during static
+// initialization work.
+
+namespace SlabAllocator
+{
+
+enum
+{
+   SpanShift = 16,
+   SpanSize = 1 << SpanShift,
+
+   /// Number of spans reserved from the system in one go.
+   SpansPerChunk = 16,
+
+   MapLeafShift = 16,
+   MapLeafSize = 1 << MapLeafShift,
+   MapRootSize = 1 << 16,
+
+   /// Blocks moved between a thread cache and the depot are batched to
+   /// roughly this many bytes.
+   BatchBytes = 8192,
+   MinBatchSize = 4,
+   MaxBatchSize = 64,
+
+   /// Maximum number of threads listed by dumpStats().
+   MaxDumpThreads = 64,
+};
+
+static const U32 sgClassSize[ NumSizeClasses ] =
+{
+   16, 32, 48, 64, 80, 96, 112, 128,
+   160, 192, 224, 256,
+   320, 384, 448, 512,
+   640, 768, 896, 1024
+};
+
+/// Maps ( size + 15 ) / 16 to a size class.
+static const U8 sgSizeToClass[ MaxBlockSize / 16 + 1 ] =
+{
+   0,
+   0, 1, 2, 3, 4, 5, 6, 7,
+   8, 8, 9, 9, 10, 10, 11, 11,
+   12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15,
+   16, 16, 16, 16, 16, 16, 16, 16, 17, 17, 17, 17, 17, 17, 17, 17,
+   18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19, 19, 19, 19
+};
+
+static inline U32 sizeToClass( dsize_t size )
+{
+   return sgSizeToClass[ ( size + 15 ) >> 4 ];
+}
+
+static inline U32 getBatchSize( U32 sizeClass )
+{
+   U32 batch = BatchBytes / sgClassSize[ sizeClass ];
+   if( batch < MinBatchSize )
+      batch = MinBatchSize;
+   else if( batch > MaxBatchSize )
+      batch = MaxBatchSize;
+   return batch;
+}
+
+static inline void*& nextBlock( void* block )
+{
+   return *reinterpret_cast< void** >( block );
+}
+
+//-----------------------------------------------------------------------------
+//    Locking.
+//-----------------------------------------------------------------------------
+
+static void spinLock( volatile U32& lock )
+{
+   U32 spins = 0;
+   while( !dCompareAndSwap( lock, 0, 1 ) )
+   {
+      if( ++ spins > 64 )
+      {
+         Platform::sleep( 0 );
+         spins = 0;
+      }
+   }
+}
+
+static void spinUnlock( volatile U32& lock )
+{
+   dCompareAndSwap( lock, 1, 0 );
+}
+
+//-----------------------------------------------------------------------------
+//    Spans.
+//-----------------------------------------------------------------------------
+
+/// Two-level map from span address to size class + 1 (0 = not a slab span).
+static U8* sgSpanMap[ MapRootSize ];
+
+static volatile U32 sgSpanLock;
+static U8* sgChunkCursor;
+static U32 sgNumSpansLeft;
+static dsize_t sgBytesReserved;
+
+static inline U32 lookupSpan( const void* ptr )
+{
+   const uintptr_t key = uintptr_t( ptr ) >> SpanShift;
+   const uintptr_t root = key >> MapLeafShift;
+   if( root >= MapRootSize )
+      return 0;
+
+   const U8* leaf = sgSpanMap[ root ];
+   if( !leaf )
+      return 0;
+
+   return leaf[ key & ( MapLeafSize - 1 ) ];
+}
+
+/// Take a fresh span from the current chunk and tag it with the given size class.
+static U8* allocSpan( U32 sizeClass )
+{
+   spinLock( sgSpanLock );
+
+   if( !sgNumSpansLeft )
+   {
+      U8* chunk = ( U8* ) dMalloc_aligned( SpanSize * SpansPerChunk, SpanSize );
+      if( !chunk || ( ( uintptr_t( chunk ) + SpanSize * SpansPerChunk - 1 ) >> ( SpanShift + MapLeafShift ) ) >= MapRootSize )
+      {
+         // Out of memory or outside of what the span map covers; callers
+         // fall back to the system heap.
+         if( chunk )
+            dFree_aligned( chunk );
+         spinUnlock( sgSpanLock );
+         return NULL;
+      }
+
+      sgChunkCursor = chunk;
+      sgNumSpansLeft = SpansPerChunk;
+      sgBytesReserved += SpanSize * SpansPerChunk;
+   }
+
+   U8* span = sgChunkCursor;
+   sgChunkCursor += SpanSize;
+   sgNumSpansLeft --;
+
+   const uintptr_t key = uintptr_t( span ) >> SpanShift;
+   const uintptr_t root = key >> MapLeafShift;
+
+   U8* leaf = sgSpanMap[ root ];
+   if( !leaf )
+   {
+      leaf = ( U8* ) dRealMalloc( MapLeafSize );
+      if( !leaf )
+      {
+         // Put the span back; it has not been handed out yet.
+         sgChunkCursor -= SpanSize;
+         sgNumSpansLeft ++;
+         spinUnlock( sgSpanLock );
+         return NULL;
+      }
+      dMemset( leaf, 0, MapLeafSize );
+      sgSpanMap[ root ] = leaf;
+   }
+
+   leaf[ key & ( MapLeafSize - 1 ) ] = sizeClass + 1;
+
+   spinUnlock( sgSpanLock );
+   return span;
+}
+
+//-----------------------------------------------------------------------------
+//    Depot.
+//-----------------------------------------------------------------------------
+
+/// Global pool of free blocks for one size class.
+struct Depot
+{
+   volatile U32 mLock;
+   void* mHead;
+   U32 mCount;
+   U32 mNumSpans;
+};
+
+static Depot sgDepots[ NumSizeClasses ];
+
+/// Append the list [ head, tail ] of count blocks to the depot.
+static void depotPush( U32 sizeClass, void* head, void* tail, U32 count )
+{
+   Depot& depot = sgDepots[ sizeClass ];
+   spinLock( depot.mLock );
+
+   nextBlock( tail ) = depot.mHead;
+   depot.mHead = head;
+   depot.mCount += count;
+
+   spinUnlock( depot.mLock );
+}
+
+/// Take up to one batch of blocks out of the depot, carving a new span if
+/// the depot has run dry.  Returns the number of blocks in outHead.
+static U32 depotFetch( U32 sizeClass, void*& outHead )
+{
+   Depot& depot = sgDepots[ sizeClass ];
+   const U32 batch = getBatchSize( sizeClass );
+
+   spinLock( depot.mLock );
+
+   if( !depot.mCount )
+   {
+      U8* span = allocSpan( sizeClass );
+      if( !span )
+      {
+         spinUnlock( depot.mLock );
+         outHead = NULL;
+         return 0;
+      }
+
+      const U32 size = sgClassSize[ sizeClass ];
+      const U32 numBlocks = SpanSize / size;
+
+      void* head = depot.mHead;
+      for( S32 i = numBlocks - 1; i >= 0; -- i )
+      {
+         void* block = span + i * size;
+         nextBlock( block ) = head;
+         head = block;
+      }
+
+      depot.mHead = head;
+      depot.mCount += numBlocks;
+      depot.mNumSpans ++;
+   }
+
+   const U32 count = getMin( batch, depot.mCount );
+
+   void* head = depot.mHead;
+   void* tail = head;
+   for( U32 i = 1; i < count; ++ i )
+      tail = nextBlock( tail );
+
+   depot.mHead = nextBlock( tail );
+   depot.mCount -= count;
+   nextBlock( tail ) = NULL;
+
+   spinUnlock( depot.mLock );
+
+   outHead = head;
+   return count;
+}
+
+//-----------------------------------------------------------------------------
+//    Thread caches.
+//-----------------------------------------------------------------------------
+
+struct ThreadCache
+{
+   struct Bin
+   {
+      void* mHead;
+      U32 mCount;
+   };
+
+   Bin mBins[ NumSizeClasses ];
+
+   /// Counters are only written by the owning thread; dumpStats() reads
+   /// them racily, which is fine for statistics.
+   volatile U32 mNumAllocs[ NumSizeClasses ];
+   volatile U32 mNumFrees[ NumSizeClasses ];
+
+   U32 mThreadId;
+   ThreadCache* mNext;
+};
+
+static SLAB_THREAD_LOCAL ThreadCache* sgThreadCache;
+
+static volatile U32 sgCacheLock;
+static ThreadCache* sgActiveCaches;
+static ThreadCache* sgFreeCaches;
+
+/// Counters folded in from caches of threads that have exited.
+static U32 sgRetiredAllocs[ NumSizeClasses ];
+static U32 sgRetiredFrees[ NumSizeClasses ];
+
+static ThreadCache* acquireThreadCache()
+{
+   spinLock( sgCacheLock );
+
+   ThreadCache* cache = sgFreeCaches;
+   if( cache )
+      sgFreeCaches = cache->mNext;
+   else
+   {
+      cache = ( ThreadCache* ) dRealMalloc( sizeof( ThreadCache ) );
+      if( !cache )
+      {
+         spinUnlock( sgCacheLock );
+         return NULL;
+      }
+   }
+
+   dMemset( cache, 0, sizeof( ThreadCache ) );
+   cache->mThreadId = ThreadManager::getCurrentThreadId();
+   cache->mNext = sgActiveCaches;
+   sgActiveCaches = cache;
+
+   spinUnlock( sgCacheLock );
+
+   sgThreadCache = cache;
+   return cache;
+}
+
+/// Move count blocks from the front of the bin to the depot.
+static void flushBin( U32 sizeClass, ThreadCache::Bin& bin, U32 count )
+{
+   void* head = bin.mHead;
+   void* tail = head;
+   for( U32 i = 1; i < count; ++ i )
+      tail = nextBlock( tail );
+
+   bin.mHead = nextBlock( tail );
+   bin.mCount -= count;
+
+   depotPush( sizeClass, head, tail, count );
+}
+
+//-----------------------------------------------------------------------------
+//    Public interface.
+//-----------------------------------------------------------------------------
+
+void* alloc( dsize_t size )
+{
+   AssertFatal( isSmall( size ), "SlabAllocator::alloc - block too large" );
+
+   const U32 sizeClass = sizeToClass( size );
+
+   ThreadCache* cache = sgThreadCache;
+   if( !cache )
+   {
+      cache = acquireThreadCache();
+      if( !cache )
+         return NULL;
+   }
+
+   ThreadCache::Bin& bin = cache->mBins[ sizeClass ];
+   if( !bin.mHead )
+   {
+      bin.mCount = depotFetch( sizeClass, bin.mHead );
+      if( !bin.mHead )
+         return NULL;
+   }
+
+   void* block = bin.mHead;
+   bin.mHead = nextBlock( block );
+   bin.mCount --;
+
+   cache->mNumAllocs[ sizeClass ] ++;
+
+   return block;
+}
+
+void free( void* ptr )
+{
+   const U32 span = lookupSpan( ptr );
+   AssertFatal( span != 0, "SlabAllocator::free - not a slab block" );
+   const U32 sizeClass = span - 1;
+
+   ThreadCache* cache = sgThreadCache;
+   if( !cache )
+      cache = acquireThreadCache();
+
+   if( !cache )
+   {
+      depotPush( sizeClass, ptr, ptr, 1 );
+      dFetchAndAdd( sgRetiredFrees[ sizeClass ], 1 );
+      return;
+   }
+
+   ThreadCache::Bin& bin = cache->mBins[ sizeClass ];
+   nextBlock( ptr ) = bin.mHead;
+   bin.mHead = ptr;
+   bin.mCount ++;
+
+   cache->mNumFrees[ sizeClass ] ++;
+
+   const U32 batch = getBatchSize( sizeClass );
+   if( bin.mCount > batch * 2 )
+      flushBin( sizeClass, bin, batch );
+}
+
+bool owns( const void* ptr )
+{
+   return ( ptr && lookupSpan( ptr ) != 0 );
+}
+
+dsize_t getBlockSize( const void* ptr )
+{
+   const U32 span = lookupSpan( ptr );
+   AssertFatal( span != 0, "SlabAllocator::getBlockSize - not a slab block" );
+   return sgClassSize[ span - 1 ];
+}
+
+void releaseThreadCache()
+{
+   ThreadCache* cache = sgThreadCache;
+   if( !cache )
+      return;
+
+   for( U32 i = 0; i < NumSizeClasses; ++ i )
+   {
+      ThreadCache::Bin& bin = cache->mBins[ i ];
+      if( bin.mCount )
+         flushBin( i, bin, bin.mCount );
+   }
+
+   spinLock( sgCacheLock );
+
+   for( U32 i = 0; i < NumSizeClasses; ++ i )
+   {
+      sgRetiredAllocs[ i ] += cache->mNumAllocs[ i ];
+      sgRetiredFrees[ i ] += cache->mNumFrees[ i ];
+   }
+
+   ThreadCache** link = &sgActiveCaches;
+   while( *link && *link != cache )
+      link = &( *link )->mNext;
+   if( *link )
+      *link = cache->mNext;
+
+   cache->mNext = sgFreeCaches;
+   sgFreeCaches = cache;
+
+   spinUnlock( sgCacheLock );
+
+   sgThreadCache = NULL;
+}
+
+dsize_t getBytesInUse()
+{
+   dsize_t bytes = 0;
+
+   spinLock( sgCacheLock );
+
+   for( U32 i = 0; i < NumSizeClasses; ++ i )
+   {
+      U32 inUse = sgRetiredAllocs[ i ] - sgRetiredFrees[ i ];
+      for( ThreadCache* cache = sgActiveCaches; cache != NULL; cache = cache->mNext )
+         inUse += cache->mNumAllocs[ i ] - cache->mNumFrees[ i ];
+
+      bytes += dsize_t( inUse ) * sgClassSize[ i ];
+   }
+
+   spinUnlock( sgCacheLock );
+
+   return bytes;
+}
+
+dsize_t getBytesReserved()
+{
+   return sgBytesReserved;
+}
+
+void dumpStats()
+{
+   // Snapshot everything first; printing allocates.
+
+   U32 numSpans[ NumSizeClasses ];
+   U32 numInDepot[ NumSizeClasses ];
+   U32 numAllocs[ NumSizeClasses ];
+   U32 numInUse[ NumSizeClasses ];
+   U32 numCached[ NumSizeClasses ];
+
+   struct ThreadInfo
+   {
+      U32 mThreadId;
+      U32 mNumAllocs;
+      U32 mNumFrees;
+      U32 mBytesCached;
+   };
+
+   ThreadInfo threads[ MaxDumpThreads ];
+   U32 numThreads = 0;
+   U32 numThreadsTotal = 0;
+
+   for( U32 i = 0; i < NumSizeClasses; ++ i )
+   {
+      Depot& depot = sgDepots[ i ];
+      spinLock( depot.mLock );
+      numSpans[ i ] = depot.mNumSpans;
+      numInDepot[ i ] = depot.mCount;
+      spinUnlock( depot.mLock );
+
+      numAllocs[ i ] = sgRetiredAllocs[ i ];
+      numInUse[ i ] = sgRetiredAllocs[ i ] - sgRetiredFrees[ i ];
+      numCached[ i ] = 0;
+   }
+
+   spinLock( sgCacheLock );
+
+   for( ThreadCache* cache = sgActiveCaches; cache != NULL; cache = cache->mNext )
+   {
+      ThreadInfo info;
+      info.mThreadId = cache->mThreadId;
+      info.mNumAllocs = 0;
+      info.mNumFrees = 0;
+      info.mBytesCached = 0;
+
+      for( U32 i = 0; i < NumSizeClasses; ++ i )
+      {
+         const U32 allocs = cache->mNumAllocs[ i ];
+         const U32 frees = cache->mNumFrees[ i ];
+         const U32 cached = cache->mBins[ i ].mCount;
+
+         numAllocs[ i ] += allocs;
+         numInUse[ i ] += allocs - frees;
+         numCached[ i ] += cached;
+
+         info.mNumAllocs += allocs;
+         info.mNumFrees += frees;
+         info.mBytesCached += cached * sgClassSize[ i ];
+      }
+
+      if( numThreads < MaxDumpThreads )
+         threads[ numThreads ++ ] = info;
+      numThreadsTotal ++;
+   }
+
+   spinUnlock( sgCacheLock );
+
+   Con::printf( "Slab allocator: %u bytes reserved", U32( getBytesReserved() ) );
+   Con::printf( "   size  spans    in use (bytes)      depot     cached     allocs" );
+
+   U32 totalInUse = 0;
+   for( U32 i = 0; i < NumSizeClasses; ++ i )
+   {
+      const U32 bytesInUse = numInUse[ i ] * sgClassSize[ i ];
+      totalInUse += bytesInUse;
+
+      Con::printf( "   %4u  %5u  %8u (%9u)  %9u  %9u  %9u",
+         sgClassSize[ i ], numSpans[ i ], numInUse[ i ], bytesInUse,
+         numInDepot[ i ], numCached[ i ], numAllocs[ i ] );
+   }
+
+   Con::printf( "   total in use: %u bytes", totalInUse );
+   Con::printf( "   %u thread caches:", numThreadsTotal );
+
+   for( U32 i = 0; i < numThreads; ++ i )
+      Con::printf( "      thread %-10u  allocs: %10u  frees: %10u  cached: %8u bytes",
+         threads[ i ].mThreadId, threads[ i ].mNumAllocs, threads[ i ].mNumFrees, threads[ i ].mBytesCached );
+}
+
+} // namespace SlabAllocator
+
+//-----------------------------------------------------------------------------
+
+DefineEngineFunction( dumpSlabAllocatorStats, void, (),,
+   "@brief Print per size class and per thread statistics of the slab allocator.\n\n"
+   "@note Only available when TORQUE_SLAB_ALLOCATOR is defined in torqueConfig.h.\n\n"
+   "@ingroup Debugging" )
+{
+   SlabAllocator::dumpStats();
+}
+
+DefineEngineFunction( getSlabAllocatorStats, const char*, (),,
+   "@brief Return the bytes in use and bytes reserved by the slab allocator.\n\n"
+   "@return A string of the form \"bytesInUse bytesReserved\".\n\n"
+   "@note Only available when TORQUE_SLAB_ALLOCATOR is defined in torqueConfig.h.\n\n"
+   "@ingroup Debugging" )
+{
+   char* buffer = Con::getReturnBuffer( 64 );
+   dSprintf( buffer, 64, "%u %u", U32( SlabAllocator::getBytesInUse() ), U32( SlabAllocator::getBytesReserved() ) );
+   return buffer;
+}
+
+#endif // TORQUE_USE_SLAB_ALLOCATOR
@@ -0,0 +1,97 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _PLATFORMSLABALLOCATOR_H_
+#define _PLATFORMSLABALLOCATOR_H_
+
+#ifndef _TORQUE_TYPES_H_
+#include "platform/types.h"
+#endif
+
+/// @file
+/// Size-class slab allocator used by platformMemory for small blocks.
+///
+/// Blocks of up to MaxBlockSize bytes are rounded up to one of a fixed set
+/// of size classes.  Each size class is carved out of 64KB spans that are
+/// reserved from the system in 1MB chunks and never returned.  Every thread
+/// keeps a small cache of free blocks per size class and exchanges them in
+/// batches with a global, per-class depot, so the common alloc/free path
+/// takes no locks.
+///
+/// The allocator is compiled in when TORQUE_SLAB_ALLOCATOR is defined in
+/// torqueConfig.h.  It is not used together with TORQUE_DEBUG_GUARD since
+/// slab blocks carry no allocation headers.
+
+#if defined( TORQUE_SLAB_ALLOCATOR ) && !defined( TORQUE_DEBUG_GUARD )
+   #define TORQUE_USE_SLAB_ALLOCATOR
+#endif
+
+namespace SlabAllocator
+{
+   enum
+   {
+      /// Largest block size served by the slab allocator.
+      MaxBlockSize = 1024,
+
+      /// Number of distinct block sizes.
+      NumSizeClasses = 20,
+   };
+
+#ifdef TORQUE_USE_SLAB_ALLOCATOR
+
+   /// Return true if a block of the given size is served by the slab allocator.
+   inline bool isSmall( dsize_t size ) { return size <= MaxBlockSize; }
+
+   /// Allocate a block of at most MaxBlockSize bytes.  The result is 16 byte aligned.
+   void* alloc( dsize_t size );
+
+   /// Free a block returned by alloc().
+   void free( void* ptr );
+
+   /// Return true if the given pointer was returned by alloc().
+   bool owns( const void* ptr );
+
+   /// Return the usable size of a block returned by alloc().
+   dsize_t getBlockSize( const void* ptr );
+
+   /// Hand the calling thread's cached blocks back to the global depot.
+   /// Called by the platform thread code when a thread exits.
+   void releaseThreadCache();
+
+   /// Return the number of bytes currently handed out in slab blocks.
+   dsize_t getBytesInUse();
+
+   /// Return the number of bytes reserved from the system for slab spans.
+   dsize_t getBytesReserved();
+
+   /// Print per size class and per thread statistics to the console.
+   void dumpStats();
+
+#else
+
+   inline void releaseThreadCache() {}
+
+#endif
+}
+
+#endif // _PLATFORMSLABALLOCATOR_H_
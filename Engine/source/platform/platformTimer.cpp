@@ -34,7 +34,7 @@ void TimeManager::_updateTime()
    // Now - we want to try to sleep until the time threshold will hit.
    S32 msTillThresh = (mBackground ? mBackgroundThreshold : mForegroundThreshold) - delta;
 
-   if(msTillThresh > 0)
+   if(msTillThresh > 0 && mFramePacing)
    {
       // There's some time to go, so let's sleep.
       Platform::sleep( msTillThresh );
@@ -50,6 +50,7 @@ void TimeManager::_updateTime()
 TimeManager::TimeManager()
 {
    mBackground = false;
+   mFramePacing = true;
    mTimer = PlatformTimer::create();
    Process::notify(this, &TimeManager::_updateTime, PROCESS_TIME_ORDER);
    
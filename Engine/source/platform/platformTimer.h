@@ -65,6 +65,7 @@ class TimeManager
    PlatformTimer *mTimer;
    S32 mForegroundThreshold, mBackgroundThreshold;
    bool mBackground;
+   bool mFramePacing;
    
    void _updateTime();
 
@@ -84,6 +85,11 @@ public:
    void setBackground(const bool isBackground) { mBackground = isBackground; };
    const bool getBackground() const { return mBackground; };
 
+   /// If false, time events are sent as fast as they can be processed
+   /// instead of sleeping until the threshold is reached.
+   void setFramePacing(const bool enabled) { mFramePacing = enabled; };
+   const bool getFramePacing() const { return mFramePacing; };
+
 };
 
 class DefaultPlatformTimer : public PlatformTimer
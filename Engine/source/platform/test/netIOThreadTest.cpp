@@ -0,0 +1,280 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "platform/platform.h"
+
+#ifdef TORQUE_OS_LINUX
+
+#include "testing/unitTesting.h"
+#include "platform/platformNetIOThread.h"
+#include "console/console.h"
+
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+
+namespace
+{
+   /// Opens a UDP socket on an unused loopback port.
+   NetSocket openLoopbackSocket(U16 &port, bool blocking)
+   {
+      NetSocket sock = socket(AF_INET, SOCK_DGRAM, 0);
+      if(sock < 0)
+         return InvalidSocket;
+
+      sockaddr_in addr;
+      dMemset(&addr, 0, sizeof(addr));
+      addr.sin_family = AF_INET;
+      addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      addr.sin_port = 0;
+
+      socklen_t addrLen = sizeof(addr);
+      if(bind(sock, (sockaddr*)&addr, sizeof(addr)) < 0 ||
+         getsockname(sock, (sockaddr*)&addr, &addrLen) < 0)
+      {
+         close(sock);
+         return InvalidSocket;
+      }
+
+      // Give the kernel room to buffer bursts.
+      S32 bufferSize = 1 << 20;
+      setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+      setsockopt(sock, SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize));
+
+      if(!blocking)
+         fcntl(sock, F_SETFL, fcntl(sock, F_GETFL) | O_NONBLOCK);
+      else
+      {
+         timeval timeout = { 1, 0 };
+         setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+      }
+
+      port = ntohs(addr.sin_port);
+      return sock;
+   }
+
+   NetAddress loopbackAddress(U16 port)
+   {
+      NetAddress address;
+      dMemset(&address, 0, sizeof(address));
+      address.type = NetAddress::IPAddress;
+      address.netNum[0] = 127;
+      address.netNum[3] = 1;
+      address.port = port;
+      return address;
+   }
+
+   void sendPacket(NetSocket sock, U16 port, U32 sequence, U32 size)
+   {
+      U8 buffer[Net::MaxPacketDataSize];
+      dMemset(buffer, sequence & 0xFF, size);
+      dMemcpy(buffer, &sequence, sizeof(sequence));
+
+      sockaddr_in addr;
+      dMemset(&addr, 0, sizeof(addr));
+      addr.sin_family = AF_INET;
+      addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      addr.sin_port = htons(port);
+      sendto(sock, buffer, size, 0, (sockaddr*)&addr, sizeof(addr));
+   }
+
+   /// Sends packets as fast as it can.
+   struct senderThread : public Thread
+   {
+      NetSocket mSocket;
+      U16 mPort;
+      U32 mCount;
+      U32 mSize;
+
+      senderThread(NetSocket sock, U16 port, U32 count, U32 size)
+         : mSocket(sock), mPort(port), mCount(count), mSize(size) {}
+
+      virtual void run(void*)
+      {
+         for(U32 i = 0; i < mCount; i++)
+            sendPacket(mSocket, mPort, i, mSize);
+      }
+   };
+}
+
+TEST(NetIOThread, RoundTrip)
+{
+   U16 serverPort, clientPort;
+   NetSocket server = openLoopbackSocket(serverPort, false);
+   NetSocket client = openLoopbackSocket(clientPort, true);
+   ASSERT_TRUE(server != InvalidSocket && client != InvalidSocket);
+
+   NetIOThread ioThread;
+   ASSERT_TRUE(ioThread.start(server, 0));
+
+   // Client to server thru the receive ring.  The count is
+   // more than a ring full so the ring has to wrap.
+   const U32 numPackets = NetIOThread::RingSize * 3;
+   U32 numReceived = 0;
+   U32 numBad = 0;
+   U32 sent = 0;
+   const U32 limit = Platform::getRealMilliseconds() + 5000;
+   while(numReceived < numPackets && Platform::getRealMilliseconds() < limit)
+   {
+      // Don't send more than we can buffer.
+      while(sent < numPackets && sent - numReceived < NetIOThread::RingSize / 2)
+         sendPacket(client, serverPort, sent++, 100);
+
+      while(const NetIOThread::Packet *packet = ioThread.peekReceived())
+      {
+         U32 sequence;
+         dMemcpy(&sequence, packet->data, sizeof(sequence));
+         if(packet->size != 100 || sequence != numReceived || packet->address.port != clientPort)
+            numBad++;
+
+         numReceived++;
+         ioThread.popReceived();
+      }
+   }
+
+   EXPECT_EQ(numReceived, numPackets);
+   EXPECT_EQ(numBad, 0) << "Packets came out of the receive ring wrong!";
+
+   // Server to client thru the send ring.
+   const NetAddress clientAddress = loopbackAddress(clientPort);
+   U8 buffer[Net::MaxPacketDataSize];
+   for(U32 i = 0; i < 500; i++)
+   {
+      dMemset(buffer, i & 0xFF, 200);
+      EXPECT_EQ(ioThread.queueSend(&clientAddress, buffer, 200), Net::NoError);
+   }
+
+   numBad = 0;
+   for(U32 i = 0; i < 500; i++)
+   {
+      const S32 bytesRead = recv(client, buffer, sizeof(buffer), 0);
+      if(bytesRead != 200 || buffer[0] != (i & 0xFF) || buffer[199] != (i & 0xFF))
+         numBad++;
+   }
+   EXPECT_EQ(numBad, 0) << "Packets sent thru the send ring were lost or reordered!";
+
+   // The batching should save a lot of calls.
+   const NetIOThread::Stats &stats = ioThread.getStats();
+   EXPECT_LT(stats.sendCalls, 500);
+
+   ioThread.shutdown();
+   close(server);
+   close(client);
+}
+
+TEST(NetIOThread, StressLoopback)
+{
+   // Blasts small packets at a socket and receives them with a recvfrom
+   // per packet on the main thread, as Net::process does without the I/O
+   // thread, and then thru the I/O thread.  Packets per second and the
+   // time the main thread spends receiving go to the console.
+
+   const U32 numPackets = 200000;
+   const U32 packetSize = 120;
+
+   U32 received[2] = { 0, 0 };
+   U32 totalTime[2];
+   U32 mainThreadTime[2] = { 0, 0 };
+   U32 numCalls[2] = { 0, 0 };
+
+   for(U32 run = 0; run < 2; run++)
+   {
+      U16 serverPort, clientPort;
+      NetSocket server = openLoopbackSocket(serverPort, false);
+      NetSocket client = openLoopbackSocket(clientPort, true);
+      ASSERT_TRUE(server != InvalidSocket && client != InvalidSocket);
+
+      NetIOThread ioThread;
+      if(run == 1)
+         ASSERT_TRUE(ioThread.start(server, 0));
+
+      senderThread sender(client, serverPort, numPackets, packetSize);
+      const U32 start = Platform::getRealMilliseconds();
+      sender.start();
+
+      // Receive until we've gone 200ms without a packet.
+      U32 lastPacketTime = Platform::getRealMilliseconds();
+      while(Platform::getRealMilliseconds() - lastPacketTime < 200)
+      {
+         const U32 tickStart = Platform::getRealMilliseconds();
+         U32 count = 0;
+
+         if(run == 0)
+         {
+            U8 buffer[Net::MaxPacketDataSize];
+            sockaddr_in addr;
+            for(;;)
+            {
+               socklen_t addrLen = sizeof(addr);
+               numCalls[run]++;
+               if(recvfrom(server, buffer, sizeof(buffer), 0, (sockaddr*)&addr, &addrLen) <= 0)
+                  break;
+               count++;
+            }
+         }
+         else
+         {
+            while(ioThread.peekReceived())
+            {
+               ioThread.popReceived();
+               count++;
+            }
+         }
+
+         mainThreadTime[run] += Platform::getRealMilliseconds() - tickStart;
+         received[run] += count;
+         if(count > 0)
+            lastPacketTime = Platform::getRealMilliseconds();
+
+         // Stand in for the rest of the tick.
+         Platform::sleep(1);
+      }
+
+      totalTime[run] = Platform::getRealMilliseconds() - start - 200;
+      sender.join();
+
+      if(run == 1)
+      {
+         numCalls[run] = ioThread.getStats().receiveCalls;
+         ioThread.shutdown();
+      }
+
+      close(server);
+      close(client);
+
+      EXPECT_GT(received[run], 0);
+   }
+
+   Con::printf("UDP loopback receive, %u packets of %u bytes:", numPackets, packetSize);
+   const char *names[2] = { "recvfrom on main thread", "NetIOThread" };
+   for(U32 run = 0; run < 2; run++)
+      Con::printf("   %-24s %u received, %u pps, %u ms on the main thread, %u receive calls",
+         names[run], received[run], (U32)(received[run] * 1000.0 / getMax(totalTime[run], 1U)),
+         mainThreadTime[run], numCalls[run]);
+}
+
+#endif // TORQUE_OS_LINUX
+#endif // TORQUE_TESTS_ENABLED
@@ -0,0 +1,79 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platformSlabAllocator.h"
+
+#ifdef TORQUE_USE_SLAB_ALLOCATOR
+
+#include "platform/threads/thread.h"
+
+TEST(SlabAllocator, SizeClasses)
+{
+   for(U32 size = 1; size <= SlabAllocator::MaxBlockSize; size += 7)
+   {
+      void* mem = SlabAllocator::alloc(size);
+      ASSERT_TRUE(mem != NULL);
+      EXPECT_TRUE(SlabAllocator::owns(mem));
+      EXPECT_GE(SlabAllocator::getBlockSize(mem), size);
+      EXPECT_TRUE((uintptr_t(mem) & 15) == 0)
+         << "Slab blocks must be 16 byte aligned!";
+
+      dMemset(mem, 0xAB, size);
+      SlabAllocator::free(mem);
+   }
+
+   void* systemMem = dRealMalloc(16);
+   EXPECT_FALSE(SlabAllocator::owns(systemMem));
+   EXPECT_FALSE(SlabAllocator::owns(NULL));
+   dRealFree(systemMem);
+}
+
+TEST(SlabAllocator, CrossThreadFree)
+{
+   // Allocates on a worker and frees on the main thread.
+   struct thread : public Thread
+   {
+      void* mBlocks[256];
+
+      virtual void run(void*)
+      {
+         for(U32 i = 0; i < 256; i++)
+            mBlocks[i] = SlabAllocator::alloc(48);
+      }
+   };
+
+   thread worker;
+   worker.start();
+   worker.join();
+
+   for(U32 i = 0; i < 256; i++)
+   {
+      ASSERT_TRUE(SlabAllocator::owns(worker.mBlocks[i]));
+      SlabAllocator::free(worker.mBlocks[i]);
+   }
+}
+
+#endif
+#endif
@@ -0,0 +1,162 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/threads/jobGraph.h"
+
+
+//=============================================================================
+//    JobGraph::Job.
+//=============================================================================
+
+void JobGraph::Job::execute()
+{
+   run();
+   mGraph->_finishJob( this );
+}
+
+//=============================================================================
+//    JobGraph.
+//=============================================================================
+
+JobGraph::JobGraph( ThreadPool* pool )
+   : mPool( pool ),
+     mStarted( false )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+JobGraph::~JobGraph()
+{
+   if( mStarted )
+      mFence.wait();
+}
+
+//-----------------------------------------------------------------------------
+
+JobGraph::Job* JobGraph::addJob( Job* job )
+{
+   AssertFatal( job->mGraph == NULL, "JobGraph::addJob - job already belongs to a graph" );
+
+   job->mGraph = this;
+
+   mMutex.lock();
+   mJobs.push_back( job );
+   mMutex.unlock();
+
+   if( mStarted )
+   {
+      mFence.add();
+      _queueJob( job );
+   }
+
+   return job;
+}
+
+//-----------------------------------------------------------------------------
+
+JobGraph::Job* JobGraph::addFunction( JobFunction function, void* data )
+{
+   return addJob( new FunctionJob( function, data ) );
+}
+
+//-----------------------------------------------------------------------------
+
+void JobGraph::addDependency( Job* job, Job* dependency )
+{
+   AssertFatal( !mStarted, "JobGraph::addDependency - graph is already running" );
+   AssertFatal( job->mGraph == this && dependency->mGraph == this,
+      "JobGraph::addDependency - jobs must belong to this graph" );
+   AssertFatal( job != dependency, "JobGraph::addDependency - job can't depend on itself" );
+
+   job->mWaitingFor.add( 1 );
+   dependency->mContinuations.push_back( job );
+}
+
+//-----------------------------------------------------------------------------
+
+void JobGraph::start()
+{
+   AssertFatal( !mStarted, "JobGraph::start - graph is already running" );
+
+   // Collect the roots before queueing anything as jobs may already
+   // finish and add continuations while we're still going.
+
+   Vector< Job* > roots;
+   for( U32 i = 0; i < mJobs.size(); ++ i )
+      if( mJobs[ i ]->mWaitingFor.getValue() == 0 )
+         roots.push_back( mJobs[ i ] );
+
+   AssertFatal( mJobs.empty() || !roots.empty(),
+      "JobGraph::start - every job depends on another one; the graph has a cycle" );
+
+   mFence.add( mJobs.size() );
+   mStarted = true;
+
+   for( U32 i = 0; i < roots.size(); ++ i )
+      _queueJob( roots[ i ] );
+}
+
+//-----------------------------------------------------------------------------
+
+bool JobGraph::wait( S32 timeoutMS )
+{
+   if( !mStarted )
+      return mJobs.empty();
+
+   return mFence.wait( timeoutMS );
+}
+
+//-----------------------------------------------------------------------------
+
+void JobGraph::clear()
+{
+   if( mStarted )
+      mFence.wait();
+
+   mJobs.clear();
+   mStarted = false;
+}
+
+//-----------------------------------------------------------------------------
+
+void JobGraph::_queueJob( Job* job )
+{
+   mPool->queueWorkItem( job );
+}
+
+//-----------------------------------------------------------------------------
+
+void JobGraph::_finishJob( Job* job )
+{
+   for( U32 i = 0; i < job->mContinuations.size(); ++ i )
+   {
+      Job* continuation = job->mContinuations[ i ];
+      if( continuation->mWaitingFor.decrement() == 0 )
+         _queueJob( continuation );
+   }
+
+   // The graph may be gone as soon as the last job signals, so this
+   // has to come last.
+   mFence.signal();
+}
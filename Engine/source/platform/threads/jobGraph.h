@@ -0,0 +1,191 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _JOBGRAPH_H_
+#define _JOBGRAPH_H_
+
+#ifndef _THREADPOOL_H_
+#  include "platform/threads/threadPool.h"
+#endif
+#ifndef _THREADFENCE_H_
+#  include "platform/threads/threadFence.h"
+#endif
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#  include "platform/threads/mutex.h"
+#endif
+#ifndef _TVECTOR_H_
+#  include "core/util/tVector.h"
+#endif
+
+
+/// A set of jobs with dependencies between them that runs on a ThreadPool.
+///
+/// Jobs are added and linked up front, then start() queues every job
+/// that doesn't depend on anything.  Whenever a job finishes, the jobs
+/// that were waiting on it and have nothing else left to wait for are
+/// queued right from the worker thread, so a chain of jobs never has to
+/// round-trip through the thread that started the graph.
+///
+/// A running job may also add continuation jobs to its graph.  These are
+/// queued right away and wait() doesn't return before they finish, too.
+///
+/// @code
+/// JobGraph graph;
+/// JobGraph::Job* load = graph.addFunction( &loadData, data );
+/// JobGraph::Job* a = graph.addFunction( &processA, data );
+/// JobGraph::Job* b = graph.addFunction( &processB, data );
+/// graph.addDependency( a, load );
+/// graph.addDependency( b, load );
+/// graph.start();
+/// graph.wait();
+/// @endcode
+///
+/// @note As jobs get queued from worker threads, use wait() rather than
+///    ThreadPool::flushWorkItems() to find out when the graph is done.
+class JobGraph
+{
+   public:
+
+      /// A unit of work in a JobGraph.
+      class Job : public ThreadPool::WorkItem
+      {
+         public:
+
+            typedef ThreadPool::WorkItem Parent;
+            friend class JobGraph;
+
+            Job()
+               : mGraph( NULL ) {}
+
+            /// Return the graph the job was added to.
+            JobGraph* getGraph() const { return mGraph; }
+
+         protected:
+
+            JobGraph* mGraph;
+
+            /// Number of jobs that have to finish before this one can run.
+            ThreadSafeCounter mWaitingFor;
+
+            /// Jobs that wait for this one.
+            Vector< Job* > mContinuations;
+
+            /// Do the work of the job.  This is the function to implement
+            /// by subclasses.
+            virtual void run() = 0;
+
+            // ThreadPool::WorkItem.
+            virtual void execute();
+      };
+
+      typedef void ( *JobFunction )( void* data );
+
+      /// A job that calls a plain function.
+      class FunctionJob : public Job
+      {
+         public:
+
+            FunctionJob( JobFunction function, void* data )
+               : mFunction( function ), mData( data ) {}
+
+         protected:
+
+            JobFunction mFunction;
+            void* mData;
+
+            virtual void run() { mFunction( mData ); }
+      };
+
+   protected:
+
+      ThreadPool* mPool;
+
+      /// Counts the jobs that haven't finished yet.
+      ThreadFence mFence;
+
+      /// Guards mJobs against running jobs adding continuations.
+      Mutex mMutex;
+
+      /// References to all jobs in the graph.
+      Vector< ThreadSafeRef< Job > > mJobs;
+
+      bool mStarted;
+
+      /// Hand a job without unfinished dependencies to the pool.
+      void _queueJob( Job* job );
+
+      /// Called on the worker thread once a job's run() returned.
+      void _finishJob( Job* job );
+
+   public:
+
+      /// Create an empty graph that runs its jobs on @a pool.
+      JobGraph( ThreadPool* pool = &ThreadPool::GLOBAL() );
+
+      /// Waits for the graph to finish if it's still running.
+      ~JobGraph();
+
+      /// Add a job to the graph which then keeps a reference to it.
+      ///
+      /// Once the graph has been started, only running jobs may add
+      /// jobs.  These are queued immediately and can't have dependencies.
+      Job* addJob( Job* job );
+
+      /// Add a job that calls @a function with @a data.
+      Job* addFunction( JobFunction function, void* data );
+
+      /// Make @a job wait for @a dependency to finish before it runs.
+      /// Both jobs must be part of this graph and the graph must not
+      /// have been started yet.
+      void addDependency( Job* job, Job* dependency );
+
+      /// Return the number of jobs in the graph.
+      U32 getNumJobs() const { return mJobs.size(); }
+
+      /// Queue all jobs that don't depend on other jobs.
+      void start();
+
+      bool isStarted() const { return mStarted; }
+
+      /// Return true if every job has finished.
+      bool isDone() { return mStarted && mFence.isDone(); }
+
+      /// Block until every job has finished.
+      ///
+      /// @warning Don't call this from a job or anything else running on
+      ///    the graph's ThreadPool.  The waiting thread isn't available to
+      ///    run jobs, so if the pool runs out of threads the graph can never
+      ///    finish and this deadlocks.
+      ///
+      /// @param timeoutMS Milliseconds to wait at most or -1 to wait forever.
+      /// @return True if the graph is done, false if the wait timed out.
+      bool wait( S32 timeoutMS = -1 );
+
+      /// Wait for the graph to finish and then remove all jobs so the
+      /// graph can be set up again.
+      ///
+      /// @warning Like wait(), don't call this from the graph's ThreadPool.
+      void clear();
+};
+
+#endif // _JOBGRAPH_H_
@@ -0,0 +1,218 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+
+#include "platform/threads/jobGraph.h"
+#include "core/util/tVector.h"
+#include "console/console.h"
+
+FIXTURE(JobGraph)
+{
+public:
+   // Stamps its finishing order and checks that every job it depends on
+   // stamped before it started.
+   struct OrderJob : public JobGraph::Job
+   {
+      ThreadSafeCounter& mClock;
+      Vector<OrderJob*> mDependencies;
+      U32 mStamp;
+      bool mRanTooEarly;
+
+      OrderJob(ThreadSafeCounter& clock)
+         : mClock(clock), mStamp(0), mRanTooEarly(false) {}
+
+   protected:
+      virtual void run()
+      {
+         for(U32 i = 0; i < mDependencies.size(); i++)
+            if(!mDependencies[i]->mStamp)
+               mRanTooEarly = true;
+
+         mStamp = mClock.increment();
+      }
+   };
+
+   // Adds a continuation job from inside the graph until the depth runs out.
+   struct SpawnJob : public JobGraph::Job
+   {
+      ThreadSafeCounter& mCount;
+      U32 mDepth;
+
+      SpawnJob(ThreadSafeCounter& count, U32 depth)
+         : mCount(count), mDepth(depth) {}
+
+   protected:
+      virtual void run()
+      {
+         mCount.increment();
+         if(mDepth > 0)
+         {
+            getGraph()->addJob(new SpawnJob(mCount, mDepth - 1));
+            getGraph()->addJob(new SpawnJob(mCount, mDepth - 1));
+         }
+      }
+   };
+
+   static void bump(void* data)
+   {
+      reinterpret_cast<ThreadSafeCounter*>(data)->increment();
+   }
+
+   static void link(JobGraph& graph, OrderJob* job, OrderJob* dependency)
+   {
+      graph.addDependency(job, dependency);
+      job->mDependencies.push_back(dependency);
+   }
+};
+
+TEST_FIX(JobGraph, Empty)
+{
+   JobGraph graph;
+   EXPECT_TRUE(graph.wait(0));
+   graph.start();
+   EXPECT_TRUE(graph.isDone());
+   EXPECT_TRUE(graph.wait());
+}
+
+TEST_FIX(JobGraph, Diamond)
+{
+   ThreadSafeCounter clock;
+   JobGraph graph;
+
+   OrderJob* top = new OrderJob(clock);
+   OrderJob* left = new OrderJob(clock);
+   OrderJob* right = new OrderJob(clock);
+   OrderJob* bottom = new OrderJob(clock);
+   graph.addJob(top);
+   graph.addJob(left);
+   graph.addJob(right);
+   graph.addJob(bottom);
+
+   link(graph, left, top);
+   link(graph, right, top);
+   link(graph, bottom, left);
+   link(graph, bottom, right);
+
+   graph.start();
+   EXPECT_TRUE(graph.wait());
+
+   EXPECT_EQ(top->mStamp, 1);
+   EXPECT_EQ(bottom->mStamp, 4);
+   EXPECT_FALSE(left->mRanTooEarly || right->mRanTooEarly || bottom->mRanTooEarly);
+}
+
+TEST_FIX(JobGraph, Functions)
+{
+   ThreadSafeCounter count;
+   JobGraph graph;
+
+   for(U32 i = 0; i < 100; i++)
+      graph.addFunction(&bump, &count);
+
+   graph.start();
+   graph.wait();
+   EXPECT_EQ(count.getValue(), 100);
+
+   // The graph can be set up again after clearing it.
+   graph.clear();
+   EXPECT_EQ(graph.getNumJobs(), 0);
+   graph.addFunction(&bump, &count);
+   graph.start();
+   graph.wait();
+   EXPECT_EQ(count.getValue(), 101);
+}
+
+TEST_FIX(JobGraph, Continuations)
+{
+   ThreadSafeCounter count;
+   JobGraph graph;
+
+   // A binary tree of depth 8 grown from the single root.
+   graph.addJob(new SpawnJob(count, 8));
+   graph.start();
+   graph.wait();
+
+   EXPECT_EQ(count.getValue(), 511);
+   EXPECT_EQ(graph.getNumJobs(), 511);
+}
+
+TEST_FIX(JobGraph, Stress)
+{
+   // Layers of jobs where each job depends on a few random jobs of the
+   // layer before it, run many times over.
+
+   const U32 numRounds = 50;
+   const U32 numLayers = 16;
+   const U32 jobsPerLayer = 64;
+   const U32 dependenciesPerJob = 3;
+
+   U32 numTooEarly = 0;
+   U32 numMissing = 0;
+   U32 seed = 1;
+
+   const U32 start = Platform::getRealMilliseconds();
+   for(U32 round = 0; round < numRounds; round++)
+   {
+      ThreadSafeCounter clock;
+      JobGraph graph;
+      Vector<OrderJob*> jobs;
+
+      for(U32 layer = 0; layer < numLayers; layer++)
+         for(U32 i = 0; i < jobsPerLayer; i++)
+         {
+            OrderJob* job = new OrderJob(clock);
+            graph.addJob(job);
+
+            if(layer > 0)
+               for(U32 d = 0; d < dependenciesPerJob; d++)
+               {
+                  seed = seed * 1664525 + 1013904223;
+                  const U32 index = (layer - 1) * jobsPerLayer + (seed >> 8) % jobsPerLayer;
+                  link(graph, job, jobs[index]);
+               }
+
+            jobs.push_back(job);
+         }
+
+      graph.start();
+      graph.wait();
+
+      for(U32 i = 0; i < jobs.size(); i++)
+      {
+         if(jobs[i]->mRanTooEarly)
+            numTooEarly++;
+         if(!jobs[i]->mStamp)
+            numMissing++;
+      }
+   }
+   const U32 time = Platform::getRealMilliseconds() - start;
+
+   EXPECT_EQ(numTooEarly, 0) << "a job ran before its dependencies finished";
+   EXPECT_EQ(numMissing, 0) << "a job never ran";
+
+   Con::printf("JobGraph: %u graphs of %u jobs in %u ms", numRounds, numLayers * jobsPerLayer, time);
+}
+
+#endif
@@ -0,0 +1,202 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+
+#include "platform/threads/threadFence.h"
+#include "platform/threads/thread.h"
+
+FIXTURE(ThreadFence)
+{
+public:
+   // Bumps a shared counter and signals the fence a number of times.
+   struct SignalThread : public Thread
+   {
+      ThreadFence& mFence;
+      ThreadSafeCounter& mCounter;
+      U32 mCount;
+
+      SignalThread(ThreadFence& fence, ThreadSafeCounter& counter, U32 count)
+         : mFence(fence), mCounter(counter), mCount(count) {}
+
+      virtual void run(void*)
+      {
+         for(U32 i = 0; i < mCount; i++)
+         {
+            mCounter.increment();
+            mFence.signal();
+         }
+      }
+   };
+
+   // Waits on the fence and records whether it saw all the work done.
+   struct WaitThread : public Thread
+   {
+      ThreadFence& mFence;
+      ThreadSafeCounter& mCounter;
+      U32 mExpected;
+      bool mSawAll;
+
+      WaitThread(ThreadFence& fence, ThreadSafeCounter& counter, U32 expected)
+         : mFence(fence), mCounter(counter), mExpected(expected), mSawAll(false) {}
+
+      virtual void run(void*)
+      {
+         mFence.wait();
+         mSawAll = (mCounter.getValue() == mExpected);
+      }
+   };
+};
+
+TEST_FIX(ThreadFence, Counter)
+{
+   ThreadSafeCounter counter;
+   EXPECT_EQ(counter.getValue(), 0);
+   EXPECT_EQ(counter.increment(), 1);
+   EXPECT_EQ(counter.increment(4), 5);
+   EXPECT_EQ(counter.decrement(), 4);
+   EXPECT_EQ(counter.exchange(1), 4);
+   EXPECT_TRUE(counter.tryDecrement());
+   EXPECT_FALSE(counter.tryDecrement());
+   EXPECT_EQ(counter.getValue(), 0);
+}
+
+TEST_FIX(ThreadFence, Basics)
+{
+   ThreadFence fence;
+   EXPECT_TRUE(fence.isDone());
+   EXPECT_TRUE(fence.wait());
+
+   fence.add(2);
+   EXPECT_EQ(fence.getPending(), 2);
+   EXPECT_FALSE(fence.wait(10)) << "wait should time out";
+
+   fence.signal();
+   EXPECT_FALSE(fence.isDone());
+   fence.signal();
+   EXPECT_TRUE(fence.isDone());
+   EXPECT_TRUE(fence.wait(10));
+}
+
+TEST_FIX(ThreadFence, Stress)
+{
+   // Several waiters and signallers over many rounds so that waiters
+   // arrive before, during and after the last signal.
+
+   const U32 numRounds = 200;
+   const U32 numSignallers = 4;
+   const U32 numWaiters = 3;
+   const U32 signalsPerThread = 500;
+
+   ThreadFence fence;
+   U32 numMissed = 0;
+
+   for(U32 round = 0; round < numRounds; round++)
+   {
+      ThreadSafeCounter counter;
+      const U32 expected = numSignallers * signalsPerThread;
+      fence.add(expected);
+
+      WaitThread* waiters[numWaiters];
+      for(U32 i = 0; i < numWaiters; i++)
+      {
+         waiters[i] = new WaitThread(fence, counter, expected);
+         waiters[i]->start();
+      }
+
+      SignalThread* signallers[numSignallers];
+      for(U32 i = 0; i < numSignallers; i++)
+      {
+         signallers[i] = new SignalThread(fence, counter, signalsPerThread);
+         signallers[i]->start();
+      }
+
+      fence.wait();
+      if(counter.getValue() != expected)
+         numMissed++;
+
+      for(U32 i = 0; i < numSignallers; i++)
+      {
+         signallers[i]->join();
+         delete signallers[i];
+      }
+      for(U32 i = 0; i < numWaiters; i++)
+      {
+         waiters[i]->join();
+         if(!waiters[i]->mSawAll)
+            numMissed++;
+         delete waiters[i];
+      }
+   }
+
+   EXPECT_EQ(numMissed, 0) << "a wait returned before all work was signaled";
+   EXPECT_TRUE(fence.isDone());
+}
+
+TEST_FIX(ThreadFence, DestroyAfterWait)
+{
+   // Owners such as JobGraph destroy the fence as soon as wait() returns,
+   // so no signal() may touch it after that.  A late access shows up as a
+   // use after free under a memory checker or as a corrupt fence below.
+
+   const U32 numRounds = 2000;
+   const U32 numSignallers = 2;
+
+   U32 numMissed = 0;
+   for(U32 round = 0; round < numRounds; round++)
+   {
+      ThreadSafeCounter counter;
+      ThreadFence* fence = new ThreadFence;
+      fence->add(numSignallers);
+
+      SignalThread* signallers[numSignallers];
+      for(U32 i = 0; i < numSignallers; i++)
+      {
+         signallers[i] = new SignalThread(*fence, counter, 1);
+         signallers[i]->start();
+      }
+
+      fence->wait();
+      if(counter.getValue() != numSignallers)
+         numMissed++;
+      delete fence;
+
+      // Whatever reuses the memory must not be changed by a late signal.
+      ThreadFence* next = new ThreadFence;
+      EXPECT_TRUE(next->isDone());
+
+      for(U32 i = 0; i < numSignallers; i++)
+      {
+         signallers[i]->join();
+         delete signallers[i];
+      }
+
+      EXPECT_TRUE(next->isDone());
+      delete next;
+   }
+
+   EXPECT_EQ(numMissed, 0) << "a wait returned before all work was signaled";
+}
+
+#endif
@@ -0,0 +1,214 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+
+#include "platform/threads/threadSafeRing.h"
+#include "platform/threads/thread.h"
+#include "core/util/tVector.h"
+#include "console/console.h"
+
+FIXTURE(ThreadSafeRing)
+{
+public:
+   enum
+   {
+      NumProducers = 4,
+      ValuesPerProducer = 250000,
+   };
+
+   // Pushes an increasing sequence tagged with the producer index.
+   template<typename Ring>
+   struct ProducerThread : public Thread
+   {
+      Ring& mRing;
+      U32 mProducer;
+      U32 mCount;
+      U32 mFullCount;
+
+      ProducerThread(Ring& ring, U32 producer, U32 count)
+         : mRing(ring), mProducer(producer), mCount(count), mFullCount(0) {}
+
+      virtual void run(void*)
+      {
+         for(U32 i = 0; i < mCount; i++)
+         {
+            const U32 value = (mProducer << 24) | i;
+            while(!mRing.tryPush(value))
+            {
+               mFullCount++;
+               Platform::sleep(0);
+            }
+         }
+      }
+   };
+};
+
+TEST_FIX(ThreadSafeRing, Basics)
+{
+   ThreadSafeRing<U32> ring(4);
+   U32 value;
+
+   EXPECT_TRUE(ring.isEmpty());
+   EXPECT_FALSE(ring.tryPop(value));
+
+   for(U32 i = 0; i < 4; i++)
+      EXPECT_TRUE(ring.tryPush(i));
+   EXPECT_FALSE(ring.tryPush(4)) << "ring should be full";
+   EXPECT_EQ(ring.size(), 4);
+
+   // Wrap around a few times.
+   for(U32 i = 0; i < 10; i++)
+   {
+      EXPECT_TRUE(ring.tryPop(value));
+      EXPECT_EQ(value, i);
+      EXPECT_TRUE(ring.tryPush(i + 4));
+   }
+
+   for(U32 i = 10; i < 14; i++)
+   {
+      EXPECT_TRUE(ring.tryPop(value));
+      EXPECT_EQ(value, i);
+   }
+   EXPECT_TRUE(ring.isEmpty());
+}
+
+TEST_FIX(ThreadSafeRing, MultiProducerBasics)
+{
+   ThreadSafeMultiProducerRing<U32> ring(4);
+   U32 value;
+
+   EXPECT_TRUE(ring.isEmpty());
+   EXPECT_FALSE(ring.tryPop(value));
+
+   for(U32 i = 0; i < 4; i++)
+      EXPECT_TRUE(ring.tryPush(i));
+   EXPECT_FALSE(ring.tryPush(4)) << "ring should be full";
+
+   for(U32 i = 0; i < 10; i++)
+   {
+      EXPECT_TRUE(ring.tryPop(value));
+      EXPECT_EQ(value, i);
+      EXPECT_TRUE(ring.tryPush(i + 4));
+   }
+
+   for(U32 i = 10; i < 14; i++)
+   {
+      EXPECT_TRUE(ring.tryPop(value));
+      EXPECT_EQ(value, i);
+   }
+   EXPECT_TRUE(ring.isEmpty());
+}
+
+TEST_FIX(ThreadSafeRing, StressSingleProducer)
+{
+   // A small ring so both sides keep running into each other.
+   const U32 numValues = NumProducers * ValuesPerProducer;
+   ThreadSafeRing<U32> ring(64);
+
+   ProducerThread< ThreadSafeRing<U32> > producer(ring, 0, numValues);
+
+   const U32 start = Platform::getRealMilliseconds();
+   producer.start();
+
+   U32 next = 0;
+   U32 numErrors = 0;
+   while(next < numValues)
+   {
+      U32 value;
+      if(!ring.tryPop(value))
+      {
+         Platform::sleep(0);
+         continue;
+      }
+
+      if(value != next)
+         numErrors++;
+      next++;
+   }
+
+   producer.join();
+   const U32 time = Platform::getRealMilliseconds() - start;
+
+   EXPECT_EQ(numErrors, 0) << "values came out of the ring out of order";
+   EXPECT_TRUE(ring.isEmpty());
+
+   Con::printf("ThreadSafeRing: %u values in %u ms, producer found the ring full %u times",
+      numValues, time, producer.mFullCount);
+}
+
+TEST_FIX(ThreadSafeRing, StressMultiProducer)
+{
+   typedef ThreadSafeMultiProducerRing<U32> Ring;
+   Ring ring(64);
+
+   ProducerThread<Ring>* producers[NumProducers];
+   for(U32 i = 0; i < NumProducers; i++)
+      producers[i] = new ProducerThread<Ring>(ring, i, ValuesPerProducer);
+
+   const U32 start = Platform::getRealMilliseconds();
+   for(U32 i = 0; i < NumProducers; i++)
+      producers[i]->start();
+
+   // Each producer's values must arrive complete and in order, however
+   // they are interleaved.
+   U32 next[NumProducers] = { 0 };
+   U32 numReceived = 0;
+   U32 numErrors = 0;
+   while(numReceived < NumProducers * ValuesPerProducer)
+   {
+      U32 value;
+      if(!ring.tryPop(value))
+      {
+         Platform::sleep(0);
+         continue;
+      }
+
+      const U32 producer = value >> 24;
+      if(producer >= NumProducers || (value & 0xffffff) != next[producer])
+         numErrors++;
+      else
+         next[producer]++;
+      numReceived++;
+   }
+
+   const U32 time = Platform::getRealMilliseconds() - start;
+
+   U32 fullCount = 0;
+   for(U32 i = 0; i < NumProducers; i++)
+   {
+      producers[i]->join();
+      fullCount += producers[i]->mFullCount;
+      EXPECT_EQ(next[i], ValuesPerProducer) << "values of a producer got lost";
+      delete producers[i];
+   }
+
+   EXPECT_EQ(numErrors, 0) << "values came out of the ring out of order";
+   EXPECT_TRUE(ring.isEmpty());
+
+   Con::printf("ThreadSafeMultiProducerRing: %u values from %u producers in %u ms, producers found the ring full %u times",
+      numReceived, NumProducers, time, fullCount);
+}
+
+#endif
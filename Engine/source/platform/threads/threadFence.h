@@ -0,0 +1,226 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _THREADFENCE_H_
+#define _THREADFENCE_H_
+
+#ifndef _PLATFORM_H_
+#  include "platform/platform.h"
+#endif
+#ifndef _PLATFORMINTRINSICS_H_
+#  include "platform/platformIntrinsics.h"
+#endif
+#ifndef _PLATFORMASSERT_H_
+#  include "platform/platformAssert.h"
+#endif
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#  include "platform/threads/semaphore.h"
+#endif
+
+
+/// An unsigned counter that any number of threads may change at once.
+///
+/// dFetchAndAdd() doesn't return the previous value on all platforms,
+/// so changes that need the result go through a compare-and-swap loop.
+class ThreadSafeCounter
+{
+   public:
+
+      ThreadSafeCounter( U32 value = 0 )
+         : mValue( value ) {}
+
+      U32 getValue() { return dAtomicRead( mValue ); }
+
+      /// Add to the counter without looking at the result.
+      void add( U32 amount ) { dFetchAndAdd( mValue, amount ); }
+
+      /// Add to the counter and return the new value.
+      U32 increment( U32 amount = 1 )
+      {
+         U32 value;
+         do
+            value = dAtomicRead( mValue );
+         while( !dCompareAndSwap( mValue, value, value + amount ) );
+
+         return value + amount;
+      }
+
+      /// Subtract from the counter and return the new value.
+      U32 decrement( U32 amount = 1 )
+      {
+         U32 value;
+         do
+         {
+            value = dAtomicRead( mValue );
+            AssertFatal( value >= amount, "ThreadSafeCounter::decrement - counter would go below zero" );
+         }
+         while( !dCompareAndSwap( mValue, value, value - amount ) );
+
+         return value - amount;
+      }
+
+      /// Set the counter to @a value and return what it was before.
+      U32 exchange( U32 value )
+      {
+         U32 oldValue;
+         do
+            oldValue = dAtomicRead( mValue );
+         while( !dCompareAndSwap( mValue, oldValue, value ) );
+
+         return oldValue;
+      }
+
+      /// Subtract one unless the counter is zero.
+      /// @return True if the counter was decremented.
+      bool tryDecrement()
+      {
+         U32 value;
+         do
+         {
+            value = dAtomicRead( mValue );
+            if( !value )
+               return false;
+         }
+         while( !dCompareAndSwap( mValue, value, value - 1 ) );
+
+         return true;
+      }
+
+   protected:
+
+      // Padded to 8 bytes as dAtomicRead() may read a whole word.
+      union
+      {
+         volatile U32 mValue;
+         U64 mAlign;
+      };
+};
+
+
+/// Lets threads wait for a number of pending tasks to complete.
+///
+/// Work is announced with add() and reported done with signal().  Once
+/// the last pending task signals, every thread blocked in wait() wakes
+/// up.  The fence can be reused by adding more work after that.
+///
+/// wait() and isDone() only report the fence done once every signal() has
+/// stopped touching it, so the owner may destroy the fence right away.
+///
+/// @code
+/// ThreadFence fence;
+/// fence.add( numItems );
+/// // ...each item calls fence.signal() when finished...
+/// fence.wait();
+/// @endcode
+class ThreadFence
+{
+   public:
+
+      ThreadFence()
+         : mSemaphore( 0 ) {}
+
+      /// Announce @a count more pending tasks.
+      void add( U32 count = 1 ) { mPending.add( count ); }
+
+      /// Report a pending task as done.
+      void signal()
+      {
+         // Announce ourselves before the work can be seen as done so
+         // that waiters hold on to the fence until we are out of it.
+         mSignaling.add( 1 );
+
+         if( mPending.decrement() == 0 )
+         {
+            // Every registered waiter gets exactly one release.  Waiters that
+            // see the fence done before this point take themselves off the
+            // count instead.
+            for( U32 waiters = mWaiters.exchange( 0 ); waiters > 0; -- waiters )
+               mSemaphore.release();
+         }
+
+         // This must be the last access to the fence.
+         mSignaling.decrement();
+      }
+
+      /// Return the number of tasks that haven't signaled yet.
+      U32 getPending() { return mPending.getValue(); }
+
+      bool isDone() { return getPending() == 0 && mSignaling.getValue() == 0; }
+
+      /// Block until there are no pending tasks.
+      ///
+      /// @param timeoutMS Milliseconds to wait at most or -1 to wait forever.
+      /// @return True if the fence is done, false if the wait timed out.
+      bool wait( S32 timeoutMS = -1 )
+      {
+         while( getPending() != 0 )
+         {
+            mWaiters.add( 1 );
+
+            bool released;
+            if( getPending() == 0 )
+               released = false;
+            else
+               released = mSemaphore.acquire( true, timeoutMS );
+
+            if( !released && !mWaiters.tryDecrement() )
+            {
+               // signal() already counted us and the release is on its
+               // way; take it so it doesn't wake a later wait.
+               mSemaphore.acquire();
+            }
+
+            if( !released && timeoutMS != -1 )
+            {
+               if( getPending() != 0 )
+                  return false;
+
+               break;
+            }
+         }
+
+         // The last signal() may still be releasing waiters.  That is
+         // only a few instructions, but the signaling thread may have been
+         // preempted, so give up the time slice while spinning.
+         while( mSignaling.getValue() != 0 )
+            Platform::sleep( 0 );
+
+         return true;
+      }
+
+   protected:
+
+      ThreadSafeCounter mPending;
+      ThreadSafeCounter mWaiters;
+
+      /// The number of signal() calls that are still using the fence.
+      ThreadSafeCounter mSignaling;
+      Semaphore mSemaphore;
+
+   private:
+
+      ThreadFence( const ThreadFence& );
+      ThreadFence& operator=( const ThreadFence& );
+};
+
+#endif // _THREADFENCE_H_
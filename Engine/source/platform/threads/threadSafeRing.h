@@ -0,0 +1,260 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _THREADSAFERING_H_
+#define _THREADSAFERING_H_
+
+#ifndef _PLATFORMINTRINSICS_H_
+#  include "platform/platformIntrinsics.h"
+#endif
+#ifndef _PLATFORMASSERT_H_
+#  include "platform/platformAssert.h"
+#endif
+
+
+/// @file
+/// Bounded lock-free ring buffers for passing values between threads.
+///
+/// Unlike ThreadSafeDeque these never allocate once constructed, so
+/// they are suited for hot paths like handing work to and from a
+/// dedicated thread every frame.  When a ring is full, pushing fails
+/// and the caller decides whether to drop, retry or do the work itself.
+
+
+/// A bounded ring with a single producer thread and a single consumer
+/// thread.
+///
+/// The producer fills the slot before publishing it by advancing the
+/// tail and the consumer reads it before handing it back by advancing
+/// the head.  Both indices run freely and wrap around at 2^32 so a full
+/// ring can be told apart from an empty one.
+///
+/// @param T Type of the values; must have a default constructor and
+///    be assignable.
+template< typename T >
+class ThreadSafeRing
+{
+   public:
+
+      typedef T ValueType;
+
+      /// Create a ring holding up to @a capacity values.  This must
+      /// be a power of 2.
+      explicit ThreadSafeRing( U32 capacity )
+         : mSlots( new T[ capacity ] ),
+           mCapacity( capacity ),
+           mHead( 0 ),
+           mTail( 0 )
+      {
+         AssertFatal( capacity && !( capacity & ( capacity - 1 ) ),
+            "ThreadSafeRing - capacity must be a power of 2" );
+      }
+
+      ~ThreadSafeRing()
+      {
+         delete [] mSlots;
+      }
+
+      U32 getCapacity() const { return mCapacity; }
+
+      /// Return the number of values in the ring.  This is only a
+      /// snapshot when called while the other thread is active.
+      U32 size() { return dAtomicRead( mTail ) - dAtomicRead( mHead ); }
+
+      bool isEmpty() { return size() == 0; }
+
+      /// Append a value.  Must only be called by the producer.
+      /// @return False if the ring is full.
+      bool tryPush( const T& value )
+      {
+         const U32 tail = mTail;
+         if( tail - dAtomicRead( mHead ) >= mCapacity )
+            return false;
+
+         mSlots[ tail & ( mCapacity - 1 ) ] = value;
+         dFetchAndAdd( mTail, 1 );
+         return true;
+      }
+
+      /// Take the oldest value.  Must only be called by the consumer.
+      /// @return False if the ring is empty.
+      bool tryPop( T& outValue )
+      {
+         const U32 head = mHead;
+         if( head == dAtomicRead( mTail ) )
+            return false;
+
+         outValue = mSlots[ head & ( mCapacity - 1 ) ];
+         dFetchAndAdd( mHead, 1 );
+         return true;
+      }
+
+   protected:
+
+      // The indices each get their own cache line so the producer
+      // and consumer don't keep stealing it from each other.  They
+      // are also kept 8 byte aligned as dAtomicRead() may read a
+      // whole word.
+
+      T* mSlots;
+      U32 mCapacity;
+      U8 mPad0[ 64 - sizeof( U32 ) - sizeof( T* ) ];
+
+      volatile U32 mHead;
+      U8 mPad1[ 64 - sizeof( U32 ) ];
+
+      volatile U32 mTail;
+      U8 mPad2[ 64 - sizeof( U32 ) ];
+
+   private:
+
+      ThreadSafeRing( const ThreadSafeRing& );
+      ThreadSafeRing& operator=( const ThreadSafeRing& );
+};
+
+
+/// A bounded ring with any number of producer threads and a single
+/// consumer thread.
+///
+/// Producers claim a slot by advancing the tail with a CAS and then
+/// publish it by bumping the slot's sequence number, so a producer that
+/// stalls between the two only holds up the consumer at that slot and
+/// never the other producers.
+///
+/// @param T Type of the values; must have a default constructor and
+///    be assignable.
+template< typename T >
+class ThreadSafeMultiProducerRing
+{
+   public:
+
+      typedef T ValueType;
+
+      /// Create a ring holding up to @a capacity values.  This must
+      /// be a power of 2.
+      explicit ThreadSafeMultiProducerRing( U32 capacity )
+         : mSlots( new Slot[ capacity ] ),
+           mCapacity( capacity ),
+           mHead( 0 ),
+           mTail( 0 )
+      {
+         AssertFatal( capacity && !( capacity & ( capacity - 1 ) ),
+            "ThreadSafeMultiProducerRing - capacity must be a power of 2" );
+
+         for( U32 i = 0; i < capacity; ++ i )
+            mSlots[ i ].mSequence = i;
+      }
+
+      ~ThreadSafeMultiProducerRing()
+      {
+         delete [] mSlots;
+      }
+
+      U32 getCapacity() const { return mCapacity; }
+
+      /// Return the number of values claimed by producers but not yet
+      /// consumed.  This is only a snapshot.
+      U32 size() { return dAtomicRead( mTail ) - dAtomicRead( mHead ); }
+
+      bool isEmpty() { return size() == 0; }
+
+      /// Append a value.  May be called from any thread.
+      /// @return False if the ring is full.
+      bool tryPush( const T& value )
+      {
+         U32 pos = dAtomicRead( mTail );
+         while( true )
+         {
+            Slot& slot = mSlots[ pos & ( mCapacity - 1 ) ];
+            const S32 diff = S32( dAtomicRead( slot.mSequence ) - pos );
+
+            if( diff == 0 )
+            {
+               if( dCompareAndSwap( mTail, pos, pos + 1 ) )
+               {
+                  slot.mValue = value;
+                  dFetchAndAdd( slot.mSequence, 1 );
+                  return true;
+               }
+            }
+            else if( diff < 0 )
+            {
+               // The consumer hasn't released this slot from the
+               // previous lap yet.
+               return false;
+            }
+
+            pos = dAtomicRead( mTail );
+         }
+      }
+
+      /// Take the oldest value.  Must only be called by the consumer.
+      /// @return False if the ring is empty or the oldest slot is claimed
+      ///    but still being written.
+      bool tryPop( T& outValue )
+      {
+         const U32 pos = mHead;
+         Slot& slot = mSlots[ pos & ( mCapacity - 1 ) ];
+         if( S32( dAtomicRead( slot.mSequence ) - ( pos + 1 ) ) < 0 )
+            return false;
+
+         outValue = slot.mValue;
+         dFetchAndAdd( mHead, 1 );
+
+         // Hand the slot to the producer of the next lap.
+         dFetchAndAdd( slot.mSequence, mCapacity - 1 );
+         return true;
+      }
+
+   protected:
+
+      struct Slot
+      {
+         /// The position a producer may claim this slot at, or that
+         /// position plus one once the value has been written.
+         union
+         {
+            volatile U32 mSequence;
+            U64 mAlign;
+         };
+
+         T mValue;
+      };
+
+      Slot* mSlots;
+      U32 mCapacity;
+      U8 mPad0[ 64 - sizeof( U32 ) - sizeof( Slot* ) ];
+
+      volatile U32 mHead;
+      U8 mPad1[ 64 - sizeof( U32 ) ];
+
+      volatile U32 mTail;
+      U8 mPad2[ 64 - sizeof( U32 ) ];
+
+   private:
+
+      ThreadSafeMultiProducerRing( const ThreadSafeMultiProducerRing& );
+      ThreadSafeMultiProducerRing& operator=( const ThreadSafeMultiProducerRing& );
+};
+
+#endif // _THREADSAFERING_H_
@@ -24,6 +24,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <mm_malloc.h>
+#include <sys/resource.h>
 
 //--------------------------------------
 void* dRealMalloc(dsize_t in_size)
@@ -71,3 +72,13 @@ int dMemcmp(const void *ptr1, const void *ptr2, dsize_t len)
 {
    return(memcmp(ptr1, ptr2, len));
 }
+
+U64 Platform::getPeakMemoryUsage()
+{
+   rusage usage;
+   if(getrusage(RUSAGE_SELF, &usage) != 0)
+      return 0;
+
+   // OS X reports bytes.
+   return U64(usage.ru_maxrss);
+}
@@ -94,6 +94,12 @@ U32 Platform::getRealMilliseconds()
    return ret;
 }   
 
+U64 Platform::getRealMicroseconds()
+{
+   Nanoseconds nanos = AbsoluteToNanoseconds(UpTime());
+   return UnsignedWideToUInt64(nanos) / 1000;
+}
+
 U32 Platform::getVirtualMilliseconds()
 {
    return sgCurrentTime;   
@@ -0,0 +1,111 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "platform/platformMemoryMappedFile.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+//-----------------------------------------------------------------------------
+
+static U64 getPageSize()
+{
+   static const U64 sPageSize = sysconf( _SC_PAGESIZE );
+   return sPageSize;
+}
+
+MemoryMappedFile::MemoryMappedFile()
+   : mData( NULL ),
+     mSize( 0 )
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+   close();
+}
+
+bool MemoryMappedFile::open( const char *path )
+{
+   close();
+
+   const S32 fd = ::open( path, O_RDONLY );
+   if ( fd < 0 )
+      return false;
+
+   struct stat info;
+   if ( fstat( fd, &info ) != 0 || info.st_size <= 0 || U64( info.st_size ) != U64( size_t( info.st_size ) ) )
+   {
+      ::close( fd );
+      return false;
+   }
+
+   void *data = mmap( NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+   // The mapping keeps its own reference to the file.
+   ::close( fd );
+
+   if ( data == MAP_FAILED )
+      return false;
+
+   mData = (const U8*)data;
+   mSize = info.st_size;
+   return true;
+}
+
+void MemoryMappedFile::close()
+{
+   if ( !mData )
+      return;
+
+   munmap( (void*)mData, mSize );
+   mData = NULL;
+   mSize = 0;
+}
+
+void MemoryMappedFile::prefetch( U64 offset, U64 size ) const
+{
+   if ( !mData || offset >= mSize )
+      return;
+
+   // madvise wants page aligned addresses.
+   const U64 start = offset & ~( getPageSize() - 1 );
+   const U64 end = ( offset + size < mSize ) ? offset + size : mSize;
+   madvise( (void*)( mData + start ), end - start, MADV_WILLNEED );
+}
+
+void MemoryMappedFile::evict( U64 offset, U64 size ) const
+{
+   if ( !mData || offset >= mSize )
+      return;
+
+   // Only drop whole pages inside the range.
+   const U64 pageMask = getPageSize() - 1;
+   const U64 start = ( offset + pageMask ) & ~pageMask;
+   const U64 end = ( ( offset + size < mSize ) ? offset + size : mSize ) & ~pageMask;
+   if ( end > start )
+      madvise( (void*)( mData + start ), end - start, MADV_DONTNEED );
+}
@@ -27,6 +27,8 @@
 #include "platform/threads/semaphore.h"
 #include "platform/platformIntrinsics.h"
 #include "core/util/safeDelete.h"
+#include "core/frameAllocator.h"
+#include "platform/platformSlabAllocator.h"
 
 #include <process.h> // [tom, 4/20/2006] for _beginthread()
 
@@ -76,6 +78,7 @@ static U32 __stdcall ThreadRunHandler(void * arg)
 
    ThreadManager::addThread(mData->mThread);
    mData->mThread->run(mData->mRunArg);
+   FrameAllocator::releaseThreadArena();
    ThreadManager::removeThread(mData->mThread);
 
    bool autoDelete = mData->mThread->autoDelete;
@@ -87,6 +90,8 @@ static U32 __stdcall ThreadRunHandler(void * arg)
    if( autoDelete )
       delete mData->mThread; // Safe as we own the data.
 
+   SlabAllocator::releaseThreadCache();
+
    _endthreadex( 0 );
    return 0;
 }
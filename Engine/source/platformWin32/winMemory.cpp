@@ -22,6 +22,9 @@
 
 #include "platformWin32/platformWin32.h"
 #include <xmmintrin.h>
+#include <psapi.h>
+
+#pragma comment(lib, "psapi.lib")
 
 void* dMemcpy(void *dst, const void *src, dsize_t size)
 {
@@ -71,4 +74,13 @@ void *dMalloc_aligned(dsize_t in_size, S32 alignment)
 void dFree_aligned(void* p)
 {
    return _mm_free(p);
-}
\ No newline at end of file
+}
+
+U64 Platform::getPeakMemoryUsage()
+{
+   PROCESS_MEMORY_COUNTERS counters;
+   if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+      return 0;
+
+   return U64(counters.PeakWorkingSetSize);
+}
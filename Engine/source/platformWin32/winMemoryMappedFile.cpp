@@ -0,0 +1,115 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "platform/platformMemoryMappedFile.h"
+#include "platformWin32/platformWin32.h"
+#include "core/strings/unicode.h"
+
+//-----------------------------------------------------------------------------
+
+MemoryMappedFile::MemoryMappedFile()
+   : mData( NULL ),
+     mSize( 0 )
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+   close();
+}
+
+bool MemoryMappedFile::open( const char *path )
+{
+   close();
+
+#ifdef UNICODE
+   UTF16 widePath[ 1024 ];
+   convertUTF8toUTF16( path, widePath );
+   HANDLE file = CreateFileW( widePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+#else
+   HANDLE file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+#endif
+   if ( file == INVALID_HANDLE_VALUE )
+      return false;
+
+   LARGE_INTEGER fileSize;
+   if ( !GetFileSizeEx( file, &fileSize ) || fileSize.QuadPart <= 0 ||
+        U64( fileSize.QuadPart ) != U64( SIZE_T( fileSize.QuadPart ) ) )
+   {
+      CloseHandle( file );
+      return false;
+   }
+
+   HANDLE mapping = CreateFileMapping( file, NULL, PAGE_READONLY, 0, 0, NULL );
+   const void *data = mapping ? MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) : NULL;
+
+   // The view keeps its own references to the mapping and the file.
+   if ( mapping )
+      CloseHandle( mapping );
+   CloseHandle( file );
+
+   if ( !data )
+      return false;
+
+   mData = (const U8*)data;
+   mSize = fileSize.QuadPart;
+   return true;
+}
+
+void MemoryMappedFile::close()
+{
+   if ( !mData )
+      return;
+
+   UnmapViewOfFile( mData );
+   mData = NULL;
+   mSize = 0;
+}
+
+void MemoryMappedFile::prefetch( U64 offset, U64 size ) const
+{
+   if ( !mData || offset >= mSize )
+      return;
+
+   // PrefetchVirtualMemory is only available on Windows 8 and later, so
+   // touch one byte per page instead.  This blocks until the pages are in.
+   SYSTEM_INFO info;
+   GetSystemInfo( &info );
+
+   const U64 end = ( offset + size < mSize ) ? offset + size : mSize;
+   volatile U8 sink = 0;
+   for ( U64 i = offset; i < end; i += info.dwPageSize )
+      sink ^= mData[ i ];
+}
+
+void MemoryMappedFile::evict( U64 offset, U64 size ) const
+{
+   if ( !mData || offset >= mSize )
+      return;
+
+   // Removing pages from the working set makes them the first
+   // candidates for reuse without discarding them outright.
+   const U64 end = ( offset + size < mSize ) ? offset + size : mSize;
+   VirtualUnlock( (LPVOID)( mData + offset ), SIZE_T( end - offset ) );
+}
@@ -156,6 +156,21 @@ U32 Platform::getRealMilliseconds()
    return GetTickCount();
 }
 
+U64 Platform::getRealMicroseconds()
+{
+   static LARGE_INTEGER frequency = { 0 };
+   if(!frequency.QuadPart)
+      QueryPerformanceFrequency(&frequency);
+
+   LARGE_INTEGER count;
+   QueryPerformanceCounter(&count);
+
+   // Split it up so the multiply can't overflow.
+   const U64 secs = count.QuadPart / frequency.QuadPart;
+   const U64 rest = count.QuadPart % frequency.QuadPart;
+   return secs * 1000000 + rest * 1000000 / frequency.QuadPart;
+}
+
 U32 Platform::getVirtualMilliseconds()
 {
    return winState.currentTime;
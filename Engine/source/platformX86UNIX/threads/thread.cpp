@@ -24,6 +24,8 @@
 #include "platform/threads/thread.h"
 #include "platform/threads/semaphore.h"
 #include "platform/threads/mutex.h"
+#include "core/frameAllocator.h"
+#include "platform/platformSlabAllocator.h"
 #include <stdlib.h>
 
 class PlatformThreadData
@@ -58,6 +60,7 @@ static void *ThreadRunHandler(void * arg)
    
    ThreadManager::addThread(thread);
    thread->run(mData->mRunArg);
+   FrameAllocator::releaseThreadArena();
    ThreadManager::removeThread(thread);
 
    bool autoDelete = thread->autoDelete;
@@ -68,6 +71,8 @@ static void *ThreadRunHandler(void * arg)
    
    if( autoDelete )
       delete thread;
+
+   SlabAllocator::releaseThreadCache();
       
    // return value for pthread lib's benefit
    return NULL;
@@ -23,6 +23,7 @@
 #include "platformX86UNIX/platformX86UNIX.h"
 #include <stdlib.h>
 #include <mm_malloc.h>
+#include <sys/resource.h>
 
 void* dMemcpy(void *dst, const void *src, dsize_t size)
 {
@@ -66,3 +67,13 @@ void dFree_aligned(void* p)
 {
    return _mm_free(p);
 }
+
+U64 Platform::getPeakMemoryUsage()
+{
+   rusage usage;
+   if(getrusage(RUSAGE_SELF, &usage) != 0)
+      return 0;
+
+   // Linux reports kilobytes.
+   return U64(usage.ru_maxrss) * 1024;
+}
@@ -27,10 +27,15 @@
 #include "materials/matInstance.h"
 #include "scene/sceneManager.h"
 #include "console/engineAPI.h"
+#include "ts/instancingMatHook.h"
+#include "ts/tsMesh.h"
 
 
 IMPLEMENT_CONOBJECT(RenderBinManager);
 
+bool RenderBinManager::smAutoInstancing = true;
+S32 RenderBinManager::smAutoInstancingMinBatch = 4;
+
 
 RenderBinManager::RenderBinManager( const RenderInstType& ritype, F32 renderOrder, F32 processAddOrder ) :
    mRenderInstType( ritype ),
@@ -61,6 +66,18 @@ void RenderBinManager::initPersistFields()
       "Defines the order for adding instances in relation to other bins." );
 
    Parent::initPersistFields();
+
+   Con::addVariable( "$pref::Render::autoInstancing", TypeBool, &smAutoInstancing,
+      "@brief If true, the mesh bins draw runs of mesh instances that share their "
+      "mesh, material, lights and textures with a single hardware instanced draw call.  "
+      "Meshes with $pref::TS::maxInstancingVerts or more verts are not instanced.\n\n"
+      "@see $pref::Render::autoInstancingMinBatch\n"
+      "@ingroup RenderBin\n" );
+
+   Con::addVariable( "$pref::Render::autoInstancingMinBatch", TypeS32, &smAutoInstancingMinBatch,
+      "@brief The fewest mesh instances the mesh bins draw with one instanced draw call.\n"
+      "Shorter runs are drawn one by one.  The default value is 4.\n\n"
+      "@ingroup RenderBin\n" );
 }
 
 void RenderBinManager::onRemove()
@@ -147,6 +164,63 @@ S32 FN_CDECL RenderBinManager::cmpKeyFunc(const void* p1, const void* p2)
    return ( test1 == 0 ) ? S32(mse1->key2) - S32(mse2->key2) : test1;
 }
 
+BaseMatInstance* RenderBinManager::getAutoInstancingMat( U32 start ) const
+{
+   MeshRenderInst *ri = static_cast<MeshRenderInst*>( mElementList[start].inst );
+   BaseMatInstance *mat = ri->matInst;
+
+#ifdef TORQUE_OS_MAC
+
+   return mat;
+
+#else
+
+   if ( !smAutoInstancing || !mat || mat->isInstanced() )
+      return mat;
+
+   // Only look as far ahead as needed to know the run is long enough.
+   const U32 minBatch = getMax( smAutoInstancingMinBatch, 2 );
+   if ( getInstancedRunLength( start, minBatch ) < minBatch )
+      return mat;
+
+   // Fall back to the material itself if it can't be instanced.
+   BaseMatInstance *instancingMat = InstancingMaterialHook::getInstancingMat( mat );
+   if ( !instancingMat || !instancingMat->isValid() || !instancingMat->isInstanced() )
+      return mat;
+
+   return instancingMat;
+
+#endif
+}
+
+U32 RenderBinManager::getInstancedRunLength( U32 start, U32 maxLength ) const
+{
+   MeshRenderInst *ri = static_cast<MeshRenderInst*>( mElementList[start].inst );
+
+   // Big meshes gain little from instancing and cost
+   // a lot more vertex work, so leave them alone.
+   U32 numVerts = 0;
+   if ( ri->prim )
+      numVerts = ri->prim->numVertices;
+   else if ( ri->primBuff && ri->primBuff->isValid() &&
+             ri->primBuffIndex < (*ri->primBuff)->mPrimitiveCount )
+      numVerts = (*ri->primBuff)->mPrimitiveArray[ri->primBuffIndex].numVertices;
+
+   if ( (S32)numVerts >= TSMesh::smMaxInstancingVerts )
+      return 1;
+
+   const U32 end = getMin( start + maxLength, (U32)mElementList.size() );
+
+   U32 i = start + 1;
+   for ( ; i < end; i++ )
+   {
+      if ( newInstancedBatchNeeded( ri, static_cast<MeshRenderInst*>( mElementList[i].inst ) ) )
+         break;
+   }
+
+   return i - start;
+}
+
 void RenderBinManager::setupSGData( MeshRenderInst *ri, SceneData &data )
 {
    PROFILE_SCOPE( RenderBinManager_setupSGData );
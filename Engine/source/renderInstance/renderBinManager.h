@@ -86,6 +86,13 @@ public:
 
    MaterialOverrideDelegate& getMatOverrideDelegate() { return mMatOverrideDelegate; }
 
+   /// If true, mesh bins draw runs of instances that share mesh, material,
+   /// lights and textures with a single instanced draw call.
+   static bool smAutoInstancing;
+
+   /// The shortest run of instances which is drawn instanced.
+   static S32 smAutoInstancingMinBatch;
+
 protected:
 
    struct MainSortElem
@@ -124,10 +131,26 @@ protected:
    /// MeshRenderInst requires a new batch/pass.
    inline bool newPassNeeded( MeshRenderInst *ri, MeshRenderInst* nextRI ) const;
 
+   /// A inlined helper method for testing if the next MeshRenderInst
+   /// can't join an instanced batch.  On top of newPassNeeded() the
+   /// textures must match as they are only bound once per batch.
+   inline bool newInstancedBatchNeeded( MeshRenderInst *ri, MeshRenderInst* nextRI ) const;
+
    /// Inlined utility function which gets the material from the 
    /// RenderInst if available, otherwise, return NULL.
    inline BaseMatInstance* getMaterial( RenderInst *inst ) const;
 
+   /// Returns the material to draw the MeshRenderInst at @a start in
+   /// mElementList with.  This is the instancing version of its material
+   /// if auto instancing is on and getInstancedRunLength() is long enough.
+   BaseMatInstance* getAutoInstancingMat( U32 start ) const;
+
+   /// Returns how many MeshRenderInsts from @a start in mElementList can
+   /// be drawn in one instanced batch, counting no further than @a maxLength.
+   /// This is 1 if the mesh has too many verts to be instanced.
+   /// @see TSMesh::smMaxInstancingVerts
+   U32 getInstancedRunLength( U32 start, U32 maxLength ) const;
+
 };
 
 
@@ -156,6 +179,19 @@ inline bool RenderBinManager::newPassNeeded( MeshRenderInst *ri, MeshRenderInst*
    return false;
 }
 
+inline bool RenderBinManager::newInstancedBatchNeeded( MeshRenderInst *ri, MeshRenderInst* nextRI ) const
+{
+   if ( newPassNeeded( ri, nextRI ) )
+      return true;
+
+   return   ri->lightmap != nextRI->lightmap ||
+            ri->cubemap != nextRI->cubemap ||
+            ri->reflectTex != nextRI->reflectTex ||
+            ri->miscTex != nextRI->miscTex ||
+            ri->accuTex != nextRI->accuTex ||
+            ri->backBuffTex != nextRI->backBuffTex;
+}
+
 inline BaseMatInstance* RenderBinManager::getMaterial( RenderInst *inst ) const
 {
    if (  inst->type == RenderPassManager::RIT_Mesh || 
@@ -127,7 +127,10 @@ void RenderMeshMgr::render(SceneRenderState * state)
       MeshRenderInst *ri = static_cast<MeshRenderInst*>(mElementList[j].inst);
 
       setupSGData( ri, sgData );
-      BaseMatInstance *mat = ri->matInst;
+
+      // Draw runs of the same mesh instanced.  This happens before
+      // the override so that the override is instanced as well.
+      BaseMatInstance *mat = getAutoInstancingMat( j );
 
       // If we have an override delegate then give it a 
       // chance to swap the material with another.
@@ -151,13 +154,17 @@ void RenderMeshMgr::render(SceneRenderState * state)
 
       while( mat && mat->setupPass(state, sgData ) )
       {
+         U32 numInstances = 0;
+
          for( a=j; a<binSize; a++ )
          {
             MeshRenderInst *passRI = static_cast<MeshRenderInst*>(mElementList[a].inst);
 
-            // Check to see if we need to break this batch.
+            // Check to see if we need to break this batch.  Instanced
+            // batches bind their textures once so those must match too.
             if (  newPassNeeded( ri, passRI ) ||
-                  lastMiscTex != passRI->miscTex )
+                  lastMiscTex != passRI->miscTex ||
+                  ( mat->isInstanced() && newInstancedBatchNeeded( ri, passRI ) ) )
             {
                lastLM = NULL;
                break;
@@ -174,6 +181,8 @@ void RenderMeshMgr::render(SceneRenderState * state)
             // If we're instanced then don't render yet.
             if ( mat->isInstanced() )
             {
+               numInstances++;
+
                // Let the material increment the instance buffer, but
                // break the batch if it runs out of room for more.
                if ( !mat->stepInstance() )
@@ -259,6 +268,10 @@ void RenderMeshMgr::render(SceneRenderState * state)
                GFX->drawPrimitive( *ri->prim );
             else
                GFX->drawPrimitive( ri->primBuffIndex );
+
+            GFXDeviceStatistics *stats = GFX->getDeviceStatistics();
+            stats->mInstancedDrawCalls++;
+            stats->mInstancedMeshes += numInstances;
          }
 
          matListEnd = a;
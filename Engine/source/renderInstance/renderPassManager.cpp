@@ -40,6 +40,8 @@
 #include "core/util/safeDelete.h"
 #include "math/util/matrixSet.h"
 #include "console/engineAPI.h"
+#include "scene/renderStageStats.h"
+#include "platform/platformTLS.h"
 
 
 const RenderInstType RenderInstType::Invalid( "" );
@@ -60,6 +62,11 @@ const RenderInstType RenderPassManager::RIT_Particle("Particle");
 const RenderInstType RenderPassManager::RIT_Occluder("Occluder");
 const RenderInstType RenderPassManager::RIT_Editor("Editor");
 
+bool RenderPassManager::smPrepChunks = false;
+
+/// The PrepChunk bound to the calling thread.
+static ThreadStorage sgThreadPrepChunk;
+
 
 //*****************************************************************************
 // RenderInstance
@@ -127,6 +134,7 @@ void RenderPassManager::initPersistFields()
 RenderPassManager::RenderPassManager()
 {   
    mSceneManager = NULL;
+   mNumUsedPrepChunks = 0;
    VECTOR_SET_ASSOCIATION( mRenderBins );
 
    mMatrixSet = reinterpret_cast<MatrixSet *>(dMalloc_aligned(sizeof(MatrixSet), 16));
@@ -137,6 +145,9 @@ RenderPassManager::~RenderPassManager()
 {
    dFree_aligned(mMatrixSet);
 
+   for ( U32 i = 0; i < mPrepChunks.size(); i++ )
+      delete mPrepChunks[i];
+
    // Any bins left need to be deleted.
    for ( U32 i=0; i<mRenderBins.size(); i++ )
    {
@@ -194,12 +205,56 @@ RenderBinManager* RenderPassManager::getManager(S32 i) const
       return NULL;
 }
 
+RenderPassManager::PrepChunk* RenderPassManager::allocPrepChunk()
+{
+   if ( mNumUsedPrepChunks == mPrepChunks.size() )
+      mPrepChunks.push_back( new PrepChunk );
+
+   return mPrepChunks[ mNumUsedPrepChunks++ ];
+}
+
+void RenderPassManager::bindPrepChunk( PrepChunk *chunk )
+{
+   sgThreadPrepChunk.set( chunk );
+}
+
+RenderPassManager::PrepChunk* RenderPassManager::getThreadPrepChunk()
+{
+   return reinterpret_cast< PrepChunk* >( sgThreadPrepChunk.get() );
+}
+
+void RenderPassManager::deferPrepToMainThread()
+{
+   PrepChunk *chunk = getThreadPrepChunk();
+   AssertFatal( chunk, "RenderPassManager::deferPrepToMainThread - Not preparing into a chunk!" );
+   chunk->deferred = true;
+}
+
+void RenderPassManager::mergePrepChunk( PrepChunk *chunk )
+{
+   PROFILE_SCOPE( RenderPassManager_mergePrepChunk );
+
+   AssertFatal( !isPreparingIntoChunk(), "RenderPassManager::mergePrepChunk - Can't merge from a worker!" );
+
+   for ( U32 i = 0; i < chunk->insts.size(); i++ )
+      addInst( chunk->insts[i] );
+}
+
 void RenderPassManager::addInst( RenderInst *inst )
 {
    PROFILE_SCOPE( RenderPassManager_addInst );
 
    AssertFatal( inst != NULL, "RenderPassManager::addInst - Got null instance!" );
 
+   // Workers only queue their instances as the bins
+   // and the add signals aren't thread-safe.
+   PrepChunk *chunk = smPrepChunks ? getThreadPrepChunk() : NULL;
+   if ( chunk )
+   {
+      chunk->insts.push_back( inst );
+      return;
+   }
+
    AddInstTable::Iterator iter = mAddInstSignals.find( inst->type );
    if ( iter == mAddInstSignals.end() )
       return;
@@ -223,7 +278,15 @@ void RenderPassManager::clear()
 {
    PROFILE_SCOPE( RenderPassManager_Clear );
 
-   mChunker.clear();
+   mChunker.reset();
+
+   for ( U32 i = 0; i < mNumUsedPrepChunks; i++ )
+   {
+      mPrepChunks[i]->chunker.reset();
+      mPrepChunks[i]->insts.clear();
+      mPrepChunks[i]->deferred = false;
+   }
+   mNumUsedPrepChunks = 0;
 
    for (Vector<RenderBinManager *>::iterator itr = mRenderBins.begin();
       itr != mRenderBins.end(); itr++)
@@ -263,8 +326,14 @@ void RenderPassManager::render(SceneRenderState * state)
 void RenderPassManager::renderPass(SceneRenderState * state)
 {
    PROFILE_SCOPE( RenderPassManager_RenderPass );
-   sort();
-   render(state);
+   {
+      RenderStageStats::Scope sortScope( RenderStageStats::Sort );
+      sort();
+   }
+   {
+      RenderStageStats::Scope renderScope( RenderStageStats::RenderBins );
+      render(state);
+   }
    clear();
 }
 
@@ -122,6 +122,57 @@ public:
    RenderPassManager();
    virtual ~RenderPassManager();
 
+   /// @name Parallel preparation
+   ///
+   /// Render instances can be prepared on worker threads.  A worker binds
+   /// a PrepChunk and on that thread the allocation interface and addInst()
+   /// then go to the chunk instead of the pass.  Once the workers are done
+   /// the main thread merges the chunks into the bins before sorting.
+   /// @{
+
+   /// The instances prepared by one worker.
+   struct PrepChunk
+   {
+      /// Holds the instances, transforms and primitives.
+      ArenaChunker chunker;
+
+      /// The instances passed to addInst() in order.
+      Vector<RenderInst*> insts;
+
+      /// Set through deferPrepToMainThread().
+      bool deferred;
+
+      PrepChunk() : deferred( false ) {}
+   };
+
+   /// If true, threads which bound a PrepChunk allocate and add into it.
+   /// This is only on while workers prepare render instances.
+   static bool smPrepChunks;
+
+   /// Returns an empty chunk which stays valid until clear() is called.
+   PrepChunk* allocPrepChunk();
+
+   /// Send the allocations and added instances of the calling thread
+   /// to @a chunk or back to the pass if @a chunk is NULL.
+   static void bindPrepChunk( PrepChunk *chunk );
+
+   /// Returns the chunk bound to the calling thread if any.
+   static PrepChunk* getThreadPrepChunk();
+
+   /// Returns true if the calling thread prepares into a chunk.
+   static bool isPreparingIntoChunk() { return smPrepChunks && getThreadPrepChunk(); }
+
+   /// Called while preparing into a chunk by code that can only run on
+   /// the main thread, like creating a material instance.  The instances
+   /// of the object being prepared are dropped from the chunk and the
+   /// object is prepared again on the main thread.
+   static void deferPrepToMainThread();
+
+   /// Add the instances of @a chunk to the bins through addInst().
+   void mergePrepChunk( PrepChunk *chunk );
+
+   /// @}
+
    /// @name Allocation interface
    /// @{
 
@@ -130,7 +181,7 @@ public:
    template <typename T>
    T* allocInst()
    {
-      T* inst = mChunker.alloc<T>();
+      T* inst = _getChunker().alloc<T>();
       inst->clear();
       return inst;
    }
@@ -138,7 +189,7 @@ public:
    /// Allocate a matrix, valid until ::clear called.
    MatrixF* allocUniqueXform(const MatrixF& data) 
    { 
-      MatrixF *r = mChunker.alloc<MatrixF>(); 
+      MatrixF *r = _getChunker().alloc<MatrixF>(); 
       *r = data; 
       return r; 
    }
@@ -157,7 +208,7 @@ public:
 
    /// Allocate a GFXPrimitive object which will remain valid 
    /// until the pass manager is cleared.
-   GFXPrimitive* allocPrim() { return mChunker.alloc<GFXPrimitive>(); }
+   GFXPrimitive* allocPrim() { return _getChunker().alloc<GFXPrimitive>(); }
    /// @}
 
    /// Add a RenderInstance to the list
@@ -241,7 +292,18 @@ public:
 
 protected:
 
-   MultiTypedChunker mChunker;
+   ArenaChunker mChunker;
+
+   /// The chunks handed out by allocPrepChunk() come first.
+   Vector< PrepChunk* > mPrepChunks;
+   U32 mNumUsedPrepChunks;
+
+   /// Returns the chunker to allocate from on the calling thread.
+   ArenaChunker& _getChunker()
+   {
+      PrepChunk *chunk = smPrepChunks ? getThreadPrepChunk() : NULL;
+      return chunk ? chunk->chunker : mChunker;
+   }
       
    Vector< RenderBinManager* > mRenderBins;
 
@@ -337,8 +337,9 @@ void RenderPrePassMgr::render( SceneRenderState *state )
    {
       MeshRenderInst *ri = static_cast<MeshRenderInst*>( itr->inst );
 
-      // Get the prepass material.
-      BaseMatInstance *mat = getPrePassMaterial( ri->matInst );
+      // Get the prepass material, instanced if this is
+      // the start of a run of the same mesh.
+      BaseMatInstance *mat = getPrePassMaterial( getAutoInstancingMat( itr - mElementList.begin() ) );
 
       // Set up SG data proper like and flag it 
       // as a pre-pass render
@@ -348,6 +349,8 @@ void RenderPrePassMgr::render( SceneRenderState *state )
 
       while ( mat->setupPass( state, sgData ) )
       {
+         U32 numInstances = 0;
+
          meshItr = itr;
          for ( ; meshItr != mElementList.end(); meshItr++ )
          {
@@ -357,9 +360,11 @@ void RenderPrePassMgr::render( SceneRenderState *state )
             //
             // NOTE: We're comparing the non-prepass materials 
             // here so we don't incur the cost of looking up the 
-            // prepass hook on each inst.
+            // prepass hook on each inst.  Instanced batches bind
+            // their textures once so those must match too.
             //
-            if ( newPassNeeded( ri, passRI ) )
+            if (  newPassNeeded( ri, passRI ) ||
+                  ( mat->isInstanced() && newInstancedBatchNeeded( ri, passRI ) ) )
                break;
 
             // Set up SG data for this instance.
@@ -375,6 +380,8 @@ void RenderPrePassMgr::render( SceneRenderState *state )
             // If we're instanced then don't render yet.
             if ( mat->isInstanced() )
             {
+               numInstances++;
+
                // Let the material increment the instance buffer, but
                // break the batch if it runs out of room for more.
                if ( !mat->stepInstance() )
@@ -406,6 +413,10 @@ void RenderPrePassMgr::render( SceneRenderState *state )
                GFX->drawPrimitive( *ri->prim );
             else
                GFX->drawPrimitive( ri->primBuffIndex );
+
+            GFXDeviceStatistics *stats = GFX->getDeviceStatistics();
+            stats->mInstancedDrawCalls++;
+            stats->mInstancedMeshes += numInstances;
          }
 
          endOfBatchItr = meshItr;
@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "renderInstance/renderBinManager.h"
+#include "materials/materialDefinition.h"
+#include "ts/tsMesh.h"
+
+namespace
+{
+   /// Exposes the instanced run detection of the bins.
+   class TestInstancingBin : public RenderBinManager
+   {
+   public:
+      void add(MeshRenderInst *ri)
+      {
+         MainSortElem elem;
+         elem.inst = ri;
+         elem.key = 0;
+         elem.key2 = 0;
+         mElementList.push_back(elem);
+      }
+
+      U32 getRunLength(U32 start, U32 maxLength) const
+      {
+         return getInstancedRunLength(start, maxLength);
+      }
+   };
+
+   /// Stands in for the textures, which are only ever compared.
+   U8 sFakeTextures[2];
+
+   GFXTextureObject* fakeTexture(U32 i)
+   {
+      return reinterpret_cast<GFXTextureObject*>(&sFakeTextures[i]);
+   }
+}
+
+FIXTURE(RenderBinInstancing)
+{
+protected:
+   RenderBinInstancingFixture() : mMatInst(mMaterial.createMatInstance()) {}
+   ~RenderBinInstancingFixture() { delete mMatInst; }
+
+   static const U32 NumInsts = 6;
+
+   Material mMaterial;
+   BaseMatInstance *mMatInst;
+   GFXPrimitive mPrim;
+   MeshRenderInst mInsts[NumInsts];
+   TestInstancingBin mBin;
+
+   void SetUp()
+   {
+      mPrim.numVertices = TSMesh::smMaxInstancingVerts - 1;
+
+      // The same mesh with the same material at different places.
+      for(U32 i = 0; i < NumInsts; i++)
+      {
+         mInsts[i].clear();
+         mInsts[i].matInst = mMatInst;
+         mInsts[i].prim = &mPrim;
+         mInsts[i].lightmap = fakeTexture(0);
+         mInsts[i].reflectTex = fakeTexture(0);
+      }
+   }
+
+   void addInsts()
+   {
+      for(U32 i = 0; i < NumInsts; i++)
+         mBin.add(&mInsts[i]);
+   }
+};
+
+TEST_FIX(RenderBinInstancing, MatchingRun)
+{
+   addInsts();
+
+   EXPECT_EQ(mBin.getRunLength(0, NumInsts), NumInsts);
+   EXPECT_EQ(mBin.getRunLength(0, 4), 4);
+   EXPECT_EQ(mBin.getRunLength(2, NumInsts), NumInsts - 2);
+   EXPECT_EQ(mBin.getRunLength(NumInsts - 1, NumInsts), 1);
+}
+
+TEST_FIX(RenderBinInstancing, MeshBreaksRun)
+{
+   GFXPrimitive otherPrim = mPrim;
+   mInsts[3].prim = &otherPrim;
+   addInsts();
+
+   EXPECT_EQ(mBin.getRunLength(0, NumInsts), 3);
+   EXPECT_EQ(mBin.getRunLength(3, NumInsts), 1);
+   EXPECT_EQ(mBin.getRunLength(4, NumInsts), 2);
+}
+
+TEST_FIX(RenderBinInstancing, TexturesBreakRun)
+{
+   GFXCubemap *fakeCubemap = reinterpret_cast<GFXCubemap*>(&sFakeTextures[1]);
+
+   mInsts[1].lightmap = fakeTexture(1);
+   mInsts[2].cubemap = fakeCubemap;
+   mInsts[3].reflectTex = NULL;
+   mInsts[4].miscTex = fakeTexture(1);
+   mInsts[5].accuTex = fakeTexture(1);
+   addInsts();
+
+   // Every instance uses a texture its neighbours don't.
+   for(U32 i = 0; i < NumInsts; i++)
+      EXPECT_EQ(mBin.getRunLength(i, NumInsts), 1) << "Instance " << i;
+}
+
+TEST_FIX(RenderBinInstancing, MaxInstancingVerts)
+{
+   mPrim.numVertices = TSMesh::smMaxInstancingVerts;
+   addInsts();
+
+   EXPECT_EQ(mBin.getRunLength(0, NumInsts), 1);
+   EXPECT_EQ(mBin.getRunLength(2, NumInsts), 1);
+}
+
+#endif
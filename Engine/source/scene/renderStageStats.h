@@ -0,0 +1,108 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _RENDERSTAGESTATS_H_
+#define _RENDERSTAGESTATS_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+
+/// Accumulates the CPU time spent in each stage of scene rendering.
+///
+/// The stages are timed with Scope objects placed in SceneManager,
+/// SceneRenderState and RenderPassManager.  The timers cost nothing
+/// but a flag check unless they have been enabled, which is done by
+/// the render benchmark.
+///
+/// The times of all the passes rendered, shadow and reflection
+/// passes included, are added up until reset() is called.
+class RenderStageStats
+{
+public:
+
+   enum Stage
+   {
+      /// Zone traversal, the container query and culling.
+      Cull,
+
+      /// SceneObject::prepRenderImage of all the visible objects.
+      PrepRenderImage,
+
+      /// Sorting the render instances in the render bins.
+      Sort,
+
+      /// Rendering the render bins.
+      RenderBins,
+
+      NumStages
+   };
+
+   /// Adds the time until it is stopped or destroyed to a stage.
+   class Scope
+   {
+      Stage mStage;
+      U64 mStart;
+      bool mStopped;
+
+   public:
+
+      Scope( Stage stage )
+         : mStage( stage ),
+           mStart( RenderStageStats::isEnabled() ? Platform::getRealMicroseconds() : 0 ),
+           mStopped( false )
+      {
+      }
+
+      ~Scope() { stop(); }
+
+      void stop()
+      {
+         if ( !mStopped && RenderStageStats::isEnabled() )
+            RenderStageStats::addTime( mStage, Platform::getRealMicroseconds() - mStart );
+         mStopped = true;
+      }
+   };
+
+   static void setEnabled( bool enabled ) { smEnabled = enabled; }
+   static bool isEnabled() { return smEnabled; }
+
+   /// Clears the accumulated times.
+   static void reset();
+
+   /// Adds @a microseconds to a stage.
+   static void addTime( Stage stage, U64 microseconds ) { smTimes[stage] += microseconds; }
+
+   /// Returns the microseconds spent in a stage since the last reset().
+   static U64 getTime( Stage stage ) { return smTimes[stage]; }
+
+   static const char* getStageName( Stage stage );
+
+protected:
+
+   static bool smEnabled;
+   static U64 smTimes[NumStages];
+};
+
+#endif // _RENDERSTAGESTATS_H_
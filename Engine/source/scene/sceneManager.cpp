@@ -26,6 +26,7 @@
 #include "scene/sceneObject.h"
 #include "scene/zones/sceneTraversalState.h"
 #include "scene/sceneRenderState.h"
+#include "scene/renderStageStats.h"
 #include "scene/zones/sceneRootZone.h"
 #include "scene/zones/sceneZoneSpace.h"
 #include "lighting/lightManager.h"
@@ -84,6 +85,23 @@ MODULE_BEGIN( Scene )
       Con::addVariable( "$Scene::occluderMinHeightPercentage", TypeF32, &SceneCullingState::smOccluderMinHeightPercentage,
          "TODO\n\n"
          "@ingroup Rendering" );
+
+      Con::addVariable( "$pref::Scene::parallelPrep", TypeBool, &SceneRenderState::smParallelPrep,
+         "If true, the diffuse pass prepares the render instances of thread-safe objects on the thread pool "
+         "and merges them before sorting.\n\n"
+         "@ingroup Rendering" );
+
+      Con::addVariable( "$pref::Scene::parallelPrepMinObjects", TypeS32, &SceneRenderState::smParallelPrepMinObjects,
+         "Render instances are only prepared in parallel if at least this many objects are thread-safe.\n\n"
+         "@ingroup Rendering" );
+
+      Con::addVariable( "$Scene::parallelPrepCount", TypeS32, &SceneRenderState::smLastParallelPrepCount,
+         "The number of objects the last diffuse pass prepared on the thread pool.\n\n"
+         "@ingroup Rendering" );
+
+      Con::addVariable( "$Scene::deferredPrepCount", TypeS32, &SceneRenderState::smLastDeferredPrepCount,
+         "The number of thread-safe objects the last diffuse pass had to prepare on the main thread.\n\n"
+         "@ingroup Rendering" );
    }
    
    MODULE_SHUTDOWN
@@ -344,6 +362,8 @@ void SceneManager::_renderScene( SceneRenderState* state, U32 objectMask, SceneZ
 
    PROFILE_SCOPE( SceneGraph_batchRenderImages );
 
+   RenderStageStats::Scope cullScope( RenderStageStats::Cull );
+
    // In the editor, override the type mask for diffuse passes.
 
    if( gEditingMission && state->isDiffusePass() )
@@ -450,6 +470,7 @@ void SceneManager::_renderScene( SceneRenderState* state, U32 objectMask, SceneZ
    }
 
    PROFILE_END();
+   cullScope.stop();
 
    // Render the remaining objects.
 
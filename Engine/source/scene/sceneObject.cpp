@@ -120,6 +120,7 @@ SceneObject::SceneObject()
    mBinRefHead = NULL;
 
    mSceneManager = NULL;
+   mSceneUpdateDeferred = false;
 
    mNumCurrZones = 0;
    mZoneRefHead = NULL;
@@ -401,13 +402,30 @@ void SceneObject::setTransform( const MatrixF& mat )
    // If we're in a SceneManager, sync our scene state.
 
    if( mSceneManager != NULL )
-      mSceneManager->notifyObjectDirty( this );
+   {
+      if( _isDeferringTickUpdates() )
+         mSceneUpdateDeferred = true;
+      else
+         mSceneManager->notifyObjectDirty( this );
+   }
 
    setRenderTransform( mat );
 }
 
 //-----------------------------------------------------------------------------
 
+void SceneObject::applyDeferredSceneUpdate()
+{
+   if( !mSceneUpdateDeferred )
+      return;
+
+   mSceneUpdateDeferred = false;
+   if( mSceneManager != NULL )
+      mSceneManager->notifyObjectDirty( this );
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneObject::setScale( const VectorF &scale )
 {
 	AssertFatal( !mIsNaN( scale ), "SceneObject::setScale() - The scale is NaN!" );
@@ -968,6 +986,32 @@ ProcessList* SceneObject::getProcessList() const
       return ServerProcessList::get();
 }
 
+//-----------------------------------------------------------------------------
+
+bool SceneObject::_isDeferringTickUpdates() const
+{
+   ProcessList *list = getProcessList();
+   return list && list->isDeferringUpdates();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObject::applyDeferredTickUpdates()
+{
+   applyDeferredSceneUpdate();
+   applyDeferredMaskBits();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObject::setMaskBits( U32 orMask )
+{
+   if ( _isDeferringTickUpdates() )
+      deferMaskBits( orMask );
+   else
+      Parent::setMaskBits( orMask );
+}
+
 //-------------------------------------------------------------------------
 
 bool SceneObject::isMounted()
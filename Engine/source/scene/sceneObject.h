@@ -164,6 +164,9 @@ class SceneObject : public NetObject, private SceneContainer::Link, public Proce
       /// SceneManager to which this SceneObject belongs.
       SceneManager* mSceneManager;
 
+      /// Set if the object moved while its ProcessList was deferring updates.
+      bool mSceneUpdateDeferred;
+
       /// Links installed by SceneTrackers attached to this object.
       SceneObjectLink* mSceneObjectLinks;
 
@@ -388,6 +391,10 @@ class SceneObject : public NetObject, private SceneContainer::Link, public Proce
       /// Return the SceneManager that this SceneObject belongs to.
       SceneManager* getSceneManager() const { return mSceneManager; }
 
+      /// Sync the scene state of an object that moved while its
+      /// ProcessList was deferring updates.
+      void applyDeferredSceneUpdate();
+
       /// Adds object to the client or server container depending on the object
       void addToScene();
 
@@ -696,6 +703,18 @@ class SceneObject : public NetObject, private SceneContainer::Link, public Proce
       /// @param state Rendering state.
       virtual void prepRenderImage( SceneRenderState* state ) {}
 
+      /// Returns true if prepRenderImage() may run on a worker thread
+      /// alongside other thread-safe objects during the diffuse pass.
+      ///
+      /// It must then only change the object itself, allocate and add render
+      /// instances through the render pass and use the world matrix stack
+      /// of GFX.  Code which must run on the main thread calls
+      /// RenderPassManager::deferPrepToMainThread() and the object is
+      /// prepared again on the main thread once the workers are done.
+      ///
+      /// @see SceneRenderState::smParallelPrep
+      virtual bool isPrepRenderImageThreadSafe() const { return false; }
+
       /// @}
 
       /// @name Lighting
@@ -726,13 +745,19 @@ class SceneObject : public NetObject, private SceneContainer::Link, public Proce
       /// Return the ProcessList for this object to use.
       ProcessList* getProcessList() const;
 
+      /// Return true if our ProcessList is ticking objects on worker threads,
+      /// in which case moves and mask bits are only recorded on the object.
+      bool _isDeferringTickUpdates() const;
+
       // ProcessObject,
       virtual void processAfter( ProcessObject *obj );
       virtual void clearProcessAfter();
       virtual ProcessObject* getAfterObject() const { return mAfterObject; }
       virtual void setProcessTick( bool t );
+      virtual void applyDeferredTickUpdates();
 
       // NetObject.
+      virtual void setMaskBits( U32 orMask );
       virtual U32 packUpdate( NetConnection* conn, U32 mask, BitStream* stream );
       virtual void unpackUpdate( NetConnection* conn, BitStream* stream );
       virtual void onCameraScopeQuery( NetConnection* connection, CameraScopeQuery* query );
@@ -22,9 +22,11 @@
 
 #include "platform/platform.h"
 #include "scene/sceneRenderState.h"
+#include "scene/renderStageStats.h"
 
 #include "renderInstance/renderPassManager.h"
 #include "math/util/matrixSet.h"
+#include "platform/threads/jobGraph.h"
 
 
 
@@ -94,15 +96,153 @@ const MatrixF& SceneRenderState::getProjectionMatrix() const
 
 //-----------------------------------------------------------------------------
 
+bool SceneRenderState::smParallelPrep = false;
+S32 SceneRenderState::smParallelPrepMinObjects = 64;
+U32 SceneRenderState::smLastParallelPrepCount = 0;
+U32 SceneRenderState::smLastDeferredPrepCount = 0;
+
+/// Prepares a run of thread-safe objects into a chunk of the render pass.
+class SceneRenderState::PrepJob : public JobGraph::Job
+{
+public:
+
+   PrepJob( SceneRenderState *state, SceneObject **objects, U32 count, RenderPassManager::PrepChunk *chunk )
+      : mState( state ), mObjects( objects ), mCount( count ), mChunk( chunk ) {}
+
+   RenderPassManager::PrepChunk* getChunk() const { return mChunk; }
+
+   /// Objects which have to be prepared again on the main thread.
+   const Vector<SceneObject*>& getDeferred() const { return mDeferred; }
+
+protected:
+
+   SceneRenderState *mState;
+   SceneObject **mObjects;
+   U32 mCount;
+   RenderPassManager::PrepChunk *mChunk;
+   Vector<SceneObject*> mDeferred;
+
+   virtual void run()
+   {
+      GFXDevice::ThreadWorldMatrixStack worldStack;
+      GFX->bindThreadWorldMatrixStack( &worldStack );
+      RenderPassManager::bindPrepChunk( mChunk );
+
+      for ( U32 i = 0; i < mCount; i++ )
+      {
+         const U32 mark = mChunk->insts.size();
+         mChunk->deferred = false;
+
+         mObjects[i]->prepRenderImage( mState );
+
+         // Drop what the object added so far.  The memory is
+         // released with the rest of the chunk.
+         if ( mChunk->deferred )
+         {
+            mChunk->insts.setSize( mark );
+            mDeferred.push_back( mObjects[i] );
+         }
+      }
+
+      mChunk->deferred = false;
+
+      RenderPassManager::bindPrepChunk( NULL );
+      GFX->bindThreadWorldMatrixStack( NULL );
+   }
+};
+
+bool SceneRenderState::_prepRenderImagesParallel( SceneObject** objects, U32 numObjects )
+{
+   PROFILE_SCOPE( SceneRenderState_prepRenderImagesParallel );
+
+   // Override materials are created on demand and other passes
+   // are too small to be worth it.
+   if ( !isDiffusePass() || !mMatDelegate.empty() || (S32)numObjects < smParallelPrepMinObjects )
+      return false;
+
+   Vector<SceneObject*> parallelObjects;
+   Vector<SceneObject*> serialObjects;
+   for ( U32 i = 0; i < numObjects; i++ )
+   {
+      if ( objects[i]->isPrepRenderImageThreadSafe() )
+         parallelObjects.push_back( objects[i] );
+      else
+         serialObjects.push_back( objects[i] );
+   }
+
+   if ( (S32)parallelObjects.size() < smParallelPrepMinObjects )
+      return false;
+
+   // Split the objects into a few jobs per worker.  Each job prepares
+   // into its own chunk so the instances merge in the same order every
+   // frame no matter which worker ran which job.
+   ThreadPool *pool = &ThreadPool::GLOBAL();
+   const U32 maxJobs = getMax( pool->getNumThreads(), 1U ) * 4;
+   const U32 minObjectsPerJob = 16;
+   const U32 count = parallelObjects.size();
+   const U32 numJobs = mClamp( count / minObjectsPerJob, 1, maxJobs );
+
+   JobGraph graph( pool );
+   Vector<PrepJob*> jobs;
+   for ( U32 i = 0; i < numJobs; i++ )
+   {
+      const U32 first = count * i / numJobs;
+      const U32 last = count * ( i + 1 ) / numJobs;
+      PrepJob *job = new PrepJob( this, parallelObjects.address() + first, last - first, mRenderPass->allocPrepChunk() );
+      graph.addJob( job );
+      jobs.push_back( job );
+   }
+
+   GFXDevice::smThreadWorldMatrices = true;
+   RenderPassManager::smPrepChunks = true;
+
+   graph.start();
+   graph.wait();
+
+   GFXDevice::smThreadWorldMatrices = false;
+   RenderPassManager::smPrepChunks = false;
+
+   // Catch up on the main thread.
+   for ( U32 i = 0; i < jobs.size(); i++ )
+      mRenderPass->mergePrepChunk( jobs[i]->getChunk() );
+
+   for ( U32 i = 0; i < serialObjects.size(); i++ )
+      serialObjects[i]->prepRenderImage( this );
+
+   U32 numDeferred = 0;
+   for ( U32 i = 0; i < jobs.size(); i++ )
+   {
+      const Vector<SceneObject*> &deferred = jobs[i]->getDeferred();
+      for ( U32 j = 0; j < deferred.size(); j++ )
+         deferred[j]->prepRenderImage( this );
+
+      numDeferred += deferred.size();
+   }
+
+   smLastParallelPrepCount = count - numDeferred;
+   smLastDeferredPrepCount = numDeferred;
+   return true;
+}
+
 void SceneRenderState::renderObjects( SceneObject** objects, U32 numObjects )
 {
    // Let the objects batch their stuff.
 
    PROFILE_START( SceneRenderState_prepRenderImages );
-   for( U32 i = 0; i < numObjects; ++ i )
    {
-      SceneObject* object = objects[ i ];
-      object->prepRenderImage( this );
+      RenderStageStats::Scope prepScope( RenderStageStats::PrepRenderImage );
+
+      if ( isDiffusePass() )
+         smLastParallelPrepCount = smLastDeferredPrepCount = 0;
+
+      if ( !smParallelPrep || !_prepRenderImagesParallel( objects, numObjects ) )
+      {
+         for( U32 i = 0; i < numObjects; ++ i )
+         {
+            SceneObject* object = objects[ i ];
+            object->prepRenderImage( this );
+         }
+      }
    }
    PROFILE_END();
 
@@ -112,6 +112,13 @@ class SceneRenderState
       /// If true (default) non-lightmapped meshes should be rendered.
       bool mRenderNonLightmappedMeshes;
 
+      class PrepJob;
+
+      /// Prepare the thread-safe objects on the thread pool and the
+      /// rest on the main thread.  Returns false without preparing
+      /// anything if too few objects are thread-safe.
+      bool _prepRenderImagesParallel( SceneObject** objects, U32 numObjects );
+
    public:
 
       /// Construct a new SceneRenderState.
@@ -169,6 +176,24 @@ class SceneRenderState
       /// @param numObjects Number of objects in @a objects.
       void renderObjects( SceneObject** objects, U32 numObjects );
 
+      /// If true, the diffuse pass prepares the render instances of objects
+      /// that are thread-safe to do so on the thread pool.
+      /// @see SceneObject::isPrepRenderImageThreadSafe
+      static bool smParallelPrep;
+
+      /// Objects are only prepared in parallel if at least this many of
+      /// them are thread-safe.
+      static S32 smParallelPrepMinObjects;
+
+      /// The number of objects the last diffuse pass prepared on the thread
+      /// pool.  Objects deferred to the main thread are not counted.
+      static U32 smLastParallelPrepCount;
+
+      /// The number of thread-safe objects the last diffuse pass had to
+      /// prepare on the main thread after all.
+      /// @see RenderPassManager::deferPrepToMainThread
+      static U32 smLastDeferredPrepCount;
+
       /// @}
 
       /// @name Lighting
@@ -0,0 +1,365 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "scene/sceneRenderState.h"
+#include "scene/sceneObject.h"
+#include "renderInstance/renderPassManager.h"
+#include "T3D/tsStatic.h"
+#include "ts/tsShape.h"
+#include "ts/tsShapeInstance.h"
+#include "gfx/gfxDevice.h"
+#include "math/mMathFn.h"
+#include "console/console.h"
+
+namespace
+{
+   /// Does a bit of busy work and then adds one instance whose sort
+   /// distance comes from the world matrix stack of GFX.
+   class TestPrepObject : public SceneObject
+   {
+   public:
+      TestPrepObject(U32 index, bool threadSafe, bool defer, U32 work)
+         : mIndex(index), mThreadSafe(threadSafe), mDefer(defer), mWork(work), mValue(1.0f) {}
+
+      U32 mIndex;
+      bool mThreadSafe;
+      bool mDefer;
+      U32 mWork;
+      F32 mValue;
+
+      virtual bool isPrepRenderImageThreadSafe() const { return mThreadSafe; }
+
+      virtual void prepRenderImage(SceneRenderState *state)
+      {
+         RenderPassManager *pass = state->getRenderPass();
+
+         for(U32 i = 0; i < mWork; i++)
+            mValue = mSin(mValue) * 0.5f + mCos(mValue + F32(i));
+
+         GFX->pushWorldMatrix();
+         MatrixF xfm(true);
+         xfm.setPosition(Point3F(F32(mIndex), 0.0f, 0.0f));
+         GFX->multWorld(xfm);
+
+         ObjectRenderInst *ri = pass->allocInst<ObjectRenderInst>();
+         ri->type = RenderPassManager::RIT_Object;
+         ri->objectIndex = mIndex;
+         ri->sortDistSq = GFX->getWorldMatrix().getPosition().x;
+         pass->addInst(ri);
+
+         GFX->popWorldMatrix();
+
+         // Bail out after adding an instance which has to be dropped.
+         if(mDefer && RenderPassManager::isPreparingIntoChunk())
+            RenderPassManager::deferPrepToMainThread();
+      }
+   };
+
+   /// Records the instances that reach the bins.
+   struct InstCollector
+   {
+      Vector<S32> mIndices;
+      U32 mErrors;
+
+      InstCollector() : mErrors(0) {}
+
+      void onAddInst(RenderInst *inst)
+      {
+         ObjectRenderInst *ri = static_cast<ObjectRenderInst*>(inst);
+         mIndices.push_back(ri->objectIndex);
+         mErrors += ri->sortDistSq != F32(ri->objectIndex);
+      }
+   };
+
+   /// Every seventh object is not thread-safe and every eleventh has to
+   /// be prepared on the main thread.
+   void populate(Vector<TestPrepObject*> &objects, U32 count, U32 work)
+   {
+      for(U32 i = 0; i < count; i++)
+         objects.push_back(new TestPrepObject(i, i % 7 != 0, i % 11 == 0, work));
+   }
+
+   void destroy(Vector<TestPrepObject*> &objects)
+   {
+      for(U32 i = 0; i < objects.size(); i++)
+         delete objects[i];
+      objects.clear();
+   }
+
+   U32 prep(RenderPassManager *pass, Vector<TestPrepObject*> &objects, U32 numFrames)
+   {
+      SceneCameraState view(RectI(0, 0, 800, 600), Frustum(), MatrixF(true), MatrixF(true));
+
+      const U32 start = Platform::getRealMilliseconds();
+      for(U32 i = 0; i < numFrames; i++)
+      {
+         // Drop the last frame's instances like the render does.
+         pass->clear();
+
+         SceneRenderState state(gClientSceneGraph, SPT_Diffuse, view, pass);
+         state.renderObjects((SceneObject**)objects.address(), objects.size());
+      }
+      return Platform::getRealMilliseconds() - start;
+   }
+
+   S32 QSORT_CALLBACK compareIndices(const S32 *a, const S32 *b)
+   {
+      return *a - *b;
+   }
+
+   /// Builds a shape with a single node, an empty mesh slot and one detail,
+   /// plus a cyclic "ambient" sequence that dirties the node transforms.
+   TSShape* createStaticShape()
+   {
+      TSShape *shape = new TSShape;
+      shape->createEmptyShape();
+      shape->defaultRotations[0].identity();
+      shape->meshes.push_back(NULL);
+
+      shape->sequences.increment();
+      TSShape::Sequence &seq = shape->sequences.last();
+      seq.nameIndex = shape->addName("ambient");
+      seq.numKeyframes = 2;
+      seq.duration = 1.5f;
+      seq.baseRotation = seq.baseTranslation = seq.baseScale = 0;
+      seq.baseObjectState = seq.baseDecalState = 0;
+      seq.firstGroundFrame = seq.numGroundFrames = 0;
+      seq.firstTrigger = seq.numTriggers = 0;
+      seq.toolBegin = 0.0f;
+      seq.priority = 0;
+      seq.flags = TSShape::Cyclic;
+      seq.dirtyFlags = TSShapeInstance::TransformDirty;
+
+      shape->init();
+      return shape;
+   }
+
+   /// A client side TSStatic without the shape resource and scene that
+   /// TSStatic::onAdd() sets up.  Animated ones dirty their shape instance
+   /// every frame, which has to be animated on the main thread.
+   class TestPrepStatic : public TSStatic
+   {
+   public:
+      TestPrepStatic(TSShape *shape, U32 index, bool animated)
+      {
+         mShapeInstance = new TSShapeInstance(shape, false);
+         mForceDetail = 0;
+         if(animated)
+            mAmbientThread = mShapeInstance->addThread();
+
+         MatrixF xfm(true);
+         xfm.setPosition(Point3F(F32(index % 100), F32(index / 100), 0.0f));
+         SceneObject::setTransform(xfm);
+      }
+
+      ~TestPrepStatic()
+      {
+         delete mShapeInstance;
+      }
+
+      void advance()
+      {
+         if(mAmbientThread)
+            mShapeInstance->advanceTime(TickSec, mAmbientThread);
+      }
+
+      bool isDirty() const { return mShapeInstance->mDirtyFlags[0] != 0; }
+   };
+
+   /// Every third static is animated.
+   void populate(Vector<TestPrepStatic*> &statics, TSShape *shape, U32 count)
+   {
+      for(U32 i = 0; i < count; i++)
+         statics.push_back(new TestPrepStatic(shape, i, i % 3 == 0));
+   }
+
+   void destroy(Vector<TestPrepStatic*> &statics)
+   {
+      for(U32 i = 0; i < statics.size(); i++)
+         delete statics[i];
+      statics.clear();
+   }
+
+   U32 prep(RenderPassManager *pass, Vector<TestPrepStatic*> &statics, U32 numFrames)
+   {
+      SceneCameraState view(RectI(0, 0, 800, 600), Frustum(), MatrixF(true), MatrixF(true));
+
+      const U32 start = Platform::getRealMilliseconds();
+      for(U32 i = 0; i < numFrames; i++)
+      {
+         for(U32 j = 0; j < statics.size(); j++)
+            statics[j]->advance();
+
+         pass->clear();
+
+         SceneRenderState state(gClientSceneGraph, SPT_Diffuse, view, pass);
+         state.renderObjects((SceneObject**)statics.address(), statics.size());
+      }
+      return Platform::getRealMilliseconds() - start;
+   }
+}
+
+TEST(SceneRenderState, ParallelPrepMatchesSerial)
+{
+   // Render instances can only be prepared with a device and a scene.
+   if(!GFX || !gClientSceneGraph)
+      return;
+
+   const U32 numObjects = 2000;
+
+   const bool oldParallelPrep = SceneRenderState::smParallelPrep;
+   const MatrixF oldWorld = GFX->getWorldMatrix();
+
+   RenderPassManager *pass = new RenderPassManager;
+   InstCollector collector;
+   pass->getAddSignal(RenderPassManager::RIT_Object).notify(&collector, &InstCollector::onAddInst);
+
+   Vector<TestPrepObject*> objects;
+   populate(objects, numObjects, 20);
+
+   SceneRenderState::smParallelPrep = false;
+   prep(pass, objects, 1);
+   Vector<S32> serialIndices = collector.mIndices;
+
+   collector.mIndices.clear();
+   SceneRenderState::smParallelPrep = true;
+   prep(pass, objects, 1);
+
+   EXPECT_GT(SceneRenderState::smLastParallelPrepCount, 0)
+      << "No objects were prepared in parallel!";
+   EXPECT_EQ(collector.mErrors, 0) << "Instances were prepared with the wrong world matrix!";
+   EXPECT_TRUE(GFX->getWorldMatrix() == oldWorld) << "The device world matrix changed!";
+
+   // The merge order differs but every object adds exactly one instance.
+   collector.mIndices.sort(compareIndices);
+   serialIndices.sort(compareIndices);
+   ASSERT_EQ(collector.mIndices.size(), numObjects);
+   ASSERT_EQ(serialIndices.size(), numObjects);
+
+   U32 numMismatches = 0;
+   for(U32 i = 0; i < numObjects; i++)
+      numMismatches += collector.mIndices[i] != S32(i) || serialIndices[i] != S32(i);
+   EXPECT_EQ(numMismatches, 0) << "Objects were dropped or prepared twice!";
+
+   SceneRenderState::smParallelPrep = oldParallelPrep;
+   delete pass;
+   destroy(objects);
+}
+
+TEST(SceneRenderState, ParallelPrepDefersAnimatedStatics)
+{
+   if(!GFX || !gClientSceneGraph)
+      return;
+
+   const U32 numStatics = 300;
+   const U32 numAnimated = (numStatics + 2) / 3;
+
+   const bool oldParallelPrep = SceneRenderState::smParallelPrep;
+   const MatrixF oldWorld = GFX->getWorldMatrix();
+
+   RenderPassManager *pass = new RenderPassManager;
+   TSShape *shape = createStaticShape();
+   Vector<TestPrepStatic*> statics;
+   populate(statics, shape, numStatics);
+
+   // New shape instances start out dirty, so let the first
+   // frame animate them all before counting.
+   SceneRenderState::smParallelPrep = true;
+   prep(pass, statics, 2);
+
+   EXPECT_EQ(SceneRenderState::smLastDeferredPrepCount, numAnimated)
+      << "Only the animated statics should be prepared on the main thread!";
+   EXPECT_EQ(SceneRenderState::smLastParallelPrepCount, numStatics - numAnimated)
+      << "The still statics should be prepared in parallel!";
+   EXPECT_TRUE(GFX->getWorldMatrix() == oldWorld) << "The device world matrix changed!";
+
+   U32 numDirty = 0;
+   for(U32 i = 0; i < statics.size(); i++)
+      numDirty += statics[i]->isDirty();
+   EXPECT_EQ(numDirty, 0) << "Deferred statics were never animated!";
+
+   SceneRenderState::smParallelPrep = oldParallelPrep;
+   delete pass;
+   destroy(statics);
+   delete shape;
+}
+
+TEST(SceneRenderState, StressParallelPrep)
+{
+   // Prepares a dense scene of ten thousand objects serially and in
+   // parallel.  Timings go to the console.
+
+   if(!GFX || !gClientSceneGraph)
+      return;
+
+   const U32 numObjects = 10000;
+   const U32 numFrames = 50;
+
+   const bool oldParallelPrep = SceneRenderState::smParallelPrep;
+
+   RenderPassManager *pass = new RenderPassManager;
+   Vector<TestPrepObject*> objects;
+   populate(objects, numObjects, 50);
+
+   SceneRenderState::smParallelPrep = false;
+   const U32 serialTime = prep(pass, objects, numFrames);
+
+   SceneRenderState::smParallelPrep = true;
+   const U32 parallelTime = prep(pass, objects, numFrames);
+   const U32 parallelCount = SceneRenderState::smLastParallelPrepCount;
+   const U32 deferredCount = SceneRenderState::smLastDeferredPrepCount;
+
+   Con::printf("Scene prep, %u objects (%u prepared in parallel, %u deferred) over %u frames:", numObjects, parallelCount, deferredCount, numFrames);
+   Con::printf("   serial:    %u ms (%.2f ms/frame)", serialTime, F32(serialTime) / numFrames);
+   Con::printf("   parallel:  %u ms (%.2f ms/frame)", parallelTime, F32(parallelTime) / numFrames);
+
+   destroy(objects);
+
+   // The same with real TSStatics, a third of which animate and have
+   // to be prepared on the main thread.
+   TSShape *shape = createStaticShape();
+   Vector<TestPrepStatic*> statics;
+   populate(statics, shape, numObjects);
+
+   SceneRenderState::smParallelPrep = false;
+   const U32 serialStaticTime = prep(pass, statics, numFrames);
+
+   SceneRenderState::smParallelPrep = true;
+   const U32 parallelStaticTime = prep(pass, statics, numFrames);
+   const U32 parallelStaticCount = SceneRenderState::smLastParallelPrepCount;
+   const U32 deferredStaticCount = SceneRenderState::smLastDeferredPrepCount;
+
+   Con::printf("TSStatic prep, %u statics (%u prepared in parallel, %u deferred) over %u frames:", numObjects, parallelStaticCount, deferredStaticCount, numFrames);
+   Con::printf("   serial:    %u ms (%.2f ms/frame)", serialStaticTime, F32(serialStaticTime) / numFrames);
+   Con::printf("   parallel:  %u ms (%.2f ms/frame)", parallelStaticTime, F32(parallelStaticTime) / numFrames);
+
+   SceneRenderState::smParallelPrep = oldParallelPrep;
+   delete pass;
+   destroy(statics);
+   delete shape;
+}
+
+#endif
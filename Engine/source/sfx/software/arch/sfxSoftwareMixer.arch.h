@@ -0,0 +1,45 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SFXSOFTWAREMIXER_ARCH_H_
+#define _SFXSOFTWAREMIXER_ARCH_H_
+
+// Portable implementations, also the reference the SIMD ones are tested against
+extern void sfx_mix_mono_to_stereo_C(F32 * __restrict out, const F32 * __restrict in, const U32 numFrames, const F32 gainLeft, const F32 gainRight);
+extern void sfx_mix_stereo_to_stereo_C(F32 * __restrict out, const F32 * __restrict in, const U32 numFrames, const F32 gainLeft, const F32 gainRight);
+extern void sfx_convert_F32_to_S16_C(S16 * __restrict out, const F32 * __restrict in, const U32 numSamples);
+
+#if defined(TORQUE_CPU_X86) || defined(TORQUE_CPU_X64)
+# // x86/x64 CPU family implementations
+extern void sfx_mix_mono_to_stereo_SSE(F32 * __restrict out, const F32 * __restrict in, const U32 numFrames, const F32 gainLeft, const F32 gainRight);
+extern void sfx_mix_stereo_to_stereo_SSE(F32 * __restrict out, const F32 * __restrict in, const U32 numFrames, const F32 gainLeft, const F32 gainRight);
+#  if defined(_MSC_VER) || defined(__SSE2__)
+#     define TORQUE_SFX_MIXER_SSE2
+extern void sfx_convert_F32_to_S16_SSE2(S16 * __restrict out, const F32 * __restrict in, const U32 numSamples);
+#  endif
+#
+#else
+# // Other CPU types go here...
+#endif
+
+#endif // _SFXSOFTWAREMIXER_ARCH_H_
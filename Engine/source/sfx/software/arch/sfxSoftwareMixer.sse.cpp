@@ -0,0 +1,127 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+
+#if defined(TORQUE_CPU_X86) || defined(TORQUE_CPU_X64)
+#include "sfx/software/sfxSoftwareMixer.h"
+#include "sfx/software/arch/sfxSoftwareMixer.arch.h"
+#include "math/mMathFn.h"
+#include <xmmintrin.h>
+#if defined(TORQUE_SFX_MIXER_SSE2)
+#include <emmintrin.h>
+#endif
+
+void sfx_mix_mono_to_stereo_SSE(F32 * __restrict out, const F32 * __restrict in, const U32 numFrames, const F32 gainLeft, const F32 gainRight)
+{
+   // Gains laid out to match the interleaved output: L R L R
+   const __m128 vGain = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+
+   U32 i = 0;
+   for(; i + 4 <= numFrames; i += 4)
+   {
+      // Load 4 mono samples and duplicate each into a L/R pair.
+      const __m128 vIn = _mm_loadu_ps(in + i);
+      const __m128 vLo = _mm_unpacklo_ps(vIn, vIn); // s0 s0 s1 s1
+      const __m128 vHi = _mm_unpackhi_ps(vIn, vIn); // s2 s2 s3 s3
+
+      F32 *dest = out + i * 2;
+      __m128 vOut0 = _mm_loadu_ps(dest);
+      __m128 vOut1 = _mm_loadu_ps(dest + 4);
+
+      vOut0 = _mm_add_ps(vOut0, _mm_mul_ps(vLo, vGain));
+      vOut1 = _mm_add_ps(vOut1, _mm_mul_ps(vHi, vGain));
+
+      _mm_storeu_ps(dest, vOut0);
+      _mm_storeu_ps(dest + 4, vOut1);
+   }
+
+   // Remainder.
+   for(; i < numFrames; i++)
+   {
+      out[i * 2]     += in[i] * gainLeft;
+      out[i * 2 + 1] += in[i] * gainRight;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void sfx_mix_stereo_to_stereo_SSE(F32 * __restrict out, const F32 * __restrict in, const U32 numFrames, const F32 gainLeft, const F32 gainRight)
+{
+   const __m128 vGain = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+   const U32 numSamples = numFrames * 2;
+
+   U32 i = 0;
+   for(; i + 8 <= numSamples; i += 8)
+   {
+      __m128 vOut0 = _mm_loadu_ps(out + i);
+      __m128 vOut1 = _mm_loadu_ps(out + i + 4);
+
+      vOut0 = _mm_add_ps(vOut0, _mm_mul_ps(_mm_loadu_ps(in + i), vGain));
+      vOut1 = _mm_add_ps(vOut1, _mm_mul_ps(_mm_loadu_ps(in + i + 4), vGain));
+
+      _mm_storeu_ps(out + i, vOut0);
+      _mm_storeu_ps(out + i + 4, vOut1);
+   }
+
+   // Remainder (always whole frames).
+   for(; i < numSamples; i += 2)
+   {
+      out[i]     += in[i] * gainLeft;
+      out[i + 1] += in[i + 1] * gainRight;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+#if defined(TORQUE_SFX_MIXER_SSE2)
+
+void sfx_convert_F32_to_S16_SSE2(S16 * __restrict out, const F32 * __restrict in, const U32 numSamples)
+{
+   const __m128 vScale = _mm_set1_ps(32767.0f);
+   const __m128 vMin = _mm_set1_ps(-1.0f);
+   const __m128 vMax = _mm_set1_ps(1.0f);
+
+   U32 i = 0;
+   for(; i + 8 <= numSamples; i += 8)
+   {
+      // Clamp, scale, convert to 32-bit ints and pack.  Out of range floats
+      // would convert to 0x80000000, so the clamp can't be left to the pack.
+      const __m128 v0 = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i), vMin), vMax);
+      const __m128 v1 = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i + 4), vMin), vMax);
+      const __m128i vInt0 = _mm_cvttps_epi32(_mm_mul_ps(v0, vScale));
+      const __m128i vInt1 = _mm_cvttps_epi32(_mm_mul_ps(v1, vScale));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packs_epi32(vInt0, vInt1));
+   }
+
+   // Remainder.
+   for(; i < numSamples; i++)
+   {
+      // Clamp before converting as out of range floats don't convert.
+      out[i] = S16(mClampF(in[i], -1.0f, 1.0f) * 32767.0f);
+   }
+}
+
+#endif // TORQUE_SFX_MIXER_SSE2
+
+#endif // TORQUE_CPU_X86 || TORQUE_CPU_X64
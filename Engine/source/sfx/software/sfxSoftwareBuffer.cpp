@@ -0,0 +1,149 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "sfx/software/sfxSoftwareBuffer.h"
+#include "sfx/software/sfxSoftwareVoice.h"
+#include "sfx/sfxInternal.h"
+#include "console/console.h"
+
+
+//#define DEBUG_SPEW
+
+
+SFXSoftwareBuffer* SFXSoftwareBuffer::create( const ThreadSafeRef< SFXStream >& stream, SFXDescription* description )
+{
+   SFXSoftwareBuffer* buffer = new SFXSoftwareBuffer( stream, description );
+
+   // We only mix 8-bit unsigned and 16-bit signed PCM in mono or stereo.
+
+   const SFXFormat& format = buffer->getFormat();
+   if( format.getChannels() < 1 || format.getChannels() > 2
+       || ( format.getBytesPerChannel() != 1 && format.getBytesPerChannel() != 2 ) )
+   {
+      Con::errorf( "SFXSoftwareBuffer::create - unsupported sample format (%i channels, %i bits)",
+         format.getChannels(), format.getBitsPerChannel() );
+      delete buffer;
+      return NULL;
+   }
+
+   return buffer;
+}
+
+SFXSoftwareBuffer::SFXSoftwareBuffer( const ThreadSafeRef< SFXStream >& stream, SFXDescription* description )
+   : Parent( stream, description ),
+     mFirstSample( 0 ),
+     mHaveLastPacket( false )
+{
+   VECTOR_SET_ASSOCIATION( mSamples );
+}
+
+SFXSoftwareBuffer::~SFXSoftwareBuffer()
+{
+}
+
+void SFXSoftwareBuffer::write( SFXInternal::SFXStreamPacket* const* packets, U32 num )
+{
+   AssertFatal( SFXInternal::isSFXThread(), "SFXSoftwareBuffer::write() - not on SFX thread" );
+   using namespace SFXInternal;
+
+   MutexHandle mutex;
+   mutex.lock( &mMutex, true );
+
+   // For streaming buffers, drop everything the voice has already played
+   // past.  Keep one frame behind the cursor for interpolation.
+
+   SFXSoftwareVoice* voice = _getUniqueVoice();
+   if( isStreaming() && voice )
+   {
+      const U32 cursor = voice->_getCursorFrame();
+      if( cursor > mFirstSample + 1 )
+      {
+         const U32 numDrop = getMin( cursor - mFirstSample - 1, _getNumFrames() );
+         if( numDrop > 0 )
+         {
+            mSamples.erase( 0, numDrop * mFormat.getChannels() );
+            mFirstSample += numDrop;
+
+            #ifdef DEBUG_SPEW
+            Platform::outputDebugString( "[SFXSoftwareBuffer] Dropped %i played frames", numDrop );
+            #endif
+         }
+      }
+   }
+
+   for( U32 i = 0; i < num; ++ i )
+   {
+      SFXStreamPacket* packet = packets[ i ];
+
+      _appendPacket( packet );
+      if( packet->mIsLast )
+         mHaveLastPacket = true;
+
+      destructSingle( packet );
+   }
+}
+
+void SFXSoftwareBuffer::_appendPacket( SFXInternal::SFXStreamPacket* packet )
+{
+   const U32 bytesPerChannel = mFormat.getBytesPerChannel();
+   const U32 numSamples = packet->mSizeActual / bytesPerChannel;
+   if( !numSamples )
+      return;
+
+   const U32 offset = mSamples.size();
+   mSamples.increment( numSamples );
+   F32* dest = &mSamples[ offset ];
+
+   if( bytesPerChannel == 1 )
+   {
+      // 8-bit PCM is unsigned.
+      const U8* src = packet->data;
+      for( U32 i = 0; i < numSamples; ++ i )
+         dest[ i ] = ( F32( src[ i ] ) - 128.f ) * ( 1.f / 128.f );
+   }
+   else
+   {
+      const S16* src = reinterpret_cast< const S16* >( packet->data );
+      for( U32 i = 0; i < numSamples; ++ i )
+         dest[ i ] = F32( src[ i ] ) * ( 1.f / 32768.f );
+   }
+}
+
+void SFXSoftwareBuffer::_flush()
+{
+   AssertFatal( isStreaming(), "SFXSoftwareBuffer::_flush() - not a streaming buffer" );
+
+   #ifdef DEBUG_SPEW
+   Platform::outputDebugString( "[SFXSoftwareBuffer] Flushing buffer" );
+   #endif
+
+   if( _getUniqueVoice() )
+      _getUniqueVoice()->_stop();
+
+   MutexHandle mutex;
+   mutex.lock( &mMutex, true );
+
+   mSamples.clear();
+   mFirstSample = 0;
+   mHaveLastPacket = false;
+}
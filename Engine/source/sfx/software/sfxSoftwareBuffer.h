@@ -0,0 +1,98 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SFXSOFTWAREBUFFER_H_
+#define _SFXSOFTWAREBUFFER_H_
+
+#ifndef _SFXBUFFER_H_
+   #include "sfx/sfxBuffer.h"
+#endif
+#ifndef _TVECTOR_H_
+   #include "core/util/tVector.h"
+#endif
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+   #include "platform/threads/mutex.h"
+#endif
+
+
+class SFXSoftwareVoice;
+
+
+/// Sound buffer for the software mixing device.
+///
+/// Incoming PCM packets are converted to 32-bit float on the SFX update
+/// thread so that the mixer thread only ever has to deal with one sample
+/// format.  Non-streaming buffers hold the full sound.  Streaming buffers
+/// hold a sliding window that is trimmed behind the play cursor of the
+/// unique voice whenever new packets arrive.
+class SFXSoftwareBuffer : public SFXBuffer
+{
+      friend class SFXSoftwareDevice;
+      friend class SFXSoftwareVoice;
+      typedef SFXBuffer Parent;
+
+   protected:
+
+      /// Float samples, interleaved by channel.
+      Vector< F32 > mSamples;
+
+      /// Sample index of the first frame in #mSamples.  Always zero for
+      /// non-streaming buffers.  For streaming buffers, this is relative
+      /// to the last flush, in the same space as the voice's play cursor.
+      U32 mFirstSample;
+
+      /// True once the packet flagged as last has been written.
+      bool mHaveLastPacket;
+
+      /// Guards #mSamples and #mFirstSample between the SFX update
+      /// thread writing and the mixer thread reading.
+      Mutex mMutex;
+
+      SFXSoftwareBuffer( const ThreadSafeRef< SFXStream >& stream, SFXDescription* description );
+
+      /// If this is a streaming buffer, return the unique voice associated
+      /// with the buffer.
+      SFXSoftwareVoice* _getUniqueVoice() { return ( SFXSoftwareVoice* ) mUniqueVoice.getPointer(); }
+
+      /// Return the number of frames currently held in #mSamples.
+      U32 _getNumFrames() const { return mSamples.size() / mFormat.getChannels(); }
+
+      /// Append the samples in @a packet to #mSamples as floats.
+      void _appendPacket( SFXInternal::SFXStreamPacket* packet );
+
+      // SFXBuffer.
+      virtual void write( SFXInternal::SFXStreamPacket* const* packets, U32 num );
+      virtual void _flush();
+
+   public:
+
+      virtual ~SFXSoftwareBuffer();
+
+      ///
+      static SFXSoftwareBuffer* create( const ThreadSafeRef< SFXStream >& stream, SFXDescription* description );
+
+      // SFXBuffer.
+      virtual U32 getMemoryUsed() const { return mSamples.memSize(); }
+};
+
+#endif // _SFXSOFTWAREBUFFER_H_
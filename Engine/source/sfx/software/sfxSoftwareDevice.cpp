@@ -0,0 +1,382 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "sfx/software/sfxSoftwareDevice.h"
+#include "sfx/software/sfxSoftwareMixer.h"
+#include "sfx/sfxInternal.h"
+#include "core/util/safeDelete.h"
+#include "console/console.h"
+#include "console/consoleTypes.h"
+#include "math/mMathFn.h"
+
+
+//-----------------------------------------------------------------------------
+
+SFXSoftwareDevice::SFXSoftwareDevice( SFXProvider* provider,
+                                      String name,
+                                      bool useHardware,
+                                      S32 maxBuffers,
+                                      SFXSoftwareSink* sink,
+                                      U32 samplesPerSecond,
+                                      bool realtime )
+
+   :  Parent( name, provider, useHardware, maxBuffers ),
+      mSink( sink ),
+      mSamplesPerSecond( samplesPerSecond ),
+      mMixerThread( NULL ),
+      mIsShuttingDown( false ),
+      mLastMixTime( Platform::getVirtualMilliseconds() ),
+      mDistanceModel( SFXDistanceModelLinear ),
+      mRolloffFactor( 1.0f ),
+      mMixedFrames( 0 ),
+      mMixTimeMs( 0 ),
+      mMixedVoices( 0 ),
+      mStatMixedFrames( 0 ),
+      mStatMixTimeMs( 0 ),
+      mStatMixedVoices( 0 ),
+      mStatCpuLoad( 0.0f )
+{
+   AssertFatal( sink, "SFXSoftwareDevice - must have a sink" );
+
+   mMaxBuffers = maxBuffers > 0 ? maxBuffers : 64;
+
+   VECTOR_SET_ASSOCIATION( mMixBuffer );
+   VECTOR_SET_ASSOCIATION( mVoiceBuffer );
+   VECTOR_SET_ASSOCIATION( mOutputBuffer );
+
+   mMixBuffer.setSize( MIX_PERIOD_FRAMES * 2 );
+   mVoiceBuffer.setSize( MIX_PERIOD_FRAMES * 2 );
+   mOutputBuffer.setSize( MIX_PERIOD_FRAMES * 2 );
+
+   Con::addVariable( "SFX::Software::mixedFrames", TypeS32, &mStatMixedFrames,
+      "Total number of frames mixed by the software device.\n"
+      "@ingroup SFX" );
+   Con::addVariable( "SFX::Software::mixTimeMs", TypeS32, &mStatMixTimeMs,
+      "Total wall-clock milliseconds spent mixing by the software device.\n"
+      "@ingroup SFX" );
+   Con::addVariable( "SFX::Software::mixedVoices", TypeS32, &mStatMixedVoices,
+      "Total number of voice mixes (voices times periods) done by the software device.\n"
+      "@ingroup SFX" );
+   Con::addVariable( "SFX::Software::cpuLoad", TypeF32, &mStatCpuLoad,
+      "Time spent mixing divided by the duration of the audio mixed.\n"
+      "@ingroup SFX" );
+
+   if( !mSink->open( mSamplesPerSecond ) )
+      Con::errorf( "SFXSoftwareDevice - could not open output sink; mixing into the void" );
+
+   if( realtime )
+   {
+      mMixerThread = new MixerThread( this );
+      mMixerThread->start();
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+SFXSoftwareDevice::~SFXSoftwareDevice()
+{
+   if( mMixerThread )
+   {
+      mMixerThread->stop();
+      mMixerThread->join();
+      SAFE_DELETE( mMixerThread );
+   }
+
+   mIsShuttingDown = true;
+   _releaseAllResources();
+
+   mSink->close();
+   SAFE_DELETE( mSink );
+
+   Con::removeVariable( "SFX::Software::mixedFrames" );
+   Con::removeVariable( "SFX::Software::mixTimeMs" );
+   Con::removeVariable( "SFX::Software::mixedVoices" );
+   Con::removeVariable( "SFX::Software::cpuLoad" );
+}
+
+//-----------------------------------------------------------------------------
+
+SFXBuffer* SFXSoftwareDevice::createBuffer( const ThreadSafeRef< SFXStream >& stream, SFXDescription* description )
+{
+   SFXSoftwareBuffer* buffer = SFXSoftwareBuffer::create( stream, description );
+   if( !buffer )
+      return NULL;
+
+   _addBuffer( buffer );
+   return buffer;
+}
+
+//-----------------------------------------------------------------------------
+
+SFXVoice* SFXSoftwareDevice::createVoice( bool is3D, SFXBuffer* buffer )
+{
+   // Don't bother going any further if we've 
+   // exceeded the maximum voices.
+   if ( mVoices.size() >= mMaxBuffers )
+      return NULL;
+
+   AssertFatal( buffer, "SFXSoftwareDevice::createVoice() - Got null buffer!" );
+
+   SFXSoftwareBuffer* softwareBuffer = dynamic_cast< SFXSoftwareBuffer* >( buffer );
+   AssertFatal( softwareBuffer, "SFXSoftwareDevice::createVoice() - Got bad buffer!" );
+
+   SFXSoftwareVoice* voice = new SFXSoftwareVoice( this, softwareBuffer, is3D );
+
+   MutexHandle mutex;
+   mutex.lock( &mMixMutex, true );
+
+   _addVoice( voice );
+   return voice;
+}
+
+//-----------------------------------------------------------------------------
+
+void SFXSoftwareDevice::_removeVoice( SFXVoice* voice )
+{
+   MutexHandle mutex;
+   mutex.lock( &mMixMutex, true );
+
+   Parent::_removeVoice( voice );
+}
+
+//-----------------------------------------------------------------------------
+
+void SFXSoftwareDevice::setDistanceModel( SFXDistanceModel model )
+{
+   mDistanceModel = model;
+}
+
+//-----------------------------------------------------------------------------
+
+void SFXSoftwareDevice::setRolloffFactor( F32 factor )
+{
+   mRolloffFactor = factor;
+}
+
+//-----------------------------------------------------------------------------
+
+void SFXSoftwareDevice::setListener( U32 index, const SFXListenerProperties& listener )
+{
+   if( index != 0 )
+      return;
+
+   MutexHandle mutex;
+   mutex.lock( &mMixMutex, true );
+
+   mListener = listener;
+}
+
+//-----------------------------------------------------------------------------
+
+void SFXSoftwareDevice::resetStats()
+{
+   MutexHandle mutex;
+   mutex.lock( &mMixMutex, true );
+
+   mMixedFrames = 0;
+   mMixTimeMs = 0;
+   mMixedVoices = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void SFXSoftwareDevice::update()
+{
+   Parent::update();
+
+   // In non-realtime mode, mix as much as simulation time has advanced.
+
+   if( !mMixerThread )
+   {
+      const U32 time = Platform::getVirtualMilliseconds();
+      const U32 numFrames = U64( time - mLastMixTime ) * mSamplesPerSecond / 1000;
+
+      // Only move the time base by what we actually consumed so that
+      // rounding doesn't make us drift.
+      mLastMixTime += U64( numFrames ) * 1000 / mSamplesPerSecond;
+
+      for( U32 numLeft = numFrames; numLeft > 0; )
+      {
+         const U32 num = getMin( numLeft, U32( MIX_PERIOD_FRAMES ) );
+         _mix( num );
+         numLeft -= num;
+      }
+   }
+
+   // Publish stats.
+
+   MutexHandle mutex;
+   mutex.lock( &mMixMutex, true );
+
+   mStatMixedFrames = mMixedFrames;
+   mStatMixTimeMs = mMixTimeMs;
+   mStatMixedVoices = mMixedVoices;
+
+   const F32 mixedMs = F32( mMixedFrames ) * 1000.0f / F32( mSamplesPerSecond );
+   mStatCpuLoad = mixedMs > 0.0f ? F32( mMixTimeMs ) / mixedMs : 0.0f;
+}
+
+//-----------------------------------------------------------------------------
+
+void SFXSoftwareDevice::_getVoiceGains( const SFXSoftwareVoice* voice, F32& outLeft, F32& outRight ) const
+{
+   F32 volume = voice->mVolume;
+   F32 pan = 0.0f;
+
+   if( voice->is3D() )
+   {
+      const MatrixF& transform = mListener.getTransform();
+
+      Point3F listenerPos;
+      transform.getColumn( 3, &listenerPos );
+
+      const VectorF toSource = voice->mPosition - listenerPos;
+      const F32 distance = toSource.len();
+
+      volume = SFXDistanceAttenuation( mDistanceModel,
+                                       voice->mMinDistance,
+                                       voice->mMaxDistance,
+                                       distance,
+                                       volume,
+                                       mRolloffFactor );
+
+      if( distance > POINT_EPSILON )
+      {
+         // Cone attenuation.  Cone angles are full apex angles.
+
+         if( voice->mConeInnerAngle < 360.0f )
+         {
+            const F32 cosAngle = mDot( voice->mDirection, -toSource ) / distance;
+            const F32 angle = 2.0f * mRadToDeg( mAcos( mClampF( cosAngle, -1.0f, 1.0f ) ) );
+
+            if( angle >= voice->mConeOuterAngle )
+               volume *= voice->mConeOuterVolume;
+            else if( angle > voice->mConeInnerAngle )
+            {
+               const F32 t = ( angle - voice->mConeInnerAngle ) / ( voice->mConeOuterAngle - voice->mConeInnerAngle );
+               volume *= 1.0f + t * ( voice->mConeOuterVolume - 1.0f );
+            }
+         }
+
+         // Project onto the listener's right axis for panning.
+
+         VectorF right;
+         transform.getColumn( 0, &right );
+         pan = mClampF( mDot( toSource, right ) / distance, -1.0f, 1.0f );
+      }
+   }
+
+   // Only mono sources are panned; stereo sources keep their image.
+
+   if( voice->getFormat().isMono() )
+   {
+      // Equal-power pan law.
+      const F32 angle = ( pan + 1.0f ) * M_PI_F * 0.25f;
+      outLeft = volume * mCos( angle );
+      outRight = volume * mSin( angle );
+   }
+   else
+   {
+      outLeft = volume;
+      outRight = volume;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void SFXSoftwareDevice::_mix( U32 numFrames )
+{
+   AssertFatal( numFrames <= MIX_PERIOD_FRAMES, "SFXSoftwareDevice::_mix - too many frames" );
+
+   const U32 startTime = Platform::getRealMilliseconds();
+
+   MutexHandle mutex;
+   mutex.lock( &mMixMutex, true );
+
+   F32* mixBuffer = mMixBuffer.address();
+   F32* voiceBuffer = mVoiceBuffer.address();
+
+   dMemset( mixBuffer, 0, numFrames * 2 * sizeof( F32 ) );
+
+   for( U32 i = 0, num = mVoices.size(); i < num; ++ i )
+   {
+      SFXSoftwareVoice* voice = static_cast< SFXSoftwareVoice* >( mVoices[ i ] );
+      if( voice->mState != SFXSoftwareVoice::STATE_Playing || !voice->_getBuffer() )
+         continue;
+
+      const SFXFormat& format = voice->getFormat();
+      const F64 step = F64( format.getSamplesPerSecond() ) / F64( mSamplesPerSecond ) * voice->mPitch;
+
+      const U32 numRendered = voice->_render( voiceBuffer, numFrames, step );
+      if( !numRendered )
+         continue;
+
+      F32 gainLeft, gainRight;
+      _getVoiceGains( voice, gainLeft, gainRight );
+
+      if( format.isMono() )
+         sfx_mix_mono_to_stereo( mixBuffer, voiceBuffer, numRendered, gainLeft, gainRight );
+      else
+         sfx_mix_stereo_to_stereo( mixBuffer, voiceBuffer, numRendered, gainLeft, gainRight );
+
+      mMixedVoices ++;
+   }
+
+   sfx_convert_F32_to_S16( mOutputBuffer.address(), mixBuffer, numFrames * 2 );
+
+   mMixedFrames += numFrames;
+   mMixTimeMs += Platform::getRealMilliseconds() - startTime;
+
+   mutex.unlock();
+
+   mSink->write( mOutputBuffer.address(), numFrames );
+}
+
+//-----------------------------------------------------------------------------
+
+void SFXSoftwareDevice::MixerThread::run( void* arg )
+{
+   _setName( "SFXSoftwareMixer" );
+
+   const U32 samplesPerSecond = mDevice->mSamplesPerSecond;
+   const U32 startTime = Platform::getRealMilliseconds();
+   U64 numFramesMixed = 0;
+
+   while( !checkForStop() )
+   {
+      // Stay a little ahead of the wall clock so the sink never starves.
+
+      const U32 elapsed = Platform::getRealMilliseconds() - startTime + REALTIME_LATENCY_MS;
+      const U64 numFramesDue = U64( elapsed ) * samplesPerSecond / 1000;
+
+      if( numFramesMixed >= numFramesDue )
+      {
+         Platform::sleep( 1 );
+         continue;
+      }
+
+      const U32 numFrames = getMin( U32( numFramesDue - numFramesMixed ), U32( MIX_PERIOD_FRAMES ) );
+      mDevice->_mix( numFrames );
+      numFramesMixed += numFrames;
+   }
+}
@@ -0,0 +1,181 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SFXSOFTWAREDEVICE_H_
+#define _SFXSOFTWAREDEVICE_H_
+
+class SFXProvider;
+
+#ifndef _SFXDEVICE_H_
+   #include "sfx/sfxDevice.h"
+#endif
+#ifndef _SFXPROVIDER_H_
+   #include "sfx/sfxProvider.h"
+#endif
+#ifndef _SFXSOFTWAREBUFFER_H_
+   #include "sfx/software/sfxSoftwareBuffer.h"
+#endif
+#ifndef _SFXSOFTWAREVOICE_H_
+   #include "sfx/software/sfxSoftwareVoice.h"
+#endif
+#ifndef _SFXSOFTWARESINK_H_
+   #include "sfx/software/sfxSoftwareSink.h"
+#endif
+#ifndef _PLATFORM_THREADS_THREAD_H_
+   #include "platform/threads/thread.h"
+#endif
+
+
+/// A device that mixes all voices in software and hands the resulting
+/// 16-bit stereo stream to an SFXSoftwareSink.
+///
+/// Voices are resampled, scaled by volume, attenuated and panned according
+/// to the listener and accumulated into a float mix buffer using the
+/// kernels in sfxSoftwareMixer.h.
+///
+/// In realtime mode, mixing runs on a dedicated thread paced by the wall
+/// clock.  Otherwise, mixing happens in update() for as many frames as
+/// virtual (simulation) time has advanced, so a run that is faster or slower
+/// than realtime still produces an audio track in sync with the simulation.
+///
+/// Mixing cost is exposed to script through the $SFX::Software::* variables.
+class SFXSoftwareDevice : public SFXDevice
+{
+   public:
+
+      typedef SFXDevice Parent;
+      friend class SFXSoftwareVoice; // mMixMutex, mIsShuttingDown, _removeVoice
+
+      enum
+      {
+         /// Maximum number of frames mixed in one period.
+         MIX_PERIOD_FRAMES = 512,
+
+         /// How far ahead of the wall clock the realtime mixer thread runs.
+         REALTIME_LATENCY_MS = 50,
+      };
+
+   protected:
+
+      /// Thread running the realtime mixing loop.
+      struct MixerThread : public Thread
+      {
+         SFXSoftwareDevice* mDevice;
+
+         MixerThread( SFXSoftwareDevice* device )
+            : mDevice( device ) {}
+
+         virtual void run( void* arg = 0 );
+      };
+
+      /// Where the mix goes.  Owned by the device.
+      SFXSoftwareSink* mSink;
+
+      /// Output sample rate.
+      U32 mSamplesPerSecond;
+
+      /// Mixer thread in realtime mode; NULL otherwise.
+      MixerThread* mMixerThread;
+
+      /// Set while the destructor releases resources so that dying
+      /// voices don't modify the voice list being iterated.
+      bool mIsShuttingDown;
+
+      /// Virtual time of the last update() in non-realtime mode.
+      U32 mLastMixTime;
+
+      /// Serializes mixing with changes to the voice list, listener
+      /// and voice play state.
+      Mutex mMixMutex;
+
+      SFXDistanceModel mDistanceModel;
+      F32 mRolloffFactor;
+      SFXListenerProperties mListener;
+
+      /// Float stereo accumulation buffer.
+      Vector< F32 > mMixBuffer;
+
+      /// Scratch buffer holding a single voice's resampled output.
+      Vector< F32 > mVoiceBuffer;
+
+      /// Converted output handed to the sink.
+      Vector< S16 > mOutputBuffer;
+
+      /// @name Statistics
+      /// Accumulated on the mixing side and published to the console
+      /// variables in update().
+      /// @{
+
+      U32 mMixedFrames;
+      U32 mMixTimeMs;
+      U32 mMixedVoices;
+
+      S32 mStatMixedFrames;
+      S32 mStatMixTimeMs;
+      S32 mStatMixedVoices;
+      F32 mStatCpuLoad;
+
+      /// @}
+
+      /// Compute the left and right gains for @a voice based on its volume,
+      /// 3D parameters and the current listener.
+      void _getVoiceGains( const SFXSoftwareVoice* voice, F32& outLeft, F32& outRight ) const;
+
+      /// Mix @a numFrames frames and pass them on to the sink.
+      void _mix( U32 numFrames );
+
+      // SFXDevice.
+      virtual void _removeVoice( SFXVoice* voice );
+
+   public:
+
+      /// Create a device writing to @a sink.  The device takes ownership of the sink.
+      SFXSoftwareDevice( SFXProvider* provider,
+                         String name,
+                         bool useHardware,
+                         S32 maxBuffers,
+                         SFXSoftwareSink* sink,
+                         U32 samplesPerSecond,
+                         bool realtime );
+
+      virtual ~SFXSoftwareDevice();
+
+      /// @return The sink the device mixes into.
+      SFXSoftwareSink* getSink() const { return mSink; }
+
+      /// @return The output sample rate.
+      U32 getSamplesPerSecond() const { return mSamplesPerSecond; }
+
+      /// Reset the accumulated mixing statistics.
+      void resetStats();
+
+      // SFXDevice.
+      virtual SFXBuffer* createBuffer( const ThreadSafeRef< SFXStream >& stream, SFXDescription* description );
+      virtual SFXVoice* createVoice( bool is3D, SFXBuffer* buffer );
+      virtual void setDistanceModel( SFXDistanceModel model );
+      virtual void setRolloffFactor( F32 factor );
+      virtual void setListener( U32 index, const SFXListenerProperties& listener );
+      virtual void update();
+};
+
+#endif // _SFXSOFTWAREDEVICE_H_
@@ -0,0 +1,103 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "sfx/software/sfxSoftwareMixer.h"
+#include "sfx/software/arch/sfxSoftwareMixer.arch.h"
+#include "math/mMathFn.h"
+#include "core/module.h"
+
+
+void (*sfx_mix_mono_to_stereo)(F32 * __restrict out, const F32 * __restrict in, const U32 numFrames, const F32 gainLeft, const F32 gainRight) = NULL;
+void (*sfx_mix_stereo_to_stereo)(F32 * __restrict out, const F32 * __restrict in, const U32 numFrames, const F32 gainLeft, const F32 gainRight) = NULL;
+void (*sfx_convert_F32_to_S16)(S16 * __restrict out, const F32 * __restrict in, const U32 numSamples) = NULL;
+
+//------------------------------------------------------------------------------
+// Default C++ Implementations
+//------------------------------------------------------------------------------
+
+void sfx_mix_mono_to_stereo_C(F32 * __restrict out, const F32 * __restrict in, const U32 numFrames, const F32 gainLeft, const F32 gainRight)
+{
+   for(U32 i = 0; i < numFrames; i++)
+   {
+      const F32 sample = in[i];
+      out[0] += sample * gainLeft;
+      out[1] += sample * gainRight;
+      out += 2;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void sfx_mix_stereo_to_stereo_C(F32 * __restrict out, const F32 * __restrict in, const U32 numFrames, const F32 gainLeft, const F32 gainRight)
+{
+   for(U32 i = 0; i < numFrames; i++)
+   {
+      out[0] += in[0] * gainLeft;
+      out[1] += in[1] * gainRight;
+      out += 2;
+      in += 2;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void sfx_convert_F32_to_S16_C(S16 * __restrict out, const F32 * __restrict in, const U32 numSamples)
+{
+   for(U32 i = 0; i < numSamples; i++)
+   {
+      // Clamp before converting as out of range floats don't convert.
+      out[i] = S16(mClampF(in[i], -1.0f, 1.0f) * 32767.0f);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Initializer.
+//------------------------------------------------------------------------------
+
+MODULE_BEGIN( SFXSoftwareMixer )
+
+   MODULE_INIT_BEFORE( SFX )
+
+   MODULE_INIT
+   {
+      // Assign defaults (C++ versions)
+      sfx_mix_mono_to_stereo = sfx_mix_mono_to_stereo_C;
+      sfx_mix_stereo_to_stereo = sfx_mix_stereo_to_stereo_C;
+      sfx_convert_F32_to_S16 = sfx_convert_F32_to_S16_C;
+
+      // Find the best implementation for the current CPU
+   #if defined(TORQUE_CPU_X86) || defined(TORQUE_CPU_X64)
+      if(Platform::SystemInfo.processor.properties & CPU_PROP_SSE)
+      {
+         sfx_mix_mono_to_stereo = sfx_mix_mono_to_stereo_SSE;
+         sfx_mix_stereo_to_stereo = sfx_mix_stereo_to_stereo_SSE;
+      }
+   #if defined(TORQUE_SFX_MIXER_SSE2)
+      if(Platform::SystemInfo.processor.properties & CPU_PROP_SSE2)
+         sfx_convert_F32_to_S16 = sfx_convert_F32_to_S16_SSE2;
+   #endif
+   #endif
+   }
+
+MODULE_END;
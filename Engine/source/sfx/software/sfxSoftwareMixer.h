@@ -0,0 +1,85 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SFXSOFTWAREMIXER_H_
+#define _SFXSOFTWAREMIXER_H_
+
+#ifndef _TORQUE_TYPES_H_
+   #include "platform/types.h"
+#endif
+
+
+/// @name Software Mixing Kernels
+///
+/// These are the inner loops of the software mixing device.  They are
+/// assigned at module initialization time to the fastest implementation
+/// available on the current CPU, so always call through the pointers.
+///
+/// All sample buffers are 32-bit float.  Stereo data is interleaved
+/// left/right.  The SIMD versions process four floats at a time and
+/// fall back to scalar code for any remainder, so no alignment or
+/// padding requirements are imposed on the caller.
+///
+/// @{
+
+/// Accumulate a mono signal into an interleaved stereo mix buffer.
+///
+/// @param out       Stereo mix buffer (2 * numFrames floats).
+/// @param in        Mono source samples (numFrames floats).
+/// @param numFrames Number of frames to mix.
+/// @param gainLeft  Gain applied to the left output channel.
+/// @param gainRight Gain applied to the right output channel.
+extern void (*sfx_mix_mono_to_stereo)
+                           (F32 * __restrict out,
+                            const F32 * __restrict in,
+                            const U32 numFrames,
+                            const F32 gainLeft,
+                            const F32 gainRight);
+
+/// Accumulate an interleaved stereo signal into an interleaved stereo mix buffer.
+///
+/// @param out       Stereo mix buffer (2 * numFrames floats).
+/// @param in        Stereo source samples (2 * numFrames floats).
+/// @param numFrames Number of frames to mix.
+/// @param gainLeft  Gain applied to the left channel.
+/// @param gainRight Gain applied to the right channel.
+extern void (*sfx_mix_stereo_to_stereo)
+                           (F32 * __restrict out,
+                            const F32 * __restrict in,
+                            const U32 numFrames,
+                            const F32 gainLeft,
+                            const F32 gainRight);
+
+/// Convert float samples in [-1,1] to saturated signed 16-bit PCM.
+///
+/// @param out        Destination PCM samples.
+/// @param in         Source float samples.
+/// @param numSamples Number of individual samples (not frames) to convert.
+extern void (*sfx_convert_F32_to_S16)
+                           (S16 * __restrict out,
+                            const F32 * __restrict in,
+                            const U32 numSamples);
+
+/// @}
+
+#endif // _SFXSOFTWAREMIXER_H_
@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "sfx/sfxProvider.h"
+#include "sfx/software/sfxSoftwareDevice.h"
+#include "core/strings/stringFunctions.h"
+#include "console/console.h"
+#include "core/module.h"
+
+
+class SFXSoftwareProvider : public SFXProvider
+{
+public:
+
+   SFXSoftwareProvider()
+      : SFXProvider( "Software" ) {}
+   virtual ~SFXSoftwareProvider();
+
+   /// Where a software device sends its output.
+   enum SinkType
+   {
+      SINK_WavFile,
+      SINK_RingBuffer,
+   };
+
+   struct SoftwareDeviceInfo : public SFXDeviceInfo
+   {
+      SinkType sinkType;
+   };
+
+protected:
+   void addDeviceDesc( const String& name, const String& desc, SinkType sinkType );
+   void init();
+
+public:
+
+   SFXDevice* createDevice( const String& deviceName, bool useHardware, S32 maxBuffers );
+
+};
+
+MODULE_BEGIN( SFXSoftware )
+
+   MODULE_INIT_BEFORE( SFX )
+   MODULE_SHUTDOWN_AFTER( SFX )
+   
+   SFXSoftwareProvider* mProvider;
+
+   MODULE_INIT
+   {
+      mProvider = new SFXSoftwareProvider;
+   }
+   
+   MODULE_SHUTDOWN
+   {
+      delete mProvider;
+   }
+
+MODULE_END;
+
+void SFXSoftwareProvider::init()
+{
+   regProvider( this );
+   addDeviceDesc( "WAV", "SFX Software Mixer (WAV File)", SINK_WavFile );
+   addDeviceDesc( "RingBuffer", "SFX Software Mixer (Ring Buffer)", SINK_RingBuffer );
+}
+
+SFXSoftwareProvider::~SFXSoftwareProvider()
+{
+}
+
+
+void SFXSoftwareProvider::addDeviceDesc( const String& name, const String& desc, SinkType sinkType )
+{
+   SoftwareDeviceInfo* info = new SoftwareDeviceInfo;
+   info->name = desc;
+   info->driver = name;
+   info->hasHardware = false;
+   info->maxBuffers = 64;
+   info->sinkType = sinkType;
+
+   mDeviceInfo.push_back( info );
+}
+
+SFXDevice* SFXSoftwareProvider::createDevice( const String& deviceName, bool useHardware, S32 maxBuffers )
+{
+   SoftwareDeviceInfo* info = static_cast< SoftwareDeviceInfo* >( _findDeviceInfo( deviceName ) );
+
+   // Do we find one to create?
+   if ( !info )
+      return NULL;
+
+   const U32 samplesPerSecond = getMax( Con::getIntVariable( "$pref::SFX::Software::sampleRate", 44100 ), 8000 );
+   const bool realtime = Con::getBoolVariable( "$pref::SFX::Software::realtime", true );
+
+   SFXSoftwareSink* sink;
+   if( info->sinkType == SINK_WavFile )
+   {
+      const char* fileName = Con::getVariable( "$pref::SFX::Software::outputFile" );
+      sink = new SFXWavFileSink( dStrlen( fileName ) ? fileName : "sfxOutput.wav" );
+   }
+   else
+   {
+      const F32 seconds = getMax( Con::getFloatVariable( "$pref::SFX::Software::ringBufferSeconds", 2.0f ), 0.1f );
+      sink = new SFXRingBufferSink( U32( seconds * samplesPerSecond ) );
+   }
+
+   return new SFXSoftwareDevice( this, info->name, useHardware, maxBuffers, sink, samplesPerSecond, realtime );
+}
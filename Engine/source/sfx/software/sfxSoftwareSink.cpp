@@ -0,0 +1,198 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "sfx/software/sfxSoftwareSink.h"
+#include "core/stream/fileStream.h"
+#include "core/util/safeDelete.h"
+#include "console/console.h"
+
+
+//-----------------------------------------------------------------------------
+//    SFXWavFileSink.
+//-----------------------------------------------------------------------------
+
+SFXWavFileSink::SFXWavFileSink( const String& fileName )
+   : mFileName( fileName ),
+     mStream( NULL ),
+     mDataSize( 0 ),
+     mSamplesPerSecond( 0 )
+{
+}
+
+SFXWavFileSink::~SFXWavFileSink()
+{
+   close();
+}
+
+bool SFXWavFileSink::open( U32 samplesPerSecond )
+{
+   close();
+
+   mStream = FileStream::createAndOpen( mFileName, Torque::FS::File::Write );
+   if( !mStream )
+   {
+      Con::errorf( "SFXWavFileSink::open - could not open '%s' for writing", mFileName.c_str() );
+      return false;
+   }
+
+   mDataSize = 0;
+   mSamplesPerSecond = samplesPerSecond;
+   _writeHeader( samplesPerSecond );
+
+   return true;
+}
+
+void SFXWavFileSink::close()
+{
+   if( !mStream )
+      return;
+
+   // Go back and patch the chunk sizes now that we know them.
+
+   mStream->setPosition( 0 );
+   _writeHeader( mSamplesPerSecond );
+
+   mStream->close();
+   SAFE_DELETE( mStream );
+}
+
+void SFXWavFileSink::_writeHeader( U32 samplesPerSecond )
+{
+   const U16 numChannels = 2;
+   const U16 bitsPerSample = 16;
+   const U16 blockAlign = numChannels * bitsPerSample / 8;
+
+   mStream->write( 4, "RIFF" );
+   mStream->write( U32( 36 + mDataSize ) );
+   mStream->write( 4, "WAVE" );
+
+   mStream->write( 4, "fmt " );
+   mStream->write( U32( 16 ) );
+   mStream->write( U16( 1 ) ); // PCM
+   mStream->write( numChannels );
+   mStream->write( samplesPerSecond );
+   mStream->write( U32( samplesPerSecond * blockAlign ) );
+   mStream->write( blockAlign );
+   mStream->write( bitsPerSample );
+
+   mStream->write( 4, "data" );
+   mStream->write( mDataSize );
+}
+
+void SFXWavFileSink::write( const S16* samples, U32 numFrames )
+{
+   if( !mStream )
+      return;
+
+   #ifdef TORQUE_BIG_ENDIAN
+   for( U32 i = 0; i < numFrames * 2; ++ i )
+      mStream->write( samples[ i ] );
+   #else
+   mStream->write( numFrames * 2 * sizeof( S16 ), samples );
+   #endif
+
+   mDataSize += numFrames * 2 * sizeof( S16 );
+}
+
+//-----------------------------------------------------------------------------
+//    SFXRingBufferSink.
+//-----------------------------------------------------------------------------
+
+SFXRingBufferSink::SFXRingBufferSink( U32 numFrames )
+   : mNumFrames( numFrames ),
+     mWritePos( 0 ),
+     mNumAvailable( 0 ),
+     mNumOverwritten( 0 )
+{
+   AssertFatal( numFrames > 0, "SFXRingBufferSink - ring must not be empty" );
+
+   VECTOR_SET_ASSOCIATION( mRing );
+   mRing.setSize( numFrames * 2 );
+}
+
+bool SFXRingBufferSink::open( U32 samplesPerSecond )
+{
+   MutexHandle mutex;
+   mutex.lock( &mMutex, true );
+
+   mWritePos = 0;
+   mNumAvailable = 0;
+   mNumOverwritten = 0;
+
+   return true;
+}
+
+void SFXRingBufferSink::write( const S16* samples, U32 numFrames )
+{
+   MutexHandle mutex;
+   mutex.lock( &mMutex, true );
+
+   // Only the tail end of an oversized write survives.
+
+   if( numFrames > mNumFrames )
+   {
+      mNumOverwritten += numFrames - mNumFrames;
+      samples += ( numFrames - mNumFrames ) * 2;
+      numFrames = mNumFrames;
+   }
+
+   while( numFrames > 0 )
+   {
+      const U32 numToCopy = getMin( numFrames, mNumFrames - mWritePos );
+      dMemcpy( &mRing[ mWritePos * 2 ], samples, numToCopy * 2 * sizeof( S16 ) );
+
+      samples += numToCopy * 2;
+      numFrames -= numToCopy;
+      mWritePos = ( mWritePos + numToCopy ) % mNumFrames;
+      mNumAvailable += numToCopy;
+   }
+
+   if( mNumAvailable > mNumFrames )
+   {
+      mNumOverwritten += mNumAvailable - mNumFrames;
+      mNumAvailable = mNumFrames;
+   }
+}
+
+U32 SFXRingBufferSink::read( S16* outSamples, U32 numFrames )
+{
+   MutexHandle mutex;
+   mutex.lock( &mMutex, true );
+
+   numFrames = getMin( numFrames, mNumAvailable );
+   U32 readPos = ( mWritePos + mNumFrames - mNumAvailable ) % mNumFrames;
+
+   U32 numLeft = numFrames;
+   while( numLeft > 0 )
+   {
+      const U32 numToCopy = getMin( numLeft, mNumFrames - readPos );
+      dMemcpy( outSamples, &mRing[ readPos * 2 ], numToCopy * 2 * sizeof( S16 ) );
+
+      outSamples += numToCopy * 2;
+      numLeft -= numToCopy;
+      readPos = ( readPos + numToCopy ) % mNumFrames;
+   }
+
+   mNumAvailable -= numFrames;
+   return numFrames;
+}
@@ -0,0 +1,154 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SFXSOFTWARESINK_H_
+#define _SFXSOFTWARESINK_H_
+
+#ifndef _PLATFORM_H_
+   #include "platform/platform.h"
+#endif
+#ifndef _TVECTOR_H_
+   #include "core/util/tVector.h"
+#endif
+#ifndef _TORQUE_STRING_H_
+   #include "core/util/str.h"
+#endif
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+   #include "platform/threads/mutex.h"
+#endif
+
+
+class FileStream;
+
+
+/// Destination for the 16-bit interleaved stereo PCM produced by
+/// SFXSoftwareDevice.
+///
+/// @note write() is called on the mixer thread.
+class SFXSoftwareSink
+{
+   public:
+
+      typedef void Parent;
+
+      virtual ~SFXSoftwareSink() {}
+
+      /// Prepare the sink for receiving data.
+      /// @return True if the sink is ready for writing.
+      virtual bool open( U32 samplesPerSecond ) = 0;
+
+      /// Finish writing.  No write() calls will be issued after this.
+      virtual void close() = 0;
+
+      /// Consume @a numFrames frames of interleaved stereo samples.
+      virtual void write( const S16* samples, U32 numFrames ) = 0;
+};
+
+
+/// Sink that writes the mix to a 16-bit stereo RIFF/WAVE file.
+class SFXWavFileSink : public SFXSoftwareSink
+{
+   public:
+
+      typedef SFXSoftwareSink Parent;
+
+   protected:
+
+      /// Path of the output file.
+      String mFileName;
+
+      /// The open file or NULL.
+      FileStream* mStream;
+
+      /// Number of PCM bytes written so far.
+      U32 mDataSize;
+
+      /// Write the RIFF header using the current data size.
+      void _writeHeader( U32 samplesPerSecond );
+
+      /// Sample rate the file was opened with.
+      U32 mSamplesPerSecond;
+
+   public:
+
+      SFXWavFileSink( const String& fileName );
+      virtual ~SFXWavFileSink();
+
+      // SFXSoftwareSink.
+      virtual bool open( U32 samplesPerSecond );
+      virtual void close();
+      virtual void write( const S16* samples, U32 numFrames );
+};
+
+
+/// Sink that keeps the most recent part of the mix in a fixed-size
+/// ring buffer for retrieval by the application.  When the ring is
+/// full, the oldest frames are overwritten.
+class SFXRingBufferSink : public SFXSoftwareSink
+{
+   public:
+
+      typedef SFXSoftwareSink Parent;
+
+   protected:
+
+      /// Interleaved stereo sample storage.
+      Vector< S16 > mRing;
+
+      /// Capacity in frames.
+      U32 mNumFrames;
+
+      /// Frame index of the next write.
+      U32 mWritePos;
+
+      /// Number of frames available for reading.
+      U32 mNumAvailable;
+
+      /// Total number of frames dropped because the reader fell behind.
+      U32 mNumOverwritten;
+
+      /// Guards the ring against concurrent read() and write().
+      Mutex mMutex;
+
+   public:
+
+      SFXRingBufferSink( U32 numFrames );
+
+      /// Copy up to @a numFrames of the oldest available frames into @a outSamples
+      /// and remove them from the ring.
+      /// @return The number of frames copied.
+      U32 read( S16* outSamples, U32 numFrames );
+
+      /// @return The number of frames waiting to be read.
+      U32 getNumAvailable() const { return mNumAvailable; }
+
+      /// @return The number of frames lost to overruns.
+      U32 getNumOverwritten() const { return mNumOverwritten; }
+
+      // SFXSoftwareSink.
+      virtual bool open( U32 samplesPerSecond );
+      virtual void close() {}
+      virtual void write( const S16* samples, U32 numFrames );
+};
+
+#endif // _SFXSOFTWARESINK_H_
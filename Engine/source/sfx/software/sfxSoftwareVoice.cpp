@@ -0,0 +1,238 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "sfx/software/sfxSoftwareVoice.h"
+#include "sfx/software/sfxSoftwareBuffer.h"
+#include "sfx/software/sfxSoftwareDevice.h"
+#include "sfx/sfxInternal.h"
+#include "math/mMathFn.h"
+
+
+SFXSoftwareVoice::SFXSoftwareVoice( SFXSoftwareDevice* device, SFXSoftwareBuffer* buffer, bool is3D )
+   : Parent( buffer ),
+     mDevice( device ),
+     mIs3D( is3D ),
+     mIsLooping( false ),
+     mState( STATE_Stopped ),
+     mCursor( 0.0 ),
+     mCursorFrame( 0 ),
+     mVolume( 1.0f ),
+     mPitch( 1.0f ),
+     mPosition( 0.0f, 0.0f, 0.0f ),
+     mVelocity( 0.0f, 0.0f, 0.0f ),
+     mDirection( 0.0f, 1.0f, 0.0f ),
+     mMinDistance( 1.0f ),
+     mMaxDistance( 100.0f ),
+     mConeInnerAngle( 360.0f ),
+     mConeOuterAngle( 360.0f ),
+     mConeOuterVolume( 1.0f )
+{
+}
+
+SFXSoftwareVoice::~SFXSoftwareVoice()
+{
+   // Get off the mixer's list before we are torn down.  The base class
+   // will trigger this again through smVoiceDestroyedSignal but by then
+   // our derived state is gone.
+   if( !mDevice->mIsShuttingDown )
+      mDevice->_removeVoice( this );
+}
+
+SFXStatus SFXSoftwareVoice::_status() const
+{
+   switch( mState )
+   {
+      case STATE_Playing:  return SFXStatusPlaying;
+      case STATE_Paused:   return SFXStatusPaused;
+      default:             return SFXStatusStopped;
+   }
+}
+
+void SFXSoftwareVoice::_play()
+{
+   MutexHandle mutex;
+   mutex.lock( &mDevice->mMixMutex, true );
+
+   mState = STATE_Playing;
+}
+
+void SFXSoftwareVoice::_pause()
+{
+   MutexHandle mutex;
+   mutex.lock( &mDevice->mMixMutex, true );
+
+   mState = STATE_Paused;
+}
+
+void SFXSoftwareVoice::_stop()
+{
+   MutexHandle mutex;
+   mutex.lock( &mDevice->mMixMutex, true );
+
+   mState = STATE_Stopped;
+   mCursor = 0.0;
+   mCursorFrame = 0;
+}
+
+void SFXSoftwareVoice::_seek( U32 sample )
+{
+   MutexHandle mutex;
+   mutex.lock( &mDevice->mMixMutex, true );
+
+   mCursor = sample;
+   mCursorFrame = sample;
+}
+
+U32 SFXSoftwareVoice::_tell() const
+{
+   return mCursorFrame;
+}
+
+U32 SFXSoftwareVoice::_render( F32* dest, U32 numFrames, F64 step )
+{
+   SFXSoftwareBuffer* buffer = _getBuffer();
+   if( !buffer )
+      return 0;
+
+   MutexHandle mutex;
+   mutex.lock( &buffer->mMutex, true );
+
+   const U32 numChannels = buffer->getFormat().getChannels();
+   const F32* samples = buffer->mSamples.address();
+   const U32 firstFrame = buffer->mFirstSample;
+   const U32 endFrame = firstFrame + buffer->_getNumFrames();
+   const bool isStreaming = buffer->isStreaming();
+   const bool wrap = mIsLooping && !isStreaming && endFrame > 0;
+   const bool haveAllData = !isStreaming || buffer->mHaveLastPacket;
+
+   U32 i = 0;
+   for( ; i < numFrames; ++ i )
+   {
+      if( wrap && mCursor >= endFrame )
+         mCursor = mFmodD( mCursor, endFrame );
+
+      const U32 frame = U32( mCursor );
+      if( frame < firstFrame || frame >= endFrame )
+         break;
+
+      // Find the frame to interpolate towards.  At the very end of the
+      // data, either wrap around or hold the last frame.
+
+      U32 next = frame + 1;
+      if( next >= endFrame )
+      {
+         if( wrap )
+            next = 0;
+         else if( haveAllData )
+            next = frame;
+         else
+            break; // Starved; wait for more data.
+      }
+
+      const F32 frac = F32( mCursor - frame );
+      const F32* s0 = &samples[ ( frame - firstFrame ) * numChannels ];
+      const F32* s1 = &samples[ ( next - firstFrame ) * numChannels ];
+
+      for( U32 c = 0; c < numChannels; ++ c )
+         dest[ i * numChannels + c ] = s0[ c ] + ( s1[ c ] - s0[ c ] ) * frac;
+
+      mCursor += step;
+   }
+
+   if( i < numFrames && haveAllData && !wrap && U32( mCursor ) >= endFrame )
+   {
+      // Played to the end.  Streaming voices hold at the end so that the
+      // buffer's queue sees the final position and flags STATUS_AtEnd.
+
+      mCursor = endFrame;
+      if( !isStreaming )
+         mState = STATE_Stopped;
+   }
+
+   mCursorFrame = U32( mCursor );
+   return i;
+}
+
+void SFXSoftwareVoice::play( bool looping )
+{
+   {
+      MutexHandle mutex;
+      mutex.lock( &mDevice->mMixMutex, true );
+
+      mIsLooping = looping;
+   }
+
+   Parent::play( looping );
+}
+
+void SFXSoftwareVoice::setMinMaxDistance( F32 min, F32 max )
+{
+   MutexHandle mutex;
+   mutex.lock( &mDevice->mMixMutex, true );
+
+   mMinDistance = min;
+   mMaxDistance = max;
+}
+
+void SFXSoftwareVoice::setVelocity( const VectorF& velocity )
+{
+   MutexHandle mutex;
+   mutex.lock( &mDevice->mMixMutex, true );
+
+   mVelocity = velocity;
+}
+
+void SFXSoftwareVoice::setTransform( const MatrixF& transform )
+{
+   MutexHandle mutex;
+   mutex.lock( &mDevice->mMixMutex, true );
+
+   transform.getColumn( 3, &mPosition );
+   transform.getColumn( 1, &mDirection );
+}
+
+void SFXSoftwareVoice::setVolume( F32 volume )
+{
+   MutexHandle mutex;
+   mutex.lock( &mDevice->mMixMutex, true );
+
+   mVolume = volume;
+}
+
+void SFXSoftwareVoice::setPitch( F32 pitch )
+{
+   MutexHandle mutex;
+   mutex.lock( &mDevice->mMixMutex, true );
+
+   mPitch = getMax( pitch, 0.0f );
+}
+
+void SFXSoftwareVoice::setCone( F32 innerAngle, F32 outerAngle, F32 outerVolume )
+{
+   MutexHandle mutex;
+   mutex.lock( &mDevice->mMixMutex, true );
+
+   mConeInnerAngle = innerAngle;
+   mConeOuterAngle = outerAngle;
+   mConeOuterVolume = outerVolume;
+}
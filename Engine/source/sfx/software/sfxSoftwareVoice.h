@@ -0,0 +1,139 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SFXSOFTWAREVOICE_H_
+#define _SFXSOFTWAREVOICE_H_
+
+#ifndef _SFXVOICE_H_
+   #include "sfx/sfxVoice.h"
+#endif
+
+
+class SFXSoftwareBuffer;
+class SFXSoftwareDevice;
+
+
+/// Voice for the software mixing device.
+///
+/// All playback state is read by the mixer thread while it holds the
+/// device's mix mutex.  Methods that move the play cursor or change the
+/// play state take the same mutex.  Plain parameters (volume, pitch,
+/// transform) are picked up by the next mixing period.
+class SFXSoftwareVoice : public SFXVoice
+{
+   public:
+
+      typedef SFXVoice Parent;
+
+      friend class SFXSoftwareDevice;
+      friend class SFXSoftwareBuffer;
+
+   protected:
+
+      /// Device-side play state.
+      enum State
+      {
+         STATE_Stopped,
+         STATE_Playing,
+         STATE_Paused,
+      };
+
+      SFXSoftwareVoice( SFXSoftwareDevice* device, SFXSoftwareBuffer* buffer, bool is3D );
+
+      /// The device that created us.
+      SFXSoftwareDevice* mDevice;
+
+      /// Whether this is a positional voice.
+      bool mIs3D;
+
+      /// Whether playback of a non-streaming voice wraps around.
+      bool mIsLooping;
+
+      /// Current device-side play state.
+      volatile State mState;
+
+      /// Play cursor in source frames.  The fractional part is the
+      /// resampling phase.  For streaming voices, this counts frames
+      /// since the buffer was last flushed.
+      F64 mCursor;
+
+      /// Integer copy of #mCursor that can be read without the mix
+      /// mutex held (used by the buffer to trim streamed data).
+      volatile U32 mCursorFrame;
+
+      F32 mVolume;
+      F32 mPitch;
+
+      /// @name 3D Parameters
+      /// @{
+
+      Point3F mPosition;
+      VectorF mVelocity;
+      VectorF mDirection;
+      F32 mMinDistance;
+      F32 mMaxDistance;
+      F32 mConeInnerAngle;
+      F32 mConeOuterAngle;
+      F32 mConeOuterVolume;
+
+      /// @}
+
+      SFXSoftwareBuffer* _getBuffer() const { return ( SFXSoftwareBuffer* ) mBuffer.getPointer(); }
+
+      ///
+      U32 _getCursorFrame() const { return mCursorFrame; }
+
+      /// Resample up to @a numFrames frames from the buffer into @a dest
+      /// advancing the cursor by @a step source frames per output frame.
+      ///
+      /// @return The number of frames written.  Less than @a numFrames if
+      ///   the voice ran out of data.
+      /// @note Called on the mixer thread with the mix mutex held.
+      U32 _render( F32* dest, U32 numFrames, F64 step );
+
+      // SFXVoice.
+      virtual SFXStatus _status() const;
+      virtual void _play();
+      virtual void _pause();
+      virtual void _stop();
+      virtual void _seek( U32 sample );
+      virtual U32 _tell() const;
+
+   public:
+
+      virtual ~SFXSoftwareVoice();
+
+      /// Is this a 3D positional voice.
+      bool is3D() const { return mIs3D; }
+
+      // SFXVoice.
+      void play( bool looping );
+      void setMinMaxDistance( F32 min, F32 max );
+      void setVelocity( const VectorF& velocity );
+      void setTransform( const MatrixF& transform );
+      void setVolume( F32 volume );
+      void setPitch( F32 pitch );
+      void setCone( F32 innerAngle, F32 outerAngle, F32 outerVolume );
+};
+
+#endif // _SFXSOFTWAREVOICE_H_
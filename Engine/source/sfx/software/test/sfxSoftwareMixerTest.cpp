@@ -0,0 +1,148 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "sfx/software/sfxSoftwareMixer.h"
+#include "sfx/software/arch/sfxSoftwareMixer.arch.h"
+#include "math/mRandom.h"
+#include "core/util/tVector.h"
+
+#if defined(TORQUE_CPU_X86) || defined(TORQUE_CPU_X64)
+
+namespace
+{
+   /// Frame counts around the four and eight float blocks of the SSE kernels.
+   const U32 sFrameCounts[] = { 0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 257 };
+   const U32 sNumFrameCounts = sizeof(sFrameCounts) / sizeof(sFrameCounts[0]);
+
+   void fillRandom(MRandomLCG &rand, Vector<F32> &samples, U32 count, F32 range)
+   {
+      samples.setSize(count);
+      for(U32 i = 0; i < count; i++)
+         samples[i] = rand.randF(-range, range);
+   }
+}
+
+TEST(SFXSoftwareMixer, MonoToStereoMatchesScalar)
+{
+   if(!(Platform::SystemInfo.processor.properties & CPU_PROP_SSE))
+      return;
+
+   MRandomLCG rand(1);
+   for(U32 i = 0; i < sNumFrameCounts; i++)
+   {
+      const U32 numFrames = sFrameCounts[i];
+
+      Vector<F32> in, scalarOut, simdOut;
+      fillRandom(rand, in, numFrames, 1.0f);
+      fillRandom(rand, scalarOut, numFrames * 2, 1.0f);
+      simdOut = scalarOut;
+
+      sfx_mix_mono_to_stereo_C(scalarOut.address(), in.address(), numFrames, 0.75f, -0.25f);
+      sfx_mix_mono_to_stereo_SSE(simdOut.address(), in.address(), numFrames, 0.75f, -0.25f);
+
+      for(U32 j = 0; j < numFrames * 2; j++)
+         EXPECT_FLOAT_EQ(scalarOut[j], simdOut[j]) << numFrames << " frames, sample " << j;
+   }
+}
+
+TEST(SFXSoftwareMixer, StereoToStereoMatchesScalar)
+{
+   if(!(Platform::SystemInfo.processor.properties & CPU_PROP_SSE))
+      return;
+
+   MRandomLCG rand(2);
+   for(U32 i = 0; i < sNumFrameCounts; i++)
+   {
+      const U32 numFrames = sFrameCounts[i];
+
+      Vector<F32> in, scalarOut, simdOut;
+      fillRandom(rand, in, numFrames * 2, 1.0f);
+      fillRandom(rand, scalarOut, numFrames * 2, 1.0f);
+      simdOut = scalarOut;
+
+      sfx_mix_stereo_to_stereo_C(scalarOut.address(), in.address(), numFrames, 0.5f, 1.5f);
+      sfx_mix_stereo_to_stereo_SSE(simdOut.address(), in.address(), numFrames, 0.5f, 1.5f);
+
+      for(U32 j = 0; j < numFrames * 2; j++)
+         EXPECT_FLOAT_EQ(scalarOut[j], simdOut[j]) << numFrames << " frames, sample " << j;
+   }
+}
+
+#if defined(TORQUE_SFX_MIXER_SSE2)
+
+TEST(SFXSoftwareMixer, ConvertToS16MatchesScalar)
+{
+   if(!(Platform::SystemInfo.processor.properties & CPU_PROP_SSE2))
+      return;
+
+   MRandomLCG rand(3);
+   for(U32 i = 0; i < sNumFrameCounts; i++)
+   {
+      // Mixed stereo samples well outside [-1,1] to exercise the clamp.
+      const U32 numSamples = sFrameCounts[i] * 2 + 1;
+
+      Vector<F32> in;
+      fillRandom(rand, in, numSamples, 4.0f);
+
+      Vector<S16> scalarOut, simdOut;
+      scalarOut.setSize(numSamples);
+      simdOut.setSize(numSamples);
+
+      sfx_convert_F32_to_S16_C(scalarOut.address(), in.address(), numSamples);
+      sfx_convert_F32_to_S16_SSE2(simdOut.address(), in.address(), numSamples);
+
+      for(U32 j = 0; j < numSamples; j++)
+         EXPECT_EQ(scalarOut[j], simdOut[j]) << numSamples << " samples, sample " << j << " = " << in[j];
+   }
+}
+
+TEST(SFXSoftwareMixer, ConvertToS16Clamps)
+{
+   if(!(Platform::SystemInfo.processor.properties & CPU_PROP_SSE2))
+      return;
+
+   // Nine samples so the last one takes the scalar remainder.
+   const F32 in[] = { -100.0f, -1.5f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1.5f, 100.0f };
+   const S16 expected[] = { -32767, -32767, -32767, -16383, 0, 16383, 32767, 32767, 32767 };
+   const U32 numSamples = sizeof(in) / sizeof(in[0]);
+
+   S16 scalarOut[numSamples];
+   S16 simdOut[numSamples];
+   sfx_convert_F32_to_S16_C(scalarOut, in, numSamples);
+   sfx_convert_F32_to_S16_SSE2(simdOut, in, numSamples);
+
+   for(U32 i = 0; i < numSamples; i++)
+   {
+      EXPECT_EQ(scalarOut[i], expected[i]) << "Sample " << i;
+      EXPECT_EQ(simdOut[i], expected[i]) << "Sample " << i;
+   }
+}
+
+#endif // TORQUE_SFX_MIXER_SSE2
+
+#endif // TORQUE_CPU_X86 || TORQUE_CPU_X64
+
+#endif
@@ -106,6 +106,10 @@ MODULE_BEGIN( ShaderGenHLSL )
       sInitDelegate.bind(_initShaderGenHLSL);
       SHADERGEN->registerInitDelegate(Direct3D9, sInitDelegate);
       SHADERGEN->registerInitDelegate(Direct3D9_360, sInitDelegate);
+
+      // The null device never compiles its shaders, but generates
+      // them so shader materials can run without a GPU.
+      SHADERGEN->registerInitDelegate(NullDevice, sInitDelegate);
    }
    
 MODULE_END;
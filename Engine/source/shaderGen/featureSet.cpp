@@ -69,6 +69,25 @@ void FeatureSet::_rebuildDesc()
    mDescription = desc.intern();
 }
 
+void FeatureSet::_rebuildHash()
+{
+   PROFILE_SCOPE( FeatureSet_RebuildHash );
+
+   // Hash the features in the same order as the description.
+   mFeatures.sort( _typeCmp );
+
+   Torque::IncrementalHash64 hash;
+   hash.addU32( mFeatures.size() );
+   for ( U32 i=0; i < mFeatures.size(); i++ )
+   {
+      hash.addU64( mFeatures[i].type->getNameHash() );
+      hash.addU32( mFeatures[i].index );
+   }
+
+   // Zero marks the hash as dirty.
+   mHash = hash.getHash() ? hash.getHash() : 1;
+}
+
 const FeatureType& FeatureSet::getAt( U32 index, S32 *outIndex ) const 
 {
    // We want to make sure we access the features in the
@@ -84,7 +103,7 @@ const FeatureType& FeatureSet::getAt( U32 index, S32 *outIndex ) const
 
 void FeatureSet::clear()
 {
-   mDescription.clear();
+   _setDirty();
    mFeatures.clear();
 }
 
@@ -121,7 +140,7 @@ void FeatureSet::setFeature( const FeatureType &type, bool set, S32 index )
          else
          {
             mFeatures.erase_fast( i );
-            mDescription.clear();
+            _setDirty();
             return;
          }
       }
@@ -135,7 +154,7 @@ void FeatureSet::setFeature( const FeatureType &type, bool set, S32 index )
    info.index = index;
    mFeatures.push_back( info );
 
-   mDescription.clear();
+   _setDirty();
 }
 
 void FeatureSet::addFeature( const FeatureType &type, S32 index )
@@ -153,7 +172,7 @@ void FeatureSet::addFeature( const FeatureType &type, S32 index )
    info.index = index;
    mFeatures.push_back( info );
 
-   mDescription.clear();
+   _setDirty();
 }
 
 void FeatureSet::removeFeature( const FeatureType &type )
@@ -164,7 +183,7 @@ void FeatureSet::removeFeature( const FeatureType &type )
       if ( info.type == &type )
       {
          mFeatures.erase_fast( i );
-         mDescription.clear();
+         _setDirty();
          return;
       }
    }
@@ -194,7 +213,7 @@ void FeatureSet::filter( const FeatureSet &features )
          i++;
    }
 
-   mDescription.clear();
+   _setDirty();
 }
 
 void FeatureSet::exclude( const FeatureSet &features )
@@ -204,7 +223,7 @@ void FeatureSet::exclude( const FeatureSet &features )
    for ( U32 i=0; i < features.mFeatures.size(); i++ )
       removeFeature( *features.mFeatures[i].type );
 
-   mDescription.clear();
+   _setDirty();
 }
 
 void FeatureSet::merge( const FeatureSet &features )
@@ -215,6 +234,7 @@ void FeatureSet::merge( const FeatureSet &features )
    {
       mFeatures.merge( features.mFeatures );
       mDescription = features.mDescription;
+      mHash = features.mHash;
       return;
    }
 
@@ -51,21 +51,37 @@ protected:
    /// features used for comparisons.
    String mDescription;
 
+   /// A hash of the features or zero if it 
+   /// needs to be rebuilt.
+   U64 mHash;
+
    ///
    static S32 _typeCmp( const FeatureInfo* a, const FeatureInfo *b );
 
    ///
    void _rebuildDesc();
 
+   ///
+   void _rebuildHash();
+
+   /// Called when the features change.
+   void _setDirty()
+   {
+      mDescription.clear();
+      mHash = 0;
+   }
+
 public:
 
    FeatureSet()
+      :  mHash( 0 )
    {
    }
 
    FeatureSet( const FeatureSet &h )
       :  mFeatures( h.mFeatures ),
-         mDescription( h.mDescription ) 
+         mDescription( h.mDescription ),
+         mHash( h.mHash )
    {
    }
 
@@ -86,6 +102,11 @@ public:
    /// Return the description string which uniquely identifies this feature set.
    const String& getDescription() const;
 
+   /// Returns a hash which uniquely identifies this feature set.  Unlike
+   /// the description this doesn't need to build a string and it is the
+   /// same from run to run.
+   U64 getHash() const;
+
    /// Returns the feature count.
    U32 getCount() const { return mFeatures.size(); }
 
@@ -135,4 +156,12 @@ inline const String& FeatureSet::getDescription() const
    return mDescription;
 }
 
+inline U64 FeatureSet::getHash() const
+{
+   if ( mHash == 0 )
+      const_cast<FeatureSet*>(this)->_rebuildHash();
+
+   return mHash;
+}
+
 #endif // _FEATURESET_H_
@@ -24,6 +24,7 @@
 #include "shaderGen/featureType.h"
 
 #include "shaderGen/featureSet.h"
+#include "core/util/hashFunction.h"
 
 FeatureTypeVector& FeatureType::_getTypes()
 {
@@ -44,6 +45,18 @@ void FeatureType::addDefaultTypes( FeatureSet *outFeatures )
    }   
 }
 
+const FeatureType* FeatureType::findByName( const char *name )
+{
+   const FeatureTypeVector &types = _getTypes();
+   for ( U32 i=0; i < types.size(); i++ )
+   {
+      if ( types[i]->getName().equal( name ) )
+         return types[i];
+   }
+
+   return NULL;
+}
+
 FeatureType::FeatureType( const char *name, U32 group, F32 order, bool isDefault )
    :  mName( name ),
       mGroup( group ),
@@ -57,6 +70,10 @@ FeatureType::FeatureType( const char *name, U32 group, F32 order, bool isDefault
          AssertFatal( !mName.equal( types[i]->getName() ), "FeatureType - This feature already exists!" );
    #endif
 
+   Torque::IncrementalHash64 hash;
+   hash.addString( name );
+   mNameHash = hash.getHash();
+
    mId = types.size();
    types.push_back( this );
 }
@@ -52,6 +52,10 @@ protected:
    /// A unique feature id value.
    U32 mId;
 
+   /// A hash of the name which, unlike the id, is the
+   /// same from run to run.
+   U64 mNameHash;
+
    /// The group is used to orginize the types.
    U32 mGroup;
 
@@ -70,6 +74,9 @@ public:
    /// Adds all the default features types to the set.
    static void addDefaultTypes( FeatureSet *outFeatures );
 
+   /// Returns the feature type with this name or NULL.
+   static const FeatureType* findByName( const char *name );
+
    /// You should not use this constructor directly.
    /// @see DeclareFeatureType
    /// @see ImplementFeatureType
@@ -86,6 +93,8 @@ public:
 
    U32 getId() const { return mId; }
 
+   U64 getNameHash() const { return mNameHash; }
+
    U32 getGroup() const { return mGroup; }
 
    F32 getOrder() const { return mOrder; }
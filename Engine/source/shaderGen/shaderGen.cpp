@@ -25,11 +25,16 @@
 
 #include "shaderGen/conditionerFeature.h"
 #include "core/stream/fileStream.h"
+#include "core/stream/memStream.h"
 #include "shaderGen/featureMgr.h"
 #include "shaderGen/shaderOp.h"
 #include "gfx/gfxDevice.h"
 #include "core/memVolume.h"
 #include "core/module.h"
+#include "materials/materialFeatureTypes.h"
+#include "core/util/hashFunction.h"
+#include "core/strings/stringUnit.h"
+#include "console/engineAPI.h"
 
 
 MODULE_BEGIN( ShaderGen )
@@ -50,6 +55,7 @@ MODULE_BEGIN( ShaderGen )
 MODULE_END;
 
 
+
 ShaderGen::ShaderGen()
 {
    mInit = false;
@@ -163,6 +169,8 @@ void ShaderGen::generateShader( const MaterialFeatureData &featureData,
    // this needs to change - need to optimize down to ps v.1.1
    *pixVersion = GFX->getPixelShaderVersion();
    
+   mInstancingFormat.clear();
+
    if ( !Con::getBoolVariable( "ShaderGen::GenNewShaders", true ) )
    {
       // If we are not regenerating the shader we will return here.
@@ -174,39 +182,57 @@ void ShaderGen::generateShader( const MaterialFeatureData &featureData,
       return;
    }
 
+   // The sources are generated into memory and the cached files are
+   // only rewritten when their contents differ, so a cached source is
+   // reused for exactly as long as the features generate the same code.
+
    // create vertex shader
    //------------------------
-   FileStream* s = new FileStream();
-   if(!s->open(vertShaderName, Torque::FS::File::Write ))
-   {
-      AssertFatal(false, "Failed to open Shader Stream" );
-      return;
-   }
-
+   MemStream vertStream( 4096 );
    mOutput = new MultiLine;
-   mInstancingFormat.clear();
    _processVertFeatures(macros);
-   _printVertShader( *s );
-   delete s;
+   _printVertShader( vertStream );
    
    ((ShaderConnector*)mComponents[C_CONNECTOR])->reset();
    LangElement::deleteElements();
 
    // create pixel shader
    //------------------------
-   s = new FileStream();
-   if(!s->open(pixShaderName, Torque::FS::File::Write ))
-   {
-      AssertFatal(false, "Failed to open Shader Stream" );
-      return;
-   }   
-
+   MemStream pixStream( 4096 );
    mOutput = new MultiLine;
    _processPixFeatures(macros);
-   _printPixShader( *s );
+   _printPixShader( pixStream );
 
-   delete s;
    LangElement::deleteElements();
+
+   _writeCachedSource( vertShaderName, vertStream );
+   _writeCachedSource( pixShaderName, pixStream );
+}
+
+bool ShaderGen::_writeCachedSource( const char *fileName, MemStream &source )
+{
+   const U32 size = source.getStreamSize();
+
+   void *cached = NULL;
+   U32 cachedSize = 0;
+   if ( Torque::FS::ReadFile( fileName, cached, cachedSize ) )
+   {
+      const bool unchanged = cachedSize == size && 
+                             ( size == 0 || dMemcmp( cached, source.getBuffer(), size ) == 0 );
+      delete [] (U8*)cached;
+
+      if ( unchanged )
+         return true;
+   }
+
+   FileStream stream;
+   if ( !stream.open( fileName, Torque::FS::File::Write ) )
+   {
+      AssertFatal( false, "Failed to open Shader Stream" );
+      return false;
+   }
+
+   return stream.write( size, source.getBuffer() );
 }
 
 void ShaderGen::_init()
@@ -450,31 +476,25 @@ GFXShader* ShaderGen::getShader( const MaterialFeatureData &featureData, const G
 
    const FeatureSet &features = featureData.codify();
 
-   // Build a description string from the features
-   // and vertex format combination ( and macros ).
-   String shaderDescription = vertexFormat->getDescription() + features.getDescription();
-   if ( macros && !macros->empty() )
-   {
-      String macroStr;
-      GFXShaderMacro::stringize( *macros, &macroStr );
-      shaderDescription += macroStr;
-   }
-
-   // Generate a single 64bit hash from the description string.
+   // Hash the features and vertex format combination ( and 
+   // macros ) into a single 64bit key without building strings.
    //
    // Don't get paranoid!  This has 1 in 18446744073709551616
    // chance for collision... it won't happen in this lifetime.
    //
-   U64 hash = Torque::hash64( (const U8*)shaderDescription.c_str(), shaderDescription.length(), 0 );
-   hash = convertHostToLEndian(hash);
-   U32 high = (U32)( hash >> 32 );
-   U32 low = (U32)( hash & 0x00000000FFFFFFFF );
-   String cacheKey = String::ToString( "%x%x", high, low );
+   const U64 cacheKey = _getCacheKey( features, vertexFormat, macros );
 
    // return shader if exists
-   GFXShader *match = mProcShaders[cacheKey];
-   if ( match )
-      return match;
+   ShaderMap::Iterator iter = mProcShaders.find( cacheKey );
+   if ( iter != mProcShaders.end() )
+      return iter->value;
+
+   if ( !mPermutations.contains( cacheKey ) )
+      mPermutations.insert( cacheKey, _describePermutation( featureData, vertexFormat, macros ) );
+
+   // The key is also used to name the cached shader files.
+   char cacheName[32];
+   dSprintf( cacheName, sizeof( cacheName ), "%08x%08x", (U32)( cacheKey >> 32 ), (U32)cacheKey );
 
    // if not, then create it
    char vertFile[256];
@@ -485,7 +505,7 @@ GFXShader* ShaderGen::getShader( const MaterialFeatureData &featureData, const G
    shaderMacros.push_back( GFXShaderMacro( "TORQUE_SHADERGEN" ) );
    if ( macros )
       shaderMacros.merge( *macros );
-   generateShader( featureData, vertFile, pixFile, &pixVersion, vertexFormat, cacheKey, shaderMacros );
+   generateShader( featureData, vertFile, pixFile, &pixVersion, vertexFormat, cacheName, shaderMacros );
 
    GFXShader *shader = GFX->createShader();
    shader->mInstancingFormat.copy( mInstancingFormat ); // TODO: Move to init() below!
@@ -506,3 +526,222 @@ void ShaderGen::flushProceduralShaders()
    // just need to clear the map.
    mProcShaders.clear();  
 }
+
+U64 ShaderGen::_getCacheKey(  const FeatureSet &features, 
+                              const GFXVertexFormat *vertexFormat, 
+                              const Vector<GFXShaderMacro> *macros )
+{
+   Torque::IncrementalHash64 hash;
+   hash.addU64( vertexFormat->getHash() );
+   hash.addU64( features.getHash() );
+
+   if ( macros )
+   {
+      for ( U32 i=0; i < macros->size(); i++ )
+      {
+         hash.addString( (*macros)[i].name.c_str() );
+         hash.addString( (*macros)[i].value.c_str() );
+      }
+   }
+
+   return hash.getHash();
+}
+
+String ShaderGen::_describePermutation(   const MaterialFeatureData &featureData, 
+                                          const GFXVertexFormat *vertexFormat, 
+                                          const Vector<GFXShaderMacro> *macros )
+{
+   // The sections are separated by '|' in the order of
+   // features, material features, vertex elements and macros.
+   String desc;
+
+   const FeatureSet *sets[2] = { &featureData.features, &featureData.materialFeatures };
+   for ( U32 i=0; i < 2; i++ )
+   {
+      for ( U32 j=0; j < sets[i]->getCount(); j++ )
+      {
+         S32 index;
+         const FeatureType &type = sets[i]->getAt( j, &index );
+         desc += String::ToString( "%s:%d ", type.getName().c_str(), index );
+      }
+      desc += "|";
+   }
+
+   for ( U32 i=0; i < vertexFormat->getElementCount(); i++ )
+   {
+      const GFXVertexElement &element = vertexFormat->getElement( i );
+      desc += String::ToString( "%d,%s,%d,%d ",   element.getStreamIndex(),
+                                                   element.getSemantic().c_str(),
+                                                   element.getSemanticIndex(),
+                                                   element.getType() );
+   }
+   desc += "|";
+
+   if ( macros )
+      GFXShaderMacro::stringize( *macros, &desc );
+
+   return desc;
+}
+
+bool ShaderGen::_parsePermutation(  const char *desc,
+                                    MaterialFeatureData *outFeatureData, 
+                                    GFXVertexFormat *outVertexFormat, 
+                                    Vector<GFXShaderMacro> *outMacros )
+{
+   char section[4096];
+   char unit[256];
+   char field[256];
+
+   FeatureSet *sets[2] = { &outFeatureData->features, &outFeatureData->materialFeatures };
+   for ( U32 i=0; i < 2; i++ )
+   {
+      StringUnit::getUnit( desc, i, "|", section, sizeof( section ) );
+      const U32 count = StringUnit::getUnitCount( section, " " );
+      for ( U32 j=0; j < count; j++ )
+      {
+         StringUnit::getUnit( section, j, " ", unit, sizeof( unit ) );
+         if ( unit[0] == 0 )
+            continue;
+
+         StringUnit::getUnit( unit, 0, ":", field, sizeof( field ) );
+         const FeatureType *type = FeatureType::findByName( field );
+         if ( !type )
+         {
+            Con::errorf( "ShaderGen - Unknown feature '%s'!", field );
+            return false;
+         }
+
+         sets[i]->addFeature( *type, dAtoi( StringUnit::getUnit( unit, 1, ":", field, sizeof( field ) ) ) );
+      }
+   }
+
+   StringUnit::getUnit( desc, 2, "|", section, sizeof( section ) );
+   const U32 elementCount = StringUnit::getUnitCount( section, " " );
+   for ( U32 i=0; i < elementCount; i++ )
+   {
+      StringUnit::getUnit( section, i, " ", unit, sizeof( unit ) );
+      if ( unit[0] == 0 )
+         continue;
+
+      const U32 stream = dAtoi( StringUnit::getUnit( unit, 0, ",", field, sizeof( field ) ) );
+      const U32 index = dAtoi( StringUnit::getUnit( unit, 2, ",", field, sizeof( field ) ) );
+      const GFXDeclType type = (GFXDeclType)dAtoi( StringUnit::getUnit( unit, 3, ",", field, sizeof( field ) ) );
+      outVertexFormat->addElement( StringUnit::getUnit( unit, 1, ",", field, sizeof( field ) ), type, index, stream );
+   }
+
+   StringUnit::getUnit( desc, 3, "|", section, sizeof( section ) );
+   const U32 macroCount = StringUnit::getUnitCount( section, ";" );
+   for ( U32 i=0; i < macroCount; i++ )
+   {
+      StringUnit::getUnit( section, i, ";", unit, sizeof( unit ) );
+      if ( unit[0] == 0 )
+         continue;
+
+      char *value = dStrchr( unit, '=' );
+      if ( value )
+         *value++ = 0;
+
+      outMacros->push_back( GFXShaderMacro( unit, value ? value : "" ) );
+   }
+
+   return true;
+}
+
+bool ShaderGen::savePermutations( const char *fileName )
+{
+   FileStream stream;
+   if ( !stream.open( fileName, Torque::FS::File::Write ) )
+   {
+      Con::errorf( "ShaderGen::savePermutations - Failed to open '%s'!", fileName );
+      return false;
+   }
+
+   PermutationMap::Iterator iter = mPermutations.begin();
+   for ( ; iter != mPermutations.end(); ++iter )
+      stream.writeLine( (const U8*)iter->value.c_str() );
+
+   Con::printf( "ShaderGen - Saved %d shader permutations to '%s'.", mPermutations.size(), fileName );
+   return true;
+}
+
+S32 ShaderGen::precompilePermutations( const char *fileName )
+{
+   PROFILE_SCOPE( ShaderGen_PrecompilePermutations );
+
+   if ( !mInit )
+   {
+      Con::errorf( "ShaderGen::precompilePermutations - ShaderGen is not initialized!" );
+      return -1;
+   }
+
+   FileStream stream;
+   if ( !stream.open( fileName, Torque::FS::File::Read ) )
+   {
+      Con::errorf( "ShaderGen::precompilePermutations - Failed to open '%s'!", fileName );
+      return -1;
+   }
+
+   // Generation shares the ShaderGen components and the 
+   // LangElement lists so it happens one shader at a time.
+   const U32 startTime = Platform::getRealMilliseconds();
+   S32 count = 0;
+   char line[4096];
+
+   while ( stream.getStatus() == Stream::Ok )
+   {
+      stream.readLine( (U8*)line, sizeof( line ) );
+      if ( line[0] == 0 )
+         continue;
+
+      MaterialFeatureData featureData;
+      GFXVertexFormat vertexFormat;
+      Vector<GFXShaderMacro> macros;
+      if ( !_parsePermutation( line, &featureData, &vertexFormat, &macros ) )
+         continue;
+
+      const U64 cacheKey = _getCacheKey( featureData.features, &vertexFormat, &macros );
+      char cacheName[32];
+      dSprintf( cacheName, sizeof( cacheName ), "%08x%08x", (U32)( cacheKey >> 32 ), (U32)cacheKey );
+
+      char vertFile[256];
+      char pixFile[256];
+      F32  pixVersion;
+
+      Vector<GFXShaderMacro> shaderMacros;
+      shaderMacros.push_back( GFXShaderMacro( "TORQUE_SHADERGEN" ) );
+      shaderMacros.merge( macros );
+      generateShader( featureData, vertFile, pixFile, &pixVersion, &vertexFormat, cacheName, shaderMacros );
+
+      if ( !mPermutations.contains( cacheKey ) )
+         mPermutations.insert( cacheKey, line );
+
+      count++;
+   }
+
+   Con::printf( "ShaderGen - Precompiled %d shader permutations in %d ms.", 
+      count, Platform::getRealMilliseconds() - startTime );
+
+   return count;
+}
+
+DefineEngineFunction( saveShaderPermutations, bool, ( const char *fileName ),,
+   "@brief Writes every procedural shader permutation generated this session to a file.\n\n"
+   "The file can be passed to precompileShaders() to fill the shader cache ahead of time.\n"
+   "@param fileName The file to write.\n"
+   "@return True if the file was written.\n"
+   "@ingroup Shaders" )
+{
+   return SHADERGEN->savePermutations( fileName );
+}
+
+DefineEngineFunction( precompileShaders, S32, ( const char *fileName ),,
+   "@brief Generates the procedural shader sources for the permutations in a file "
+   "written by saveShaderPermutations() into the shader cache.\n\n"
+   "Sources that are already cached with the same contents are left untouched.  "
+   "This requires an initialized GFX device.\n"
+   "@param fileName The permutation file to read.\n"
+   "@return The number of shaders generated or -1 on failure.\n"
+   "@ingroup Shaders" )
+{
+   return SHADERGEN->precompilePermutations( fileName );
+}
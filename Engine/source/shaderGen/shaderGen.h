@@ -47,6 +47,7 @@
 #include "materials/materialFeatureData.h"
 #endif
 
+class MemStream;
 
 /// Base class used by shaderGen to be API agnostic.  Subclasses implement the various methods
 /// in an API specific way.
@@ -165,6 +166,17 @@ public:
    void setComponentFactory(ShaderGenComponentFactory* factory) { mComponentFactory = factory; }
    void setFileEnding(String ending) { mFileEnding = ending; }
 
+   /// Writes every feature, vertex format and macro permutation that 
+   /// has been requested from getShader this session to a text file 
+   /// which can later be passed to precompilePermutations.
+   bool savePermutations( const char *fileName );
+
+   /// Generates the shader sources for every permutation in a file 
+   /// written by savePermutations into the shader cache.
+   ///
+   /// @return The number of shaders generated or -1 on failure.
+   S32 precompilePermutations( const char *fileName );
+
 protected:   
 
    friend class ManagedSingleton<ShaderGen>;
@@ -191,10 +203,15 @@ protected:
    bool mRegisteredWithGFX;
    Torque::FS::FileSystemRef mMemFS;
    
-   /// Map of cache string -> shaders
-   typedef Map<String, GFXShaderRef> ShaderMap;
+   /// Map of cache key -> shaders
+   typedef Map<U64, GFXShaderRef> ShaderMap;
    ShaderMap mProcShaders;
 
+   /// Map of cache key -> permutation description for 
+   /// every shader generated this session.
+   typedef Map<U64, String> PermutationMap;
+   PermutationMap mPermutations;
+
    ShaderGen();
 
    bool _handleGFXEvent(GFXDevice::GFXDeviceEventType event);
@@ -205,6 +222,28 @@ protected:
    void _init();
    void _uninit();
 
+   /// Returns the binary cache key for a feature, vertex format and 
+   /// macro combination.  This is the same from run to run.
+   static U64 _getCacheKey(   const FeatureSet &features, 
+                              const GFXVertexFormat *vertexFormat, 
+                              const Vector<GFXShaderMacro> *macros );
+
+   /// Returns a description of the permutation which can be parsed 
+   /// by _parsePermutation.
+   static String _describePermutation( const MaterialFeatureData &featureData, 
+                                       const GFXVertexFormat *vertexFormat, 
+                                       const Vector<GFXShaderMacro> *macros );
+
+   /// Parses a line written by _describePermutation.
+   static bool _parsePermutation(   const char *desc,
+                                    MaterialFeatureData *outFeatureData, 
+                                    GFXVertexFormat *outVertexFormat, 
+                                    Vector<GFXShaderMacro> *outMacros );
+
+   /// Writes a generated source to the shader cache unless the cached
+   /// file already has the same contents.
+   bool _writeCachedSource( const char *fileName, MemStream &source );
+
    /// Creates all the various shader components that will be filled in when 
    /// the shader features are processed.
    void _createComponents();
@@ -0,0 +1,113 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "shaderGen/featureSet.h"
+#include "shaderGen/featureType.h"
+#include "materials/materialFeatureTypes.h"
+#include "gfx/gfxVertexFormat.h"
+#include "core/util/hashFunction.h"
+
+TEST(ShaderGenCacheKey, IncrementalHash)
+{
+   // FNV-1a reference values.
+   Torque::IncrementalHash64 empty;
+   EXPECT_EQ(empty.getHash(), 0xcbf29ce484222325ULL);
+
+   Torque::IncrementalHash64 a;
+   a.add("a", 1);
+   EXPECT_EQ(a.getHash(), 0xaf63dc4c8601ec8cULL);
+
+   // The string terminator keeps the pieces apart.
+   Torque::IncrementalHash64 ab_c, a_bc;
+   ab_c.addString("ab");
+   ab_c.addString("c");
+   a_bc.addString("a");
+   a_bc.addString("bc");
+   EXPECT_NE(ab_c.getHash(), a_bc.getHash());
+}
+
+TEST(ShaderGenCacheKey, FeatureSetHash)
+{
+   FeatureSet a;
+   a.addFeature(MFT_DiffuseMap);
+   a.addFeature(MFT_NormalMap);
+   a.addFeature(MFT_DetailMap, 1);
+
+   // The order features are added in doesn't matter.
+   FeatureSet b;
+   b.addFeature(MFT_DetailMap, 1);
+   b.addFeature(MFT_NormalMap);
+   b.addFeature(MFT_DiffuseMap);
+   EXPECT_EQ(a.getHash(), b.getHash());
+   EXPECT_TRUE(a == b);
+
+   // Copies keep the hash.
+   FeatureSet c(a);
+   EXPECT_EQ(c.getHash(), a.getHash());
+   c = b;
+   EXPECT_EQ(c.getHash(), a.getHash());
+
+   // Changing the index or the features changes the hash.
+   b.removeFeature(MFT_DetailMap);
+   EXPECT_NE(a.getHash(), b.getHash());
+   b.addFeature(MFT_DetailMap, 2);
+   EXPECT_NE(a.getHash(), b.getHash());
+   b.removeFeature(MFT_DetailMap);
+   b.addFeature(MFT_DetailMap, 1);
+   EXPECT_EQ(a.getHash(), b.getHash());
+
+   b.clear();
+   EXPECT_NE(a.getHash(), b.getHash());
+   EXPECT_NE(b.getHash(), 0);
+}
+
+TEST(ShaderGenCacheKey, VertexFormatHash)
+{
+   GFXVertexFormat a;
+   a.addElement(GFXSemantic::POSITION, GFXDeclType_Float3);
+   a.addElement(GFXSemantic::TEXCOORD, GFXDeclType_Float2, 0);
+
+   GFXVertexFormat b;
+   b.addElement(GFXSemantic::POSITION, GFXDeclType_Float3);
+   b.addElement(GFXSemantic::TEXCOORD, GFXDeclType_Float2, 0);
+   EXPECT_EQ(a.getHash(), b.getHash());
+
+   GFXVertexFormat c(a);
+   EXPECT_EQ(c.getHash(), a.getHash());
+
+   // Element order, index, type and stream all matter.
+   GFXVertexFormat d;
+   d.addElement(GFXSemantic::POSITION, GFXDeclType_Float3);
+   d.addElement(GFXSemantic::TEXCOORD, GFXDeclType_Float2, 1);
+   EXPECT_NE(a.getHash(), d.getHash());
+
+   b.addElement(GFXSemantic::NORMAL, GFXDeclType_Float3, 0, 1);
+   EXPECT_NE(a.getHash(), b.getHash());
+   a.addElement(GFXSemantic::NORMAL, GFXDeclType_Float3, 0, 0);
+   EXPECT_NE(a.getHash(), b.getHash());
+}
+
+#endif
@@ -0,0 +1,206 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "sim/netClassStats.h"
+
+#include "sim/netConnection.h"
+#include "core/stream/fileStream.h"
+#include "console/consoleTypes.h"
+#include "console/engineAPI.h"
+
+bool NetClassStats::smEnabled = false;
+NetClassStats NetClassStats::smTotals;
+
+void NetClassStats::Entry::reset()
+{
+   numWrites = 0;
+   bitsWritten = 0;
+   writeMicroseconds = 0;
+   numReads = 0;
+   bitsRead = 0;
+   readMicroseconds = 0;
+
+   for(U32 i = 0; i < NumMaskBits; i++)
+   {
+      maskWrites[i] = 0;
+      maskBits[i] = 0;
+   }
+}
+
+void NetClassStats::recordWrite(AbstractClassRep *rep, U32 mask, U32 bits, U32 microseconds)
+{
+   Entry &entry = mEntries.findOrInsert(rep)->value;
+   entry.numWrites++;
+   entry.bitsWritten += bits;
+   entry.writeMicroseconds += microseconds;
+
+   for(U32 i = 0; mask; i++, mask >>= 1)
+   {
+      if(mask & 1)
+      {
+         entry.maskWrites[i]++;
+         entry.maskBits[i] += bits;
+      }
+   }
+}
+
+void NetClassStats::recordRead(AbstractClassRep *rep, U32 bits, U32 microseconds)
+{
+   Entry &entry = mEntries.findOrInsert(rep)->value;
+   entry.numReads++;
+   entry.bitsRead += bits;
+   entry.readMicroseconds += microseconds;
+}
+
+const NetClassStats::Entry* NetClassStats::find(AbstractClassRep *rep) const
+{
+   EntryTable::ConstIterator itr = mEntries.find(rep);
+   return itr != mEntries.end() ? &itr->value : NULL;
+}
+
+static S32 QSORT_CALLBACK compareEntryBits(const NetClassStats::EntryTable::Pair* const *a, const NetClassStats::EntryTable::Pair* const *b)
+{
+   const U64 bitsA = (*a)->value.bitsWritten + (*a)->value.bitsRead;
+   const U64 bitsB = (*b)->value.bitsWritten + (*b)->value.bitsRead;
+   return bitsA < bitsB ? 1 : (bitsA > bitsB ? -1 : 0);
+}
+
+void NetClassStats::_sortEntries(Vector<const EntryTable::Pair*> &entries) const
+{
+   entries.clear();
+   entries.reserve(mEntries.size());
+   for(EntryTable::ConstIterator itr = mEntries.begin(); itr != mEntries.end(); ++itr)
+      entries.push_back(&(*itr));
+   entries.sort(compareEntryBits);
+}
+
+void NetClassStats::print(U32 maxClasses) const
+{
+   Vector<const EntryTable::Pair*> entries;
+   _sortEntries(entries);
+
+   Con::printf("   %-32s %8s %12s %8s %10s %8s %12s %10s", "class", "sent", "bits", "avg", "pack ms", "received", "bits", "unpack ms");
+   for(U32 i = 0; i < entries.size() && i < maxClasses; i++)
+   {
+      const Entry &entry = entries[i]->value;
+      Con::printf("   %-32s %8d %12.0f %8.1f %10.2f %8d %12.0f %10.2f",
+         entries[i]->key->getClassName(),
+         entry.numWrites, F64(entry.bitsWritten),
+         entry.numWrites ? F64(entry.bitsWritten) / entry.numWrites : 0.0,
+         entry.writeMicroseconds / 1000.0,
+         entry.numReads, F64(entry.bitsRead),
+         entry.readMicroseconds / 1000.0);
+   }
+}
+
+bool NetClassStats::writeCSV(const char *fileName) const
+{
+   FileStream stream;
+   if(!stream.open(fileName, Torque::FS::File::Write))
+   {
+      Con::errorf("NetClassStats::writeCSV - could not open '%s' for writing", fileName);
+      return false;
+   }
+
+   Vector<const EntryTable::Pair*> entries;
+   _sortEntries(entries);
+
+   // A mask bit of -1 is the row for the whole class.
+   stream.writeLine((const U8*)"class,type,maskBit,sent,bitsSent,packMicroseconds,received,bitsReceived,unpackMicroseconds");
+
+   char buffer[512];
+   for(U32 i = 0; i < entries.size(); i++)
+   {
+      AbstractClassRep *rep = entries[i]->key;
+      const Entry &entry = entries[i]->value;
+      const char *type = rep->mClassType == NetClassTypeObject ? "object" :
+                         (rep->mClassType == NetClassTypeDataBlock ? "datablock" : "event");
+
+      dSprintf(buffer, sizeof(buffer), "%s,%s,-1,%d,%.0f,%.0f,%d,%.0f,%.0f", rep->getClassName(), type,
+         entry.numWrites, F64(entry.bitsWritten), F64(entry.writeMicroseconds),
+         entry.numReads, F64(entry.bitsRead), F64(entry.readMicroseconds));
+      stream.writeLine((const U8*)buffer);
+
+      for(U32 j = 0; j < NumMaskBits; j++)
+      {
+         if(!entry.maskWrites[j])
+            continue;
+
+         dSprintf(buffer, sizeof(buffer), "%s,%s,%d,%d,%.0f,,,,", rep->getClassName(), type, j,
+            entry.maskWrites[j], F64(entry.maskBits[j]));
+         stream.writeLine((const U8*)buffer);
+      }
+   }
+
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+DefineEngineFunction( dumpNetClassStats, bool, ( const char *fileName, NetConnection *connection ), ( "", NULL ),
+   "@brief Reports the bits sent and received and the time spent packing and unpacking, per network class.\n\n"
+
+   "Stats are only collected while @$Net::collectClassStats is true.\n\n"
+
+   "@param fileName If empty, the classes that used the most bandwidth are printed to the console.  "
+   "Otherwise all of them are written to this CSV file, along with the updates and bits per mask bit.\n"
+   "@param connection The connection to report on.  If not given, all connections together are reported.\n"
+   "@return False if the file could not be written.\n"
+
+   "@see resetNetClassStats()\n"
+   "@ingroup Networking\n" )
+{
+   const NetClassStats *stats = &NetClassStats::smTotals;
+   if(connection)
+      stats = connection->getClassStats();
+
+   if(!fileName || !fileName[0])
+   {
+      Con::printf("Network class stats for %s:", connection ? connection->getIdString() : "all connections");
+      if(stats)
+         stats->print(20);
+      return true;
+   }
+
+   char expanded[1024];
+   Con::expandScriptFilename(expanded, sizeof(expanded), fileName);
+
+   if(!stats)
+   {
+      NetClassStats empty;
+      return empty.writeCSV(expanded);
+   }
+   return stats->writeCSV(expanded);
+}
+
+DefineEngineFunction( resetNetClassStats, void, (),,
+   "@brief Clears the network class stats of all connections.\n\n"
+
+   "@see dumpNetClassStats()\n"
+   "@ingroup Networking\n" )
+{
+   NetClassStats::smTotals.reset();
+   for(NetConnection *walk = NetConnection::getConnectionList(); walk; walk = walk->getNext())
+      walk->resetClassStats();
+}
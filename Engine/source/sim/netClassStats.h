@@ -0,0 +1,103 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _NETCLASSSTATS_H_
+#define _NETCLASSSTATS_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _TDICTIONARY_H_
+#include "core/util/tDictionary.h"
+#endif
+
+class AbstractClassRep;
+
+/// Bandwidth and time spent packing and unpacking, per NetObject and
+/// NetEvent class.
+///
+/// Every NetConnection keeps its own table while collection is turned on
+/// with $Net::collectClassStats, and everything also adds up in
+/// NetClassStats::smTotals.  Unlike the TORQUE_NET_STATS counters this is
+/// compiled into every build, so it can be turned on on a live server.
+///
+/// @see dumpNetClassStats()
+class NetClassStats
+{
+public:
+
+   enum
+   {
+      NumMaskBits = 32,
+   };
+
+   struct Entry
+   {
+      U32 numWrites;          ///< Updates or events packed.
+      U64 bitsWritten;
+      U64 writeMicroseconds;  ///< Time spent in packUpdate or pack.
+
+      U32 numReads;           ///< Updates or events unpacked.
+      U64 bitsRead;
+      U64 readMicroseconds;   ///< Time spent in unpackUpdate or unpack.
+
+      /// Updates with each mask bit set and the bits they took.  An update
+      /// counts fully towards every bit that was set in it.
+      U32 maskWrites[NumMaskBits];
+      U64 maskBits[NumMaskBits];
+
+      Entry() { reset(); }
+      void reset();
+   };
+
+   /// Turns collection on and off for all connections.
+   static bool smEnabled;
+
+   /// Stats of all connections together.
+   static NetClassStats smTotals;
+
+   typedef HashTable<AbstractClassRep*, Entry> EntryTable;
+
+   void recordWrite(AbstractClassRep *rep, U32 mask, U32 bits, U32 microseconds);
+   void recordRead(AbstractClassRep *rep, U32 bits, U32 microseconds);
+
+   /// Returns the stats of a class, or NULL if nothing was recorded for it.
+   const Entry* find(AbstractClassRep *rep) const;
+
+   void reset() { mEntries.clear(); }
+
+   /// Prints the classes that sent the most bits to the console.
+   void print(U32 maxClasses) const;
+
+   /// Writes one row per class, and one per class and mask bit, to a
+   /// CSV file.
+   bool writeCSV(const char *fileName) const;
+
+private:
+
+   EntryTable mEntries;
+
+   void _sortEntries(Vector<const EntryTable::Pair*> &entries) const;
+};
+
+#endif // _NETCLASSSTATS_H_
@@ -154,6 +154,7 @@ NetConnection* NetConnection::mConnectionList = NULL;
 NetConnection* NetConnection::mHashTable[NetConnection::HashTableSize] = { NULL, };
 
 bool NetConnection::mFilesWereDownloaded = false;
+bool NetConnection::smAdaptiveRate = true;
 
 static inline U32 HashNetAddress(const NetAddress *addr)
 {
@@ -278,6 +279,48 @@ void NetConnection::consoleInit()
 
       "@ingroup Networking");
 
+   Con::addVariable("$pref::Net::IOThread", TypeBool, &Net::smUseIOThread,
+      "@brief Use a separate thread for the UDP socket I/O.\n\n"
+
+      "The thread receives and sends packets in batches, which saves a lot of system calls on "
+      "a busy server.  It is only supported on Linux, where it is on by default.  Changes take "
+      "effect the next time the port is opened.\n\n"
+
+      "@ingroup Networking");
+
+   Con::addVariable("$pref::Net::AdaptiveRate", TypeBool, &NetConnection::smAdaptiveRate,
+      "@brief Adapt the rate packets are sent to clients to the state of their link.\n\n"
+
+      "When packets to a client are dropped or its ping grows because packets are queuing up, "
+      "the server sends smaller packets, and then fewer of them, down to a quarter of the rate set "
+      "by @$pref::Net::PacketRateToClient and @$pref::Net::PacketSize.  While that leaves "
+      "less room, events may only fill half of each packet so that ghost updates keep flowing.  "
+      "The rate creeps back up while packets are getting through.  The default value is true.\n\n"
+
+      "@see NetConnection::getSendRate()\n\n"
+
+      "@ingroup Networking");
+
+   Con::addVariable("$Net::collectClassStats", TypeBool, &NetClassStats::smEnabled,
+      "@brief Collect the bits sent and received and the time spent packing and unpacking, per network class.\n\n"
+
+      "This is cheap enough to turn on on a live server.  The stats are kept per connection "
+      "and for all connections together.\n\n"
+
+      "@see dumpNetClassStats()\n"
+      "@ingroup Networking");
+
+   Con::addVariable("$pref::Net::GhostSnapshots", TypeBool, &NetConnection::smGhostSnapshots,
+      "@brief Send ghost snapshots as differences against what the client last acknowledged.\n\n"
+
+      "Objects like players pack their position and velocity as snapshots.  When this is on "
+      "the server sends only the difference against the newest snapshot of each ghost the "
+      "client has acknowledged, which is next to nothing for objects that are at rest or "
+      "moving steadily.  Turn it off to always send them against the scoping position "
+      "instead.  The default value is true.\n\n"
+
+      "@ingroup Networking");
+
    Con::addVariable("$Stats::netBitsSent", TypeS32, &gNetBitsSent,
       "@brief The number of bytes sent during the last packet send operation.\n\n"
 
@@ -312,7 +355,7 @@ void NetConnection::checkMaxRate()
    U32 packetRateToClient = gPacketRateToClient;
    U32 packetSize = gPacketSize;
 
-   if (isLocalConnection())
+   if (isLocalConnection() && !isSimulatedNetwork())
    {
       packetRateToServer = 128;
       packetRateToClient = 128;
@@ -370,6 +413,7 @@ NetConnection::NetConnection()
    mEstablished = false;
    mLastUpdateTime = 0;
    mRoundTripTime = 0;
+   mMinRoundTripTime = 0;
    mPacketLoss = 0;
    mNextTableHash = NULL;
    mSendDelayCredit = 0;
@@ -392,6 +436,12 @@ NetConnection::NetConnection()
    mMaxRate.changed = false;
    checkMaxRate();
 
+   mSendScale = 1.0f;
+   mLastSendScaleCut = 0;
+   updateSendRate();
+
+   mClassStats = NULL;
+
    // event management data:
 
    mNotifyEventList = NULL;
@@ -415,6 +465,9 @@ NetConnection::NetConnection()
    mGhostRefs = NULL;
    mGhostLookupTable = NULL;
    mLocalGhosts = NULL;
+   mLocalSnapshots = NULL;
+   mPackingRef = NULL;
+   mUnpackingGhostIndex = -1;
 
    mGhostsActive = 0;
 
@@ -448,6 +501,19 @@ NetConnection::~NetConnection()
    if(mCurrentDownloadingFile)
       delete mCurrentDownloadingFile;
 
+   if(mLocalSnapshots)
+   {
+      for(S32 i = 0; i < MaxGhostCount; i++)
+         delete[] mLocalSnapshots[i];
+      delete[] mLocalSnapshots;
+   }
+   if(mGhostRefs)
+   {
+      for(S32 i = 0; i < MaxGhostCount; i++)
+         delete[] mGhostRefs[i].sentSnapshots;
+   }
+
+   delete mClassStats;
    delete[] mLocalGhosts;
    delete[] mGhostLookupTable;
    delete[] mGhostRefs;
@@ -603,11 +669,45 @@ DefineEngineMethod( NetConnection, getPing, S32, (),,
 DefineEngineMethod( NetConnection, getPacketLoss, S32, (),,
    "@brief Returns the percentage of packets lost per tick.\n\n"
 
-   "@note This method is not yet hooked up.\n")
+   "This is a running average over roughly the last 20 packets sent.\n")
 {
    return( S32( 100 * object->getPacketLoss() ) );
 }
 
+DefineEngineMethod( NetConnection, getClassStats, String, ( const char *className ),,
+   "@brief Returns the network stats this connection collected for a class.\n\n"
+
+   "@param className Name of a NetObject or NetEvent class.\n"
+   "@return A string of the form \"sent bitsSent packMs received bitsReceived unpackMs\", or "
+   "an empty string if nothing was recorded for the class.\n\n"
+
+   "@see @$Net::collectClassStats\n"
+   "@see dumpNetClassStats()\n")
+{
+   AbstractClassRep *rep = AbstractClassRep::findClassRep( className );
+   const NetClassStats *stats = object->getClassStats();
+   const NetClassStats::Entry *entry = rep && stats ? stats->find( rep ) : NULL;
+   if( !entry )
+      return String();
+
+   return String::ToString( "%d %.0f %.2f %d %.0f %.2f",
+      entry->numWrites, F64( entry->bitsWritten ), entry->writeMicroseconds / 1000.0,
+      entry->numReads, F64( entry->bitsRead ), entry->readMicroseconds / 1000.0 );
+}
+
+DefineEngineMethod( NetConnection, getSendRate, String, (),,
+   "@brief Returns the rate this side of the connection is sending packets at.\n\n"
+
+   "On the server this includes the effect of adaptive rate control.\n\n"
+
+   "@return A string of the form \"bytesPerSecond packetSize updateDelay\", with the "
+   "packet size in bytes and the delay between packets in ms.\n\n"
+
+   "@see @$pref::Net::AdaptiveRate\n")
+{
+   return String::ToString( "%d %d %d", S32( object->getSendBudget() ), object->getSendPacketSize(), object->getSendDelay() );
+}
+
 DefineEngineMethod( NetConnection, checkMaxRate, void, (),,
    "@brief Ensures that all configured packet rates and sizes meet minimum requirements.\n\n"
 
@@ -703,16 +803,23 @@ void NetConnection::handleNotify(bool recvd)
    if(note->maxRateChanged && !recvd)
       mMaxRate.changed = true;
 
+   U32 curTime = Platform::getVirtualMilliseconds();
+   U32 roundTripTime = curTime - note->sendTime;
+
+   // Running average of packet loss over the last 20 or so packets
+   mPacketLoss = mPacketLoss * 0.95f + (recvd ? 0.0f : 0.05f);
+
    if(recvd) 
    {
       // Running average of roundTrip time
-      U32 curTime = Platform::getVirtualMilliseconds();
-      mRoundTripTime = (mRoundTripTime + (curTime - note->sendTime)) * 0.5;
+      mRoundTripTime = (mRoundTripTime + roundTripTime) * 0.5;
       packetReceived(note);
    }
    else
       packetDropped(note);
 
+   updateSendScale(recvd, roundTripTime);
+
    delete note;
 }
 
@@ -791,10 +898,98 @@ public:
    }
 };
 
+void NetConnection::recordClassWrite(AbstractClassRep *rep, U32 mask, U32 bits, U64 beginTime)
+{
+   if(!beginTime)
+      return;
+
+   const U32 microseconds = U32(Platform::getRealMicroseconds() - beginTime);
+   if(!mClassStats)
+      mClassStats = new NetClassStats;
+   mClassStats->recordWrite(rep, mask, bits, microseconds);
+   NetClassStats::smTotals.recordWrite(rep, mask, bits, microseconds);
+}
+
+void NetConnection::recordClassRead(AbstractClassRep *rep, U32 bits, U64 beginTime)
+{
+   if(!beginTime)
+      return;
+
+   const U32 microseconds = U32(Platform::getRealMicroseconds() - beginTime);
+   if(!mClassStats)
+      mClassStats = new NetClassStats;
+   mClassStats->recordRead(rep, bits, microseconds);
+   NetClassStats::smTotals.recordRead(rep, bits, microseconds);
+}
+
+void NetConnection::updateSendScale(bool recvd, U32 roundTripTime)
+{
+   if(recvd)
+   {
+      // Track the round trip time of an empty link.  Let it drift up so
+      // that a route change doesn't look like queuing forever.
+      if(!mMinRoundTripTime || roundTripTime < mMinRoundTripTime)
+         mMinRoundTripTime = roundTripTime;
+      else
+         mMinRoundTripTime += (roundTripTime - mMinRoundTripTime) / 64.0f;
+   }
+
+   // Packets are acked by the other side's next packet, so give the
+   // round trip time plenty of slack before calling it queuing.
+   const bool congested = !recvd || roundTripTime > mMinRoundTripTime * 2 + 50;
+
+   if(congested)
+   {
+      // Cut at most once per round trip; the notifies for the rest
+      // of the packets in flight were sent at the old rate.
+      const U32 curTime = Platform::getVirtualMilliseconds();
+      if(curTime - mLastSendScaleCut > getMax(U32(mRoundTripTime), (U32)100))
+      {
+         mSendScale = getMax(mSendScale * 0.75f, 0.25f);
+         mLastSendScaleCut = curTime;
+      }
+   }
+   else
+      mSendScale = getMin(mSendScale + 1.0f / 64.0f, 1.0f);
+}
+
+void NetConnection::updateSendRate()
+{
+   mSendRate.updateDelay = mCurRate.updateDelay;
+   mSendRate.packetSize = mCurRate.packetSize;
+   mSendRate.changed = false;
+   mEventBitLimit = mCurRate.packetSize << 3;
+
+   // Moves have to go out to the server on time, and local connections
+   // never lose anything.
+   if(!smAdaptiveRate || mSendScale >= 1.0f || isConnectionToServer() ||
+      (isLocalConnection() && !isSimulatedNetwork()))
+      return;
+
+   // Shrink the packets first, and once they are as small as they
+   // usefully get, send them less often.
+   S32 packetSize = S32(mCurRate.packetSize * mSendScale);
+   U32 updateDelay = mCurRate.updateDelay;
+   if(packetSize < MinAdaptivePacketSize)
+   {
+      packetSize = getMin(mCurRate.packetSize, (S32)MinAdaptivePacketSize);
+      updateDelay = U32(mCurRate.updateDelay * packetSize / (mCurRate.packetSize * mSendScale));
+   }
+
+   mSendRate.packetSize = packetSize;
+   mSendRate.updateDelay = updateDelay;
+
+   // Guaranteed events just wait for the next packet, but a
+   // starved ghost goes stale, so keep half the packet for ghosts.
+   mEventBitLimit = packetSize << 2;
+}
+
 void NetConnection::checkPacketSend(bool force)
 {
+   updateSendRate();
+
    U32 curTime = Platform::getVirtualMilliseconds();
-   U32 delay = isConnectionToServer() ? gPacketUpdateDelayToServer : mCurRate.updateDelay;
+   U32 delay = isConnectionToServer() ? gPacketUpdateDelayToServer : mSendRate.updateDelay;
 
    if(!force)
    {
@@ -811,7 +1006,7 @@ void NetConnection::checkPacketSend(bool force)
    if(windowFull())
       return;
 
-   BitStream *stream = BitStream::getPacketStream(mCurRate.packetSize);
+   BitStream *stream = BitStream::getPacketStream(mSendRate.packetSize);
    buildSendPacketHeader(stream);
 
    mLastUpdateTime = curTime;
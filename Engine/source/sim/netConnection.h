@@ -39,6 +39,9 @@
 #ifndef _H_CONNECTIONSTRINGTABLE
 #include "sim/connectionStringTable.h"
 #endif
+#ifndef _NETCLASSSTATS_H_
+#include "sim/netClassStats.h"
+#endif
 
 class NetConnection;
 class NetObject;
@@ -335,6 +338,29 @@ public:
    ConcreteClassRep<className> className::dynClassRep(#className, "Type" #className, &_smTypeId, groupMask, NetClassTypeEvent, NetEventDirClientToServer, className::getParentStaticClassRep(), &Parent::__description)
 
 
+//----------------------------------------------------------------------------
+
+/// A set of quantized ghost values for NetConnection::packSnapshot().
+///
+/// Objects that send the same handful of values in every update can pack
+/// them as a snapshot.  The connection then writes them as differences
+/// against the last snapshot of that ghost the client has acknowledged,
+/// which for an object that is at rest or moving steadily costs a bit per
+/// value.
+struct NetSnapshot
+{
+   enum
+   {
+      MaxValues = 16,
+   };
+
+   U32 id;                    ///< Per ghost sequence number, set by the connection.
+   U32 numValues;             ///< Number of values in use, zero for an empty slot.
+   S32 values[MaxValues];
+
+   NetSnapshot() : id(0), numValues(0) {}
+};
+
 //----------------------------------------------------------------------------
 
 /// Torque network connection.
@@ -424,6 +450,8 @@ public:
       GhostInfo *ghost;          ///< Reference to the GhostInfo we're from.
       GhostRef *nextRef;         ///< Next GhostRef in this packet.
       GhostRef *nextUpdateChain; ///< Next update we sent for this ghost.
+      bool hasSnapshot;          ///< True if this update sent a snapshot.
+      U32 snapshotId;            ///< Id of the snapshot sent in this update.
    };
 
    enum Constants
@@ -471,6 +499,7 @@ public:
       ConnectionToClient      = BIT(1),
       LocalClientConnection   = BIT(2),
       NetworkConnection       = BIT(3),
+      SimulatedNetwork        = BIT(4),
    };
 
 private:
@@ -486,6 +515,7 @@ private:
    U32 mLastUpdateTime; 
 
    F32 mRoundTripTime;
+   F32 mMinRoundTripTime;     ///< Round trip time without queuing, drifts up slowly.
    F32 mPacketLoss;
    U32 mSimulatedPing;
    F32 mSimulatedPacketLoss;
@@ -513,6 +543,33 @@ private:
    NetRate mCurRate;
    NetRate mMaxRate;
 
+   /// @name Adaptive rate control
+   ///
+   /// Connections to clients cut their send rate when packets are dropped
+   /// or the round trip time grows from queuing, and creep back up to
+   /// mCurRate while they are getting through.
+   /// @{
+
+   enum RateControlConstants
+   {
+      MinAdaptivePacketSize = 100,  ///< Below this, packets are sent less often instead.
+   };
+
+   F32 mSendScale;            ///< Fraction of mCurRate we're allowed to send.
+   U32 mLastSendScaleCut;     ///< Time mSendScale was last cut.
+   NetRate mSendRate;         ///< Rate we're actually sending at.
+   S32 mEventBitLimit;        ///< Bits of a packet that events may fill.
+
+   NetClassStats *mClassStats;
+
+   /// Adjust mSendScale for a notify.
+   void updateSendScale(bool recvd, U32 roundTripTime);
+
+   /// Work out mSendRate from mCurRate and mSendScale.
+   void updateSendRate();
+
+   /// @}
+
    /// If we're doing a "short circuited" connection, this stores
    /// a pointer to the other side.
    SimObjectPtr<NetConnection> mRemoteConnection;
@@ -574,9 +631,14 @@ public:
    bool isLocalConnection()            { return !mRemoteConnection.isNull() ; }
    bool isNetworkConnection()          { return mTypeFlags.test(NetworkConnection); }
 
+   /// A local connection that still uses the network rate settings, as
+   /// if its other side were a remote host.
+   bool isSimulatedNetwork()           { return mTypeFlags.test(SimulatedNetwork); }
+
    void setIsConnectionToServer()        { mTypeFlags.set(ConnectionToServer); }
    void setIsLocalClientConnection()   { mTypeFlags.set(LocalClientConnection); }
    void setNetworkConnection(bool net) { mTypeFlags.set(BitSet32(NetworkConnection), net); }
+   void setSimulatedNetwork(bool simulated) { mTypeFlags.set(BitSet32(SimulatedNetwork), simulated); }
 
    virtual void setEstablished();
 
@@ -595,6 +657,36 @@ public:
    F32 getRoundTripTime()                       { return mRoundTripTime; }
    F32 getPacketLoss()                          { return( mPacketLoss ); }
 
+   /// Size of the packets we are sending, after adaptive rate control.
+   S32 getSendPacketSize() const                { return mSendRate.packetSize; }
+
+   /// Time between the packets we are sending, after adaptive rate control.
+   U32 getSendDelay() const                     { return mSendRate.updateDelay; }
+
+   /// Bytes per second we are allowed to send, after adaptive rate control.
+   F32 getSendBudget() const                    { return mSendRate.packetSize * 1000.0f / getMax(mSendRate.updateDelay, (U32)1); }
+
+   /// If false, connections always send at the negotiated rate.
+   static bool smAdaptiveRate;
+
+   /// @name Class stats
+   /// @{
+
+   /// Returns the per class stats of this connection, or NULL if none were collected.
+   const NetClassStats* getClassStats() const { return mClassStats; }
+   void resetClassStats() { if(mClassStats) mClassStats->reset(); }
+
+   /// Starts timing a pack or unpack for the class stats, returns zero if
+   /// they are not being collected.
+   static U64 beginClassStats() { return NetClassStats::smEnabled ? Platform::getRealMicroseconds() : 0; }
+
+   /// Records a pack or unpack started with beginClassStats(), to this
+   /// connection and to the totals.
+   void recordClassWrite(AbstractClassRep *rep, U32 mask, U32 bits, U64 beginTime);
+   void recordClassRead(AbstractClassRep *rep, U32 bits, U64 beginTime);
+
+   /// @}
+
    static String mErrorBuffer;
    static void setLastError(const char *fmt,...);
 
@@ -788,6 +880,16 @@ protected:
    GhostInfo *mGhostRefs;           ///< Allocated array of ghostInfos. Null if ghostFrom is false.
    GhostInfo **mGhostLookupTable;   ///< Table indexed by object id to GhostInfo. Null if ghostFrom is false.
 
+   /// Last SnapshotWindow snapshots received for each local ghost, indexed
+   /// by ghost index and then by snapshot id.  Only allocated for ghosts that
+   /// send snapshots; null if ghostTo is false.
+   NetSnapshot **mLocalSnapshots;
+
+   GhostRef *mPackingRef;           ///< Update being written by ghostWritePacket, if any.
+   S32 mUnpackingGhostIndex;        ///< Ghost being read by ghostReadPacket, or -1.
+
+   void clearLocalSnapshots(U32 index);
+
    /// The object around which we are scoping this connection.
    ///
    /// This is usually the player object, or a related object, like a vehicle
@@ -821,7 +923,9 @@ public:
       GhostIdBitSize = 12,
       MaxGhostCount = 1 << GhostIdBitSize, //4096,
       GhostLookupTableSize = 1 << GhostIdBitSize, //4096
-      GhostIndexBitSize = 4 // number of bits GhostIdBitSize-3 fits into
+      GhostIndexBitSize = 4, // number of bits GhostIdBitSize-3 fits into
+      SnapshotIdBitSize = 4,
+      SnapshotWindow = 1 << SnapshotIdBitSize, ///< Snapshots a client keeps per ghost.
    };
 
    U32 getGhostsActive() { return mGhostsActive;};
@@ -872,6 +976,22 @@ public:
    /// meaningful on the server side.
    S32 getGhostIndex(NetObject *object);
 
+   /// Write a snapshot of ghost values from within NetObject::packUpdate().
+   ///
+   /// If the client has acknowledged an earlier snapshot of the ghost being
+   /// updated, the values are written as differences against it.  Otherwise
+   /// they are written against reference, or against zero if that is NULL.
+   /// Outside of a ghost update, like in ghost always events or demo start
+   /// blocks, snapshots are always written against the reference.
+   ///
+   /// Each update may contain at most one snapshot.
+   void packSnapshot(BitStream *stream, NetSnapshot &snapshot, const NetSnapshot *reference = NULL);
+
+   /// Read a snapshot written with packSnapshot() from within
+   /// NetObject::unpackUpdate().  snapshot->numValues must be set to the
+   /// number of values that were packed.
+   void unpackSnapshot(BitStream *stream, NetSnapshot *snapshot, const NetSnapshot *reference = NULL);
+
    /// Move a GhostInfo into the nonzero portion of the list (so that we know to update it).
    void ghostPushNonZero(GhostInfo *gi);
 
@@ -928,6 +1048,10 @@ public:
    /// before performing an operation.
    static Signal<void()> smGhostAlwaysDone;
 
+   /// If false, snapshots are always written against their reference
+   /// instead of the last acknowledged snapshot.
+   static bool smGhostSnapshots;
+
    /// @}
 public:
 //----------------------------------------------------------------
@@ -1077,6 +1201,12 @@ public:  // required for MSVC
    U32 index;
    U32 arrayIndex;
 
+   NetSnapshot *sentSnapshots;            ///< Last NetConnection::SnapshotWindow snapshots sent, by id.
+                                          ///  Allocated on first use and kept when the GhostInfo is reused.
+   bool snapshotAcked;                    ///< True if ackedSnapshotId is valid.
+   U32 ackedSnapshotId;                   ///< Newest snapshot the client has acknowledged.
+   U32 snapshotCount;                     ///< Snapshots sent for this ghost.
+
    /// Flags relating to the state of the object.
    enum Flags
    {
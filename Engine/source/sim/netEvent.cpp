@@ -181,7 +181,7 @@ void NetConnection::eventWritePacket(BitStream *bstream, PacketNotify *notify)
 
    while(mUnorderedSendEventQueueHead)
    {
-      if(bstream->isFull())
+      if(bstream->isFull() || bstream->getCurPos() > mEventBitLimit)
          break;
       // dequeue the first event
       NetEventNote *ev = mUnorderedSendEventQueueHead;
@@ -198,7 +198,10 @@ void NetConnection::eventWritePacket(BitStream *bstream, PacketNotify *notify)
 #ifdef TORQUE_NET_STATS
       U32 beginSize = bstream->getBitPosition();
 #endif
+      U32 statBits = bstream->getBitPosition();
+      U64 statTime = beginClassStats();
       ev->mEvent->pack(this, bstream);
+      recordClassWrite(ev->mEvent->getClassRep(), 0, bstream->getBitPosition() - statBits, statTime);
 #ifdef TORQUE_NET_STATS
       ev->mEvent->getClassRep()->updateNetStatPack(0, bstream->getBitPosition() - beginSize);
 #endif
@@ -221,7 +224,7 @@ void NetConnection::eventWritePacket(BitStream *bstream, PacketNotify *notify)
 
    while(mSendEventQueueHead)
    {
-      if(bstream->isFull())
+      if(bstream->isFull() || bstream->getCurPos() > mEventBitLimit)
          break;
 
       // if the event window is full, stop processing
@@ -256,7 +259,10 @@ void NetConnection::eventWritePacket(BitStream *bstream, PacketNotify *notify)
 #ifdef TORQUE_NET_STATS
       U32 beginSize = bstream->getBitPosition();
 #endif
+      U32 statBits = bstream->getBitPosition();
+      U64 statTime = beginClassStats();
       ev->mEvent->pack(this, bstream);
+      recordClassWrite(ev->mEvent->getClassRep(), 0, bstream->getBitPosition() - statBits, statTime);
 #ifdef TORQUE_NET_STATS
       ev->mEvent->getClassRep()->updateNetStatPack(0, bstream->getBitPosition() - beginSize);
 #endif
@@ -329,7 +335,10 @@ void NetConnection::eventReadPacket(BitStream *bstream)
 #ifdef TORQUE_NET_STATS
       U32 beginSize = bstream->getBitPosition();
 #endif
+      U32 statBits = bstream->getBitPosition();
+      U64 statTime = beginClassStats();
       evt->unpack(this, bstream);
+      recordClassRead(evt->getClassRep(), bstream->getBitPosition() - statBits, statTime);
 #ifdef TORQUE_NET_STATS
       evt->getClassRep()->updateNetStatUnpack(bstream->getBitPosition() - beginSize);
 #endif
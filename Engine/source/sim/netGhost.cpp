@@ -34,6 +34,7 @@
 #define DebugChecksum 0xF00DBAAD
 
 Signal<void()>    NetConnection::smGhostAlwaysDone;
+bool              NetConnection::smGhostSnapshots = true;
 
 extern U32 gGhostUpdates;
 
@@ -169,8 +170,12 @@ void NetConnection::setGhostTo(bool ghostTo)
    if(ghostTo)
    {
       mLocalGhosts = new NetObject *[MaxGhostCount];
+      mLocalSnapshots = new NetSnapshot *[MaxGhostCount];
       for(S32 i = 0; i < MaxGhostCount; i++)
+      {
          mLocalGhosts[i] = NULL;
+         mLocalSnapshots[i] = NULL;
+      }
    }
 }
 
@@ -190,6 +195,10 @@ void NetConnection::setGhostFrom(bool ghostFrom)
          mGhostRefs[i].obj = NULL;
          mGhostRefs[i].index = i;
          mGhostRefs[i].updateMask = 0;
+         mGhostRefs[i].sentSnapshots = NULL;
+         mGhostRefs[i].snapshotAcked = false;
+         mGhostRefs[i].ackedSnapshotId = 0;
+         mGhostRefs[i].snapshotCount = 0;
       }
       mGhostLookupTable = new GhostInfo *[GhostLookupTableSize];
       for(i = 0; i < GhostLookupTableSize; i++)
@@ -286,6 +295,19 @@ void NetConnection::ghostPacketReceived(PacketNotify *notify)
 
       *walk = 0;
 
+      // the client has this snapshot now, so keep it as the
+      // baseline unless a newer one has already been acked
+
+      if(packRef->hasSnapshot)
+      {
+         GhostInfo *ghost = packRef->ghost;
+         if(!ghost->snapshotAcked || S32(packRef->snapshotId - ghost->ackedSnapshotId) > 0)
+         {
+            ghost->snapshotAcked = true;
+            ghost->ackedSnapshotId = packRef->snapshotId;
+         }
+      }
+
       // if this object was ghosting , it is now ghosted
 
       if(packRef->ghostInfoFlags & GhostInfo::Ghosting)
@@ -446,6 +468,8 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
 
       upd->ghost = walk;
       upd->ghostInfoFlags = 0;
+      upd->hasSnapshot = false;
+      upd->snapshotId = 0;
 
       if(walk->flags & GhostInfo::KillGhost)
       {
@@ -486,7 +510,12 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
 #ifdef TORQUE_NET_STATS
          U32 beginSize = bstream->getBitPosition();
 #endif
+         U32 statBits = bstream->getBitPosition();
+         U64 statTime = beginClassStats();
+         mPackingRef = upd;
          U32 retMask = walk->obj->packUpdate(this, updateMask, bstream);
+         mPackingRef = NULL;
+         recordClassWrite(walk->obj->getClassRep(), updateMask, bstream->getBitPosition() - statBits, statTime);
 #ifdef TORQUE_NET_STATS
          walk->obj->getClassRep()->updateNetStatPack(updateMask, bstream->getBitPosition() - beginSize);
 #endif
@@ -549,6 +578,7 @@ void NetConnection::ghostReadPacket(BitStream *bstream)
          AssertFatal(mLocalGhosts[index] != NULL, "Error, NULL ghost encountered.");
          mLocalGhosts[index]->deleteObject();
          mLocalGhosts[index] = NULL;
+         clearLocalSnapshots(index);
       }
       else
       {
@@ -577,6 +607,7 @@ void NetConnection::ghostReadPacket(BitStream *bstream)
 
             obj->mNetIndex = index;
             mLocalGhosts[index] = obj;
+            clearLocalSnapshots(index);
 #ifdef TORQUE_DEBUG_NET
             U32 checksum = bstream->readInt(32);
             S32 origId = checksum ^ DebugChecksum;
@@ -592,7 +623,12 @@ void NetConnection::ghostReadPacket(BitStream *bstream)
 #ifdef TORQUE_NET_STATS
             U32 beginSize = bstream->getBitPosition();
 #endif
+            U32 statBits = bstream->getBitPosition();
+            U64 statTime = beginClassStats();
+            mUnpackingGhostIndex = index;
             mLocalGhosts[index]->unpackUpdate(this, bstream);
+            mUnpackingGhostIndex = -1;
+            recordClassRead(mLocalGhosts[index]->getClassRep(), bstream->getBitPosition() - statBits, statTime);
 #ifdef TORQUE_NET_STATS
             mLocalGhosts[index]->getClassRep()->updateNetStatUnpack(bstream->getBitPosition() - beginSize);
 #endif
@@ -641,7 +677,12 @@ void NetConnection::ghostReadPacket(BitStream *bstream)
 #ifdef TORQUE_NET_STATS
             U32 beginSize = bstream->getBitPosition();
 #endif
+            U32 statBits = bstream->getBitPosition();
+            U64 statTime = beginClassStats();
+            mUnpackingGhostIndex = index;
             mLocalGhosts[index]->unpackUpdate(this, bstream);
+            mUnpackingGhostIndex = -1;
+            recordClassRead(mLocalGhosts[index]->getClassRep(), bstream->getBitPosition() - statBits, statTime);
 #ifdef TORQUE_NET_STATS
             mLocalGhosts[index]->getClassRep()->updateNetStatUnpack(bstream->getBitPosition() - beginSize);
 #endif
@@ -720,6 +761,102 @@ void NetConnection::freeGhostInfo(GhostInfo *ghost)
    }
    ghostPushZeroToFree(ghost);
    AssertFatal(ghost->updateChain == NULL, "Ack!");
+
+   ghost->snapshotAcked = false;
+   ghost->snapshotCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void NetConnection::clearLocalSnapshots(U32 index)
+{
+   if(!mLocalSnapshots[index])
+      return;
+
+   for(U32 i = 0; i < SnapshotWindow; i++)
+      mLocalSnapshots[index][i].numValues = 0;
+}
+
+void NetConnection::packSnapshot(BitStream *stream, NetSnapshot &snapshot, const NetSnapshot *reference)
+{
+   AssertFatal(snapshot.numValues > 0 && snapshot.numValues <= NetSnapshot::MaxValues, "NetConnection::packSnapshot - Bad value count.");
+   AssertFatal(!reference || reference->numValues == snapshot.numValues, "NetConnection::packSnapshot - Reference doesn't match.");
+
+   // Outside of ghostWritePacket there is nothing to track, so
+   // just write the values.
+   if(!mPackingRef)
+   {
+      for(U32 i = 0; i < snapshot.numValues; i++)
+         stream->writeDeltaInt(snapshot.values[i], reference ? reference->values[i] : 0);
+      return;
+   }
+
+   AssertFatal(!mPackingRef->hasSnapshot, "NetConnection::packSnapshot - Only one snapshot per update.");
+
+   GhostInfo *ghost = mPackingRef->ghost;
+   if(!ghost->sentSnapshots)
+      ghost->sentSnapshots = new NetSnapshot[SnapshotWindow];
+
+   snapshot.id = ghost->snapshotCount++;
+   stream->writeInt(snapshot.id & (SnapshotWindow - 1), SnapshotIdBitSize);
+
+   // The client only keeps the last SnapshotWindow snapshots, and so do
+   // we, so older acks can't be used as a baseline.
+   const NetSnapshot *baseline = NULL;
+   if(smGhostSnapshots && ghost->snapshotAcked && snapshot.id - ghost->ackedSnapshotId < SnapshotWindow)
+   {
+      baseline = &ghost->sentSnapshots[ghost->ackedSnapshotId & (SnapshotWindow - 1)];
+      if(baseline->numValues != snapshot.numValues)
+         baseline = NULL;
+   }
+
+   if(stream->writeFlag(baseline != NULL))
+   {
+      stream->writeInt(baseline->id & (SnapshotWindow - 1), SnapshotIdBitSize);
+      reference = baseline;
+   }
+
+   for(U32 i = 0; i < snapshot.numValues; i++)
+      stream->writeDeltaInt(snapshot.values[i], reference ? reference->values[i] : 0);
+
+   // Keep it as the baseline for once this update is acked.
+   ghost->sentSnapshots[snapshot.id & (SnapshotWindow - 1)] = snapshot;
+   mPackingRef->hasSnapshot = true;
+   mPackingRef->snapshotId = snapshot.id;
+}
+
+void NetConnection::unpackSnapshot(BitStream *stream, NetSnapshot *snapshot, const NetSnapshot *reference)
+{
+   AssertFatal(snapshot->numValues > 0 && snapshot->numValues <= NetSnapshot::MaxValues, "NetConnection::unpackSnapshot - Bad value count.");
+
+   if(mUnpackingGhostIndex < 0)
+   {
+      for(U32 i = 0; i < snapshot->numValues; i++)
+         snapshot->values[i] = stream->readDeltaInt(reference ? reference->values[i] : 0);
+      return;
+   }
+
+   NetSnapshot *&ring = mLocalSnapshots[mUnpackingGhostIndex];
+   if(!ring)
+      ring = new NetSnapshot[SnapshotWindow];
+
+   snapshot->id = stream->readInt(SnapshotIdBitSize);
+
+   if(stream->readFlag())
+   {
+      const NetSnapshot &baseline = ring[stream->readInt(SnapshotIdBitSize)];
+      if(baseline.numValues != snapshot->numValues)
+      {
+         setLastError("Invalid packet. (missing snapshot baseline)");
+         return;
+      }
+      reference = &baseline;
+   }
+
+   for(U32 i = 0; i < snapshot->numValues; i++)
+      snapshot->values[i] = stream->readDeltaInt(reference ? reference->values[i] : 0);
+
+   ring[snapshot->id] = *snapshot;
 }
 
 //-----------------------------------------------------------------------------
@@ -1253,6 +1390,26 @@ void NetConnection::ghostWriteStartBlock(ResizeBitStream *stream)
          stream->validate();
       }
    }
+
+   // Updates recorded after this may be written against snapshots we
+   // received before the recording started, so save those too.
+   for(U32 i = 0; i < MaxGhostCount; i++)
+   {
+      if(mLocalGhosts[i] && mLocalSnapshots[i])
+      {
+         stream->writeFlag(true);
+         stream->writeInt(i, GhostIdBitSize);
+         for(U32 j = 0; j < SnapshotWindow; j++)
+         {
+            const NetSnapshot &snapshot = mLocalSnapshots[i][j];
+            stream->writeInt(snapshot.numValues, 5);
+            for(U32 k = 0; k < snapshot.numValues; k++)
+               stream->writeInt(snapshot.values[k], 32);
+         }
+         stream->validate();
+      }
+   }
+   stream->writeFlag(false);
 }
 
 void NetConnection::ghostReadStartBlock(BitStream *stream)
@@ -1295,6 +1452,21 @@ void NetConnection::ghostReadStartBlock(BitStream *stream)
          addObject(mLocalGhosts[i]);
       }
    }
+
+   while(stream->readFlag())
+   {
+      U32 index = stream->readInt(GhostIdBitSize);
+      if(!mLocalSnapshots[index])
+         mLocalSnapshots[index] = new NetSnapshot[SnapshotWindow];
+      for(U32 j = 0; j < SnapshotWindow; j++)
+      {
+         NetSnapshot &snapshot = mLocalSnapshots[index][j];
+         snapshot.id = j;
+         snapshot.numValues = getMin(U32(stream->readInt(5)), U32(NetSnapshot::MaxValues));
+         for(U32 k = 0; k < snapshot.numValues; k++)
+            snapshot.values[k] = stream->readInt(32);
+      }
+   }
    // MARKF - TODO - looks like we could have memory leaks here
    // if there are errors.
 }
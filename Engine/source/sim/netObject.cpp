@@ -46,6 +46,7 @@ NetObject::NetObject()
    mPrevDirtyList = NULL;
    mNextDirtyList = NULL;
    mDirtyMaskBits = 0;
+   mDeferredMaskBits = 0;
 }
 
 NetObject::~NetObject()
@@ -91,10 +92,21 @@ void NetObject::setMaskBits(U32 orMask)
    AssertFatal(mDirtyMaskBits == 0 || (mPrevDirtyList != NULL || mNextDirtyList != NULL || mDirtyList == this), "Invalid dirty list state.");
 }
 
+void NetObject::applyDeferredMaskBits()
+{
+   if(mDeferredMaskBits)
+   {
+      U32 mask = mDeferredMaskBits;
+      mDeferredMaskBits = 0;
+      setMaskBits(mask);
+   }
+}
+
 void NetObject::clearMaskBits(U32 orMask)
 {
    if(isDeleted())
       return;
+   mDeferredMaskBits &= ~orMask;
    if(mDirtyMaskBits)
    {
       mDirtyMaskBits &= ~orMask;
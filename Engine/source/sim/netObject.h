@@ -234,6 +234,9 @@ private:
    /// object.
    U32 mDirtyMaskBits;
 
+   /// Bits recorded by deferMaskBits().
+   U32 mDeferredMaskBits;
+
    /// @name Dirty List
    ///
    /// Whenever a NetObject becomes "dirty", we add it to the dirty list.
@@ -299,6 +302,14 @@ public:
    /// @param   orMask   Bit(s) to set
    virtual void setMaskBits(U32 orMask);
 
+   /// Records mask bits on the object only and leaves the global dirty list
+   /// alone until applyDeferredMaskBits() is called.  Used while the object
+   /// ticks on a worker thread.
+   void deferMaskBits(U32 orMask) { mDeferredMaskBits |= orMask; }
+
+   /// Sets the mask bits recorded by deferMaskBits().
+   void applyDeferredMaskBits();
+
    /// Clear the specified bits from the dirty mask.
    ///
    /// @param   orMask   Bits to clear
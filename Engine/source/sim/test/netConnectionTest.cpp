@@ -0,0 +1,199 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "sim/netConnection.h"
+#include "core/stream/bitStream.h"
+#include "core/util/tVector.h"
+
+namespace
+{
+   /// Exposes the ghost update bookkeeping so snapshots can be sent, acked
+   /// and dropped for ghost 0 without a live connection or a NetObject.
+   class SnapshotConnection : public NetConnection
+   {
+   public:
+      SnapshotConnection(bool server)
+      {
+         if(server)
+         {
+            setGhostFrom(true);
+            mGhostRefs[0].updateChain = NULL;
+         }
+         else
+            setGhostTo(true);
+      }
+
+      /// Pack a snapshot the way NetObject::packUpdate does from within
+      /// ghostWritePacket, and return the update to ack or drop later.
+      /// Acking or dropping the update frees it.
+      GhostRef *send(BitStream *stream, NetSnapshot &snapshot)
+      {
+         GhostInfo *ghost = &mGhostRefs[0];
+         GhostRef *ref = new GhostRef;
+         dMemset(ref, 0, sizeof(GhostRef));
+         ref->ghost = ghost;
+         ref->nextUpdateChain = ghost->updateChain;
+         ghost->updateChain = ref;
+
+         mPackingRef = ref;
+         packSnapshot(stream, snapshot);
+         mPackingRef = NULL;
+         return ref;
+      }
+
+      void receive(BitStream *stream, NetSnapshot *snapshot)
+      {
+         mUnpackingGhostIndex = 0;
+         unpackSnapshot(stream, snapshot);
+         mUnpackingGhostIndex = -1;
+      }
+
+      void ack(GhostRef *ref)
+      {
+         PacketNotify notify;
+         notify.ghostList = ref;
+         ghostPacketReceived(&notify);
+      }
+
+      void drop(GhostRef *ref)
+      {
+         PacketNotify notify;
+         notify.ghostList = ref;
+         ghostPacketDropped(&notify);
+      }
+   };
+
+   /// Sends snapshots from a server connection to a client connection
+   /// through a bit stream, tracking which of them used a baseline.
+   class SnapshotLink
+   {
+   public:
+      SnapshotConnection server;
+      SnapshotConnection client;
+      bool usedBaseline;
+
+      SnapshotLink() : server(true), client(false), usedBaseline(false) {}
+
+      NetConnection::GhostRef *send(S32 a, S32 b, S32 c, bool delivered = true)
+      {
+         NetSnapshot snapshot;
+         snapshot.numValues = 3;
+         snapshot.values[0] = a;
+         snapshot.values[1] = b;
+         snapshot.values[2] = c;
+
+         U8 buffer[256];
+         BitStream stream(buffer, sizeof(buffer));
+         NetConnection::GhostRef *ref = server.send(&stream, snapshot);
+
+         // The baseline flag follows the snapshot id.
+         stream.setPosition(0);
+         stream.readInt(NetConnection::SnapshotIdBitSize);
+         usedBaseline = stream.readFlag();
+
+         if(delivered)
+         {
+            stream.setPosition(0);
+            NetSnapshot received;
+            received.numValues = 3;
+            client.receive(&stream, &received);
+            EXPECT_EQ(a, received.values[0]);
+            EXPECT_EQ(b, received.values[1]);
+            EXPECT_EQ(c, received.values[2]);
+         }
+         return ref;
+      }
+   };
+}
+
+TEST(NetConnection, AckedSnapshotIsBaseline)
+{
+   NetConnection::smGhostSnapshots = true;
+   SnapshotLink link;
+
+   NetConnection::GhostRef *ref = link.send(1000, -2000, 3000);
+   EXPECT_FALSE(link.usedBaseline) << "Nothing acked yet, so this should be a full update";
+   link.server.ack(ref);
+
+   ref = link.send(1001, -2001, 3002);
+   EXPECT_TRUE(link.usedBaseline) << "Should be a delta against the acked snapshot";
+   link.server.ack(ref);
+
+   ref = link.send(1002, -2001, 3004);
+   EXPECT_TRUE(link.usedBaseline) << "Should be a delta against the newest acked snapshot";
+   link.server.ack(ref);
+}
+
+TEST(NetConnection, DroppedSnapshotFallsBack)
+{
+   NetConnection::smGhostSnapshots = true;
+   SnapshotLink link;
+
+   link.server.drop(link.send(10, 20, 30, false));
+
+   NetConnection::GhostRef *ref = link.send(11, 21, 31);
+   EXPECT_FALSE(link.usedBaseline) << "A dropped snapshot must not become a baseline";
+   link.server.ack(ref);
+
+   // Dropping a later update keeps the last acked snapshot as the baseline,
+   // which the client still has.
+   link.server.drop(link.send(12, 22, 32, false));
+
+   ref = link.send(13, 23, 33);
+   EXPECT_TRUE(link.usedBaseline) << "Should still use the acked snapshot";
+   link.server.ack(ref);
+}
+
+TEST(NetConnection, SnapshotWindowOverflow)
+{
+   NetConnection::smGhostSnapshots = true;
+   SnapshotLink link;
+
+   link.server.ack(link.send(0, 0, 0));
+
+   // Everything sent while the acked snapshot is in the window deltas
+   // against it, even though none of these have been acked.
+   Vector<NetConnection::GhostRef*> pending;
+   for(S32 i = 1; i < NetConnection::SnapshotWindow; i++)
+   {
+      pending.push_back(link.send(i, i * 2, i * 3));
+      EXPECT_TRUE(link.usedBaseline) << "Snapshot " << i << " is within the window";
+   }
+
+   // The client has overwritten the acked snapshot by now.
+   const S32 last = NetConnection::SnapshotWindow;
+   pending.push_back(link.send(last, last * 2, last * 3));
+   EXPECT_FALSE(link.usedBaseline) << "The acked snapshot is outside the window";
+
+   for(U32 i = 0; i < pending.size(); i++)
+      link.server.ack(pending[i]);
+
+   NetConnection::GhostRef *ref = link.send(1, 2, 3);
+   EXPECT_TRUE(link.usedBaseline) << "Acks should bring the baseline back into the window";
+   link.server.ack(ref);
+}
+
+#endif
@@ -0,0 +1,43 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _TERRCOLLISION_ARCH_H_
+#define _TERRCOLLISION_ARCH_H_
+
+class Point3F;
+class Box3F;
+
+/// Sets outMayHit[i] to zero for each ray that cannot touch @a bounds.
+extern void (*terr_cull_rays)(const Point3F *starts, const Point3F *ends, const U32 count, const Box3F &bounds, U8 *outMayHit);
+
+extern void terr_cull_rays_C(const Point3F *starts, const Point3F *ends, const U32 count, const Box3F &bounds, U8 *outMayHit);
+
+#if defined(TORQUE_CPU_X86) || defined(TORQUE_CPU_X64)
+# // x86/x64 CPU family implementations
+extern void terr_cull_rays_SSE(const Point3F *starts, const Point3F *ends, const U32 count, const Box3F &bounds, U8 *outMayHit);
+#
+#else
+# // Other CPU types go here...
+#endif
+
+#endif // _TERRCOLLISION_ARCH_H_
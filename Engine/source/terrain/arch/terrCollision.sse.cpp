@@ -0,0 +1,74 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+
+#if defined(TORQUE_CPU_X86) || defined(TORQUE_CPU_X64)
+#include "math/mBox.h"
+#include "terrain/arch/terrCollision.arch.h"
+#include <xmmintrin.h>
+
+void terr_cull_rays_SSE(const Point3F *starts, const Point3F *ends, const U32 count, const Box3F &bounds, U8 *outMayHit)
+{
+   const __m128 vMinX = _mm_set1_ps(bounds.minExtents.x);
+   const __m128 vMinY = _mm_set1_ps(bounds.minExtents.y);
+   const __m128 vMinZ = _mm_set1_ps(bounds.minExtents.z);
+   const __m128 vMaxX = _mm_set1_ps(bounds.maxExtents.x);
+   const __m128 vMaxY = _mm_set1_ps(bounds.maxExtents.y);
+   const __m128 vMaxZ = _mm_set1_ps(bounds.maxExtents.z);
+
+   U32 i = 0;
+   for(; i + 4 <= count; i += 4)
+   {
+      const Point3F *s = starts + i;
+      const Point3F *e = ends + i;
+
+      // Four rays, one per lane.
+      const __m128 sx = _mm_setr_ps(s[0].x, s[1].x, s[2].x, s[3].x);
+      const __m128 sy = _mm_setr_ps(s[0].y, s[1].y, s[2].y, s[3].y);
+      const __m128 sz = _mm_setr_ps(s[0].z, s[1].z, s[2].z, s[3].z);
+      const __m128 ex = _mm_setr_ps(e[0].x, e[1].x, e[2].x, e[3].x);
+      const __m128 ey = _mm_setr_ps(e[0].y, e[1].y, e[2].y, e[3].y);
+      const __m128 ez = _mm_setr_ps(e[0].z, e[1].z, e[2].z, e[3].z);
+
+      // A ray misses when both ends are outside the same face.
+      __m128 miss = _mm_and_ps(_mm_cmplt_ps(sx, vMinX), _mm_cmplt_ps(ex, vMinX));
+      miss = _mm_or_ps(miss, _mm_and_ps(_mm_cmpgt_ps(sx, vMaxX), _mm_cmpgt_ps(ex, vMaxX)));
+      miss = _mm_or_ps(miss, _mm_and_ps(_mm_cmplt_ps(sy, vMinY), _mm_cmplt_ps(ey, vMinY)));
+      miss = _mm_or_ps(miss, _mm_and_ps(_mm_cmpgt_ps(sy, vMaxY), _mm_cmpgt_ps(ey, vMaxY)));
+      miss = _mm_or_ps(miss, _mm_and_ps(_mm_cmplt_ps(sz, vMinZ), _mm_cmplt_ps(ez, vMinZ)));
+      miss = _mm_or_ps(miss, _mm_and_ps(_mm_cmpgt_ps(sz, vMaxZ), _mm_cmpgt_ps(ez, vMaxZ)));
+
+      const S32 mask = _mm_movemask_ps(miss);
+      outMayHit[i]     = !(mask & 1);
+      outMayHit[i + 1] = !(mask & 2);
+      outMayHit[i + 2] = !(mask & 4);
+      outMayHit[i + 3] = !(mask & 8);
+   }
+
+   // Remainder.
+   if(i < count)
+      terr_cull_rays_C(starts + i, ends + i, count - i, bounds, outMayHit + i);
+}
+
+#endif // TORQUE_CPU_X86 || TORQUE_CPU_X64
@@ -46,6 +46,9 @@ const U32 TerrCell::smVBSize        = ( TerrCell::smVBStride * TerrCell::smVBStr
 const U32 TerrCell::smPBSize        = ( TerrCell::smMinCellSize * TerrCell::smMinCellSize * 6 ) + 
                                       ( TerrCell::smMinCellSize * 4 * 6 ); // 101,376
 const U32 TerrCell::smTriCount      = TerrCell::smPBSize / 3;              // 33,792
+const U32 TerrCell::smPrebuildLevels = 2;
+
+U32 TerrCell::smMaxVBBuildsPerCull = 4;
 
 
 TerrCell::TerrCell()
@@ -278,6 +281,10 @@ TerrCell* TerrCell::init( TerrainBlock *terrain )
    // Set initial states of OBBs.
    root->updateOBBs();
 
+   // Give the coarse cells their VBs now so that culling
+   // can fall back to them while finer cells are built.
+   root->_prebuildVertexBuffers();
+
    return root;
 }
 
@@ -294,13 +301,11 @@ void TerrCell::_init( TerrainBlock *terrain,
    mSize = size;
    mLevel = level;
 
-   // Generate a VB (and maybe a PB) for this cell, unless we are the Root cell.
-   if ( level > 0 )
-   {
-      _updateVertexBuffer();
-      _updatePrimitiveBuffer();
-   }
-      
+   // Except for the coarse cells, the VB (and maybe a PB) of this
+   // cell is generated the first time it is rendered.  This keeps
+   // us from touching the heights of a mapped terrain file until
+   // we need them.
+
    if ( mSize <= smMinCellSize )
    {
       // Update our bounds and materials... the 
@@ -358,11 +363,14 @@ void TerrCell::updateGrid( const RectI &gridRect, bool opacityOnly )
    PROFILE_SCOPE( TerrCell_UpdateGrid );
 
    // If we have a VB... then update it.
-   if ( mVertexBuffer.isValid() && !opacityOnly )            
-      _updateVertexBuffer();
+   if ( mVertexBuffer.isValid() )
+   {
+      if ( !opacityOnly )
+         _updateVertexBuffer();
 
-   // Update our PB, if any
-   _updatePrimitiveBuffer();
+      // Update our PB, if any
+      _updatePrimitiveBuffer();
+   }
 
    // If we don't have children... then we're
    // a leaf at the bottom of the cell quadtree
@@ -417,6 +425,35 @@ void TerrCell::updateGrid( const RectI &gridRect, bool opacityOnly )
       mMaterial->init( mTerrain, mMaterials );
 }
 
+bool TerrCell::_prepareVertexBuffer( U32 *vbBudget )
+{
+   if ( mVertexBuffer.isValid() )
+      return true;
+
+   if ( *vbBudget == 0 )
+      return false;
+
+   (*vbBudget)--;
+   _updateVertexBuffer();
+   _updatePrimitiveBuffer();
+   return true;
+}
+
+void TerrCell::_prebuildVertexBuffers()
+{
+   if ( mLevel > 0 && !mVertexBuffer.isValid() )
+   {
+      _updateVertexBuffer();
+      _updatePrimitiveBuffer();
+   }
+
+   if ( mLevel >= smPrebuildLevels || !mChildren[0] )
+      return;
+
+   for ( U32 i = 0; i < 4; i++ )
+      mChildren[i]->_prebuildVertexBuffers();
+}
+
 void TerrCell::_updateVertexBuffer()
 {
    PROFILE_SCOPE( TerrCell_UpdateVertexBuffer );
@@ -863,35 +900,16 @@ void TerrCell::_updateBounds()
 
    const F32 squareSize = mTerrain->getSquareSize();
 
-   // This should really only be called for cells of smMinCellSize,
-   // in which case stepSize is always one.
-   const U32 stepSize = mSize / smMinCellSize;
-
-   // Prepare to expand the bounds.
-   mBounds.minExtents.set( F32_MAX, F32_MAX, F32_MAX );
-   mBounds.maxExtents.set( -F32_MAX, -F32_MAX, -F32_MAX );   
+   // The grid square covering this cell has the height
+   // range of all the samples including the far edges.
+   const TerrainSquare *sq = mTerrain->getFile()->findSquare( getBinLog2( mSize ), mPoint.x, mPoint.y );
 
-   Point3F vert;
-   Point2F texCoord;
-
-   const TerrainFile *file = mTerrain->getFile();
-
-   for ( U32 y = 0; y < smVBStride; y++ )
-   {
-      for ( U32 x = 0; x < smVBStride; x++ )
-      {
-         // Setup this point.
-         vert.x = (F32)( mPoint.x + x * stepSize ) * squareSize;
-         vert.y = (F32)( mPoint.y + y * stepSize ) * squareSize;
-         vert.z = fixedToFloat( file->getHeight(   mPoint.x + x,
-                                                   mPoint.y + y ) );
-
-         // HACK: Call it twice to deal with the inverted
-         // inital bounds state... shouldn't be a perf issue.
-         mBounds.extend( vert );
-         mBounds.extend( vert );
-      }
-   }
+   mBounds.minExtents.set( (F32)mPoint.x * squareSize,
+                           (F32)mPoint.y * squareSize,
+                           fixedToFloat( sq->minHeight ) );
+   mBounds.maxExtents.set( (F32)( mPoint.x + mSize ) * squareSize,
+                           (F32)( mPoint.y + mSize ) * squareSize,
+                           fixedToFloat( sq->maxHeight ) );
 
    mRadius = mBounds.len() * 0.5;
 
@@ -951,18 +969,24 @@ void TerrCell::updateZoning( const SceneZoneSpaceManager *zoneManager )
    }
 }
 
-void TerrCell::cullCells(  const SceneRenderState *state,
+bool TerrCell::cullCells(  const SceneRenderState *state,
                            const Point3F &objLodPos,
-                           Vector<TerrCell*> *outCells  )
+                           Vector<TerrCell*> *outCells,
+                           U32 *vbBudget )
 {
-   // If we have a VB and no children then just add 
-   // ourselves to the results and return.
-   if ( mVertexBuffer.isValid() && !mChildren[0]  )               
+   // If we are not the root and have no children then 
+   // just add ourselves to the results and return.
+   if ( mLevel > 0 && !mChildren[0]  )               
    {
+      if ( !_prepareVertexBuffer( vbBudget ) )
+         return false;
+
       outCells->push_back( this );
-      return;
+      return true;
    }
 
+   bool complete = true;
+
    const F32 screenError = mTerrain->getScreenError();
    const BitVector &zoneState = state->getCullingState().getZoneVisibilityFlags();
 
@@ -997,12 +1021,30 @@ void TerrCell::cullCells(  const SceneRenderState *state,
 
       if ( errorPixels < screenError )
       {
-         if ( cell->mVertexBuffer.isValid() )
-            outCells->push_back( cell );       
+         if ( cell->_prepareVertexBuffer( vbBudget ) )
+            outCells->push_back( cell );
+         else
+            complete = false;
+      }
+      else
+      {
+         // If the budget ran out under this child then draw the child
+         // itself rather than leave holes.  The VBs that did get built
+         // are kept, so the finer cells show up over the next frames.
+         const U32 firstCell = outCells->size();
+         if ( !cell->cullCells( state, objLodPos, outCells, vbBudget ) )
+         {
+            outCells->setSize( firstCell );
+
+            if ( cell->_prepareVertexBuffer( vbBudget ) )
+               outCells->push_back( cell );
+            else
+               complete = false;
+         }
       }
-      else      
-         cell->cullCells( state, objLodPos, outCells );
    }
+
+   return complete;
 }
 
 void TerrCell::getRenderPrimitive(  GFXPrimitive *prim,
@@ -1054,8 +1096,8 @@ void TerrCell::preloadMaterials()
 {
    PROFILE_SCOPE( TerrCell_PreloadMaterials );
 
-   // If we have a VB then we need a material.
-   if ( mVertexBuffer.isValid() )
+   // If we can have a VB then we need a material.
+   if ( mLevel > 0 )
    {
       TerrainCellMaterial *material = getMaterial();
       material->getReflectMat();
@@ -97,6 +97,10 @@ protected:
    static const U32 smPBSize;
    static const U32 smTriCount;
 
+   /// Cells this many levels below the root get their VB when the
+   /// quadtree is built, so there is always a coarse cell to draw.
+   static const U32 smPrebuildLevels;
+
    /// Triangle count for our own primitive buffer, if any
    U32 mTriCount;
 
@@ -152,6 +156,13 @@ protected:
    // 
    void _updateVertexBuffer();
 
+   /// Returns true if this cell has its VB, generating it and the PB
+   /// if @a vbBudget allows.  The budget is decremented for each build.
+   bool _prepareVertexBuffer( U32 *vbBudget );
+
+   /// Generates the VBs and PBs of the cells down to smPrebuildLevels.
+   void _prebuildVertexBuffers();
+
    //
    void _updatePrimitiveBuffer();
 
@@ -180,9 +191,18 @@ public:
    ///
    void updateZoning( const SceneZoneSpaceManager *zoneManager );
 
-   void cullCells( const SceneRenderState *state,
+   /// Adds the cells to render to @a outCells.  Cells without a VB
+   /// only get one while @a vbBudget lasts.  Until all the cells under
+   /// a child have one, the coarser child is drawn in their place.
+   /// @return False if a cell had to be skipped for lack of a VB.
+   bool cullCells( const SceneRenderState *state,
                    const Point3F &objLodPos,
-                   Vector<TerrCell*> *outCells );
+                   Vector<TerrCell*> *outCells,
+                   U32 *vbBudget );
+
+   /// The most cell VBs cullCells() generates in one call.  It is exposed
+   /// to the console as $pref::Terrain::maxCellBuildsPerCull.
+   static U32 smMaxVBBuildsPerCull;
 
    const Box3F& getBounds() const { return mBounds; }
 
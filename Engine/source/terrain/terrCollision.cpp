@@ -26,6 +26,8 @@
 #include "terrain/terrData.h"
 #include "collision/abstractPolyList.h"
 #include "collision/collision.h"
+#include "terrain/arch/terrCollision.arch.h"
+#include "core/module.h"
 
 
 const F32 TerrainThickness = 0.5f;
@@ -605,21 +607,48 @@ bool TerrainBlock::buildPolyList(PolyListContext context, AbstractPolyList* poly
 
 //----------------------------------------------------------------------------
 
-static F32 calcInterceptV(F32 vStart, F32 invDeltaV, F32 intercept)
+/// Returns the ray parameter where the ray crosses @a intercept along one
+/// axis.  A zero @a invDeltaV means the ray is parallel to that axis.
+static inline F32 calcIntercept(F32 vStart, F32 invDeltaV, F32 intercept)
 {
+   if(invDeltaV == 0)
+      return MAX_FLOAT;
    return (intercept - vStart) * invDeltaV;
 }
 
-static F32 calcInterceptNone(F32, F32, F32)
+void (*terr_cull_rays)(const Point3F *starts, const Point3F *ends, const U32 count, const Box3F &bounds, U8 *outMayHit) = NULL;
+
+void terr_cull_rays_C(const Point3F *starts, const Point3F *ends, const U32 count, const Box3F &bounds, U8 *outMayHit)
 {
-   return MAX_FLOAT;
+   const Point3F &bMin = bounds.minExtents;
+   const Point3F &bMax = bounds.maxExtents;
+
+   for(U32 i = 0; i < count; i++)
+   {
+      const Point3F &s = starts[i];
+      const Point3F &e = ends[i];
+
+      // A ray misses when both ends are outside the same face.
+      const bool miss = ( s.x < bMin.x && e.x < bMin.x ) || ( s.x > bMax.x && e.x > bMax.x ) ||
+                        ( s.y < bMin.y && e.y < bMin.y ) || ( s.y > bMax.y && e.y > bMax.y ) ||
+                        ( s.z < bMin.z && e.z < bMin.z ) || ( s.z > bMax.z && e.z > bMax.z );
+      outMayHit[i] = !miss;
+   }
 }
 
-static F32 (*calcInterceptX)(F32, F32, F32);
-static F32 (*calcInterceptY)(F32, F32, F32);
+MODULE_BEGIN( TerrainCollision )
 
-static U32 lineCount;
-static Point3F lineStart, lineEnd;
+   MODULE_INIT
+   {
+      terr_cull_rays = terr_cull_rays_C;
+
+   #if defined(TORQUE_CPU_X86) || defined(TORQUE_CPU_X64)
+      if(Platform::SystemInfo.processor.properties & CPU_PROP_SSE)
+         terr_cull_rays = terr_cull_rays_SSE;
+   #endif
+   }
+
+MODULE_END;
 
 bool TerrainBlock::castRay(const Point3F &start, const Point3F &end, RayInfo *info)
 {
@@ -640,12 +669,40 @@ bool TerrainBlock::castRay(const Point3F &start, const Point3F &end, RayInfo *in
    return true;
 }
 
-bool TerrainBlock::castRayI(const Point3F &start, const Point3F &end, RayInfo *info, bool collideEmpty)
+U32 TerrainBlock::castRays(const Point3F *starts, const Point3F *ends, U32 count, RayInfo *outInfos, bool *outHits)
 {
-   lineCount = 0;
-   lineStart = start;
-   lineEnd = end;
+   PROFILE_SCOPE( TerrainBlock_castRays );
+
+   // The object space bounds of the heightfield itself, which
+   // can be tighter than the object box in z.
+   const TerrainSquare *root = mFile->findSquare( mFile->mGridLevels, 0, 0 );
+   const F32 worldSize = getWorldBlockSize();
+   const Box3F bounds(  Point3F( 0.0f, 0.0f, fixedToFloat( root->minHeight ) ),
+                        Point3F( worldSize, worldSize, fixedToFloat( root->maxHeight ) ) );
+
+   enum { BatchSize = 64 };
+   U8 mayHit[ BatchSize ];
 
+   U32 numHits = 0;
+   for(U32 batch = 0; batch < count; batch += BatchSize)
+   {
+      const U32 batchCount = getMin( count - batch, (U32)BatchSize );
+      terr_cull_rays( starts + batch, ends + batch, batchCount, bounds, mayHit );
+
+      for(U32 i = 0; i < batchCount; i++)
+      {
+         const U32 ray = batch + i;
+         outHits[ray] = mayHit[i] && castRay( starts[ray], ends[ray], &outInfos[ray] );
+         if ( outHits[ray] )
+            numHits++;
+      }
+   }
+
+   return numHits;
+}
+
+bool TerrainBlock::castRayI(const Point3F &start, const Point3F &end, RayInfo *info, bool collideEmpty)
+{
    info->object = this;
 
    if(start.x == end.x && start.y == end.y)
@@ -678,14 +735,12 @@ bool TerrainBlock::castRayI(const Point3F &start, const Point3F &end, RayInfo *i
    F32 invDeltaX;
    if(pEnd.x == pStart.x)
    {
-      calcInterceptX = calcInterceptNone;
       invDeltaX = 0;
       dx = 0;
    }
    else
    {
       invDeltaX = 1 / (pEnd.x - pStart.x);
-      calcInterceptX = calcInterceptV;
       if(pEnd.x < pStart.x)
          dx = -1;
       else
@@ -695,14 +750,12 @@ bool TerrainBlock::castRayI(const Point3F &start, const Point3F &end, RayInfo *i
    F32 invDeltaY;
    if(pEnd.y == pStart.y)
    {
-      calcInterceptY = calcInterceptNone;
       invDeltaY = 0;
       dy = 0;
    }
    else
    {
       invDeltaY = 1 / (pEnd.y - pStart.y);
-      calcInterceptY = calcInterceptV;
       if(pEnd.y < pStart.y)
          dy = -1;
       else
@@ -715,8 +768,8 @@ bool TerrainBlock::castRayI(const Point3F &start, const Point3F &end, RayInfo *i
    F32 startT = 0;
    for(;;)
    {
-      F32 nextXInt = calcInterceptX(pStart.x, invDeltaX, (F32)(blockX + (dx == 1)));
-      F32 nextYInt = calcInterceptY(pStart.y, invDeltaY, (F32)(blockY + (dy == 1)));
+      F32 nextXInt = calcIntercept(pStart.x, invDeltaX, (F32)(blockX + (dx == 1)));
+      F32 nextYInt = calcIntercept(pStart.y, invDeltaY, (F32)(blockY + (dy == 1)));
 
       F32 intersectT = 1;
 
@@ -767,6 +820,9 @@ struct TerrLOSStackNode
    U32 level;
 };
 
+/// Enough for a 64k x 64k height map.
+static const U32 MaxGridLevels = 16;
+
 bool TerrainBlock::castRayBlock( const Point3F &pStart, 
                                  const Point3F &pEnd, 
                                  const Point2I &aBlockPos, 
@@ -784,8 +840,10 @@ bool TerrainBlock::castRayBlock( const Point3F &pStart,
 
    F32 invBlockSize = 1 / F32( BlockSquareWidth );
 
-   static Vector<TerrLOSStackNode> stack;
-   stack.setSize( GridLevels * 3 + 1 );
+   // The traversal state lives on the stack so that rays can
+   // be cast from multiple threads at once.
+   AssertFatal( GridLevels <= MaxGridLevels, "TerrainBlock::castRayBlock - Too many grid levels!" );
+   TerrLOSStackNode stack[ MaxGridLevels * 3 + 1 ];
    U32 stackSize = 1;
 
    stack[0].startT = aStartT;
@@ -798,7 +856,7 @@ bool TerrainBlock::castRayBlock( const Point3F &pStart,
 
    while(stackSize--)
    {
-      TerrLOSStackNode *sn = stack.address() + stackSize;
+      TerrLOSStackNode *sn = stack + stackSize;
       U32 level  = sn->level;
       F32 startT = sn->startT;
       F32 endT   = sn->endT;
@@ -907,9 +965,9 @@ bool TerrainBlock::castRayBlock( const Point3F &pStart,
       }
       S32 subSqWidth = 1 << (level - 1);
       F32 xIntercept = (blockPos.x + subSqWidth) * invBlockSize;
-      F32 xInt = calcInterceptX(pStart.x, invDeltaX, xIntercept);
+      F32 xInt = calcIntercept(pStart.x, invDeltaX, xIntercept);
       F32 yIntercept = (blockPos.y + subSqWidth) * invBlockSize;
-      F32 yInt = calcInterceptY(pStart.y, invDeltaY, yIntercept);
+      F32 yInt = calcIntercept(pStart.y, invDeltaY, yIntercept);
 
       F32 startX = startT * (pEnd.x - pStart.x) + pStart.x;
       F32 startY = startT * (pEnd.y - pStart.y) + pStart.y;
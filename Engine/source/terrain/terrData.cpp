@@ -189,6 +189,7 @@ TerrainBlock::TerrainBlock()
    mLightMapSize( 256 ),
    mMaxDetailDistance( 0.0f ),
    mCell( NULL ),
+   mLastPrefetchTile( S32_MAX, S32_MAX ),
    mCRC( 0 ),
    mBaseTexSize( 1024 ),
    mBaseTexFormat( TerrainBlock::JPG ),
@@ -347,7 +348,7 @@ void TerrainBlock::setFile(const Resource<TerrainFile>& terr)
 
 bool TerrainBlock::save(const char *filename)
 {
-   return mFile->save(filename);
+   return mFile->save(filename, TerrainFile::smSaveTiled);
 }
 
 bool TerrainBlock::_setTerrainFile( void *obj, const char *index, const char *data )
@@ -386,6 +387,7 @@ void TerrainBlock::_onZoningChanged( SceneZoneSpaceManager *zoneManager )
 void TerrainBlock::setHeight( const Point2I &pos, F32 height )
 {
    U16 ht = floatToFixed( height );
+   mFile->unmap();
    mFile->setHeight( pos.x, pos.y, ht );
 
    // Note: We do not update the grid here as this could
@@ -802,6 +804,7 @@ void TerrainBlock::removeMaterial( U32 index )
    if ( mFile->mMaterials.size() == 1 )
       return;
 
+   mFile->unmap();
    mFile->mMaterials.erase( index );
    mFile->_initMaterialInstMapping();
 
@@ -1037,9 +1040,25 @@ void TerrainBlock::_updatePhysics()
          for ( U32 column = 0; column < getBlockSize(); column++ )
             holes[ row + (column * getBlockSize()) ] = mFile->isEmptyAt( row, column );
 
+      // The plugins copy the heights they need, so a mapped terrain
+      // can stay mapped.  Gather them from the tiles in that case.
+      const U16 *heights;
+      U16 *tiledHeights = NULL;
+      if ( mFile->isMapped() )
+      {
+         tiledHeights = new U16[ getBlockSize() * getBlockSize() ];
+         for ( U32 y = 0; y < getBlockSize(); y++ )
+            for ( U32 x = 0; x < getBlockSize(); x++ )
+               tiledHeights[ x + ( y * getBlockSize() ) ] = mFile->getHeight( x, y );
+         heights = tiledHeights;
+      }
+      else
+         heights = mFile->getHeightMap().address();
+
       colShape = PHYSICSMGR->createCollision();
-      colShape->addHeightfield( mFile->getHeightMap().address(), holes, getBlockSize(), mSquareSize, MatrixF::Identity );
+      colShape->addHeightfield( heights, holes, getBlockSize(), mSquareSize, MatrixF::Identity );
 
+      delete [] tiledHeights;
       delete [] holes;
    }
 
@@ -1161,6 +1180,14 @@ void TerrainBlock::initPersistFields()
 
    Con::addVariable( "$pref::Terrain::detailScale", TypeF32, &smDetailScale, "A global detail scale used to tweak the material detail distances.\n\n" 
 	   "@ingroup Terrain");
+
+   Con::addVariable( "$pref::Terrain::saveTiled", TypeBool, &TerrainFile::smSaveTiled, "Save terrain files in the tiled version 8 format which can be "
+      "memory mapped.  Older engines can't load these files.\n\n"
+	   "@ingroup Terrain");
+
+   Con::addVariable( "$pref::Terrain::maxCellBuildsPerCull", TypeS32, &TerrCell::smMaxVBBuildsPerCull, "The most terrain cell vertex buffers "
+      "generated each time a terrain is culled.  Coarser cells are drawn until the finer ones have theirs.\n\n"
+	   "@ingroup Terrain");
 }
 
 void TerrainBlock::inspectPostApply()
@@ -161,6 +161,10 @@ protected:
    ///
    TerrCell *mCell;
 
+   /// The file tile the camera was in when we last
+   /// prefetched the mapped terrain file.
+   Point2I mLastPrefetchTile;
+
    /// The shared base material which is used to render
    /// cells that are outside the detail map range.
    TerrainCellMaterial *mBaseMaterial;
@@ -301,9 +305,9 @@ public:
    /// Accessors and mutators for TerrainMaterialUndoAction.
    /// @{
    const Vector<TerrainMaterial*>& getMaterials() const { return mFile->mMaterials; }   
-   const Vector<U8>& getLayerMap() const { return mFile->mLayerMap; }
+   const Vector<U8>& getLayerMap() { mFile->unmap(); return mFile->getLayerMap(); }
    void setMaterials( const Vector<TerrainMaterial*> &materials ) { mFile->mMaterials = materials; }
-   void setLayerMap( const Vector<U8> &layers ) { mFile->mLayerMap = layers; }
+   void setLayerMap( const Vector<U8> &layers ) { mFile->unmap(); mFile->mLayerMap = layers; }
    /// @}
 
    TerrainMaterial* getMaterial( U32 index ) const;
@@ -436,6 +440,24 @@ public:
    void buildConvex(const Box3F& box,Convex* convex);
    bool buildPolyList(PolyListContext context, AbstractPolyList* polyList, const Box3F &box, const SphereF &sphere);
    bool castRay(const Point3F &start, const Point3F &end, RayInfo* info);
+
+   /// Casts @a count object space rays and fills in @a outInfos and
+   /// @a outHits for each as castRay() would.  Rays that cannot touch the
+   /// height field bounds are rejected in groups with SIMD before any grid
+   /// map traversal.
+   ///
+   /// Other threads may call it while the main thread is waiting for them
+   /// or otherwise leaves the terrain alone.  Editing the terrain, or
+   /// TerrainFile::unmap(), acquireResident() and releaseResident(), can
+   /// swap the heights out from under a ray.  Nothing pins the terrain
+   /// during the query, so the caller has to rule these out.
+   /// @return The number of rays that hit.
+   U32 castRays(  const Point3F *starts, 
+                  const Point3F *ends, 
+                  U32 count, 
+                  RayInfo *outInfos, 
+                  bool *outHits );
+
    bool castRayI(const Point3F &start, const Point3F &end, RayInfo* info, bool emptyCollide);
    
    bool castRayBlock(   const Point3F &pStart, 
@@ -41,29 +41,23 @@ bool TerrainBlock::exportHeightMap( const UTF8 *filePath, const String &format )
    // everything to this value.
    U16 maxHeight = 0;
 
-   Vector<const U16>::iterator iBits = mFile->mHeightMap.begin();
+   // Read thru the accessors as the terrain may be mapped.
    for ( S32 y = 0; y < mFile->mSize; y++ )
    {
       for ( S32 x = 0; x < mFile->mSize; x++ )
-      {
-         if ( *iBits > maxHeight )
-            maxHeight = *iBits;
-         ++iBits;
-      }
+         maxHeight = getMax( maxHeight, mFile->getHeight( x, y ) );
    }
 
    // Now write out the map.
-   iBits = mFile->mHeightMap.begin();
    U16 *oBits = (U16*)output.getWritableBits();
    for ( S32 y = 0; y < mFile->mSize; y++ )
    {
       for ( S32 x = 0; x < mFile->mSize; x++ )
       {
          // PNG expects big endian.
-         U16 height = (U16)( ( (F32)(*iBits) / (F32)maxHeight ) * (F32)U16_MAX );
+         U16 height = (U16)( ( (F32)mFile->getHeight( x, y ) / (F32)maxHeight ) * (F32)U16_MAX );
          *oBits = convertHostToBEndian( height );
          ++oBits;
-         ++iBits;
       }
    }
 
@@ -94,8 +88,6 @@ bool TerrainBlock::exportLayerMaps( const UTF8 *filePrefix, const String &format
 {
    for(S32 i = 0; i < mFile->mMaterials.size(); i++)
    {
-      Vector<const U8>::iterator iBits = mFile->mLayerMap.begin();
-      
       GBitmap output(   mFile->mSize,
                         mFile->mSize,
                         false,
@@ -109,9 +101,8 @@ bool TerrainBlock::exportLayerMaps( const UTF8 *filePrefix, const String &format
       {
          for ( S32 x = 0; x < mFile->mSize; x++ )
          {
-            if(*iBits == i)
+            if(mFile->getLayerIndex( x, y ) == i)
                *oBits = 0xFF;
-            ++iBits;
             ++oBits;
          }
       }
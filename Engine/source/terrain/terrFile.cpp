@@ -30,8 +30,11 @@
 #include "gfx/bitmap/gBitmap.h"
 #include "platform/profiler.h"
 #include "math/mPlane.h"
+#include "math/mRect.h"
 
 
+bool TerrainFile::smSaveTiled = false;
+
 template<>
 void* Resource<TerrainFile>::create( const Torque::Path &path )
 {
@@ -47,7 +50,16 @@ template<> ResourceBase::Signature Resource<TerrainFile>::signature()
 TerrainFile::TerrainFile()
    : mNeedsResaving( false ),
      mFileVersion( FILE_VERSION ),
-     mSize( 256 )
+     mSize( 256 ),
+     mTileData( NULL ),
+     mTileShift( 0 ),
+     mTilesPerRow( 0 ),
+     mTileBytes( 0 ),
+     mTileStart( 0 ),
+     mCoarseStart( 0 ),
+     mMappedSize( 0 ),
+     mResidentRefs( 0 ),
+     mRemapOnRelease( false )
 {
    mLayerMap.setSize( mSize * mSize );
    dMemset( mLayerMap.address(), 0, mLayerMap.memSize() );
@@ -58,6 +70,7 @@ TerrainFile::TerrainFile()
 
 TerrainFile::~TerrainFile()
 {
+   AssertFatal( mResidentRefs == 0, "TerrainFile::~TerrainFile - Deleted while still held resident!" );
 }
 
 static U16 calcDev( const PlaneF &pl, const Point3F &pt )
@@ -91,6 +104,8 @@ inline U32 getMostSignificantBit( U32 v )
 
 void TerrainFile::_buildGridMap()
 {
+   AssertFatal( !mTileData, "TerrainFile::_buildGridMap - The terrain is mapped!" );
+
    // The grid level count is the same as the
    // most significant bit of the size.  While 
    // we loop we take the time to calculate the
@@ -265,14 +280,120 @@ void TerrainFile::_initMaterialInstMapping()
    mMaterialInstMapping.mapMaterials();
 }
 
-bool TerrainFile::save( const char *filename )
+bool TerrainFile::save( const char *filename, bool tiled )
 {
+   // We may be about to overwrite the file we have mapped.
+   unmap();
+
    FileStream stream;
    stream.open( filename, Torque::FS::File::Write );
    if ( stream.getStatus() != Stream::Ok )
       return false;
 
+   if ( tiled )
+      _saveTiled( stream );
+   else
+      _saveUntiled( stream );
+
+   return stream.getStatus() == FileStream::Ok;
+}
+
+void TerrainFile::_initTileLayout()
+{
+   mGridLevels = getBinLog2( mSize );
+   mTileShift = getMin( (U32)TILE_SHIFT, mGridLevels );
+   mTilesPerRow = mSize >> mTileShift;
+
+   // Each tile holds its heights, then its layers, then its
+   // grid squares from level 0 up to the level of the tile.
+   const U32 tileSamples = 1 << ( 2 * mTileShift );
+   U32 offset = tileSamples * ( sizeof( U16 ) + sizeof( U8 ) );
+   for ( U32 level = 0; level <= mTileShift; level++ )
+   {
+      mTileGridOffset[ level ] = offset;
+      offset += sizeof( TerrainSquare ) << ( 2 * ( mTileShift - level ) );
+   }
+
+   mTileBytes = ( offset + TILE_ALIGNMENT - 1 ) & ~( TILE_ALIGNMENT - 1 );
+}
+
+static void writeSquare( FileStream &stream, const TerrainSquare &sq )
+{
+   stream.write( sq.minHeight );
+   stream.write( sq.maxHeight );
+   stream.write( sq.heightDeviance );
+   stream.write( sq.flags );
+}
+
+static void writePadding( FileStream &stream, U32 alignment )
+{
+   const U8 zero = 0;
+   while ( stream.getPosition() % alignment )
+      stream.write( zero );
+}
+
+void TerrainFile::_saveTiled( FileStream &stream )
+{
+   // NOTE: The stream writes everything little endian
+   // which is what the mapped tiles expect.
+
    stream.write( (U8)FILE_VERSION );
+   stream.write( mSize );
+
+   // Write out the material names.
+   stream.write( (U32)mMaterials.size() );
+   for ( U32 i=0; i < mMaterials.size(); i++ )
+      stream.write( String( mMaterials[i]->getInternalName() ) );
+
+   // The grid map is saved with the tiles so make sure
+   // it is up to date with any edits to the heights.
+   _buildGridMap();
+   _initTileLayout();
+
+   // The tiles start on the next aligned offset.
+   writePadding( stream, TILE_ALIGNMENT );
+
+   const U32 tileSize = 1 << mTileShift;
+   for ( U32 tileY = 0; tileY < mTilesPerRow; tileY++ )
+   {
+      for ( U32 tileX = 0; tileX < mTilesPerRow; tileX++ )
+      {
+         const U32 startX = tileX << mTileShift;
+         const U32 startY = tileY << mTileShift;
+
+         for ( U32 y = 0; y < tileSize; y++ )
+            for ( U32 x = 0; x < tileSize; x++ )
+               stream.write( mHeightMap[ startX + x + ( ( startY + y ) * mSize ) ] );
+
+         for ( U32 y = 0; y < tileSize; y++ )
+            stream.write( tileSize, &mLayerMap[ startX + ( ( startY + y ) * mSize ) ] );
+
+         for ( U32 level = 0; level <= mTileShift; level++ )
+         {
+            const U32 squareSize = 1 << level;
+            for ( U32 y = 0; y < tileSize; y += squareSize )
+               for ( U32 x = 0; x < tileSize; x += squareSize )
+                  writeSquare( stream, *findSquare( level, startX + x, startY + y ) );
+         }
+
+         writePadding( stream, TILE_ALIGNMENT );
+      }
+   }
+
+   // The grid levels above the tiles are in the same order as in
+   // the grid map pool.
+   for ( S32 level = mGridLevels; level > (S32)mTileShift; level-- )
+   {
+      const U32 squareSize = 1 << level;
+      for ( U32 y = 0; y < mSize; y += squareSize )
+         for ( U32 x = 0; x < mSize; x += squareSize )
+            writeSquare( stream, *findSquare( level, x, y ) );
+   }
+}
+
+void TerrainFile::_saveUntiled( FileStream &stream )
+{
+   stream.write( (U8)UNTILED_FILE_VERSION );
 
    stream.write( mSize );
 
@@ -288,8 +409,6 @@ bool TerrainFile::save( const char *filename )
    stream.write( (U32)mMaterials.size() );
    for ( U32 i=0; i < mMaterials.size(); i++ )
       stream.write( String( mMaterials[i]->getInternalName() ) );
-
-   return stream.getStatus() == FileStream::Ok;
 }
 
 TerrainFile* TerrainFile::load( const Torque::Path &path )
@@ -315,13 +434,17 @@ TerrainFile* TerrainFile::load( const Torque::Path &path )
    ret->mFileVersion = version;
    ret->mFilePath = path;
 
-   if ( version >= 7 )
+   if ( version > UNTILED_FILE_VERSION )
+      ret->_loadTiled( stream );
+   else if ( version == UNTILED_FILE_VERSION )
       ret->_load( stream );
    else
       ret->_loadLegacy( stream );
 
-   // Update the collision structures.
-   ret->_buildGridMap();
+   // Update the collision structures unless
+   // we got them precomputed in the mapping.
+   if ( !ret->isMapped() )
+      ret->_buildGridMap();
    
    // Do the material mapping.
    ret->_initMaterialInstMapping();
@@ -361,6 +484,186 @@ void TerrainFile::_load( FileStream &stream )
    _resolveMaterials( materials );
 }
 
+void TerrainFile::_loadTiled( FileStream &stream )
+{
+   stream.read( &mSize );
+
+   // Get the material name count.
+   U32 materialCount;
+   stream.read( &materialCount );
+   Vector<String> materials;
+   materials.setSize( materialCount );
+
+   // Load the material names.
+   for ( U32 i=0; i < materialCount; i++ )
+      stream.read( &materials[i] );
+
+   // Resolve the TerrainMaterial objects from the names.
+   _resolveMaterials( materials );
+
+   _initTileLayout();
+
+   const U32 tileCount = mTilesPerRow * mTilesPerRow;
+   const U32 tileSize = 1 << mTileShift;
+   mTileStart = ( stream.getPosition() + TILE_ALIGNMENT - 1 ) & ~( TILE_ALIGNMENT - 1 );
+
+   U32 coarseSquareCount = 0;
+   for ( U32 level = mTileShift + 1; level <= mGridLevels; level++ )
+      coarseSquareCount += 1 << ( 2 * ( mGridLevels - level ) );
+
+   mCoarseStart = mTileStart + (U64)tileCount * mTileBytes;
+   mMappedSize = mCoarseStart + coarseSquareCount * sizeof( TerrainSquare );
+
+   if ( _map() )
+      return;
+
+   // We can't map the file so read the heights and layers
+   // from the tiles.  The grid map gets rebuilt.
+   mHeightMap.setSize( mSize * mSize );
+   mLayerMap.setSize( mSize * mSize );
+
+   for ( U32 tile = 0; tile < tileCount; tile++ )
+   {
+      stream.setPosition( mTileStart + tile * mTileBytes );
+
+      const U32 startX = ( tile % mTilesPerRow ) << mTileShift;
+      const U32 startY = ( tile / mTilesPerRow ) << mTileShift;
+
+      for ( U32 y = 0; y < tileSize; y++ )
+         for ( U32 x = 0; x < tileSize; x++ )
+            stream.read( &mHeightMap[ startX + x + ( ( startY + y ) * mSize ) ] );
+
+      for ( U32 y = 0; y < tileSize; y++ )
+         stream.read( tileSize, &mLayerMap[ startX + ( ( startY + y ) * mSize ) ] );
+   }
+}
+
+bool TerrainFile::_map()
+{
+   AssertFatal( !mTileData, "TerrainFile::_map - The terrain is already mapped!" );
+
+#ifdef TORQUE_LITTLE_ENDIAN
+
+   // Map the file if it is on a native volume.
+   Torque::Path fsPath;
+   if (  !Torque::FS::GetFSPath( mFilePath, fsPath ) ||
+         !mMappedFile.open( fsPath.getFullPath() ) )
+      return false;
+
+   if ( mMappedFile.getSize() < mMappedSize )
+   {
+      Con::errorf( "TerrainFile::_map - '%s' is truncated!", mFilePath.getFullPath().c_str() );
+      mMappedFile.close();
+      return false;
+   }
+
+   mTileData = mMappedFile.getData() + mTileStart;
+
+   // Point the coarse grid levels into the mapping.  The
+   // tiled levels are found thru the tiles.
+   mGridMap.setSize( mGridLevels + 1 );
+   mGridMap.compact();
+
+   const TerrainSquare *sq = (const TerrainSquare*)( mMappedFile.getData() + mCoarseStart );
+   for ( S32 level = mGridLevels; level >= 0; level-- )
+   {
+      if ( level <= (S32)mTileShift )
+      {
+         mGridMap[ level ] = NULL;
+         continue;
+      }
+
+      mGridMap[ level ] = const_cast<TerrainSquare*>( sq );
+      sq += 1 << ( 2 * ( mGridLevels - level ) );
+   }
+
+   mGridMapPool.clear();
+   mGridMapPool.compact();
+   mHeightMap.clear();
+   mHeightMap.compact();
+   mLayerMap.clear();
+   mLayerMap.compact();
+   return true;
+
+#else
+
+   return false;
+
+#endif
+}
+
+void TerrainFile::unmap()
+{
+   // Any remap is off as the caller is about to edit.
+   mRemapOnRelease = false;
+
+   if ( mTileData )
+      _copyToResident();
+}
+
+void TerrainFile::acquireResident()
+{
+   if ( mTileData )
+   {
+      _copyToResident();
+      mRemapOnRelease = true;
+   }
+
+   mResidentRefs++;
+}
+
+void TerrainFile::releaseResident()
+{
+   AssertFatal( mResidentRefs > 0, "TerrainFile::releaseResident - Unbalanced release!" );
+   if ( --mResidentRefs > 0 || !mRemapOnRelease )
+      return;
+
+   mRemapOnRelease = false;
+   _map();
+}
+
+void TerrainFile::_copyToResident()
+{
+   PROFILE_SCOPE( TerrainFile_CopyToResident );
+
+   // Copy the tiles into the height and layer maps.  The
+   // accessors read from the tiles until we drop the mapping.
+   mHeightMap.setSize( mSize * mSize );
+   mLayerMap.setSize( mSize * mSize );
+
+   for ( U32 y = 0; y < mSize; y++ )
+      for ( U32 x = 0; x < mSize; x++ )
+      {
+         mHeightMap[ x + ( y * mSize ) ] = getHeight( x, y );
+         mLayerMap[ x + ( y * mSize ) ] = getLayerIndex( x, y );
+      }
+
+   mTileData = NULL;
+   mMappedFile.close();
+
+   _buildGridMap();
+}
+
+void TerrainFile::prefetch( const RectI &area ) const
+{
+   if ( !mTileData )
+      return;
+
+   const U32 tileMax = mTilesPerRow - 1;
+   const U32 minX = mClamp( area.point.x >> (S32)mTileShift, 0, tileMax );
+   const U32 minY = mClamp( area.point.y >> (S32)mTileShift, 0, tileMax );
+   const U32 maxX = mClamp( ( area.point.x + area.extent.x ) >> (S32)mTileShift, 0, tileMax );
+   const U32 maxY = mClamp( ( area.point.y + area.extent.y ) >> (S32)mTileShift, 0, tileMax );
+
+   const U64 tileStart = mTileData - mMappedFile.getData();
+   for ( U32 y = minY; y <= maxY; y++ )
+   {
+      // Tiles in a row are contiguous.
+      const U64 offset = tileStart + (U64)( minX + y * mTilesPerRow ) * mTileBytes;
+      mMappedFile.prefetch( offset, (U64)( maxX - minX + 1 ) * mTileBytes );
+   }
+}
+
 void TerrainFile::_loadLegacy(  FileStream &stream )
 {
    // Some legacy constants.
@@ -574,6 +877,8 @@ void TerrainFile::_resolveMaterials( const Vector<String> &materials )
 
 void TerrainFile::setSize( U32 newSize, bool clear )
 {
+   unmap();
+
    // Make sure the resolution is a power of two.
    newSize = getNextPow2( newSize );
 
@@ -608,6 +913,8 @@ void TerrainFile::setSize( U32 newSize, bool clear )
 
 void TerrainFile::smooth( F32 factor, U32 steps, bool updateCollision )
 {
+   unmap();
+
    const U32 blockSize = mSize * mSize;
 
    // Grab some temp buffers for our smoothing results.
@@ -673,6 +980,8 @@ void TerrainFile::smooth( F32 factor, U32 steps, bool updateCollision )
 
 void TerrainFile::setHeightMap( const Vector<U16> &heightmap, bool updateCollision )
 {
+   unmap();
+
    AssertFatal( mHeightMap.size() == heightmap.size(), "TerrainFile::setHeightMap - Incorrect heightmap size!" );
    dMemcpy( mHeightMap.address(), heightmap.address(), mHeightMap.size() ); 
 
@@ -689,6 +998,8 @@ void TerrainFile::import(  const GBitmap &heightMap,
    AssertFatal( heightMap.getWidth() == heightMap.getHeight(), "TerrainFile::import - Height map is not square!" );
    AssertFatal( isPow2( heightMap.getWidth() ), "TerrainFile::import - Height map is not power of two!" );
 
+   unmap();
+
    const U32 newSize = heightMap.getWidth();
    if ( newSize != mSize )
    {
@@ -826,6 +1137,8 @@ void TerrainFile::updateGrid( const Point2I &minPt, const Point2I &maxPt )
 
    PROFILE_SCOPE( TerrainFile_UpdateGrid );
 
+   unmap();
+
    for ( S32 y = minPt.y - 1; y < maxPt.y + 1; y++ )
    {
       for ( S32 x = minPt.x - 1; x < maxPt.x + 1; x++ )
@@ -35,10 +35,14 @@
 #ifndef _TERRMATERIAL_H_
 #include "terrain/terrMaterial.h"
 #endif
+#ifndef _PLATFORMMEMORYMAPPEDFILE_H_
+#include "platform/platformMemoryMappedFile.h"
+#endif
 
 class TerrainMaterial;
 class FileStream;
 class GBitmap;
+class RectI;
 
 
 ///
@@ -68,9 +72,44 @@ struct TerrainSquare
 typedef U16 TerrainHeight;
 
 
-/// 
+/// The height, layer and collision data of a terrain.
+///
+/// Version 8 files are tiled: each tile holds the heights, layers and
+/// collision grid squares of a square block of the terrain and starts on
+/// a page boundary.  When such a file is on a native volume it is memory
+/// mapped rather than read, so a tile only costs memory once something
+/// reads from it.  Any operation that edits the terrain first copies the
+/// tiles into memory and releases the mapping.
+///
+/// The per sample accessors work whether the terrain is mapped or not.
+/// Code that needs the height or layer vectors themselves has to make the
+/// terrain resident first, either for good with unmap() or for a while
+/// with acquireResident() and releaseResident().  The physics plugins
+/// copy the heights they need, so collision doesn't keep a terrain resident.
+/// @see unmap
 class TerrainFile
 {
+public:
+
+   enum Constants
+   {
+      FILE_VERSION = 8,
+
+      /// The last version that stores whole height
+      /// and layer maps rather than tiles.
+      UNTILED_FILE_VERSION = 7,
+
+      /// Log2 of the tile width in version 8 files.
+      TILE_SHIFT = 8,
+
+      /// The tile alignment in version 8 files.
+      TILE_ALIGNMENT = 4096,
+   };
+
+   /// Save tiled version 8 files rather than version 7 files that older
+   /// engines can read.  Off by default.
+   static bool smSaveTiled;
+
 protected:
 
    friend class TerrainBlock;
@@ -102,6 +141,39 @@ protected:
    /// sake of collision (physics, etc.).
    MaterialList mMaterialInstMapping;
 
+   /// The mapped file of a tiled terrain.  Closed when the
+   /// terrain data is held in the vectors above.
+   MemoryMappedFile mMappedFile;
+
+   /// The first tile within the mapped file or NULL if
+   /// the terrain is not mapped.
+   const U8 *mTileData;
+
+   /// Log2 of the tile width in samples.
+   U32 mTileShift;
+
+   /// The tile count along one side of the terrain.
+   U32 mTilesPerRow;
+
+   /// The size of one tile in the file including padding.
+   U32 mTileBytes;
+
+   /// The offset of each grid level within a tile up to mTileShift.
+   U32 mTileGridOffset[ TILE_SHIFT + 1 ];
+
+   /// The offsets of the first tile and of the coarse grid levels and
+   /// the minimum size of a tiled file, used to map it again.
+   U64 mTileStart;
+   U64 mCoarseStart;
+   U64 mMappedSize;
+
+   /// The number of acquireResident() calls not yet released.
+   U32 mResidentRefs;
+
+   /// Set when acquireResident() copied a mapped terrain into memory.
+   /// Cleared by edits so that they are not lost to a remap.
+   bool mRemapOnRelease;
+
    /// The file version.
    U32 mFileVersion;     
 
@@ -114,9 +186,36 @@ protected:
    /// The internal loading function.
    void _load( FileStream &stream );
 
+   /// Loads the tiled format, mapping it if possible.
+   void _loadTiled( FileStream &stream );
+
+   /// Maps the tiles of the file in mFilePath using the offsets found by
+   /// _loadTiled() and frees the height and layer vectors.
+   bool _map();
+
+   /// Copies the mapped tiles into the height and layer vectors and
+   /// closes the mapping.
+   void _copyToResident();
+
    /// The legacy file loading code.
    void _loadLegacy( FileStream &stream );
 
+   /// Saves the version 8 tiled format.
+   void _saveTiled( FileStream &stream );
+
+   /// Saves the version 7 untiled format.
+   void _saveUntiled( FileStream &stream );
+
+   /// Sets up the tile size and the offsets within a tile for the
+   /// current terrain size.
+   void _initTileLayout();
+
+   /// Returns the start of the mapped tile holding the sample.
+   const U8* _getTile( U32 x, U32 y ) const;
+
+   /// Returns the index of the sample within its tile.
+   U32 _getTileIndex( U32 x, U32 y ) const;
+
    /// Used to populate the materail vector by finding the 
    /// TerrainMaterial objects by name.
    void _resolveMaterials( const Vector<String> &materials );
@@ -129,11 +228,6 @@ protected:
 
 public:
 
-   enum Constants
-   {
-      FILE_VERSION = 7
-   };
-
    TerrainFile();
 
    virtual ~TerrainFile();
@@ -146,7 +240,30 @@ public:
    ///
    static TerrainFile* load( const Torque::Path &path );
 
-   bool save( const char *filename );
+   /// Saves the terrain in the untiled version 7 format
+   /// or the tiled format.
+   bool save( const char *filename, bool tiled = false );
+
+   /// Returns true if the terrain data is memory mapped.
+   bool isMapped() const { return mTileData != NULL; }
+
+   /// Copies a mapped terrain into memory so that it can be edited
+   /// and releases the mapping for good.  Does nothing if it isn't mapped.
+   void unmap();
+
+   /// Makes the height and layer vectors hold the terrain until the
+   /// matching releaseResident().  A mapped terrain is copied into memory
+   /// and mapped again by the last release unless it was edited meanwhile.
+   /// These change the terrain for every reader, so only call them from
+   /// the main thread.
+   void acquireResident();
+
+   /// @see acquireResident
+   void releaseResident();
+
+   /// Hints that the tiles overlapping @a area in grid
+   /// coordinates will be read soon.
+   void prefetch( const RectI &area ) const;
 
    ///
    void import(   const GBitmap &heightMap, 
@@ -181,10 +298,15 @@ public:
 
    U16 getHeight( U32 x, U32 y ) const;
 
-   U16 getMaxHeight() const { return mGridMap[mGridLevels]->maxHeight; }
+   U16 getMaxHeight() const { return findSquare( mGridLevels, 0, 0 )->maxHeight; }
 
    /// Returns the constant heightmap vector.
-   const Vector<U16>& getHeightMap() const { return mHeightMap; }
+   /// @note The terrain must not be mapped.
+   const Vector<U16>& getHeightMap() const;
+
+   /// Returns the constant layer map vector.
+   /// @note The terrain must not be mapped.
+   const Vector<U8>& getLayerMap() const;
 
    /// Sets a new heightmap state.
    void setHeightMap( const Vector<U16> &heightmap, bool updateCollision );
@@ -194,10 +316,46 @@ public:
 };
 
 
+inline const U8* TerrainFile::_getTile( U32 x, U32 y ) const
+{
+   const U32 tile = ( x >> mTileShift ) + ( ( y >> mTileShift ) * mTilesPerRow );
+   return mTileData + (dsize_t)tile * mTileBytes;
+}
+
+inline U32 TerrainFile::_getTileIndex( U32 x, U32 y ) const
+{
+   const U32 mask = ( 1 << mTileShift ) - 1;
+   return ( x & mask ) + ( ( y & mask ) << mTileShift );
+}
+
+inline const Vector<U16>& TerrainFile::getHeightMap() const
+{
+   AssertFatal( !mTileData, "TerrainFile::getHeightMap - The terrain is mapped, call acquireResident() first!" );
+   return mHeightMap;
+}
+
+inline const Vector<U8>& TerrainFile::getLayerMap() const
+{
+   AssertFatal( !mTileData, "TerrainFile::getLayerMap - The terrain is mapped, call acquireResident() first!" );
+   return mLayerMap;
+}
+
 inline TerrainSquare* TerrainFile::findSquare( U32 level, U32 x, U32 y ) const
 {
    x %= mSize;
    y %= mSize;
+
+   if ( mTileData && level <= mTileShift )
+   {
+      // The mapping is read only, but nothing writes to the
+      // squares without unmapping the terrain first.
+      const U32 mask = ( 1 << mTileShift ) - 1;
+      const TerrainSquare *squares = (const TerrainSquare*)( _getTile( x, y ) + mTileGridOffset[ level ] );
+      x = ( x & mask ) >> level;
+      y = ( y & mask ) >> level;
+      return const_cast<TerrainSquare*>( squares + x + ( y << ( mTileShift - level ) ) );
+   }
+
    x >>= level;
    y >>= level;
 
@@ -206,6 +364,8 @@ inline TerrainSquare* TerrainFile::findSquare( U32 level, U32 x, U32 y ) const
 
 inline void TerrainFile::setHeight( U32 x, U32 y, U16 height )
 {
+   AssertFatal( !mTileData, "TerrainFile::setHeight - The terrain is mapped, call unmap() first!" );
+   mRemapOnRelease = false;
    x %= mSize;
    y %= mSize;
    mHeightMap[ x + ( y * mSize ) ] = height;
@@ -213,6 +373,7 @@ inline void TerrainFile::setHeight( U32 x, U32 y, U16 height )
 
 inline const U16* TerrainFile::getHeightAddress( U32 x, U32 y ) const
 {
+   AssertFatal( !mTileData, "TerrainFile::getHeightAddress - The terrain is mapped, call acquireResident() first!" );
    x %= mSize;
    y %= mSize;
    return &mHeightMap[ x + ( y * mSize ) ];
@@ -222,6 +383,10 @@ inline U16 TerrainFile::getHeight( U32 x, U32 y ) const
 {
    x %= mSize;
    y %= mSize;
+
+   if ( mTileData )
+      return ( (const U16*)_getTile( x, y ) )[ _getTileIndex( x, y ) ];
+
    return mHeightMap[ x + ( y * mSize ) ];
 }
 
@@ -229,11 +394,21 @@ inline U8 TerrainFile::getLayerIndex( U32 x, U32 y ) const
 {
    x %= mSize;
    y %= mSize;
+
+   if ( mTileData )
+   {
+      // The layers follow the heights in each tile.
+      const U8 *layers = _getTile( x, y ) + ( sizeof( U16 ) << ( 2 * mTileShift ) );
+      return layers[ _getTileIndex( x, y ) ];
+   }
+
    return mLayerMap[ x + ( y * mSize ) ];
 }
 
 inline void TerrainFile::setLayerIndex( U32 x, U32 y, U8 index )
 {
+   AssertFatal( !mTileData, "TerrainFile::setLayerIndex - The terrain is mapped, call unmap() first!" );
+   mRemapOnRelease = false;
    x %= mSize;
    y %= mSize;
    mLayerMap[ x + ( y * mSize ) ] = index;
@@ -249,9 +424,7 @@ inline BaseMatInstance* TerrainFile::getMaterialMapping( U32 index ) const
 
 inline StringTableEntry TerrainFile::getMaterialName( U32 x, U32 y) const
 {
-   x %= mSize;
-   y %= mSize;
-   const U8 &index = mLayerMap[ x + ( y * mSize ) ];
+   const U8 index = getLayerIndex( x, y );
 
    if ( index < mMaterials.size() )
       return mMaterials[ index ]->getInternalName();
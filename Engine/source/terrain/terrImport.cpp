@@ -74,6 +74,7 @@ ConsoleStaticMethod( TerrainBlock, createNew, S32, 5, 5,
    if ( genNoise )
    {
       TerrainFile *file = terrain->getFile();
+      file->unmap();
 
       Vector<F32> floatHeights;
       floatHeights.setSize( blockSize * blockSize );
@@ -104,11 +104,20 @@ void TerrainBlock::_updateMaterials()
       mCell->deleteMaterials();
 }
 
+/// Returns the layer at the sample index thru the file so
+/// that a mapped terrain stays mapped.
+static inline U8 _getLayerAt( const TerrainFile *file, U32 i, U32 mask, U32 shift )
+{
+   return file->getLayerIndex( i & mask, i >> shift );
+}
+
 void TerrainBlock::_updateLayerTexture()
 {
    const U32 layerSize = mFile->mSize;
-   const Vector<U8> &layerMap = mFile->mLayerMap;
-   const U32 pixelCount = layerMap.size();
+   const U32 pixelCount = layerSize * layerSize;
+   const U32 mask = layerSize - 1;
+   const U32 shift = mFile->mGridLevels;
+   const TerrainFile *file = mFile;
 
    if (  mLayerTex.isNull() ||
          mLayerTex.getWidth() != layerSize ||
@@ -124,22 +133,22 @@ void TerrainBlock::_updateLayerTexture()
 
    for ( U32 i=0; i < pixelCount; i++ )
    {  
-      lock->bits[0] = layerMap[i];
+      lock->bits[0] = _getLayerAt( file, i, mask, shift );
 
       if ( i + 1 >= pixelCount )
          lock->bits[1] = lock->bits[0];
       else
-         lock->bits[1] = layerMap[i+1];
+         lock->bits[1] = _getLayerAt( file, i + 1, mask, shift );
 
       if ( i + layerSize >= pixelCount )
          lock->bits[2] = lock->bits[0];
       else
-         lock->bits[2] = layerMap[i + layerSize];
+         lock->bits[2] = _getLayerAt( file, i + layerSize, mask, shift );
 
       if ( i + layerSize + 1 >= pixelCount )
          lock->bits[3] = lock->bits[0];
       else
-         lock->bits[3] = layerMap[i + layerSize + 1];
+         lock->bits[3] = _getLayerAt( file, i + layerSize + 1, mask, shift );
 
       lock->bits += 4;
    }
@@ -398,12 +407,33 @@ void TerrainBlock::_renderBlock( SceneRenderState *state )
       mLayerTexDirty = false;
    }   
 
+   // Ask the OS to page in the mapped terrain around
+   // the camera each time it crosses into a new tile.
+   if ( state->isDiffusePass() && mFile->isMapped() )
+   {
+      const Point2I camTile( (S32)mFloor( objCamPos.x / mSquareSize ) >> TerrainFile::TILE_SHIFT,
+                             (S32)mFloor( objCamPos.y / mSquareSize ) >> TerrainFile::TILE_SHIFT );
+
+      if ( camTile != mLastPrefetchTile )
+      {
+         mLastPrefetchTile = camTile;
+
+         const S32 tileSize = 1 << TerrainFile::TILE_SHIFT;
+         mFile->prefetch( RectI( ( camTile.x - 1 ) * tileSize,
+                                 ( camTile.y - 1 ) * tileSize,
+                                 tileSize * 3,
+                                 tileSize * 3 ) );
+      }
+   }
+
    static Vector<TerrCell*> renderCells;
    renderCells.clear();
 
+   U32 vbBudget = TerrCell::smMaxVBBuildsPerCull;
    mCell->cullCells( state,
                      objCamPos,
-                     &renderCells );
+                     &renderCells,
+                     &vbBudget );
 
    RenderPassManager *renderPass = state->getRenderPass();
 
@@ -0,0 +1,250 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "terrain/terrData.h"
+#include "terrain/terrFile.h"
+#include "core/resourceManager.h"
+#include "collision/collision.h"
+#include "platform/threads/thread.h"
+#include "math/mRandom.h"
+#include "console/console.h"
+
+namespace
+{
+   /// Saves a terrain of rolling hills and loads it into a TerrainBlock.
+   TerrainBlock* createTestTerrain(U32 size, const char *fileName)
+   {
+      TerrainFile file;
+      file.setSize(size, true);
+
+      for(U32 y = 0; y < size; y++)
+         for(U32 x = 0; x < size; x++)
+         {
+            const F32 height = 300.0f + 120.0f * mSin(x * 0.011f) * mCos(y * 0.017f)
+                                      + 40.0f * mSin((x + y) * 0.051f);
+            file.setHeight(x, y, floatToFixed(height));
+         }
+
+      if(!file.save(fileName))
+         return NULL;
+
+      Resource<TerrainFile> resource = ResourceManager::get().load(fileName);
+      if(!resource)
+         return NULL;
+
+      TerrainBlock *terrain = new TerrainBlock;
+      terrain->setFile(resource);
+      return terrain;
+   }
+
+   void destroyTestTerrain(TerrainBlock *terrain, const char *fileName)
+   {
+      delete terrain;
+      dFileDelete(fileName);
+   }
+
+   /// Random rays that start above the terrain, some of them outside
+   /// of it, and head down at random angles.
+   void makeRays(TerrainBlock *terrain, U32 count, Vector<Point3F> &starts, Vector<Point3F> &ends)
+   {
+      MRandomLCG random(1);
+      const F32 size = terrain->getWorldBlockSize();
+
+      starts.setSize(count);
+      ends.setSize(count);
+      for(U32 i = 0; i < count; i++)
+      {
+         starts[i].set(random.randF(-0.1f, 1.1f) * size,
+                       random.randF(-0.1f, 1.1f) * size,
+                       random.randF(200.0f, 600.0f));
+         ends[i] = starts[i] + Point3F(random.randF(-300.0f, 300.0f),
+                                       random.randF(-300.0f, 300.0f),
+                                       random.randF(-500.0f, 100.0f));
+      }
+   }
+
+   struct castThread : public Thread
+   {
+      TerrainBlock *mTerrain;
+      const Point3F *mStarts;
+      const Point3F *mEnds;
+      U32 mCount;
+      RayInfo *mInfos;
+      bool *mHits;
+
+      castThread(TerrainBlock *terrain, const Point3F *starts, const Point3F *ends, U32 count, RayInfo *infos, bool *hits)
+         : mTerrain(terrain), mStarts(starts), mEnds(ends), mCount(count), mInfos(infos), mHits(hits) {}
+
+      virtual void run(void*)
+      {
+         mTerrain->castRays(mStarts, mEnds, mCount, mInfos, mHits);
+      }
+   };
+}
+
+TEST(TerrainCollision, CastRayHitsSurface)
+{
+   const char *fileName = "testTerrainCastRay.ter";
+   TerrainBlock *terrain = createTestTerrain(256, fileName);
+   ASSERT_TRUE(terrain != NULL) << "Failed to create the test terrain!";
+
+   Vector<Point3F> starts, ends;
+   makeRays(terrain, 2000, starts, ends);
+
+   U32 numHits = 0;
+   U32 numBadHits = 0;
+   for(U32 i = 0; i < starts.size(); i++)
+   {
+      RayInfo info;
+      if(!terrain->castRay(starts[i], ends[i], &info))
+         continue;
+
+      numHits++;
+
+      F32 height;
+      if(!terrain->getHeight(Point2F(info.point.x, info.point.y), &height) ||
+         mFabs(height - info.point.z) > 0.05f)
+         numBadHits++;
+   }
+
+   EXPECT_GT(numHits, 0);
+   EXPECT_EQ(numBadHits, 0)
+      << "Ray contact points are not on the terrain surface!";
+
+   // Straight down onto a grid point.
+   RayInfo info;
+   EXPECT_TRUE(terrain->castRay(Point3F(100.0f, 50.0f, 1000.0f), Point3F(100.0f, 50.0f, 0.0f), &info));
+   EXPECT_NEAR(info.point.z, terrain->getHeight(Point2I(100, 50)), 0.05f);
+
+   destroyTestTerrain(terrain, fileName);
+}
+
+TEST(TerrainCollision, BatchMatchesSingle)
+{
+   const char *fileName = "testTerrainCastRays.ter";
+   TerrainBlock *terrain = createTestTerrain(256, fileName);
+   ASSERT_TRUE(terrain != NULL) << "Failed to create the test terrain!";
+
+   const U32 numRays = 4003;
+   Vector<Point3F> starts, ends;
+   makeRays(terrain, numRays, starts, ends);
+
+   // Cast the same rays from two threads at once.
+   Vector<RayInfo> infos0, infos1;
+   infos0.setSize(numRays);
+   infos1.setSize(numRays);
+   Vector<bool> hits0, hits1;
+   hits0.setSize(numRays);
+   hits1.setSize(numRays);
+
+   castThread thread0(terrain, starts.address(), ends.address(), numRays, infos0.address(), hits0.address());
+   castThread thread1(terrain, starts.address(), ends.address(), numRays, infos1.address(), hits1.address());
+   thread0.start();
+   thread1.start();
+   thread0.join();
+   thread1.join();
+
+   U32 numMismatches = 0;
+   for(U32 i = 0; i < numRays; i++)
+   {
+      RayInfo info;
+      const bool hit = terrain->castRay(starts[i], ends[i], &info);
+
+      if(hit != hits0[i] || hit != hits1[i])
+         numMismatches++;
+      else if(hit && (info.t != infos0[i].t || info.t != infos1[i].t))
+         numMismatches++;
+   }
+
+   EXPECT_EQ(numMismatches, 0)
+      << "TerrainBlock::castRays disagrees with TerrainBlock::castRay!";
+
+   destroyTestTerrain(terrain, fileName);
+}
+
+TEST(TerrainCollision, StressCastRays)
+{
+   // Casts 1M random rays over a 4k terrain one at a time, batched, and
+   // batched across threads.  Timings go to the console.
+
+   const char *fileName = "testTerrainStress.ter";
+   TerrainBlock *terrain = createTestTerrain(4096, fileName);
+   ASSERT_TRUE(terrain != NULL) << "Failed to create the test terrain!";
+
+   const U32 numRays = 1000000;
+   const U32 numThreads = 4;
+
+   Vector<Point3F> starts, ends;
+   makeRays(terrain, numRays, starts, ends);
+
+   Vector<RayInfo> infos;
+   infos.setSize(numRays);
+   Vector<bool> hits;
+   hits.setSize(numRays);
+
+   U32 singleHits = 0;
+   U32 start = Platform::getRealMilliseconds();
+   for(U32 i = 0; i < numRays; i++)
+      singleHits += terrain->castRay(starts[i], ends[i], &infos[i]);
+   const U32 singleTime = Platform::getRealMilliseconds() - start;
+
+   start = Platform::getRealMilliseconds();
+   const U32 batchHits = terrain->castRays(starts.address(), ends.address(), numRays, infos.address(), hits.address());
+   const U32 batchTime = Platform::getRealMilliseconds() - start;
+
+   EXPECT_EQ(singleHits, batchHits);
+
+   castThread* threads[numThreads];
+   const U32 raysPerThread = numRays / numThreads;
+   start = Platform::getRealMilliseconds();
+   for(U32 i = 0; i < numThreads; i++)
+   {
+      const U32 first = i * raysPerThread;
+      const U32 count = (i == numThreads - 1) ? numRays - first : raysPerThread;
+      threads[i] = new castThread(terrain, starts.address() + first, ends.address() + first, count,
+                                  infos.address() + first, hits.address() + first);
+      threads[i]->start();
+   }
+   for(U32 i = 0; i < numThreads; i++)
+   {
+      threads[i]->join();
+      delete threads[i];
+   }
+   const U32 threadedTime = Platform::getRealMilliseconds() - start;
+
+   U32 threadedHits = 0;
+   for(U32 i = 0; i < numRays; i++)
+      threadedHits += hits[i];
+   EXPECT_EQ(singleHits, threadedHits);
+
+   Con::printf("Terrain ray casts, %u rays over a %ux%u terrain, %u hits:", numRays, 4096, 4096, singleHits);
+   Con::printf("   castRay:                %u ms", singleTime);
+   Con::printf("   castRays:               %u ms", batchTime);
+   Con::printf("   castRays, %u threads:    %u ms", numThreads, threadedTime);
+
+   destroyTestTerrain(terrain, fileName);
+}
+
+#endif
@@ -0,0 +1,269 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "terrain/terrFile.h"
+#include "console/console.h"
+
+#ifdef TORQUE_OS_LINUX
+#include <stdio.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+   /// Fills a terrain with hills and a striped layer map.
+   void fillTestTerrain(TerrainFile &file, U32 size)
+   {
+      file.setSize(size, true);
+
+      for(U32 y = 0; y < size; y++)
+         for(U32 x = 0; x < size; x++)
+         {
+            const F32 height = 300.0f + 120.0f * mSin(x * 0.011f) * mCos(y * 0.017f)
+                                      + 40.0f * mSin((x + y) * 0.051f);
+            file.setHeight(x, y, floatToFixed(height));
+            file.setLayerIndex(x, y, ((x / 7) + (y / 13)) % 4);
+         }
+
+      // Punch a hole so the empty square flags get tested.
+      for(U32 y = 10; y < 20; y++)
+         for(U32 x = 30; x < 45; x++)
+            file.setLayerIndex(x, y, U8_MAX);
+   }
+
+   /// Returns the number of samples and squares that differ.
+   U32 compareTerrains(const TerrainFile *a, const TerrainFile *b, U32 size)
+   {
+      U32 numDifferent = 0;
+
+      for(U32 y = 0; y < size; y++)
+         for(U32 x = 0; x < size; x++)
+         {
+            if(a->getHeight(x, y) != b->getHeight(x, y) ||
+               a->getLayerIndex(x, y) != b->getLayerIndex(x, y))
+               numDifferent++;
+         }
+
+      for(U32 level = 0; (1U << level) <= size; level++)
+      {
+         const U32 squareSize = 1 << level;
+         for(U32 y = 0; y < size; y += squareSize)
+            for(U32 x = 0; x < size; x += squareSize)
+            {
+               const TerrainSquare *sa = a->findSquare(level, x, y);
+               const TerrainSquare *sb = b->findSquare(level, x, y);
+               if(sa->minHeight != sb->minHeight ||
+                  sa->maxHeight != sb->maxHeight ||
+                  sa->heightDeviance != sb->heightDeviance ||
+                  sa->flags != sb->flags)
+                  numDifferent++;
+            }
+      }
+
+      return numDifferent;
+   }
+
+   /// Returns the resident set size of the process in KB
+   /// or zero if we don't know how to get it.
+   U32 getResidentKB()
+   {
+#ifdef TORQUE_OS_LINUX
+      FILE *statm = fopen("/proc/self/statm", "r");
+      if(!statm)
+         return 0;
+
+      unsigned long pages = 0, resident = 0;
+      const bool ok = fscanf(statm, "%lu %lu", &pages, &resident) == 2;
+      fclose(statm);
+      return ok ? (U32)(resident * (sysconf(_SC_PAGESIZE) / 1024)) : 0;
+#else
+      return 0;
+#endif
+   }
+}
+
+TEST(TerrainFile, TiledMatchesUntiled)
+{
+   const U32 size = 512;
+   const char *untiledName = "testTerrainUntiled.ter";
+   const char *tiledName = "testTerrainTiled.ter";
+
+   TerrainFile source;
+   fillTestTerrain(source, size);
+   ASSERT_TRUE(source.save(untiledName, false));
+   ASSERT_TRUE(source.save(tiledName, true));
+
+   TerrainFile *untiled = TerrainFile::load(untiledName);
+   TerrainFile *tiled = TerrainFile::load(tiledName);
+   ASSERT_TRUE(untiled != NULL && tiled != NULL) << "Failed to load the test terrains!";
+
+   EXPECT_FALSE(untiled->isMapped());
+   EXPECT_EQ(compareTerrains(untiled, tiled, size), 0)
+      << "The tiled terrain doesn't match the untiled one!";
+   EXPECT_EQ(untiled->getMaxHeight(), tiled->getMaxHeight());
+
+   // Unmapping should leave the same terrain behind.
+   tiled->unmap();
+   EXPECT_FALSE(tiled->isMapped());
+   EXPECT_EQ(compareTerrains(untiled, tiled, size), 0)
+      << "The unmapped terrain doesn't match the untiled one!";
+
+   // Edits still work after unmapping.
+   tiled->setHeight(5, 5, 1234);
+   EXPECT_EQ(tiled->getHeight(5, 5), 1234);
+
+   delete untiled;
+   delete tiled;
+   dFileDelete(untiledName);
+   dFileDelete(tiledName);
+}
+
+TEST(TerrainFile, AcquireResident)
+{
+   const U32 size = 256;
+   const char *fileName = "testTerrainResident.ter";
+
+   TerrainFile source;
+   fillTestTerrain(source, size);
+   ASSERT_TRUE(source.save(fileName, true));
+
+   TerrainFile *file = TerrainFile::load(fileName);
+   ASSERT_TRUE(file != NULL);
+   if(!file->isMapped())
+   {
+      // Nothing to test if the platform can't map files.
+      delete file;
+      dFileDelete(fileName);
+      return;
+   }
+
+   // Nested holds keep the vectors until the last release maps it again.
+   file->acquireResident();
+   file->acquireResident();
+   EXPECT_FALSE(file->isMapped());
+   EXPECT_EQ(file->getHeightMap().size(), size * size);
+   EXPECT_EQ(compareTerrains(&source, file, size), 0);
+   file->releaseResident();
+   EXPECT_FALSE(file->isMapped());
+   file->releaseResident();
+   EXPECT_TRUE(file->isMapped());
+   EXPECT_EQ(compareTerrains(&source, file, size), 0)
+      << "The remapped terrain doesn't match the source!";
+
+   // An edit while held stops the remap so it isn't lost.
+   file->acquireResident();
+   file->setHeight(5, 5, 1234);
+   file->releaseResident();
+   EXPECT_FALSE(file->isMapped());
+   EXPECT_EQ(file->getHeight(5, 5), 1234);
+
+   delete file;
+   dFileDelete(fileName);
+}
+
+TEST(TerrainFile, SaveWhileMapped)
+{
+   // Saving over the file we have mapped must not lose the terrain.
+   const U32 size = 256;
+   const char *fileName = "testTerrainResave.ter";
+
+   TerrainFile source;
+   fillTestTerrain(source, size);
+   ASSERT_TRUE(source.save(fileName, true));
+
+   TerrainFile *loaded = TerrainFile::load(fileName);
+   ASSERT_TRUE(loaded != NULL);
+   ASSERT_TRUE(loaded->save(fileName, true));
+
+   TerrainFile *reloaded = TerrainFile::load(fileName);
+   ASSERT_TRUE(reloaded != NULL);
+   EXPECT_EQ(compareTerrains(loaded, reloaded, size), 0);
+
+   delete loaded;
+   delete reloaded;
+   dFileDelete(fileName);
+}
+
+TEST(TerrainFile, StressLoad)
+{
+   // Loads a 4k terrain from the untiled and the tiled formats and
+   // touches one sample per tile.  Timings and memory use go to the
+   // console.
+
+   const U32 size = 4096;
+   const char *untiledName = "testTerrainStressUntiled.ter";
+   const char *tiledName = "testTerrainStressTiled.ter";
+
+   {
+      TerrainFile source;
+      fillTestTerrain(source, size);
+      ASSERT_TRUE(source.save(untiledName, false));
+      ASSERT_TRUE(source.save(tiledName, true));
+   }
+
+   U32 checksum[2] = { 0, 0 };
+   U32 loadTime[2];
+   S32 residentKB[2];
+   bool mapped = false;
+
+   const char *names[2] = { untiledName, tiledName };
+   for(U32 i = 0; i < 2; i++)
+   {
+      const U32 startKB = getResidentKB();
+      const U32 start = Platform::getRealMilliseconds();
+
+      TerrainFile *file = TerrainFile::load(names[i]);
+      ASSERT_TRUE(file != NULL);
+
+      for(U32 y = 0; y < size; y += 256)
+         for(U32 x = 0; x < size; x += 256)
+            checksum[i] += file->getHeight(x, y) + file->findSquare(4, x, y)->maxHeight;
+
+      loadTime[i] = Platform::getRealMilliseconds() - start;
+      residentKB[i] = (S32)getResidentKB() - (S32)startKB;
+      mapped |= file->isMapped();
+
+      delete file;
+   }
+
+   EXPECT_EQ(checksum[0], checksum[1]);
+
+   Con::printf("Terrain load, %ux%u terrain%s:", size, size, mapped ? "" : " (not mapped)");
+   if(getResidentKB() == 0)
+   {
+      Con::printf("   untiled:   %u ms, resident n/a", loadTime[0]);
+      Con::printf("   tiled:     %u ms, resident n/a", loadTime[1]);
+   }
+   else
+   {
+      Con::printf("   untiled:   %u ms, resident +%d KB", loadTime[0], residentKB[0]);
+      Con::printf("   tiled:     %u ms, resident +%d KB", loadTime[1], residentKB[1]);
+   }
+
+   dFileDelete(untiledName);
+   dFileDelete(tiledName);
+}
+
+#endif
@@ -48,7 +48,9 @@
 #include "console/persistenceManager.h"
 #include "ts/tsShapeConstruct.h"
 #include "core/util/zip/zipVolume.h"
+#include "core/resourceManager.h"
 #include "gfx/bitmap/gBitmap.h"
+#include "console/engineAPI.h"
 
 MODULE_BEGIN( ColladaShapeLoader )
    MODULE_INIT_AFTER( ShapeLoader )
@@ -506,6 +508,23 @@ void updateMaterialsScript(const Torque::Path &path, bool copyTextures = false)
    persistMgr.saveDirty();
 }
 
+//-----------------------------------------------------------------------------
+/// Get the path of the file holding the content hash of the DAE file that the
+/// cached DTS was generated from
+static Torque::Path getCachedHashPath(const Torque::Path& path)
+{
+   Torque::Path hashPath(path);
+   hashPath.setExtension("cached.crc");
+   return hashPath;
+}
+
+/// Get the content hash of a DAE file (0 if it could not be read)
+static U32 getSourceHash(const Torque::Path& path)
+{
+   Torque::FS::FileNodeRef fileRef = Torque::FS::GetFileNode(path);
+   return (fileRef != NULL) ? fileRef->getChecksum() : 0;
+}
+
 //-----------------------------------------------------------------------------
 /// Check if an up-to-date cached DTS is available for this DAE file
 bool ColladaShapeLoader::canLoadCachedDTS(const Torque::Path& path)
@@ -514,19 +533,32 @@ bool ColladaShapeLoader::canLoadCachedDTS(const Torque::Path& path)
    Torque::Path cachedPath(path);
    cachedPath.setExtension("cached.dts");
 
-   // Check if a cached DTS newer than this file is available
+   // Check if a cached DTS generated from this file is available
    FileTime cachedModifyTime;
    if (Platform::getFileTimes(cachedPath.getFullPath(), NULL, &cachedModifyTime))
    {
       bool forceLoadDAE = Con::getBoolVariable("$collada::forceLoadDAE", false);
 
       FileTime daeModifyTime;
-      if (!Platform::getFileTimes(path.getFullPath(), NULL, &daeModifyTime) ||
-         (!forceLoadDAE && (Platform::compareFileTimes(cachedModifyTime, daeModifyTime) >= 0) ))
+      if (!Platform::getFileTimes(path.getFullPath(), NULL, &daeModifyTime))
       {
-         // DAE not found, or cached DTS is newer
+         // DAE not found
          return true;
       }
+
+      if (forceLoadDAE)
+         return false;
+
+      // Compare the DAE contents with the hash stored alongside the cached
+      // DTS, so copying or checking out the files doesn't invalidate it
+      U32 cachedHash;
+      FileStream hashStream;
+      if (hashStream.open(getCachedHashPath(path).getFullPath(), Torque::FS::File::Read) &&
+          hashStream.read(&cachedHash))
+         return (cachedHash == getSourceHash(path));
+
+      // Cached DTS files without a hash are used if they are newer
+      return (Platform::compareFileTimes(cachedModifyTime, daeModifyTime) >= 0);
    }
 
    return false;
@@ -673,6 +705,12 @@ TSShape* loadColladaShape(const Torque::Path &path)
       return NULL;
    }
 
+#ifndef DAE2DTS_TOOL
+   // Hash the DAE file before importing it so changes made during the
+   // import cause the cached DTS to be regenerated next time
+   U32 daeHash = getSourceHash(path);
+#endif
+
 #ifdef DAE2DTS_TOOL
    ColladaUtils::ImportOptions cmdLineOptions = ColladaUtils::getOptions();
 #endif
@@ -713,6 +751,18 @@ TSShape* loadColladaShape(const Torque::Path &path)
          {
             Con::printf("Writing cached COLLADA shape to %s", cachedPath.getFullPath().c_str());
             tss->write(&dtsStream);
+
+            // Record which DAE file contents the cached DTS was made from.
+            // Without a hash, remove any old one so the file times decide.
+            Torque::Path hashPath = getCachedHashPath(path);
+            FileStream hashStream;
+            if (!daeHash)
+            {
+               if (Torque::FS::IsFile(hashPath))
+                  Torque::FS::Remove(hashPath);
+            }
+            else if (hashStream.open(hashPath.getFullPath(), Torque::FS::File::Write))
+               hashStream.write(daeHash);
          }
 #endif // DAE2DTS_TOOL
 
@@ -732,3 +782,101 @@ TSShape* loadColladaShape(const Torque::Path &path)
 
    return tss;
 }
+
+//-----------------------------------------------------------------------------
+
+static S32 QSORT_CALLBACK compareShapePaths(const String* a, const String* b)
+{
+   return a->compare(*b, 0, String::NoCase);
+}
+
+DefineEngineFunction(warmColladaCache, S32, (const char* path, S32 worker, S32 numWorkers), ("", 0, 1),
+   "@brief Generates the cached DTS files of all COLLADA shapes in a folder that "
+   "don't have an up-to-date one.\n\n"
+   "The time taken to convert each shape is printed to the console.  Shapes are "
+   "converted one after the other as the COLLADA importer is not thread-safe.  To "
+   "convert them in parallel, start several processes with the same @a path and "
+   "@a numWorkers and a different @a worker each.  The processes split the work by "
+   "folder so only one of them writes to each materials.cs file.\n\n"
+   "@note A shape constructor that adds sequences from a shape in another folder "
+   "also converts that shape, which writes its cached DTS and materials.cs.  If "
+   "the two folders belong to different processes, both may write those files at "
+   "once.  Keep shapes that share sequences in one folder, or use a single process "
+   "for them.\n\n"
+   "@param path The folder to search, including subfolders.  The whole game folder "
+   "is searched if empty.\n"
+   "@param worker The index of this process, from 0 to @a numWorkers - 1.\n"
+   "@param numWorkers The number of processes sharing the work.\n"
+   "@return The number of shapes converted.\n"
+   "@ingroup Editors")
+{
+   if (numWorkers < 1 || worker < 0 || worker >= numWorkers)
+   {
+      Con::errorf("warmColladaCache - invalid worker %d of %d", worker, numWorkers);
+      return 0;
+   }
+
+   Torque::Path searchPath(Platform::getMainDotCsDir());
+   if (path[0])
+   {
+      char expanded[1024];
+      char fullPath[1024];
+      Con::expandScriptFilename(expanded, sizeof(expanded), path);
+      Platform::makeFullPathName(expanded, fullPath, sizeof(fullPath), Platform::getMainDotCsDir());
+      searchPath = String(fullPath);
+   }
+
+   // Sort the files so that every process assigns the folders the same way.
+   Vector<String> files;
+   Torque::FS::FindByPattern(searchPath, "*.dae", true, files);
+   Torque::FS::FindByPattern(searchPath, "*.kmz", true, files);
+   files.sort(compareShapePaths);
+
+   Vector<String> folders;
+   S32 converted = 0;
+   S32 upToDate = 0;
+   S32 failed = 0;
+   U32 startTime = Platform::getRealMilliseconds();
+
+   for (S32 i = 0; i < files.size(); i++)
+   {
+      // Shape constructors refer to their shapes by relative path.
+      Torque::Path shapePath(Platform::stripBasePath(files[i]));
+
+      S32 folderIndex = folders.find_next(shapePath.getPath());
+      if (folderIndex == -1)
+      {
+         folderIndex = folders.size();
+         folders.push_back(shapePath.getPath());
+      }
+      if (folderIndex % numWorkers != worker)
+         continue;
+
+      if (ColladaShapeLoader::canLoadCachedDTS(shapePath))
+      {
+         upToDate++;
+         continue;
+      }
+
+      // Load the shape as a resource so its shape script runs first.
+      U32 shapeStartTime = Platform::getRealMilliseconds();
+      Resource<TSShape> shape = ResourceManager::get().load(shapePath);
+      F32 seconds = (Platform::getRealMilliseconds() - shapeStartTime) / 1000.0f;
+
+      if (shape)
+      {
+         Con::printf("warmColladaCache - converted %s in %.2f s", shapePath.getFullPath().c_str(), seconds);
+         converted++;
+      }
+      else
+      {
+         Con::errorf("warmColladaCache - failed to convert %s", shapePath.getFullPath().c_str());
+         failed++;
+      }
+   }
+
+   Con::printf("warmColladaCache - %d converted, %d up to date, %d failed in %.2f s",
+      converted, upToDate, failed, (Platform::getRealMilliseconds() - startTime) / 1000.0f);
+
+   return converted;
+}
@@ -0,0 +1,102 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "ts/collada/colladaShapeLoader.h"
+#include "core/stream/fileStream.h"
+#include "core/volume.h"
+#include "console/console.h"
+
+namespace
+{
+   bool writeTestFile(const Torque::Path &path, const char *text)
+   {
+      FileStream stream;
+      if(!stream.open(path.getFullPath(), Torque::FS::File::Write))
+         return false;
+
+      return stream.write(dStrlen(text), text);
+   }
+
+   bool writeTestHash(const Torque::Path &path, U32 hash)
+   {
+      FileStream stream;
+      if(!stream.open(path.getFullPath(), Torque::FS::File::Write))
+         return false;
+
+      return stream.write(hash);
+   }
+
+   U32 getTestChecksum(const Torque::Path &path)
+   {
+      Torque::FS::FileNodeRef fileRef = Torque::FS::GetFileNode(path);
+      return (fileRef != NULL) ? fileRef->getChecksum() : 0;
+   }
+}
+
+TEST(ColladaShapeLoader, CachedDTSFreshness)
+{
+   const Torque::Path daePath("testColladaCache.dae");
+   Torque::Path dtsPath(daePath);
+   dtsPath.setExtension("cached.dts");
+   Torque::Path hashPath(daePath);
+   hashPath.setExtension("cached.crc");
+
+   // The contents are never parsed, only hashed.
+   ASSERT_TRUE(writeTestFile(daePath, "<COLLADA version=\"1.4.1\"/>"));
+   ASSERT_TRUE(writeTestFile(dtsPath, "cached"));
+
+   // No cached DTS means there is nothing to load.
+   Torque::FS::Remove(dtsPath);
+   EXPECT_FALSE(ColladaShapeLoader::canLoadCachedDTS(daePath));
+   ASSERT_TRUE(writeTestFile(dtsPath, "cached"));
+
+   // A hash of the current DAE contents is fresh.
+   ASSERT_TRUE(writeTestHash(hashPath, getTestChecksum(daePath)));
+   EXPECT_TRUE(ColladaShapeLoader::canLoadCachedDTS(daePath));
+
+   // Unless the DAE has to be loaded anyway.
+   Con::setBoolVariable("$collada::forceLoadDAE", true);
+   EXPECT_FALSE(ColladaShapeLoader::canLoadCachedDTS(daePath));
+   Con::setBoolVariable("$collada::forceLoadDAE", false);
+
+   // Changing the DAE makes the cached DTS stale, even though
+   // the cached DTS is no older than the DAE.
+   ASSERT_TRUE(writeTestFile(daePath, "<COLLADA version=\"1.4.1\"><asset/></COLLADA>"));
+   ASSERT_TRUE(writeTestFile(dtsPath, "cached"));
+   EXPECT_FALSE(ColladaShapeLoader::canLoadCachedDTS(daePath));
+
+   ASSERT_TRUE(writeTestHash(hashPath, getTestChecksum(daePath)));
+   EXPECT_TRUE(ColladaShapeLoader::canLoadCachedDTS(daePath));
+
+   // Without the DAE the cached DTS is all there is.
+   Torque::FS::Remove(daePath);
+   EXPECT_TRUE(ColladaShapeLoader::canLoadCachedDTS(daePath));
+
+   Torque::FS::Remove(dtsPath);
+   Torque::FS::Remove(hashPath);
+}
+
+#endif
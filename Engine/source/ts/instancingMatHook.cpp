@@ -26,6 +26,7 @@
 #include "platform/profiler.h"
 #include "materials/materialFeatureTypes.h"
 #include "materials/matInstance.h"
+#include "renderInstance/renderPassManager.h"
 
 
 const MatInstanceHookType InstancingMaterialHook::Type( "Instancing" );
@@ -50,6 +51,13 @@ BaseMatInstance* InstancingMaterialHook::getInstancingMat( BaseMatInstance *matI
    InstancingMaterialHook *hook = matInst->getHook<InstancingMaterialHook>();
    if ( hook == NULL )
    {
+      // Material instances can only be created on the main thread.
+      if ( RenderPassManager::isPreparingIntoChunk() )
+      {
+         RenderPassManager::deferPrepToMainThread();
+         return NULL;
+      }
+
       hook = new InstancingMaterialHook();
       matInst->addHook( hook );
 
@@ -21,6 +21,7 @@
 //-----------------------------------------------------------------------------
 
 #include "ts/tsShapeInstance.h"
+#include "renderInstance/renderPassManager.h"
 
 //----------------------------------------------------------------------------------
 // some utility functions
@@ -861,6 +862,13 @@ void TSShapeInstance::animate(S32 dl)
 
    U32 dirtyFlags = mDirtyFlags[ss];
 
+   // animating goes through static scratch buffers
+   if (dirtyFlags && RenderPassManager::isPreparingIntoChunk())
+   {
+      RenderPassManager::deferPrepToMainThread();
+      return;
+   }
+
    if (dirtyFlags & ThreadDirty)
       sortThreads();
 
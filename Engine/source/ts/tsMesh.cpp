@@ -47,6 +47,7 @@
 #include "scene/sceneRenderState.h"
 #include "materials/matInstance.h"
 #include "renderInstance/renderPassManager.h"
+#include "renderInstance/renderBinManager.h"
 #include "materials/customMaterialDefinition.h"
 #include "gfx/util/triListOpt.h"
 #include "util/triRayCheck.h"
@@ -244,8 +245,11 @@ void TSMesh::innerRender( TSMaterialList *materials, const TSRenderState &rdata,
 
 #ifndef TORQUE_OS_MAC
 
-      // Get the instancing material if this mesh qualifies.
-      if ( meshType != SkinMeshType && pb->mPrimitiveArray[i].numVertices < smMaxInstancingVerts )
+      // Get the instancing material if this mesh qualifies.  With auto
+      // instancing the mesh bins pick it once they see repeated meshes.
+      if (  !RenderBinManager::smAutoInstancing &&
+            meshType != SkinMeshType && 
+            pb->mPrimitiveArray[i].numVertices < smMaxInstancingVerts )
          matInst = InstancingMaterialHook::getInstancingMat( matInst );
 
 #endif
@@ -295,6 +295,7 @@ class TSMesh
    /// @name Material Methods
    /// @{
    void setFade( F32 fade ) { mVisibility = fade; }
+   F32 getFade() const { return mVisibility; }
    void clearFade() { setFade( 1.0f ); }
    /// @}
 
@@ -35,6 +35,7 @@
 #include "materials/sceneData.h"
 #include "materials/matInstance.h"
 #include "scene/sceneRenderState.h"
+#include "renderInstance/renderPassManager.h"
 #include "gfx/primBuilder.h"
 #include "gfx/gfxDrawUtil.h"
 #include "core/module.h"
@@ -73,7 +74,8 @@ MODULE_BEGIN( TSShapeInstance )
 
       Con::addVariable("$pref::TS::maxInstancingVerts", TypeS32, &TSMesh::smMaxInstancingVerts,
          "@brief Enables mesh instancing on non-skin meshes that have less that this count of verts.\n"
-         "The default value is 200.  Higher values can degrade performance.\n"
+         "The default value is 200.  Higher values can degrade performance.  Also limits "
+         "the meshes $pref::Render::autoInstancing draws instanced.\n"
          "@ingroup Rendering\n" );
    }
 
@@ -520,6 +522,13 @@ void TSShapeInstance::render( const TSRenderState &rdata, S32 dl, F32 intraDL )
    if ( ss < 0 )
    {
       PROFILE_SCOPE( TSShapeInstance_RenderBillboards );
+
+      // Billboards may need to update their textures.
+      if ( RenderPassManager::isPreparingIntoChunk() )
+      {
+         RenderPassManager::deferPrepToMainThread();
+         return;
+      }
       
       if ( !rdata.isNoRenderTranslucent() && ( TSLastDetail::smCanShadow || !rdata.getSceneState()->isShadowPass() ) )
          mShape->billboardDetails[ dl ]->render( rdata, mAlphaAlways ? mAlphaAlwaysValue : 1.0f );
@@ -572,8 +581,11 @@ S32 TSShapeInstance::setDetailFromDistance( const SceneRenderState *state, F32 s
 {
    PROFILE_SCOPE( TSShapeInstance_setDetailFromDistance );
 
-   // For debugging/metrics.
-   smLastScaledDistance = scaledDistance;
+   // For debugging/metrics.  Only the main thread records these as
+   // render prep workers select details at the same time.
+   const bool recordMetrics = !RenderPassManager::isPreparingIntoChunk();
+   if ( recordMetrics )
+      smLastScaledDistance = scaledDistance;
 
    // Shortcut if the distance is really close or negative.
    if ( scaledDistance <= 0.0f )
@@ -625,7 +637,8 @@ S32 TSShapeInstance::setDetailFromDistance( const SceneRenderState *state, F32 s
       pixelSize = mShape->mSmallestVisibleSize + 0.01f;
 
    // For debugging/metrics.
-   smLastPixelSize = pixelSize;
+   if ( recordMetrics )
+      smLastPixelSize = pixelSize;
 
    // Clamp it to an acceptable range for the lookup table.
    U32 index = (U32)mClampF( pixelSize, 0, mShape->mDetailLevelLookup.size() - 1 );
@@ -651,8 +664,9 @@ S32 TSShapeInstance::setDetailFromScreenError( F32 errorTolerance )
 {
    PROFILE_SCOPE( TSShapeInstance_setDetailFromScreenError );
 
-   // For debugging/metrics.
-   smLastScreenErrorTolerance = errorTolerance;
+   // For debugging/metrics, on the main thread only.
+   if ( !RenderPassManager::isPreparingIntoChunk() )
+      smLastScreenErrorTolerance = errorTolerance;
 
    // note:  we use 10 time the average error as the metric...this is
    // more robust than the maxError...the factor of 10 is to put average error
@@ -740,11 +754,23 @@ void TSShapeInstance::MeshObjectInstance::render(  S32 objectDetail,
          return;
    }
 
+   // The fade is set on the mesh which is shared by all instances of
+   // the shape, so only the main thread may change it.
+   const F32 fade = visible * alpha;
+   if ( mesh->getFade() != fade )
+   {
+      if ( RenderPassManager::isPreparingIntoChunk() )
+      {
+         RenderPassManager::deferPrepToMainThread();
+         return;
+      }
+
+      mesh->setFade( fade );
+   }
+
    GFX->pushWorldMatrix();
    GFX->multWorld( transform );
 
-   mesh->setFade( visible * alpha );
-
    // Pass a hint to the mesh that time has advanced and that the
    // skin is dirty and needs to be updated.  This should result
    // in the skin only updating once per frame in most cases.
@@ -461,7 +461,8 @@ protected:
    /// only way to get a visible detail)
    static S32 smNumSkipRenderDetails;
 
-   /// For debugging / metrics.
+   /// For debugging / metrics.  These are only
+   /// updated by detail selection on the main thread.
    static F32 smLastScreenErrorTolerance;
    static F32 smLastScaledDistance;
    static F32 smLastPixelSize;
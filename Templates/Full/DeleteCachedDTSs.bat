@@ -1 +1,2 @@
 for /R %%a IN (*.dae) do IF EXIST "%%~pna.cached.dts" del "%%~pna.cached.dts"
+for /R %%a IN (*.dae) do IF EXIST "%%~pna.cached.crc" del "%%~pna.cached.crc"
@@ -37,12 +37,22 @@ function createCanvas(%windowTitle)
       return true;
    }
 
+   // Headless time demos still render, just through the null device.
+   if ($timeDemoHeadless)
+   {
+      %displayDevice = $pref::Video::displayDevice;
+      $pref::Video::displayDevice = "NullDevice";
+   }
+
    // Create the Canvas
    %foo = new GuiCanvas(Canvas)
    {
       displayWindow = $platform !$= "windows";
    };
 
+   if ($timeDemoHeadless)
+      $pref::Video::displayDevice = %displayDevice;
+
    $GameCanvas = %foo;
    
    // Set the window title
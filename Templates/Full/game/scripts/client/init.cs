@@ -102,6 +102,8 @@ function initClient()
    exec("./game.cs");
    exec("./missionDownload.cs");
    exec("./serverConnection.cs");
+   exec("./timeDemo.cs");
+   exec("./renderBenchmark.cs");
 
    // Load useful Materials
    exec("./shaders.cs");
@@ -135,6 +137,36 @@ function initClient()
       return;
    }
 
+   // Fill the shader cache and quit if requested.
+   if ($precompileShadersArg !$= "") {
+      precompileShaders($precompileShadersArg);
+      quit();
+      return;
+   }
+
+   // Convert the COLLADA shapes ahead of time if requested.  Several
+   // processes can share the work with -shapeCacheWorker.
+   if ($warmShapeCacheArg !$= "") {
+      if ($shapeCacheWorkerArg $= "")
+         warmColladaCache($warmShapeCacheArg);
+      else
+         warmColladaCache($warmShapeCacheArg, getWord($shapeCacheWorkerArg, 0), getWord($shapeCacheWorkerArg, 1));
+      quit();
+      return;
+   }
+
+   // Benchmark a recording if requested.
+   if ($timeDemoArg !$= "") {
+      startTimeDemoPlayback(getWord($timeDemoArg, 0), getWord($timeDemoArg, 1));
+      return;
+   }
+
+   // Benchmark the render path of a mission if requested.
+   if ($renderBenchArg !$= "") {
+      startRenderBenchmarkMission(getWord($renderBenchArg, 0));
+      return;
+   }
+
    // Connect to server if requested.
    if ($JoinGameAddress !$= "") {
       // If we are instantly connecting to an address, load the
@@ -39,6 +39,9 @@
 
 function onMissionDownloadPhase1(%missionName, %musicTrack)
 {   
+   // Time the material initialization of this mission.
+   resetMaterialInitStats();
+
    // Load the post effect presets for this mission.
    %path = "levels/" @ fileBase( %missionName ) @ $PostFXManager::fileExtension;
    if ( isScriptFile( %path ) )
@@ -161,6 +164,14 @@ function onMissionDownloadComplete()
 {
    // Client will shortly be dropped into the game, so this is
    // good place for any last minute gui cleanup.
+
+   // Report where the material initialization time went.
+   %stats = getMaterialInitStats();
+   echo("Mission materials: " @ getWord(%stats, 0) @ " instances, " @
+        getWord(%stats, 1) @ " textures decoded in parallel");
+   echo("   prefetch " @ getWord(%stats, 2) @ " ms, textures " @ getWord(%stats, 3) @
+        " ms, features " @ getWord(%stats, 4) @ " ms, shaders " @ getWord(%stats, 5) @
+        " ms, finalize " @ getWord(%stats, 6) @ " ms");
 }
 
 
@@ -0,0 +1,183 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+
+//-----------------------------------------------------------------------------
+// Render benchmarks load a mission, fly the camera along its camera paths
+// and write the CPU time of each render stage and the GFX draw call and
+// state change counts to a JSON file.  Given the results of an earlier run
+// as a baseline, the game exits with status 1 if any count regressed, or any
+// stage got slower by more than it varied between the measured passes.
+//
+// To run a render benchmark from the command line use:
+//    -renderbench <mission> <results> [-renderbaseline <file>] [-headless]
+//
+// All the Path objects in the mission are flown along, or the ones named in
+// $RenderBenchmark::paths.  Missions without paths get an orbit around their
+// first spawn point.
+//
+// With -renderforest <count> a grid of identical TSStatic trees is planted
+// around the first spawn point, which shows how well repeated shapes batch
+// through the drawCalls and unbatchedDrawCalls results.
+//-----------------------------------------------------------------------------
+
+// How much a count or stage time can grow, as a fraction, before it is a
+// regression.
+if ($RenderBenchmark::threshold $= "")
+   $RenderBenchmark::threshold = 0.2;
+
+// The orbit flown in missions without camera paths.
+$RenderBenchmark::orbitRadius = 40;
+$RenderBenchmark::orbitHeight = 15;
+$RenderBenchmark::orbitMarkers = 8;
+
+// The shape and spacing of the trees planted for -renderforest.
+$RenderBenchmark::forestShape = "art/shapes/trees/defaulttree/defaulttree.DAE";
+$RenderBenchmark::forestSpacing = 8;
+
+function startRenderBenchmarkMission(%mission)
+{
+   StartLevel(%mission, "SinglePlayer");
+}
+
+function RenderBenchmark::getCenter()
+{
+   // The first spawn point the game would put a camera at.
+   for (%i = 0; %i < getWordCount($Game::defaultCameraSpawnGroups); %i++)
+   {
+      %group = getWord($Game::defaultCameraSpawnGroups, %i);
+      if (isObject(%group) && %group.getCount() > 0)
+         return %group.getObject(0).getPosition();
+   }
+   return "0 0 0";
+}
+
+function RenderBenchmark::plantForest(%count)
+{
+   %center = RenderBenchmark::getCenter();
+   %side = mCeil(mSqrt(%count));
+   %offset = (%side - 1) * $RenderBenchmark::forestSpacing / 2;
+
+   for (%i = 0; %i < %count; %i++)
+   {
+      %x = (%i % %side) * $RenderBenchmark::forestSpacing - %offset;
+      %y = mFloor(%i / %side) * $RenderBenchmark::forestSpacing - %offset;
+
+      // Turn the trees in a fixed pattern so every run renders the same.
+      %tree = new TSStatic()
+      {
+         shapeName = $RenderBenchmark::forestShape;
+         position = VectorAdd(%center, %x SPC %y SPC 0);
+         rotation = "0 0 1" SPC (%i * 37) % 360;
+         collisionType = "None";
+      };
+      MissionCleanup.add(%tree);
+   }
+}
+
+function RenderBenchmark::findPaths(%group)
+{
+   %paths = "";
+   %count = %group.getCount();
+   for (%i = 0; %i < %count; %i++)
+   {
+      %obj = %group.getObject(%i);
+      if (%obj.getClassName() $= "Path")
+         %paths = %paths SPC %obj.getId();
+      else if (%obj.isMemberOfClass("SimGroup"))
+         %paths = %paths SPC RenderBenchmark::findPaths(%obj);
+   }
+   return trim(%paths);
+}
+
+function RenderBenchmark::createOrbitPath()
+{
+   // Orbit around the first spawn point the game would put a camera at.
+   %center = RenderBenchmark::getCenter();
+
+   %path = new Path(RenderBenchmarkOrbit)
+   {
+      isLooping = true;
+   };
+   MissionCleanup.add(%path);
+
+   for (%i = 0; %i < $RenderBenchmark::orbitMarkers; %i++)
+   {
+      %angle = %i * 2 * 3.14159265 / $RenderBenchmark::orbitMarkers;
+      %offset = mCos(%angle) * $RenderBenchmark::orbitRadius SPC
+                mSin(%angle) * $RenderBenchmark::orbitRadius SPC
+                $RenderBenchmark::orbitHeight;
+
+      // Look back at the center.
+      %yaw = mAtan(-mCos(%angle), -mSin(%angle));
+      %transform = MatrixCreateFromEuler("0 0" SPC %yaw);
+
+      %path.add(new Marker()
+      {
+         position = VectorAdd(%center, %offset);
+         rotation = getWords(%transform, 3, 5) SPC mRadToDeg(getWord(%transform, 6));
+         seqNum = %i;
+         msToNext = 1000;
+      });
+   }
+
+   return %path.getId();
+}
+
+function onRenderBenchmarkComplete(%passed)
+{
+   if ($renderBenchArg $= "")
+      return;
+
+   disconnect();
+   quitWithStatus(%passed ? 0 : 1);
+}
+
+package RenderBenchmark {
+
+function GameConnection::initialControlSet(%this)
+{
+   Parent::initialControlSet(%this);
+
+   if ($renderBenchArg $= "" || isRenderBenchmarkRunning())
+      return;
+
+   if ($renderForestArg > 0)
+      RenderBenchmark::plantForest($renderForestArg);
+
+   %paths = $RenderBenchmark::paths;
+   if (%paths $= "")
+      %paths = RenderBenchmark::findPaths(MissionGroup);
+   if (%paths $= "")
+      %paths = RenderBenchmark::createOrbitPath();
+
+   if (!startRenderBenchmark(%paths, getWord($renderBenchArg, 1), $renderBaselineArg, $RenderBenchmark::threshold))
+   {
+      error("Render benchmark failed to start.");
+      disconnect();
+      quitWithStatus(1);
+   }
+}
+
+};
+activatePackage(RenderBenchmark);
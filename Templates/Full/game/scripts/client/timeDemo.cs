@@ -0,0 +1,72 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Time demos play a demo recording back as fast as the frames can be made
+// and write frame and subsystem timings to a JSON file, so that engine
+// changes can be benchmarked against the same recorded game.
+//
+// To run a time demo from the command line use:
+//    -timedemo <recording> <results> [-headless]
+//-----------------------------------------------------------------------------
+
+function startTimeDemoPlayback(%recording, %results)
+{
+   new GameConnection(ServerConnection);
+   RootGroup.add(ServerConnection);
+
+   // The demo skips the mission loading sequence, so start up the
+   // client side of the mission here like StartSelectedDemo() does.
+   clientStartMission();
+
+   if (!ServerConnection.playDemo(%recording))
+   {
+      error("Time demo playback failed for file '" @ %recording @ "'.");
+      ServerConnection.delete();
+      quit();
+      return;
+   }
+
+   Canvas.setContent(PlayGui);
+   ServerConnection.prepDemoPlayback();
+   startTimeDemo(%results);
+}
+
+package TimeDemo {
+
+function demoPlaybackComplete()
+{
+   // The engine already stopped the time demo and wrote the results.
+   if ($timeDemoArg !$= "")
+   {
+      disconnect();
+      clientEndMission();
+      quit();
+      return;
+   }
+
+   Parent::demoPlaybackComplete();
+}
+
+};
+activatePackage(TimeDemo);
@@ -33,7 +33,17 @@ function displayHelp() {
       "Fps Mod options:\n"@
       "  -dedicated             Start as dedicated server\n"@
       "  -connect <address>     For non-dedicated: Connect to a game at <address>\n" @
-      "  -mission <filename>    For dedicated: Load the mission\n"
+      "  -mission <filename>    For dedicated: Load the mission\n"@
+      "  -loadtest <bots> <seconds> For dedicated: Run a load test with simulated clients and quit\n"@
+      "  -timedemo <recording> <results> Play a demo back as fast as possible, write the timings to <results> and quit\n"@
+      "  -renderbench <mission> <results> Fly the camera paths of a mission, write the render stage timings to <results> and quit\n"@
+      "  -renderbaseline <file> For -renderbench: Exit with status 1 if the counts or timings regressed against <file>\n"@
+      "  -renderforest <count>  For -renderbench: Plant <count> identical trees around the first spawn point\n"@
+      "  -headless              For -timedemo and -renderbench: Use the null graphics and sound devices\n"@
+      "  -shaderPermutations <file> Write the shader permutations used this session to <file> on exit\n"@
+      "  -precompileShaders <file> Generate the shaders listed in <file> into the shader cache and quit\n"@
+      "  -warmShapeCache <folder> Generate the missing or out of date cached DTS files of the COLLADA shapes in <folder> and quit\n"@
+      "  -shapeCacheWorker <index> <count> For -warmShapeCache: Convert only this process's share of the shapes\n"
    );
 }
 
@@ -78,6 +88,114 @@ function parseArgs()
             }
             else
                error("Error: Missing Command Line argument. Usage: -connect <ip_address>");
+
+         //--------------------
+         case "-loadtest":
+            $argUsed[%i]++;
+            if ($Game::argc - %i > 2) {
+               $loadTestArg = %nextArg SPC $Game::argv[%i+2];
+               $argUsed[%i+1]++;
+               $argUsed[%i+2]++;
+               %i += 2;
+            }
+            else
+               error("Error: Missing Command Line argument. Usage: -loadtest <bots> <seconds>");
+
+         //--------------------
+         case "-timedemo":
+            $argUsed[%i]++;
+            if ($Game::argc - %i > 2) {
+               $timeDemoArg = %nextArg SPC $Game::argv[%i+2];
+               $argUsed[%i+1]++;
+               $argUsed[%i+2]++;
+               %i += 2;
+            }
+            else
+               error("Error: Missing Command Line argument. Usage: -timedemo <recording> <results>");
+
+         //--------------------
+         case "-renderbench":
+            $argUsed[%i]++;
+            if ($Game::argc - %i > 2) {
+               $renderBenchArg = %nextArg SPC $Game::argv[%i+2];
+               $argUsed[%i+1]++;
+               $argUsed[%i+2]++;
+               %i += 2;
+            }
+            else
+               error("Error: Missing Command Line argument. Usage: -renderbench <mission> <results>");
+
+         //--------------------
+         case "-renderbaseline":
+            $argUsed[%i]++;
+            if (%hasNextArg) {
+               $renderBaselineArg = %nextArg;
+               $argUsed[%i+1]++;
+               %i++;
+            }
+            else
+               error("Error: Missing Command Line argument. Usage: -renderbaseline <file>");
+
+         //--------------------
+         case "-renderforest":
+            $argUsed[%i]++;
+            if (%hasNextArg) {
+               $renderForestArg = %nextArg;
+               $argUsed[%i+1]++;
+               %i++;
+            }
+            else
+               error("Error: Missing Command Line argument. Usage: -renderforest <count>");
+
+         //--------------------
+         case "-headless":
+            $argUsed[%i]++;
+            $timeDemoHeadless = true;
+
+         //--------------------
+         case "-shaderPermutations":
+            $argUsed[%i]++;
+            if (%hasNextArg) {
+               $shaderPermutationsArg = %nextArg;
+               $argUsed[%i+1]++;
+               %i++;
+            }
+            else
+               error("Error: Missing Command Line argument. Usage: -shaderPermutations <file>");
+
+         //--------------------
+         case "-precompileShaders":
+            $argUsed[%i]++;
+            if (%hasNextArg) {
+               $precompileShadersArg = %nextArg;
+               $argUsed[%i+1]++;
+               %i++;
+            }
+            else
+               error("Error: Missing Command Line argument. Usage: -precompileShaders <file>");
+
+         //--------------------
+         case "-warmShapeCache":
+            $argUsed[%i]++;
+            if (%hasNextArg) {
+               $warmShapeCacheArg = %nextArg;
+               $argUsed[%i+1]++;
+               %i++;
+            }
+            else
+               error("Error: Missing Command Line argument. Usage: -warmShapeCache <folder>");
+
+         //--------------------
+         case "-shapeCacheWorker":
+            $argUsed[%i]++;
+            if ($Game::argc - %i > 2) {
+               $shapeCacheWorkerArg = %nextArg SPC $Game::argv[%i+2];
+               $argUsed[%i+1]++;
+               $argUsed[%i+2]++;
+               %i += 2;
+            }
+            else
+               error("Error: Missing Command Line argument. Usage: -shapeCacheWorker <index> <count>");
       }
    }
 }
@@ -99,8 +217,12 @@ function onStart()
    // Init the physics plugin.
    physicsInit();
       
-   // Start up the audio system.
-   sfxStartup();
+   // Start up the audio system.  Load tests and headless time demos
+   // don't need to make any noise.
+   if ($loadTestArg !$= "" || $timeDemoHeadless)
+      sfxCreateDevice("Null", "SFX Null Device", false, -1);
+   else
+      sfxStartup();
 
    // Server gets loaded for all sessions, since clients
    // can host in-game servers.
@@ -125,6 +247,10 @@ function onExit()
    
    // Destroy the physics plugin.
    physicsDestroy();
+
+   // Save the shaders this session used so they can be precompiled.
+   if ($shaderPermutationsArg !$= "")
+      saveShaderPermutations($shaderPermutationsArg);
       
    echo("Exporting client prefs");
    export("$pref::*", "./client/prefs.cs", False);
@@ -0,0 +1,84 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Server side of the bots started by startLoadTest().  Bots skip the mission
+// download and go straight into the game as soon as they connect.
+//
+// To run a load test from the command line use:
+//    -dedicated -mission <filename> -loadtest <bots> <seconds>
+//-----------------------------------------------------------------------------
+
+function LoadTestConnection::onConnectRequest(%client, %netAddress, %name)
+{
+   // Bots are not counted against the player limit.
+   return "";
+}
+
+function LoadTestConnection::onBotConnect(%client)
+{
+   %client.playerName = addTaggedString("Bot" @ %client.getId());
+   %client.score = 0;
+   %client.kills = 0;
+   %client.deaths = 0;
+   Game.preparePlayer(%client);
+}
+
+function LoadTestConnection::onGhostAlwaysObjectsReceived(%client)
+{
+   // No mission download phases to go through.
+}
+
+function LoadTestConnection::onDrop(%client, %reason)
+{
+   if (isObject(Game))
+      Game.onClientLeaveGame(%client);
+   removeTaggedString(%client.playerName);
+}
+
+// Bot side callbacks.  There's no GUI to update for bots.
+function LoadTestConnection::initialControlSet(%this) {}
+function LoadTestConnection::onControlObjectChange(%this) {}
+function LoadTestConnection::onFlash(%this, %state) {}
+
+//-----------------------------------------------------------------------------
+
+function onLoadTestComplete()
+{
+   if ($loadTestArg !$= "")
+      quit();
+}
+
+package LoadTest {
+
+function onMissionLoaded()
+{
+   Parent::onMissionLoaded();
+
+   // Start the load test given on the command line once the mission is up.
+   if ($loadTestArg !$= "")
+      startLoadTest(getWord($loadTestArg, 0), getWord($loadTestArg, 1), "random");
+}
+
+};
+activatePackage(LoadTest);
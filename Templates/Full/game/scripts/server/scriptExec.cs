@@ -56,3 +56,6 @@ exec("./turret.cs");
 // Load our gametypes
 exec("./gameCore.cs"); // This is the 'core' of the gametype functionality.
 exec("./gameDM.cs"); // Overrides GameCore with DeathMatch functionality.
+
+// Server side of the in-process load test bots.
+exec("./loadTest.cs");
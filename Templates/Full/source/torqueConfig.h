@@ -52,6 +52,11 @@
 #define TORQUE_DISABLE_MEMORY_MANAGER
 #endif
 
+/// Define me to serve small allocations from the size-class slab allocator
+/// with per-thread caches (see platform/platformSlabAllocator.h).  Works with
+/// or without the Torque memory manager, but is ignored with TORQUE_DEBUG_GUARD.
+//#define TORQUE_SLAB_ALLOCATOR
+
 /// The improved SimDictionary uses C++11 and is designed for games where
 /// there are over 10000 simobjects active normally. To enable the new
 /// SimDictionary just uncomment the line below.
@@ -174,6 +179,11 @@
 /// texture manager.
 #define TORQUE_FRAME_SIZE     32 << 20
 
+/// The size of the FrameAllocator arena given to each worker thread that
+/// uses FrameTemp or FrameAllocatorMarker.  The main thread uses
+/// TORQUE_FRAME_SIZE above.
+#define TORQUE_WORKER_FRAME_SIZE     4 << 20
+
 // Finally, we define some dependent #defines. This enables some subsidiary
 // functionality to get automatically turned on in certain configurations.
 
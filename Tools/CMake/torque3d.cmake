@@ -100,6 +100,9 @@ mark_as_advanced(TORQUE_MULTITHREAD)
 option(TORQUE_DISABLE_MEMORY_MANAGER "Disable memory manager" ON)
 mark_as_advanced(TORQUE_DISABLE_MEMORY_MANAGER)
 
+option(TORQUE_SLAB_ALLOCATOR "Serve small allocations from the slab allocator" OFF)
+mark_as_advanced(TORQUE_SLAB_ALLOCATOR)
+
 option(TORQUE_DISABLE_VIRTUAL_MOUNT_SYSTEM "Disable virtual mount system" OFF)
 mark_as_advanced(TORQUE_DISABLE_VIRTUAL_MOUNT_SYSTEM)
 
@@ -169,12 +172,17 @@ addPath("${srcDir}/") # must come first :)
 addPathRec("${srcDir}/app")
 addPath("${srcDir}/sfx/media")
 addPath("${srcDir}/sfx/null")
+addPath("${srcDir}/sfx/software")
+addPath("${srcDir}/sfx/software/arch")
+addPath("${srcDir}/sfx/software/test")
 addPath("${srcDir}/sfx")
 addPath("${srcDir}/component")
 addPath("${srcDir}/component/interfaces")
 addPath("${srcDir}/console")
+addPath("${srcDir}/console/test")
 addPath("${srcDir}/core")
 addPath("${srcDir}/core/stream")
+addPath("${srcDir}/core/stream/test")
 addPath("${srcDir}/core/strings")
 addPath("${srcDir}/core/util")
 addPath("${srcDir}/core/util/test")
@@ -185,6 +193,7 @@ addPath("${srcDir}/core/util/zip/test")
 addPath("${srcDir}/core/util/zip/compressors")
 addPath("${srcDir}/i18n")
 addPath("${srcDir}/sim")
+addPath("${srcDir}/sim/test")
 addPath("${srcDir}/util")
 addPath("${srcDir}/windowManager")
 addPath("${srcDir}/windowManager/torque")
@@ -200,6 +209,7 @@ if( NOT TORQUE_DEDICATED )
 endif()
 addPath("${srcDir}/platform/test")
 addPath("${srcDir}/platform/threads")
+addPath("${srcDir}/platform/threads/test")
 addPath("${srcDir}/platform/async")
 addPath("${srcDir}/platform/async/test")
 addPath("${srcDir}/platform/input")
@@ -215,10 +225,12 @@ addPath("${srcDir}/gfx/util")
 addPath("${srcDir}/gfx/video")
 addPath("${srcDir}/gfx")
 addPath("${srcDir}/shaderGen")
+addPath("${srcDir}/shaderGen/test")
 addPath("${srcDir}/gfx/sim")
 addPath("${srcDir}/gui/buttons")
 addPath("${srcDir}/gui/containers")
 addPath("${srcDir}/gui/controls")
+addPath("${srcDir}/gui/controls/test")
 addPath("${srcDir}/gui/core")
 addPath("${srcDir}/gui/game")
 addPath("${srcDir}/gui/shiny")
@@ -226,15 +238,20 @@ addPath("${srcDir}/gui/utility")
 addPath("${srcDir}/gui")
 addPath("${srcDir}/collision")
 addPath("${srcDir}/materials")
+addPath("${srcDir}/materials/test")
 addPath("${srcDir}/lighting")
 addPath("${srcDir}/lighting/common")
 addPath("${srcDir}/renderInstance")
+addPath("${srcDir}/renderInstance/test")
 addPath("${srcDir}/scene")
 addPath("${srcDir}/scene/culling")
 addPath("${srcDir}/scene/zones")
 addPath("${srcDir}/scene/mixin")
+addPath("${srcDir}/scene/test")
 addPath("${srcDir}/shaderGen")
 addPath("${srcDir}/terrain")
+addPath("${srcDir}/terrain/arch")
+addPath("${srcDir}/terrain/test")
 addPath("${srcDir}/environment")
 addPath("${srcDir}/forest")
 addPath("${srcDir}/forest/ts")
@@ -252,6 +269,7 @@ addPath("${srcDir}/T3D/physics")
 addPath("${srcDir}/T3D/decal")
 addPath("${srcDir}/T3D/sfx")
 addPath("${srcDir}/T3D/gameBase")
+addPath("${srcDir}/T3D/gameBase/test")
 addPath("${srcDir}/T3D/turret")
 addPath("${srcDir}/main/")
 addPathRec("${srcDir}/ts/collada")
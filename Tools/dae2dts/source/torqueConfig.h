@@ -65,6 +65,11 @@
 #define TORQUE_DISABLE_MEMORY_MANAGER
 #endif
 
+/// Define me to serve small allocations from the size-class slab allocator
+/// with per-thread caches (see platform/platformSlabAllocator.h).  Works with
+/// or without the Torque memory manager, but is ignored with TORQUE_DEBUG_GUARD.
+//#define TORQUE_SLAB_ALLOCATOR
+
 /// Define me if you don't want Torque to compile dso's
 #define TORQUE_NO_DSO_GENERATION
 
@@ -148,6 +153,11 @@
 /// texture manager.
 #define TORQUE_FRAME_SIZE     32 << 20
 
+/// The size of the FrameAllocator arena given to each worker thread that
+/// uses FrameTemp or FrameAllocatorMarker.  The main thread uses
+/// TORQUE_FRAME_SIZE above.
+#define TORQUE_WORKER_FRAME_SIZE     4 << 20
+
 // Finally, we define some dependent #defines. This enables some subsidiary
 // functionality to get automatically turned on in certain configurations.
 